@@ -5,10 +5,23 @@ file(GLOB TESTS_SOURCES
     "${TESTS_ROOT_DIR}/Platform/${OS}/*.cpp" "${TESTS_ROOT_DIR}/Platform/${OS}/*.h" "${TESTS_ROOT_DIR}/Platform/${OS}/*.mm"
     "${TESTS_ROOT_DIR}/Platform/*.cpp" "${TESTS_ROOT_DIR}/Platform/*.h"
     "${TESTS_ROOT_DIR}/Tools/*.cpp" "${TESTS_ROOT_DIR}/Tools/*.h"
+    "${TESTS_ROOT_DIR}/Tools/BehaviorControl/CircleSectors.cpp" "${TESTS_ROOT_DIR}/Tools/BehaviorControl/CircleSectors.h"
+    "${TESTS_ROOT_DIR}/Tools/BehaviorControl/PassingLanes.cpp" "${TESTS_ROOT_DIR}/Tools/BehaviorControl/PassingLanes.h"
     "${TESTS_ROOT_DIR}/Tools/Debugging/TimingManager.cpp" "${TESTS_ROOT_DIR}/Tools/Debugging/TimingManager.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/ParallelRows.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/ParallelRows.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/PatchUtilities.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/PatchUtilities.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/Resize.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/Resize.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/ScanLineColumns.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/ScanLineColumns.h"
+    "${TESTS_ROOT_DIR}/Tools/ImageProcessing/Sobel.cpp" "${TESTS_ROOT_DIR}/Tools/ImageProcessing/Sobel.h"
+    "${TESTS_ROOT_DIR}/Tools/Math/BilinearGrid.cpp" "${TESTS_ROOT_DIR}/Tools/Math/BilinearGrid.h"
+    "${TESTS_ROOT_DIR}/Tools/Math/Delaunay.cpp" "${TESTS_ROOT_DIR}/Tools/Math/Delaunay.h"
     "${TESTS_ROOT_DIR}/Tools/Math/Random.cpp" "${TESTS_ROOT_DIR}/Tools/Math/Random.h"
     "${TESTS_ROOT_DIR}/Tools/Math/RotationMatrix.cpp" "${TESTS_ROOT_DIR}/Tools/Math/RotationMatrix.h"
+    "${TESTS_ROOT_DIR}/Tools/Math/SpatialGrid.cpp" "${TESTS_ROOT_DIR}/Tools/Math/SpatialGrid.h"
     "${TESTS_ROOT_DIR}/Tools/Logging/LoggingTools.cpp" "${TESTS_ROOT_DIR}/Tools/Logging/LoggingTools.h"
+    "${TESTS_ROOT_DIR}/Tools/Logging/SnappyEncoder.cpp" "${TESTS_ROOT_DIR}/Tools/Logging/SnappyEncoder.h"
+    "${TESTS_ROOT_DIR}/Tools/Modeling/UKFPose2D.cpp" "${TESTS_ROOT_DIR}/Tools/Modeling/UKFPose2D.h"
+    "${TESTS_ROOT_DIR}/Tools/Modeling/UKFPose2DBatch.cpp" "${TESTS_ROOT_DIR}/Tools/Modeling/UKFPose2DBatch.h"
     "${TESTS_ROOT_DIR}/Tools/MessageQueue/*.cpp" "${TESTS_ROOT_DIR}/Tools/MessageQueue/*.h"
     "${TESTS_ROOT_DIR}/Tools/Module/*.cpp" "${TESTS_ROOT_DIR}/Tools/Module/*.h"
     "${TESTS_ROOT_DIR}/Tools/Streams/*.cpp" "${TESTS_ROOT_DIR}/Tools/Streams/*.h")
@@ -50,6 +63,8 @@ target_link_libraries(Tests PRIVATE $<$<PLATFORM_ID:Linux>:-lpthread>)
 target_link_libraries(Tests PRIVATE Eigen::Eigen)
 target_link_libraries(Tests PRIVATE GameController::GameController)
 target_link_libraries(Tests PRIVATE GTest::GTest)
+target_link_libraries(Tests PRIVATE ${OpenCV_LIBS})
+target_link_libraries(Tests PRIVATE snappy::snappy)
 
 target_compile_definitions(Tests PRIVATE TARGET_TOOL GTEST_DONT_DEFINE_FAIL GTEST_DONT_DEFINE_TEST GTEST_HAS_TR1_TUPLE=0)
 
@@ -15,6 +15,7 @@
 #include "Platform/File.h"
 #include "Platform/Time.h"
 #include "Tools/FunctionList.h"
+#include "Tools/Streams/OutStreams.h"
 
 #include <SimRobotEditor.h>
 
@@ -23,6 +24,7 @@
 #include <QFileDialog>
 #include <QInputDialog>
 #include <QSettings>
+#include <QStringList>
 
 #include <algorithm>
 #include <cctype>
@@ -73,6 +75,8 @@ bool ConsoleRoboCupCtrl::compile()
   if(p2 > p)
     fileName = fileName.substr(0, p2);
   executeFile("", fileName, false, nullptr, true);
+  for(const QString& argument : application->getArguments())
+    executeConsoleCommand(argument.toUtf8().constData(), nullptr, true);
 
   if(!RoboCupCtrl::compile())
     return false;
@@ -86,6 +90,8 @@ bool ConsoleRoboCupCtrl::compile()
   start();
 
   executeFile("", fileName, false, nullptr, false);
+  for(const QString& argument : application->getArguments())
+    executeConsoleCommand(argument.toUtf8().constData());
 
   for(ControllerRobot* robot : robots)
     robot->getRobotThread()->handleConsole("endOfStartScript");
@@ -143,6 +149,9 @@ void ConsoleRoboCupCtrl::update()
   for(RemoteRobot* remoteRobot : remoteRobots)
     remoteRobot->update();
 
+  if(!matchStatisticsFile.empty())
+    updateMatchStatistics();
+
   {
     SYNC;
     application->setStatusMessage(statusText);
@@ -379,6 +388,11 @@ void ConsoleRoboCupCtrl::executeConsoleCommand(std::string command, RobotConsole
     if(!gameController.handleGlobalConsole(stream))
       printLn("Syntax Error");
   }
+  else if(buffer == "ms")
+  {
+    if(!collectMatchStatistics(stream))
+      printLn("Syntax Error");
+  }
   else if(buffer == "mvo")
   {
     std::string objectID;
@@ -510,6 +524,7 @@ void ConsoleRoboCupCtrl::help(In& stream)
   list("  echo <text> : Print text into console window. Useful in console.con.", pattern, true);
   list("  gc initial | standby | ready | set | playing | finished | goalByFirstTeam | goalBySecondTeam | kickOffFirstTeam | kickOffSecondTeam | manualPlacementFirstTeam | manualPlacementSecondTeam | goalKickForFirstTeam | goalKickForSecondTeam | pushingFreeKickForFirstTeam | pushingFreeKickForSecondTeam | cornerKickForFirstTeam | cornerKickForSecondTeam | kickInForFirstTeam | kickInForSecondTeam | penaltyKickForFirstTeam | penaltyKickForSecondTeam | gameNormal | gamePenaltyShootout | competitionPhasePlayoff | competitionPhaseRoundRobin | competitionTypeNormal : Set GameController state.", pattern, true);
   list("  ( help | ? ) [<pattern>] : Display this text.", pattern, true);
+  list("  ms <file> [<seconds>] : Write match statistics to a file and stop the simulation when the half is over or after the given simulated time.", pattern, true);
   if(is2D)
     list("  mvo <name> <x> <y> [<rot>] : Move the object with the given name to the given position.", pattern, true);
   else
@@ -535,6 +550,7 @@ void ConsoleRoboCupCtrl::help(In& stream)
   list("  log saveJointAngleData [<file>] : Save the joint angle data from the lot into a dataset. Require motion log.", pattern, true);
   list("  log saveLabeledBallSpots [<file>] : Extracts labeled BallSpots.", pattern, true);
   list("  log saveTiming [<file>] : Save timing data from log to csv.", pattern, true);
+  list("  log saveTrace [<file>] : Save stopwatch events from log as Chrome trace (json).", pattern, true);
   list("  log trim ( until <end frame> | from <start frame> | between <start frame> <end frame> ) : Keep only the given section of the log. WARNING: Overwrites the log file!", pattern, true);
   list("  log ? [<pattern>] : Display information about log file.", pattern, true);
   list("  log load <file> | clear : Load log-file or clear all frames.", pattern, true);
@@ -544,6 +560,7 @@ void ConsoleRoboCupCtrl::help(In& stream)
   list("  log start | pause | stop | forward [image] | backward [image] | repeat | goto <number> | time <minutes> <seconds> | cycle | once | fastForward | fastBackward : Replay log file.", pattern, true);
   list("  log mr [legacy] [list] : Generate module requests to replay log file.", pattern, true);
   list("  log analyzeRobotStatus : Find timestamps with joints that are defect or gyros not updating.", pattern, true);
+  list("  log batch <dir> <output dir> [overwrite] ( images | inertialSensorData | jointAngleData | timing ) {...} : Extract data from all logs in a directory in parallel and merge the results.", pattern, true);
   list("  msg off | on | log <file> | enable | disable : Switch output of text messages on or off. Log text messages to a file. Switch message handling on or off.", pattern, true);
   list("  mr ? [<pattern>] | modules [<pattern>] | save | <representation> ( ? [<pattern>] | ( <module> | off ) [<thread>] | default ) : Send module request.", pattern, true);
   if(is2D)
@@ -700,6 +717,53 @@ bool ConsoleRoboCupCtrl::calcImage(In& stream)
   }
 }
 
+bool ConsoleRoboCupCtrl::collectMatchStatistics(In& stream)
+{
+  std::string fileName;
+  std::string timeLimit;
+  stream >> fileName >> timeLimit;
+  if(fileName.empty() || timeLimit.find_first_not_of("0123456789") != std::string::npos)
+    return false;
+
+  matchStatisticsFile = fileName;
+  matchTimeLimit = static_cast<float>(atoi(timeLimit.c_str()));
+  matchStatistics = MatchStatistics();
+  lastStepTime = std::chrono::steady_clock::time_point();
+  return true;
+}
+
+void ConsoleRoboCupCtrl::updateMatchStatistics()
+{
+  // The first step only starts the measurement, because the previous one might
+  // have been spent initializing.
+  const auto now = std::chrono::steady_clock::now();
+  MatchStatistics::Timing& timing = matchStatistics.timing;
+  if(lastStepTime != std::chrono::steady_clock::time_point())
+  {
+    const float stepTime = std::chrono::duration<float, std::milli>(now - lastStepTime).count();
+    ++timing.steps;
+    timing.simulatedTime += simStepLength / 1000.f;
+    timing.realTime += stepTime / 1000.f;
+    timing.maxStepTime = std::max(timing.maxStepTime, stepTime);
+  }
+  lastStepTime = now;
+
+  if(gameController.updateMatchStatistics(matchStatistics, simStepLength)
+     || (matchTimeLimit > 0.f && timing.simulatedTime >= matchTimeLimit))
+  {
+    if(timing.steps)
+    {
+      timing.meanStepTime = timing.realTime * 1000.f / static_cast<float>(timing.steps);
+      timing.realTimeFactor = timing.simulatedTime / std::max(timing.realTime, 0.001f);
+    }
+    OutMapFile file(matchStatisticsFile, true);
+    file << matchStatistics;
+    printLn("Match statistics written to " + matchStatisticsFile);
+    matchStatisticsFile.clear();
+    application->simStop();
+  }
+}
+
 void ConsoleRoboCupCtrl::print(const std::string& text)
 {
   SYNC;
@@ -755,12 +819,14 @@ void ConsoleRoboCupCtrl::createCompletion()
     "log full",
     "log jpeg",
     "log saveAudio",
+    "log batch",
     "log saveChoregrapheTimeline",
     "log saveImages raw onlyPlaying",
     "log saveInertialSensorData",
     "log saveLabeledBallSpots gray",
     "log saveJointAngleData",
     "log saveTiming",
+    "log saveTrace",
     "log trim from",
     "log trim until",
     "log trim between",
@@ -790,6 +856,7 @@ void ConsoleRoboCupCtrl::createCompletion()
     "log analyzeRobotStatus",
     "mr modules",
     "mr save",
+    "ms",
     "msg off",
     "msg on",
     "msg log",
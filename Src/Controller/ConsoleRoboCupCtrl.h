@@ -8,11 +8,13 @@
 
 #pragma once
 
+#include <chrono>
 #include <set>
 #include <QDir>
 #include <QString>
 
 #include "BHToolBar.h"
+#include "MatchStatistics.h"
 #include "RoboCupCtrl.h"
 #include "RobotConsole.h"
 
@@ -50,6 +52,10 @@ private:
   const RobotConsole::PlotViews* plotViews = nullptr; /**< Points to the map of plot views used for tab-completion. */
   BHToolBar toolBar; /**< The toolbar shown for this controller. */
   static constexpr float ballFriction = -0.35f; /**< The ball friction acceleration (2D only). */
+  std::string matchStatisticsFile; /**< The file the match statistics are written to. Empty if they are not collected. */
+  float matchTimeLimit = 0.f; /**< The simulated time after which the match is aborted (in s, 0 = unlimited). */
+  MatchStatistics matchStatistics; /**< The statistics of the current match. */
+  std::chrono::steady_clock::time_point lastStepTime; /**< When did the previous simulation step end? */
 
 public:
   /**
@@ -245,6 +251,19 @@ private:
    */
   bool calcImage(In&);
 
+  /**
+   * The function handles the console input for the "ms" command.
+   * @param stream The stream containing the parameters of "ms".
+   * @return Returns true if the parameters were correct.
+   */
+  bool collectMatchStatistics(In& stream);
+
+  /**
+   * The function updates the match statistics. When the match is over, they
+   * are written to a file and the simulation is stopped.
+   */
+  void updateMatchStatistics();
+
   /**
    * The function creates the map for command completion.
    */
@@ -6,6 +6,7 @@
  */
 
 #include "GameController.h"
+#include "MatchStatistics.h"
 #include "SimulatedRobot.h"
 #include "Platform/BHAssert.h"
 #include "Platform/Time.h"
@@ -857,6 +858,18 @@ void GameController::referee()
   }
 }
 
+int GameController::getSecsRemaining() const
+{
+  const int duration = gameInfo.gamePhase == GAME_PHASE_NORMAL ? halfTime : penaltyShotTime;
+  const int timePlayed = gameInfo.state == STATE_INITIAL
+                         || ((gameInfo.state == STATE_READY || gameInfo.state == STATE_SET)
+                             && (gameInfo.competitionPhase == COMPETITION_PHASE_PLAYOFF || timeBeforeCurrentState == 0))
+                         || gameInfo.state == STATE_FINISHED
+                         ? timeBeforeCurrentState / 1000
+                         : Time::getTimeSince(timeWhenStateBegan - timeBeforeCurrentState) / 1000;
+  return duration - timePlayed;
+}
+
 void GameController::addTimeInCurrentState()
 {
   timeBeforeCurrentState += Time::getCurrentSystemTime() - timeWhenStateBegan;
@@ -935,18 +948,43 @@ void GameController::setLastBallContactRobot(SimRobot::Object* robot)
   lastBallContactTime = Time::getCurrentSystemTime();
 }
 
+bool GameController::updateMatchStatistics(MatchStatistics& statistics, float stepLength)
+{
+  SYNC;
+
+  if(gameInfo.state == STATE_PLAYING)
+  {
+    statistics.playingTime += stepLength / 1000.f;
+    if(lastBallContactTime)
+      (lastBallContactPose.rotation == 0.f ? statistics.secondTeam : statistics.firstTeam).ballPossession += stepLength / 1000.f;
+  }
+
+  for(int i = 0; i < numOfRobots; ++i)
+  {
+    Robot& r = robots[i];
+    if(r.simulatedRobot)
+    {
+      const bool upright = r.simulatedRobot->isUpright();
+      if(r.upright && !upright && r.info.penalty == PENALTY_NONE)
+        ++(i < numOfRobots / 2 ? statistics.firstTeam : statistics.secondTeam).falls;
+      r.upright = upright;
+    }
+  }
+
+  statistics.firstTeam.score = teamInfos[0].score;
+  statistics.secondTeam.score = teamInfos[1].score;
+
+  if(gameInfo.state == STATE_PLAYING && gameInfo.gamePhase == GAME_PHASE_NORMAL && getSecsRemaining() <= 0)
+    VERIFY(handleStateCommand("finished"));
+  statistics.finished = gameInfo.state == STATE_FINISHED && statistics.playingTime > 0.f;
+  return statistics.finished;
+}
+
 void GameController::writeGameInfo(Out& stream)
 {
   SYNC;
 
-  const int duration = gameInfo.gamePhase == GAME_PHASE_NORMAL ? halfTime : penaltyShotTime;
-  const int timePlayed = gameInfo.state == STATE_INITIAL
-                         || ((gameInfo.state == STATE_READY || gameInfo.state == STATE_SET)
-                             && (gameInfo.competitionPhase == COMPETITION_PHASE_PLAYOFF || timeBeforeCurrentState == 0))
-                         || gameInfo.state == STATE_FINISHED
-                         ? timeBeforeCurrentState / 1000
-                         : Time::getTimeSince(timeWhenStateBegan - timeBeforeCurrentState) / 1000;
-  gameInfo.secsRemaining = static_cast<int16_t>(duration - timePlayed);
+  gameInfo.secsRemaining = static_cast<int16_t>(getSecsRemaining());
 
   if(gameInfo.state == STATE_READY)
     gameInfo.secondaryTime = static_cast<int16_t>((gameInfo.setPlay == SET_PLAY_PENALTY_KICK ? penaltyKickReadyTime : readyTime) - Time::getTimeSince(timeWhenStateBegan) / 1000);
@@ -21,6 +21,7 @@
 #include <string>
 
 class SimulatedRobot;
+struct MatchStatistics;
 
 /**
  * The class simulates a console-based GameController.
@@ -58,6 +59,7 @@ private:
     uint8_t lastPenalty = PENALTY_NONE;
     GlobalPose2f lastPose;
     bool manuallyPlaced = false;
+    bool upright = true; /**< Was the robot upright when the match statistics were updated last? */
   };
 
   ENUM(Penalty,
@@ -150,6 +152,16 @@ public:
    */
   void setLastBallContactRobot(SimRobot::Object* robot);
 
+  /**
+   * Updates the statistics of the match. It must be called once per simulation
+   * step. When the time of the half is up, the game state is switched to finished,
+   * because the simulated GameController does not play a second half.
+   * @param statistics The statistics that are updated.
+   * @param stepLength The duration of a simulation step (in ms).
+   * @return Is the match over?
+   */
+  bool updateMatchStatistics(MatchStatistics& statistics, float stepLength);
+
   /**
    * Write the current game information to the stream provided.
    * @param stream The stream the game information is written to.
@@ -297,6 +309,12 @@ private:
    */
   void checkIllegalPositionInSet(int robot);
 
+  /**
+   * Determines the remaining time of the current half or penalty shot.
+   * @return The remaining time (in s).
+   */
+  int getSecsRemaining() const;
+
   /** Adds the time that has elapsed in the current state to timeBeforeCurrentState. */
   void addTimeInCurrentState();
 
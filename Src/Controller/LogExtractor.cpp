@@ -36,6 +36,7 @@
 #include "Tools/ImageProcessing/ImageExport.h"
 #include "Tools/ImageProcessing/PatchUtilities.h"
 #include "Tools/Logging/LoggingTools.h"
+#include "Tools/Logging/TraceWriter.h"
 #include "Tools/Math/Projection.h"
 #include "Tools/Math/Transformation.h"
 #include "Tools/Motion/SensorData.h"
@@ -43,6 +44,13 @@
 #include "Tools/Streams/TypeInfo.h"
 #include <QImage>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <type_traits>
 
 /**
@@ -72,6 +80,7 @@ bool LogExtractor::save(const std::string& fileName, const TypeInfo* typeInfo)
 {
   if(logPlayer.state == LogPlayer::recording)
     logPlayer.recordStop();
+  logPlayer.loadAllChunks();
 
   if(!logPlayer.getNumberOfMessages())
     return false;
@@ -101,6 +110,7 @@ bool LogExtractor::save(const std::string& fileName, const TypeInfo* typeInfo)
 
 bool LogExtractor::split(const std::string& fileName, const TypeInfo* typeInfo, const int& split)
 {
+  logPlayer.loadAllChunks();
   int numberOfMessagesToWrite = static_cast<int>(std::ceil(logPlayer.getNumberOfMessages() / split));
   for(int i = 0; i < split; ++i)
   {
@@ -143,15 +153,15 @@ bool LogExtractor::saveAudioFile(const std::string& fileName)
 
   int frames = 0;
   AudioData audioData;
-  for(int currentMessageNumber = 0; currentMessageNumber < logPlayer.getNumberOfMessages(); ++currentMessageNumber)
+  logPlayer.forAllMessages([&](InMessage& message)
   {
-    logPlayer.queue.setSelectedMessageForReading(currentMessageNumber);
-    if(logPlayer.queue.getMessageID() == idAudioData)
+    if(message.getMessageID() == idAudioData)
     {
-      logPlayer.in.bin >> audioData;
+      message.bin >> audioData;
       frames += unsigned(audioData.samples.size()) / audioData.channels;
     }
-  }
+    return true;
+  });
 
   struct WAVHeader
   {
@@ -191,16 +201,16 @@ bool LogExtractor::saveAudioFile(const std::string& fileName)
   header->subchunk2Size = frames * audioData.channels * sizeof(AudioData::Sample);
 
   char* p = reinterpret_cast<char*>(header + 1);
-  for(int currentMessageNumber = 0; currentMessageNumber < logPlayer.getNumberOfMessages(); ++currentMessageNumber)
+  logPlayer.forAllMessages([&](InMessage& message)
   {
-    logPlayer.queue.setSelectedMessageForReading(currentMessageNumber);
-    if(logPlayer.queue.getMessageID() == idAudioData)
+    if(message.getMessageID() == idAudioData)
     {
-      logPlayer.in.bin >> audioData;
+      message.bin >> audioData;
       memcpy(p, audioData.samples.data(), audioData.samples.size() * sizeof(AudioData::Sample));
       p += audioData.samples.size() * sizeof(AudioData::Sample);
     }
-  }
+    return true;
+  });
 
   stream.write(header, length);
   delete[] header;
@@ -409,49 +419,49 @@ bool LogExtractor::writeTimingData(const std::string& fileName)
   std::map<unsigned short, std::string> names;/**<contains a mapping from watch id to watch name */
   std::map<unsigned, std::map<unsigned short, unsigned>> timings;/**<Contains a map from watch id to timing for each existing frame*/
   std::map<unsigned, unsigned> threadStartTimes;/**< After parsing this contains the start time of each frame (frames may be missing) */
-  for(int currentMessageNumber = 0; currentMessageNumber < logPlayer.getNumberOfMessages(); currentMessageNumber++)
+  logPlayer.forAllMessages([&](InMessage& message)
   {
-    logPlayer.queue.setSelectedMessageForReading(currentMessageNumber);
-    if(logPlayer.queue.getMessageID() == idStopwatch)
+    if(message.getMessageID() == idStopwatch)
     {
       //NOTE: this parser is a slightly modified version of the on in TimeInfo
       //first get the names
       unsigned short nameCount;
-      logPlayer.in.bin >> nameCount;
+      message.bin >> nameCount;
 
       for(unsigned short i = 0; i < nameCount; ++i)
       {
         std::string watchName;
         unsigned short watchId;
-        logPlayer.in.bin >> watchId;
-        logPlayer.in.bin >> watchName;
+        message.bin >> watchId;
+        message.bin >> watchName;
         if(names.find(watchId) == names.end()) //new name
           names[watchId] = watchName;
       }
 
       //now get timing data
       unsigned short dataCount;
-      logPlayer.in.bin >> dataCount;
+      message.bin >> dataCount;
 
       std::map<unsigned short, unsigned> frameTiming;
       for(unsigned short i = 0; i < dataCount; ++i)
       {
         unsigned short watchId;
         unsigned time;
-        logPlayer.in.bin >> watchId;
-        logPlayer.in.bin >> time;
+        message.bin >> watchId;
+        message.bin >> time;
 
         frameTiming[watchId] = time;
       }
       unsigned threadStartTime;
-      logPlayer.in.bin >> threadStartTime;
+      message.bin >> threadStartTime;
       unsigned frameNo;
-      logPlayer.in.bin >> frameNo;
+      message.bin >> frameNo;
 
       timings[frameNo] = frameTiming;
       threadStartTimes[frameNo] = threadStartTime;
     }
-  }
+    return true;
+  });
 
   //now write the data to disk
   OutTextRawFile file(fileName);
@@ -497,6 +507,18 @@ bool LogExtractor::writeTimingData(const std::string& fileName)
   return true;
 }
 
+bool LogExtractor::writeTraceData(const std::string& fileName)
+{
+  logPlayer.stop();
+
+  TraceWriter trace(fileName);
+  if(!trace.exists())
+    return false;
+
+  logPlayer.handleAllMessages(trace);
+  return true;
+}
+
 bool LogExtractor::saveChoregrapheTimeline(const std::string& path)
 {
   logPlayer.stop(); // Just reset the LogPlayer to start
@@ -723,6 +745,146 @@ bool LogExtractor::saveLabeledBallSpots(const std::string& path)
   true);
 }
 
+bool LogExtractor::batch(const std::string& directory, const std::string& outputDirectory, const std::vector<std::string>& jobs, bool overwrite)
+{
+  for(const std::string& job : jobs)
+    if(job != "images" && job != "inertialSensorData" && job != "jointAngleData" && job != "timing")
+      return false;
+
+  const std::string logPath = File::isAbsolute(directory.c_str()) ? directory : std::string(File::getBHDir()) + "/Config/" + directory;
+  const std::string outputPath = (File::isAbsolute(outputDirectory.c_str()) ? outputDirectory : std::string(File::getBHDir()) + "/Config/" + outputDirectory) + "/";
+  std::vector<std::string> names; // The names of the logs without extension
+  for(const QString& file : QDir(logPath.c_str()).entryList({"*.log"}, QDir::Files, QDir::Name))
+    names.push_back(file.left(file.size() - 4).toUtf8().constData());
+  if(names.empty())
+    return false;
+
+  // Results of a previous run are only replaced if this was requested explicitly.
+  for(const std::string& job : jobs)
+  {
+    const std::string jobPath = outputPath + job;
+    if(QFileInfo::exists(jobPath.c_str()) || QFileInfo::exists((jobPath + ".csv").c_str()))
+    {
+      if(!overwrite)
+      {
+        OUTPUT_ERROR("LogExtractor: " << jobPath << " already exists. Add \"overwrite\" to replace it.");
+        return false;
+      }
+      QDir(jobPath.c_str()).removeRecursively();
+      QFile::remove((jobPath + ".csv").c_str());
+    }
+  }
+  for(const std::string& job : jobs)
+    QDir().mkpath((outputPath + job).c_str());
+
+  // Logs that are not chunked are completely loaded into memory. Therefore, a thread only
+  // loads the next log if all logs loaded together stay within the budget. The size of
+  // the file is used as an estimate until the log was loaded. A log is always loaded if
+  // no other one is, however large it is.
+  constexpr size_t maxLoadedBytes = size_t(4) << 30;
+  size_t loadedBytes = 0;
+  std::mutex loadedBytesMutex;
+  std::condition_variable loadedBytesReduced;
+  auto reserveBytes = [&](size_t bytes)
+  {
+    std::unique_lock<std::mutex> lock(loadedBytesMutex);
+    loadedBytesReduced.wait(lock, [&] {return !loadedBytes || loadedBytes + bytes <= maxLoadedBytes;});
+    loadedBytes += bytes;
+  };
+  auto updateBytes = [&](size_t reservedBytes, size_t bytes)
+  {
+    {
+      std::lock_guard<std::mutex> lock(loadedBytesMutex);
+      loadedBytes = loadedBytes - reservedBytes + bytes;
+    }
+    loadedBytesReduced.notify_all();
+  };
+
+  // Each thread loads the next log that was not processed yet and runs all jobs on it.
+  std::atomic<size_t> nextLog(0);
+  std::atomic<bool> success(true);
+  std::vector<std::thread> threads(std::clamp(std::thread::hardware_concurrency(), 1u, static_cast<unsigned>(names.size())));
+  for(std::thread& thread : threads)
+    thread = std::thread([&]
+    {
+      MessageQueue targetQueue;
+      for(size_t i = nextLog++; i < names.size(); i = nextLog++)
+      {
+        const std::string logName = logPath + "/" + names[i] + ".log";
+        const size_t estimatedBytes = static_cast<size_t>(QFileInfo(logName.c_str()).size());
+        reserveBytes(estimatedBytes);
+        LogPlayer logPlayer(targetQueue);
+        if(!logPlayer.open(logName))
+        {
+          updateBytes(estimatedBytes, 0);
+          success = false;
+          continue;
+        }
+
+        // Chunked logs only keep the current chunk in memory.
+        const size_t bytes = logPlayer.getStreamedSize();
+        updateBytes(estimatedBytes, bytes);
+        LogExtractor logExtractor(logPlayer);
+        for(const std::string& job : jobs)
+        {
+          const std::string fileName = outputPath + job + "/" + names[i] + ".csv";
+          if(!(job == "images" ? logExtractor.saveImages(outputPath + job + "/" + names[i] + "/", false, false, 1)
+               : job == "inertialSensorData" ? logExtractor.saveInertialSensorData(fileName)
+               : job == "jointAngleData" ? logExtractor.saveJointAngleData(fileName)
+               : logExtractor.writeTimingData(fileName)))
+            success = false;
+        }
+        updateBytes(bytes, 0);
+      }
+    });
+  for(std::thread& thread : threads)
+    thread.join();
+
+  // Merge the results of each job in the order of the logs.
+  for(const std::string& job : jobs)
+  {
+    QFile merged((outputPath + job + ".csv").c_str());
+    if(!merged.open(QIODevice::WriteOnly))
+    {
+      success = false;
+      continue;
+    }
+
+    if(job == "images")
+    {
+      merged.write("log;camera;file\n");
+      for(const std::string& name : names)
+        for(const QString& file : QDir((outputPath + job + "/" + name).c_str()).entryList({"*.png"}, QDir::Files, QDir::Name))
+          merged.write(QByteArray(name.c_str()) + ";" + (file.startsWith("upper") ? "upper" : "lower") + ";" + name.c_str() + "/" + file.toUtf8() + "\n");
+    }
+    else
+    {
+      const char separator = job == "timing" ? ',' : ';';
+      QByteArray header;
+      for(const std::string& name : names)
+      {
+        QFile part((outputPath + job + "/" + name + ".csv").c_str());
+        if(!part.open(QIODevice::ReadOnly))
+          continue;
+
+        // The header is only repeated if it differs from the previous one, e.g. because other stopwatches were logged.
+        const QByteArray partHeader = part.readLine();
+        if(partHeader != header)
+        {
+          merged.write(QByteArray("log") + separator + partHeader);
+          header = partHeader;
+        }
+        const QByteArray prefix = QByteArray(name.c_str()) + separator;
+        while(!part.atEnd())
+          merged.write(prefix + part.readLine());
+        part.remove();
+      }
+      QDir(outputPath.c_str()).rmdir(job.c_str()); // Only succeeds if it only contained the parts
+    }
+  }
+  return success;
+}
+
 std::string LogExtractor::createNewFolder(const std::string& prefix) const
 {
   std::string folderPath = File::isAbsolute(prefix.c_str()) ? prefix : std::string(File::getBHDir()) + "/Config/" + prefix;
@@ -751,7 +913,8 @@ bool LogExtractor::saveCSV(const std::string& fileName, const std::function<void
     return true;
   }
                         );
-  OUTPUT_TEXT("File was created successfully: " << name);
+  if(Global::debugOutExists()) // Not in threads started by batch
+    OUTPUT_TEXT("File was created successfully: " << name);
   return finished;
 }
 
@@ -759,28 +922,24 @@ bool LogExtractor::goThroughLog(const std::map<const MessageID, Streamable*>& re
 {
   std::string frameType;
   bool filled = false;
-  for(int currentMessageNumber = 0; currentMessageNumber < logPlayer.getNumberOfMessages(); currentMessageNumber++)
+  return logPlayer.forAllMessages([&](InMessage& in)
   {
-    logPlayer.queue.setSelectedMessageForReading(currentMessageNumber);
-    MessageID message = logPlayer.queue.getMessageID();
+    MessageID message = in.getMessageID();
     auto repr = representations.find(message);
     // repr == end() if not found
     if(repr != representations.end())
     {
       // Does not convert logs automatically now, can be found in LogDataProvider
-      logPlayer.in.bin >> *(repr->second);
+      in.bin >> *(repr->second);
       filled = true;
     }
     else if(message == idFrameBegin)
     {
-      frameType = logPlayer.in.readThreadIdentifier();
+      frameType = in.readThreadIdentifier();
       filled = false;
     }
     else if(message == idFrameFinished && filled)
-    {
-      if(!executeAction(frameType))
-        return false;
-    }
-  }
-  return true;
+      return executeAction(frameType);
+    return true;
+  });
 }
@@ -13,6 +13,7 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 class LogPlayer;
 class Out;
@@ -103,6 +104,13 @@ public:
    */
   bool writeTimingData(const std::string& fileName);
 
+  /**
+   * Writes the stopwatch events of all threads as a trace in the Chrome Trace Event
+   * format, which can be inspected with chrome://tracing or https://ui.perfetto.dev.
+   * @return true if writing was successful
+   */
+  bool writeTraceData(const std::string& fileName);
+
   /**
    * Analyze if the measured joint angles are jumping, which indicates defect sensors.
    * @return true if analyzing was successful
@@ -118,6 +126,25 @@ public:
    */
   bool saveLabeledBallSpots(const std::string& path);
 
+  /**
+   * Runs extractions on all logs in a directory in parallel. Each thread loads one
+   * log at a time. Threads wait before loading a log if the logs that are already
+   * loaded together with the new one would exceed a memory budget.
+   * The results of the same extraction from all logs are merged.
+   * @param directory The directory that contains the logs.
+   * @param outputDirectory The directory to which the results are written. Image
+   *                        extractions create a directory "images" with a directory
+   *                        per log and the manifest "images.csv". All other extractions
+   *                        create a file (e.g. "timing.csv") with the rows of all logs,
+   *                        each preceded by the name of the log.
+   * @param jobs The extractions, i.e. "images", "inertialSensorData", "jointAngleData",
+   *             or "timing".
+   * @param overwrite Replace the results of previous extractions. Otherwise, nothing is
+   *                  extracted if any of them exist.
+   * @return Whether all logs could be loaded and all extractions were successful.
+   */
+  static bool batch(const std::string& directory, const std::string& outputDirectory, const std::vector<std::string>& jobs, bool overwrite);
+
 private:
   /**
    * The method creates a new folder with logname in the current logfolder, replacing the prefix.
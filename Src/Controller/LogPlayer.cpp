@@ -7,6 +7,7 @@
  */
 
 #include <QImage>
+#include <QFile>
 #include <QFileInfo>
 #include "LogPlayer.h"
 #include "Platform/File.h"
@@ -17,6 +18,9 @@
 #include "Tools/Debugging/DebugImages.h"
 #include "Tools/Logging/LoggingTools.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <snappy-c.h>
 
 LogPlayer::LogPlayer(MessageQueue& targetQueue) :
@@ -25,10 +29,18 @@ LogPlayer::LogPlayer(MessageQueue& targetQueue) :
   init();
 }
 
+LogPlayer::~LogPlayer() = default;
+
 void LogPlayer::init()
 {
   clear();
   stop();
+  chunks.clear();
+  chunkIndex = LoggingTools::ChunkIndex();
+  loadedChunk = -1;
+  chunkedData = nullptr;
+  chunkedFile.reset();
+  messageIDs.clear();
   numberOfFrames = 0;
   numberOfMessagesWithinCompleteFrames = 0;
   replayOffset = 0;
@@ -57,6 +69,7 @@ bool LogPlayer::open(const std::string& fileName)
     if(magicByte == LoggingTools::logFileMessageIDs)
     {
       readMessageIDMapping(stream);
+      writeMessageIDs(messageIDs);
       stream >> magicByte;
     }
 
@@ -92,15 +105,25 @@ bool LogPlayer::open(const std::string& fileName)
           mem >> *this;
         }
         break;
+      case LoggingTools::logFileChunked: //log file consisting of chunks of frames that are decompressed on demand
+        if(!openChunks(stream.getFile()->getFullName(), stream.getFile()->getPosition()))
+        {
+          logfilePath = "";
+          return false;
+        }
+        break;
       default:
         logfilePath = "";
         return false; //unknown magic byte
     }
 
     stop();
-    countFrames();
-    createIndices();
-    upgradeFrames();
+    if(chunks.empty())
+    {
+      countFrames();
+      createIndices();
+      upgradeFrames();
+    }
     logfileMerged = false;
     loadLabels();
     return true;
@@ -145,8 +168,7 @@ void LogPlayer::stepBackward()
       currentFrameNumber = numberOfFrames - 1;
     else
       return;
-    ASSERT(currentFrameNumber < static_cast<int>(frameIndex.size()));
-    currentMessageNumber = frameIndex[currentFrameNumber];
+    currentMessageNumber = messageBeforeFrame(currentFrameNumber) + 1;
 
     queue.setSelectedMessageForReading(currentMessageNumber);
     stepRepeat();
@@ -173,11 +195,12 @@ void LogPlayer::stepForward()
   pause();
   if(state == paused)
   {
-    if(currentFrameNumber >= numberOfFrames - 1 || currentMessageNumber >= numberOfMessagesWithinCompleteFrames - 1)
+    if(currentFrameNumber >= numberOfFrames - 1
+       || (currentMessageNumber >= numberOfMessagesWithinCompleteFrames - 1 && loadedChunk + 1 >= static_cast<int>(chunks.size())))
     {
       if(loop && numberOfFrames > 0)
       {
-        currentMessageNumber = -1;
+        currentMessageNumber = messageBeforeFrame(-1);
         currentFrameNumber = -1;
       }
       else
@@ -185,6 +208,7 @@ void LogPlayer::stepForward()
     }
 
     replayTypeInfo();
+    prepareNextMessage();
 
     do
     {
@@ -221,7 +245,7 @@ void LogPlayer::stepRepeat()
   if(state == paused && currentFrameNumber >= 0)
   {
     --currentFrameNumber;
-    currentMessageNumber = currentFrameNumber >= 0 ? frameIndex[currentFrameNumber] - 1 : -1;
+    currentMessageNumber = messageBeforeFrame(currentFrameNumber);
     stepForward();
   }
 }
@@ -233,7 +257,7 @@ void LogPlayer::gotoFrame(int frame)
   if(state == paused && frame < numberOfFrames)
   {
     currentFrameNumber = frame - 1;
-    currentMessageNumber = currentFrameNumber >= 0 ? frameIndex[currentFrameNumber] - 1 : -1;
+    currentMessageNumber = messageBeforeFrame(currentFrameNumber);
     stepForward();
   }
 }
@@ -245,6 +269,7 @@ int LogPlayer::getFrameForRemainingGCTime(int time)
 
 void LogPlayer::recordStart()
 {
+  loadAllChunks();
   state = recording;
 }
 
@@ -282,6 +307,7 @@ bool LogPlayer::replay()
     if(currentFrameNumber < numberOfFrames - 1)
     {
       replayTypeInfo();
+      prepareNextMessage();
 
       do
       {
@@ -321,6 +347,7 @@ MessageQueue LogPlayer::copyNextFrame()
   MessageQueue copiedFrame;
   if(currentFrameNumber < numberOfFrames - 1)
   {
+    prepareNextMessage();
     int copyMessageNumber = currentMessageNumber;
     do
     {
@@ -338,6 +365,7 @@ MessageQueue LogPlayer::copyNextFrame()
 void LogPlayer::keep(const std::function<bool(InMessage&)>& filter)
 {
   stop();
+  loadAllChunks();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
   moveAllMessages(temp);
@@ -356,6 +384,7 @@ void LogPlayer::keep(const std::function<bool(InMessage&)>& filter)
 void LogPlayer::keepFrames(const std::function<bool(InMessage&)>& filter)
 {
   stop();
+  loadAllChunks();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
   moveAllMessages(temp);
@@ -389,6 +418,7 @@ void LogPlayer::keepFrames(const std::function<bool(InMessage&)>& filter)
 void LogPlayer::keepFramesByThreadIdentifier(const std::function<bool(std::string)>& filter)
 {
   stop();
+  loadAllChunks();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
   moveAllMessages(temp);
@@ -420,6 +450,7 @@ void LogPlayer::keepFramesByThreadIdentifier(const std::function<bool(std::strin
 void LogPlayer::trim(int startFrame, int endFrame)
 {
   stop();
+  loadAllChunks();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
   moveAllMessages(temp);
@@ -438,6 +469,7 @@ void LogPlayer::trim(int startFrame, int endFrame)
 void LogPlayer::keep(const std::vector<int>& messageNumbers)
 {
   stop();
+  loadAllChunks();
   LogPlayer temp(static_cast<MessageQueue&>(*this));
   temp.setSize(queue.getSize());
   moveAllMessages(temp);
@@ -464,25 +496,20 @@ void LogPlayer::statistics(int frequencies[numOfDataMessageIDs], unsigned* sizes
         sizes[id] = 0;
   }
 
-  if(getNumberOfMessages() > 0)
+  std::string currentThread;
+  forAllMessages([&](InMessage& message)
   {
-    int current = queue.getSelectedMessageForReading();
-    std::string currentThread;
-    for(int i = 0; i < getNumberOfMessages(); ++i)
+    ASSERT(message.getMessageID() < numOfDataMessageIDs);
+    if(message.getMessageID() == idFrameBegin)
+      currentThread = message.readThreadIdentifier();
+    if(threadIdentifier.empty() || threadIdentifier == currentThread)
     {
-      queue.setSelectedMessageForReading(i);
-      ASSERT(queue.getMessageID() < numOfDataMessageIDs);
-      if(queue.getMessageID() == idFrameBegin)
-        currentThread = in.readThreadIdentifier();
-      if(threadIdentifier.empty() || threadIdentifier == currentThread)
-      {
-        ++frequencies[queue.getMessageID()];
-        if(sizes)
-          sizes[queue.getMessageID()] += queue.getMessageSize() + 4;
-      }
+      ++frequencies[message.getMessageID()];
+      if(sizes)
+        sizes[message.getMessageID()] += message.getMessageSize() + 4;
     }
-    queue.setSelectedMessageForReading(current);
-  }
+    return true;
+  });
 }
 
 void LogPlayer::createIndices()
@@ -547,6 +574,7 @@ void LogPlayer::merge()
 
   if(logfileMerged || logfilePath.empty())
     return;
+  loadAllChunks();
 
   //parse filename and find the corresponding other log file
   std::string threadName, headName, bodyName, scenario, location, identifier, suffix;
@@ -567,6 +595,7 @@ void LogPlayer::merge()
     OUTPUT_ERROR("Could not open " << logOtherFile);
     return;
   }
+  logOther.loadAllChunks();
 
   //copy the currently loaded log file
   LogPlayer logCopy(static_cast<MessageQueue&>(*this));
@@ -718,6 +747,7 @@ void LogPlayer::loadLabels()
 
     if(imageSet.labelImages.size() > 0)
     {
+      loadAllChunks();
       LogPlayer cognitionLog(static_cast<MessageQueue&>(*this));
       cognitionLog.setSize(queue.getSize());
 
@@ -823,6 +853,8 @@ std::string LogPlayer::getThreadIdentifierOfNextFrame()
     if(queue.getMessageID() == idFrameBegin)
       return in.readThreadIdentifier();
   }
+  else if(loadedChunk + 1 < static_cast<int>(chunks.size())) // The next frame is the first one of the next chunk
+    return chunkIndex.threads[chunkIndex.frames[chunks[loadedChunk + 1].firstFrame].thread];
   if(currentMessageNumber >= 0 && currentMessageNumber < queue.numberOfMessages)
   {
     queue.setSelectedMessageForReading(currentMessageNumber);
@@ -872,3 +904,278 @@ void LogPlayer::upgradeFrames()
     }
   }
 }
+
+bool LogPlayer::forAllMessages(const std::function<bool(InMessage&)>& handler)
+{
+  const int chunk = loadedChunk;
+  const int selected = getNumberOfMessages() ? queue.getSelectedMessageForReading() : -1;
+  bool completed = true;
+  for(int i = chunks.empty() ? -1 : 0; completed && i < static_cast<int>(chunks.size()); ++i)
+  {
+    if(i >= 0)
+      loadChunk(i);
+    for(int j = 0; completed && j < getNumberOfMessages(); ++j)
+    {
+      queue.setSelectedMessageForReading(j);
+      in.text.reset();
+      completed = handler(in);
+    }
+  }
+  if(chunk >= 0)
+    loadChunk(chunk);
+  if(selected >= 0)
+    queue.setSelectedMessageForReading(selected);
+  return completed;
+}
+
+void LogPlayer::handleAllMessages(MessageHandler& handler)
+{
+  forAllMessages([&handler](InMessage& message)
+  {
+    handler.handleMessage(message);
+    return true;
+  });
+}
+
+bool LogPlayer::openChunks(const std::string& fileName, size_t firstChunk)
+{
+  chunkedFile = std::make_unique<QFile>(fileName.c_str());
+  if(!chunkedFile->open(QIODevice::ReadOnly)
+     || !(chunkedData = reinterpret_cast<const char*>(chunkedFile->map(0, chunkedFile->size()))))
+  {
+    OUTPUT_ERROR("LogPlayer: Could not map " << fileName << " into memory.");
+    chunkedFile.reset();
+    return false;
+  }
+
+  const size_t size = static_cast<size_t>(chunkedFile->size());
+  if(LoggingTools::readChunkIndex(chunkedData, size, firstChunk, chunkIndex))
+    for(const LoggingTools::ChunkIndex::Chunk& chunk : chunkIndex.chunks)
+    {
+      chunks.push_back({firstChunk, 0, false});
+      firstChunk += LoggingTools::chunkHeaderSize + chunk.size;
+    }
+  else
+  {
+    OUTPUT_WARNING("LogPlayer: " << fileName << " has no valid index, probably because it was not closed properly. Decompressing it once to rebuild the index.");
+    rebuildIndex(size, firstChunk);
+  }
+
+  numberOfFrames = 0;
+  for(size_t i = 0; i < chunks.size(); ++i)
+  {
+    chunks[i].firstFrame = numberOfFrames;
+    numberOfFrames += chunkIndex.chunks[i].frames;
+  }
+  gcTimeIndex.fill(-1);
+  for(int frame = 0; frame < numberOfFrames; ++frame)
+  {
+    const int time = chunkIndex.frames[frame].gcTime;
+    if(time >= 0 && time < static_cast<int>(gcTimeIndex.size()) && gcTimeIndex[time] == -1)
+      gcTimeIndex[time] = frame;
+  }
+
+  if(chunks.empty())
+  {
+    clear();
+    chunkedData = nullptr;
+    chunkedFile.reset();
+  }
+  else
+  {
+    loadedChunk = -1;
+    loadChunk(0);
+  }
+  return true;
+}
+
+void LogPlayer::rebuildIndex(size_t size, size_t offset)
+{
+  GameInfo gameInfo;
+  OutBinaryMemory gameInfoSize(256);
+  gameInfoSize << gameInfo;
+
+  chunkIndex = LoggingTools::ChunkIndex();
+  for(unsigned chunkNumber = 0; size - offset >= LoggingTools::chunkHeaderSize; ++chunkNumber)
+  {
+    LoggingTools::ChunkIndex::Chunk chunk;
+    std::memcpy(&chunk.size, chunkedData + offset, sizeof(unsigned));
+    std::memcpy(&chunk.uncompressedSize, chunkedData + offset + sizeof(unsigned), sizeof(unsigned));
+    std::memcpy(&chunk.frames, chunkedData + offset + 2 * sizeof(unsigned), sizeof(unsigned));
+    if(!chunk.size) // End marker
+      break;
+    else if(size - offset - LoggingTools::chunkHeaderSize < chunk.size || chunk.size > chunk.uncompressedSize)
+    {
+      OUTPUT_WARNING("LogPlayer: The last chunk of " << logfilePath << " is incomplete and was skipped.");
+      break;
+    }
+    else if(!decompressChunk(offset, chunk))
+      OUTPUT_ERROR("LogPlayer: Chunk " << chunkNumber << " of " << logfilePath << " is corrupt. Its "
+                   << chunk.frames << " frames after frame " << static_cast<unsigned>(chunkIndex.frames.size()) << " were skipped.");
+    else
+    {
+      for(int i = 0; i < getNumberOfMessages(); ++i)
+      {
+        queue.setSelectedMessageForReading(i);
+        const MessageID id = queue.getMessageID();
+        if(id == idFrameBegin)
+        {
+          const std::string thread = in.readThreadIdentifier();
+          const auto t = std::find(chunkIndex.threads.begin(), chunkIndex.threads.end(), thread);
+          chunkIndex.frames.push_back({static_cast<unsigned char>(t - chunkIndex.threads.begin()), -1});
+          if(t == chunkIndex.threads.end())
+            chunkIndex.threads.push_back(thread);
+        }
+        else if(id == idGameInfo && queue.getMessageSize() == static_cast<int>(gameInfoSize.size()))
+        {
+          in.bin >> gameInfo;
+          if(gameInfo.secsRemaining >= 0 && gameInfo.secsRemaining <= std::numeric_limits<short>::max())
+            chunkIndex.frames.back().gcTime = static_cast<short>(gameInfo.secsRemaining);
+        }
+      }
+      chunkIndex.chunks.push_back(chunk);
+      chunks.push_back({offset, 0, false});
+    }
+    offset += LoggingTools::chunkHeaderSize + chunk.size;
+  }
+}
+
+bool LogPlayer::decompressChunk(size_t offset, const LoggingTools::ChunkIndex::Chunk& chunk)
+{
+  clear();
+  if(messageIDs.size())
+  {
+    InBinaryMemory stream(messageIDs.data(), messageIDs.size());
+    readMessageIDMapping(stream);
+  }
+
+  const char* data = chunkedData + offset + LoggingTools::chunkHeaderSize;
+  if(chunk.size != chunk.uncompressedSize)
+  {
+    uncompressedChunk.resize(chunk.uncompressedSize);
+    size_t length = chunk.uncompressedSize;
+    if(snappy_uncompress(data, chunk.size, uncompressedChunk.data(), &length) != SNAPPY_OK || length != chunk.uncompressedSize)
+      return false;
+    data = uncompressedChunk.data();
+  }
+
+  // The chunk starts with an appendable header. The sizes of the messages must add up to the size of the chunk.
+  if(chunk.uncompressedSize < 2 * sizeof(unsigned))
+    return false;
+  const char* const end = data + chunk.uncompressedSize;
+  const char* p = data + 2 * sizeof(unsigned);
+  while(end - p >= 4)
+  {
+    unsigned header;
+    std::memcpy(&header, p, sizeof(header));
+    p += 4 + (header >> 8);
+  }
+  if(p != end)
+    return false;
+
+  InBinaryMemory stream(data, chunk.uncompressedSize);
+  append(stream, chunk.uncompressedSize);
+  queue.createIndex();
+
+  unsigned begins = 0;
+  unsigned ends = 0;
+  for(int i = 0; i < getNumberOfMessages(); ++i)
+  {
+    queue.setSelectedMessageForReading(i);
+    if(queue.getMessageID() == idFrameBegin)
+      ++begins;
+    else if(queue.getMessageID() == idFrameFinished)
+      ++ends;
+  }
+  return begins == chunk.frames && ends == chunk.frames && queue.getMessageID() == idFrameFinished;
+}
+
+void LogPlayer::loadChunk(int chunk)
+{
+  if(chunk == loadedChunk)
+    return;
+
+  Chunk& c = chunks[chunk];
+  const LoggingTools::ChunkIndex::Chunk& header = chunkIndex.chunks[chunk];
+  if(c.corrupt || !decompressChunk(c.offset, header))
+  {
+    if(!c.corrupt)
+    {
+      OUTPUT_ERROR("LogPlayer: Chunk " << chunk << " of " << logfilePath << " is corrupt. Its frames "
+                   << c.firstFrame << " to " << c.firstFrame + header.frames - 1 << " are replayed empty.");
+      c.corrupt = true;
+    }
+
+    // The frames are written with the current message ids, so the mapping is not restored.
+    clear();
+    for(int frame = c.firstFrame; frame < c.firstFrame + static_cast<int>(header.frames); ++frame)
+    {
+      const std::string& thread = chunkIndex.threads[chunkIndex.frames[frame].thread];
+      out.bin << thread;
+      out.finishMessage(idFrameBegin);
+      out.bin << thread;
+      out.finishMessage(idFrameFinished);
+    }
+    queue.createIndex();
+  }
+
+  loadedChunk = chunk;
+  frameIndex.clear();
+  for(int i = 0; i < getNumberOfMessages(); ++i)
+  {
+    queue.setSelectedMessageForReading(i);
+    if(queue.getMessageID() == idFrameBegin)
+      frameIndex.push_back(i);
+  }
+  numberOfMessagesWithinCompleteFrames = getNumberOfMessages();
+  upgradeFrames();
+}
+
+void LogPlayer::loadAllChunks()
+{
+  if(chunks.empty())
+    return;
+
+  // The messages are collected with the current message ids, because the mapping is lost when the queue is cleared.
+  MessageQueue all;
+  all.setSize(queue.getSize());
+  for(int i = 0; i < static_cast<int>(chunks.size()); ++i)
+  {
+    loadChunk(i);
+    copyAllMessages(all);
+  }
+
+  clear();
+  chunks.clear();
+  loadedChunk = -1;
+  chunkedData = nullptr;
+  chunkedFile.reset();
+  all.moveAllMessages(*this);
+  stop();
+  countFrames();
+  createIndices();
+}
+
+void LogPlayer::prepareNextMessage()
+{
+  if(currentMessageNumber >= numberOfMessagesWithinCompleteFrames - 1 && loadedChunk + 1 < static_cast<int>(chunks.size()))
+  {
+    loadChunk(loadedChunk + 1);
+    currentMessageNumber = -1;
+  }
+}
+
+int LogPlayer::messageBeforeFrame(int frame)
+{
+  if(chunks.empty())
+  {
+    ASSERT(frame < static_cast<int>(frameIndex.size()));
+    return frame >= 0 ? frameIndex[frame] - 1 : -1;
+  }
+
+  ASSERT(frame < numberOfFrames);
+  const int chunk = static_cast<int>(std::upper_bound(chunks.begin(), chunks.end(), std::max(frame, 0),
+                                                      [](int frame, const Chunk& chunk) {return frame < chunk.firstFrame;}) - chunks.begin()) - 1;
+  loadChunk(chunk);
+  return frame >= 0 ? frameIndex[frame - chunks[chunk].firstFrame] - 1 : -1;
+}
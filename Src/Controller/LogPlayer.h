@@ -9,7 +9,9 @@
 #pragma once
 
 #include "Tools/Function.h"
+#include "Tools/Logging/LoggingTools.h"
 #include "Tools/MessageQueue/MessageQueue.h"
+#include "Tools/Streams/OutStreams.h"
 #include "Tools/Streams/TypeInfo.h"
 
 #include <array>
@@ -19,11 +21,15 @@
 #include <string>
 #include <vector>
 
+class QFile;
+
 /**
  * @class LogPlayer
  *
  * A message queue that can record and play logfiles.
  * The messages are played in the same time sequence as they were recorded.
+ * Log files that consist of compressed chunks are mapped into memory and only
+ * the chunk that is currently played is decompressed into the queue.
  *
  * @author Martin Lötzsch
  */
@@ -48,7 +54,7 @@ public:
   std::string logfilePath;
 
 private:
-  friend class LogExtractor; /**< The LogExtractor use queue and logfilePath. */
+  friend class LogExtractor; /**< The LogExtractor uses typeInfo and loadAllChunks. */
   MessageQueue& targetQueue; /**< The queue into that messages from played logfiles shall be stored. */
   int currentMessageNumber; /**< The current message number in the message queue. */
   int numberOfMessagesWithinCompleteFrames; /**< The number of messages within complete frames. Messages behind that number will be skipped. */
@@ -58,17 +64,36 @@ private:
   std::array<int, 601> gcTimeIndex; /**< The frames correspending to Game Controller times. */
   std::unique_ptr<TypeInfo> typeInfo; /**< The type information of the log file entries. */
 
+  /** The position of a chunk in a log file in the format logFileChunked. */
+  struct Chunk
+  {
+    size_t offset; /**< The offset of the header of the chunk in the log file. */
+    int firstFrame; /**< The number of the first frame in the chunk. */
+    bool corrupt; /**< Could the chunk not be decompressed? */
+  };
+
+  std::unique_ptr<QFile> chunkedFile; /**< The log file if its chunks are decompressed on demand. */
+  const char* chunkedData = nullptr; /**< The contents of chunkedFile mapped into memory. */
+  LoggingTools::ChunkIndex chunkIndex; /**< The sizes of the chunks as well as the threads and GameController times of all frames. */
+  std::vector<Chunk> chunks; /**< The chunks of the log file. Empty if the whole log is in the queue. */
+  int loadedChunk = -1; /**< The chunk that is currently in the queue or -1 if the whole log is in the queue. */
+  OutBinaryMemory messageIDs; /**< The message id mapping of the log file, which has to be restored whenever the queue is cleared. */
+  std::vector<char> uncompressedChunk; /**< The buffer chunks are decompressed into. */
+
 public:
   /**
    * @param targetQueue The queue into that messages from played logfiles shall be stored.
    */
   LogPlayer(MessageQueue& targetQueue);
 
+  ~LogPlayer();
+
   /** Deletes all messages from the queue */
   void init();
 
   /**
-   * Opens a log file and reads all messages into the queue.
+   * Opens a log file and reads all messages into the queue. Log files that
+   * consist of chunks are only indexed and the first chunk is decompressed.
    * @param fileName the name of the file to open
    * @return if the reading was successful
    */
@@ -142,6 +167,22 @@ public:
    */
   MessageQueue copyNextFrame();
 
+  /**
+   * Calls a function for all messages of the log. The chunks of a chunked log
+   * file are decompressed one after another, i.e. it is never completely in memory.
+   * @param handler The function that is called for each message. It returns
+   *                whether the remaining messages should also be handled.
+   * @return Were all messages handled?
+   */
+  bool forAllMessages(const std::function<bool(InMessage&)>& handler);
+
+  /**
+   * Calls a message handler for all messages of the log, also for those in
+   * chunks that are currently not decompressed.
+   * @param handler A reference to a message handler.
+   */
+  void handleAllMessages(MessageHandler& handler);
+
   /**
    * The function filters the message queue.
    * @param filter Returns whether a message should be kept.
@@ -217,4 +258,58 @@ private:
 
   /** Renames all frames called "Upper" that contain lower camera data to "Lower". */
   void upgradeFrames();
+
+  /**
+   * Maps a log file in the format logFileChunked into memory, reads its index, and
+   * decompresses the first chunk. If the index is missing, it is rebuilt.
+   * @param fileName The full path of the log file.
+   * @param firstChunk The offset of the header of the first chunk in the log file.
+   * @return Could the log file be mapped into memory?
+   */
+  bool openChunks(const std::string& fileName, size_t firstChunk);
+
+  /**
+   * Rebuilds the index of a log file in the format logFileChunked that was not closed
+   * properly by decompressing all chunks once. Corrupt chunks are skipped.
+   * @param size The size of the log file.
+   * @param offset The offset of the header of the first chunk in the log file.
+   */
+  void rebuildIndex(size_t size, size_t offset);
+
+  /**
+   * Replaces the messages in the queue by the ones of a chunk.
+   * @param offset The offset of the header of the chunk in the log file.
+   * @param chunk The header of the chunk.
+   * @return Was the chunk valid, i.e. could it be decompressed and did it
+   *         contain the number of complete frames stated in its header?
+   */
+  bool decompressChunk(size_t offset, const LoggingTools::ChunkIndex::Chunk& chunk);
+
+  /**
+   * Replaces the messages in the queue by the ones of a chunk if it is not loaded
+   * yet. The frames of a corrupt chunk are replaced by empty ones.
+   * @param chunk The index of the chunk.
+   */
+  void loadChunk(int chunk);
+
+  /**
+   * Decompresses all chunks of a chunked log file into the queue, because the
+   * queue is modified or accessed by message numbers. The player is stopped.
+   */
+  void loadAllChunks();
+
+  /**
+   * If the current message is the last one of the chunk loaded, the next
+   * chunk is loaded and the current message is set before its first one.
+   */
+  void prepareNextMessage();
+
+  /**
+   * Returns the message number before a frame starts. In chunked log files,
+   * the chunk containing the frame is loaded.
+   * @param frame The number of the frame. If it is negative, the first chunk
+   *              is loaded and -1 is returned.
+   * @return The number of the message before the frame.
+   */
+  int messageBeforeFrame(int frame);
 };
@@ -0,0 +1,38 @@
+/**
+ * @file Controller/MatchStatistics.h
+ *
+ * This file declares the statistics of a simulated match. They are collected
+ * by the console command "ms" and written to a file when the match is over,
+ * which allows comparing many matches simulated without a GUI.
+ */
+
+#pragma once
+
+#include "Tools/Streams/AutoStreamable.h"
+
+STREAMABLE(MatchStatistics,
+{
+  STREAMABLE(Team,
+  {,
+    (int)(0) score, /**< The number of goals scored. */
+    (float)(0.f) ballPossession, /**< The playing time during which a robot of this team touched the ball last [s]. */
+    (int)(0) falls, /**< How often robots of this team fell while not being penalized. */
+  });
+
+  STREAMABLE(Timing,
+  {,
+    (unsigned)(0) steps, /**< The number of simulation steps. */
+    (float)(0.f) simulatedTime, /**< The simulated duration of the match [s]. */
+    (float)(0.f) realTime, /**< The real duration of the match [s]. */
+    (float)(0.f) realTimeFactor, /**< How many times faster than real time was the match simulated? */
+    (float)(0.f) meanStepTime, /**< The mean real duration of a simulation step [ms]. */
+    (float)(0.f) maxStepTime, /**< The longest real duration of a simulation step [ms]. */
+  });
+  ,
+
+  (bool)(false) finished, /**< Was the half played to its end? Otherwise, the match was aborted at the time limit. */
+  (float)(0.f) playingTime, /**< The simulated time spent in the state playing [s]. */
+  (Team) firstTeam,
+  (Team) secondTeam,
+  (Timing) timing,
+});
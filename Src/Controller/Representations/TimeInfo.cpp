@@ -15,6 +15,7 @@
 void TimeInfo::reset()
 {
   infos.clear();
+  statistics = ExecutionStatistics();
   lastFrameNo = 0;
   lastStartTime = 0;
 }
@@ -78,6 +79,12 @@ bool TimeInfo::handleMessage(InMessage& message, bool justReadNames)
     lastStartTime = threadStartTime;
     return true;
   }
+  else if(message.getMessageID() == idExecutionStatistics)
+  {
+    if(!justReadNames)
+      message.bin >> statistics;
+    return true;
+  }
   else
     return false;
 }
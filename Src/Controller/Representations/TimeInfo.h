@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "Representations/Infrastructure/ExecutionStatistics.h"
 #include "Tools/RingBufferWithSum.h"
 
 #include <string>
@@ -40,6 +41,7 @@ public:
   std::string threadName;
   Infos infos;
   unsigned int timestamp; /**< The timestamp of the last change. */
+  ExecutionStatistics statistics; /**< The duration percentiles of the providers reported by the thread. */
 
 private:
   std::unordered_map<unsigned short, std::string> names;
@@ -51,10 +53,10 @@ public:
   TimeInfo() {reset();}
 
   /**
-   * The function handles a stop watch message.
+   * The function handles a stop watch or execution statistics message.
    * @param message The message.
    * @param justReadNames Only read stopwatch names. Do not update statistics.
-   * @return Was it a stop watch message?
+   * @return Was it a stop watch or execution statistics message?
    */
   bool handleMessage(InMessage& message, bool justReadNames = false);
 
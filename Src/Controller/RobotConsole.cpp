@@ -466,6 +466,7 @@ bool RobotConsole::handleMessage(InMessage& message)
       threadData[threadIdentifier].annotationInfo.addMessage(message, currentFrame);
       return true;
     case idStopwatch:
+    case idExecutionStatistics:
       threadData[threadIdentifier].timeInfo.handleMessage(message);
       return true;
     case idDebugResponse:
@@ -1239,6 +1240,28 @@ bool RobotConsole::log(In& stream)
   }
   else if(command == "analyzeRobotStatus")
     return logExtractor.analyzeRobotStatus();
+  else if(command == "batch")
+  {
+    std::string directory;
+    std::string outputDirectory;
+    std::vector<std::string> jobs;
+    stream >> directory >> outputDirectory >> command;
+    const bool overwrite = command == "overwrite";
+    if(overwrite)
+    {
+      command.clear();
+      stream >> command;
+    }
+    while(!command.empty())
+    {
+      jobs.push_back(command);
+      command.clear();
+      stream >> command;
+    }
+    if(directory.empty() || outputDirectory.empty() || jobs.empty())
+      return false;
+    return LogExtractor::batch(directory, outputDirectory, jobs, overwrite);
+  }
   else if(command == "saveImages")
   {
     SYNC;
@@ -1282,7 +1305,8 @@ bool RobotConsole::log(In& stream)
   else if(command == "saveInertialSensorData"
           || command == "saveJointAngleData"
           || command == "saveLabeledBallSpots"
-          || command == "saveTiming")
+          || command == "saveTiming"
+          || command == "saveTrace")
   {
     SYNC;
     std::string name;
@@ -1297,7 +1321,7 @@ bool RobotConsole::log(In& stream)
     }
 
     if(static_cast<int>(name.rfind('.')) <= static_cast<int>(name.find_last_of("\\/")))
-      name = name + ".csv";
+      name = name + (command == "saveTrace" ? ".json" : ".csv");
     if(command == "saveInertialSensorData")
       return logExtractor.saveInertialSensorData(name);
     else if(command == "saveJointAngleData")
@@ -1305,7 +1329,9 @@ bool RobotConsole::log(In& stream)
     else if(command == "saveLabeledBallSpots")
       return logExtractor.saveLabeledBallSpots(name);
     else if(command == "saveTiming")
-      return logExtractor.writeTimingData(name);;
+      return logExtractor.writeTimingData(name);
+    else if(command == "saveTrace")
+      return logExtractor.writeTraceData(name);
   }
   else if(command == "saveChoregrapheTimeline")
   {
@@ -1500,8 +1526,12 @@ bool RobotConsole::log(In& stream)
     logPlayer.statistics(frequencies, sizes);
 
     float size = 0;
+    unsigned total = 0;
     FOREACH_ENUM(MessageID, id, numOfDataMessageIDs)
+    {
       size += static_cast<float>(sizes[id]);
+      total += frequencies[id];
+    }
 
     char buf[100];
     FOREACH_ENUM(MessageID, id, numOfDataMessageIDs)
@@ -1510,7 +1540,7 @@ bool RobotConsole::log(In& stream)
         sprintf(buf, "%u\t%.2f%%", frequencies[id], static_cast<float>(sizes[id]) * 100.f / size);
         ctrl->list(std::string(buf) + "\t" + TypeRegistry::getEnumName(id), option, true);
       }
-    sprintf(buf, "%u", logPlayer.getNumberOfMessages());
+    sprintf(buf, "%u", total); // The queue only contains the current chunk of chunked log files
     ctrl->printLn(std::string(buf) + "\ttotal");
     return true;
   }
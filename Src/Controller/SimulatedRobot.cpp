@@ -68,6 +68,12 @@ void SimulatedRobot::setBall(SimRobot::Object* ball)
   SimulatedRobot::ball = ball;
 }
 
+bool SimulatedRobot::isUpright() const
+{
+  Pose2f pose;
+  return getPose2f(robot, pose);
+}
+
 void SimulatedRobot::getWorldState(GroundTruthWorldState& worldState) const
 {
   // Initialize world state
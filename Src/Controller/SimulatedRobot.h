@@ -63,6 +63,12 @@ public:
    */
   virtual void getRobotPose(Pose2f& robotPose) const = 0;
 
+  /**
+   * Determines whether the simulated robot is upright.
+   * @return Is the robot upright? Robots in the 2D simulation always are.
+   */
+  bool isUpright() const;
+
   /**
    * Determines all robot states as well as the ball state.
    * @param worldState The determined world state.
@@ -38,19 +38,21 @@ struct Row
   NumberTableWidgetItem* min;
   NumberTableWidgetItem* max;
   NumberTableWidgetItem* avg;
+  NumberTableWidgetItem* p95;
+  NumberTableWidgetItem* p99;
 };
 
 TimeWidget::TimeWidget(TimeView& timeView) : timeView(timeView)
 {
   table = new QTableWidget();
-  table->setColumnCount(4);
+  table->setColumnCount(6);
   QStringList headerNames;
-  headerNames << "Stopwatch" << "Min" << "Max" << "Avg";
+  headerNames << "Stopwatch" << "Min" << "Max" << "Avg" << "P95" << "P99";
   table->setHorizontalHeaderLabels(headerNames);
   table->verticalHeader()->setVisible(false);
   table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
   table->verticalHeader()->setDefaultSectionSize(15);
-  table->horizontalHeader()->setSectionResizeMode(3, QHeaderView::Stretch);
+  table->horizontalHeader()->setSectionResizeMode(5, QHeaderView::Stretch);
   table->setEditTriggers(QAbstractItemView::NoEditTriggers);
   table->setAlternatingRowColors(true);
   table->setSortingEnabled(true);
@@ -124,9 +126,12 @@ void TimeWidget::update()
     float minDuration = -1.f;
     float maxDuration = -1.f;
     timeView.info.getThreadStatistics(avgFrequency, minDuration, maxDuration);
+    const ExecutionStatistics& statistics = timeView.info.statistics;
     frequency->setText(" Freq: " + QString::number(avgFrequency, 'f', 1)
                        + ", Min: " + QString::number(minDuration, 'f', 1) +
-                       "ms, Max: " + QString::number(maxDuration, 'f', 1) + "ms");
+                       "ms, Max: " + QString::number(maxDuration, 'f', 1) + "ms" +
+                       (statistics.budget > 0.f ? ", Overruns: " + QString::number(statistics.overruns) + "/" + QString::number(statistics.frames) +
+                        " > " + QString::number(statistics.budget, 'f', 1) + "ms" : QString()));
 
     table->setUpdatesEnabled(false);
     table->setSortingEnabled(false);//disable sorting while updating to avoid race conditions
@@ -146,6 +151,8 @@ void TimeWidget::update()
         currentRow->avg = new NumberTableWidgetItem();
         currentRow->max = new NumberTableWidgetItem();
         currentRow->min = new NumberTableWidgetItem();
+        currentRow->p95 = new NumberTableWidgetItem();
+        currentRow->p99 = new NumberTableWidgetItem();
         currentRow->name = new QTableWidgetItem();
         const int rowCount = table->rowCount();
         table->setRowCount(rowCount + 1);
@@ -153,6 +160,8 @@ void TimeWidget::update()
         table->setItem(rowCount, 1, currentRow->min);
         table->setItem(rowCount, 2, currentRow->max);
         table->setItem(rowCount, 3, currentRow->avg);
+        table->setItem(rowCount, 4, currentRow->p95);
+        table->setItem(rowCount, 5, currentRow->p99);
         items[infoPair.first] = currentRow;
       }
       float minTime = -1, maxTime = -1, avgTime = -1;
@@ -163,6 +172,10 @@ void TimeWidget::update()
       currentRow->avg->setText(QString::number(avgTime));
       currentRow->min->setText(QString::number(minTime));
       currentRow->max->setText(QString::number(maxTime));
+      // Percentiles are only collected for providers, whose stopwatches are named after their representations.
+      const ExecutionStatistics::Durations* durations = statistics.find(name);
+      currentRow->p95->setText(durations ? QString::number(durations->p95) : QString());
+      currentRow->p99->setText(durations ? QString::number(durations->p99) : QString());
       currentRow->name->setText(QString(name.c_str())); //refresh name every time to eliminate unknown
     }
   }
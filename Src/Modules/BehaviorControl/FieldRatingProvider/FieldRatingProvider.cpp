@@ -50,6 +50,48 @@ void FieldRatingProvider::updateParameters()
   ballRTV = ballRating / ballRange;
   bestBallPositionRange = Rangef(bestDistanceForBall - bestDistanceWidth, bestDistanceForBall + bestDistanceWidth);
   lowPassFilterFactor = lowPassFilterFactorPerSecond * Constants::motionCycleTime;
+  fieldGrid = BilinearGrid();
+}
+
+void FieldRatingProvider::updateGrids()
+{
+  const Vector2f min(theFieldDimensions.xPosOwnFieldBorder, theFieldDimensions.yPosRightFieldBorder);
+  const Vector2f max(theFieldDimensions.xPosOpponentFieldBorder, theFieldDimensions.yPosLeftFieldBorder);
+  const auto sample = [this](PotentialValue (FieldRatingProvider::*potential)(float, float, bool))
+  {
+    return [this, potential](const Vector2f& point, float& value, Vector2f& direction)
+    {
+      const PotentialValue pv = (this->*potential)(point.x(), point.y(), true);
+      value = pv.value;
+      direction = pv.direction;
+    };
+  };
+
+  if(!fieldGrid.isValid())
+  {
+    fieldGrid.init(min, max, staticGridCellSize);
+    fieldGrid.fill(sample(&FieldRatingProvider::getFieldOnlyPotential));
+  }
+  // With the default field and cell size, each of these grids has 53 x 38 nodes, i.e. the
+  // potentials are evaluated about 4000 times per frame.
+  obstacleGrid.init(min, max, dynamicGridCellSize);
+  obstacleGrid.fill(sample(&FieldRatingProvider::getObstaclePotential));
+  teammatesGrid.init(min, max, dynamicGridCellSize);
+  teammatesGrid.fill(sample(&FieldRatingProvider::getTeammatesPotential));
+}
+
+PotentialValue FieldRatingProvider::getGridPotential(const BilinearGrid& grid, PotentialValue (FieldRatingProvider::*potential)(float, float, bool),
+                                                     const float x, const float y, const bool calculateFieldDirection)
+{
+  const Vector2f point(x, y);
+  if(!grid.isInside(point))
+    return (this->*potential)(x, y, calculateFieldDirection);
+  PotentialValue pv;
+  if(calculateFieldDirection)
+    pv.value = grid.value(point, pv.direction);
+  else
+    pv.value = grid.value(point);
+  return pv;
 }
 
 void FieldRatingProvider::update(FieldRating& fieldRating)
@@ -58,23 +100,49 @@ void FieldRatingProvider::update(FieldRating& fieldRating)
   // with the hack the smalles dribble angle (when no obstacles are near), going outwards to the field sides, is about 20_deg (previous about 40_deg?)
   robotRotation = robotRotation.normalize(1.f - lowPassFilterFactor) + Vector2f::polar(lowPassFilterFactor, theRobotPose.rotation);
 
-  fieldRating.potentialFieldOnly = [this](const float x, const float y, const bool calculateFieldDirection)
+  // Either interpolate the potentials in grids or compute them (once per position).
+  FunctionImpl::Function<PotentialValue(float, float, bool)> obstaclePotential;
+  FunctionImpl::Function<PotentialValue(float, float, bool)> teammatesPotential;
+  if(useGrid)
   {
-    PotentialValue pv;
-    pv += getFieldBorderPotential(x, y, calculateFieldDirection);
-    pv += getGoalPotential(x, y, calculateFieldDirection);
-    pv += getGoalAnglePotential(x, y, calculateFieldDirection);
-    return pv;
-  };
+    updateGrids();
+    fieldRating.potentialFieldOnly = [this](const float x, const float y, const bool calculateFieldDirection)
+    {
+      return getGridPotential(fieldGrid, &FieldRatingProvider::getFieldOnlyPotential, x, y, calculateFieldDirection);
+    };
+    obstaclePotential = [this](const float x, const float y, const bool calculateFieldDirection)
+    {
+      return getGridPotential(obstacleGrid, &FieldRatingProvider::getObstaclePotential, x, y, calculateFieldDirection);
+    };
+    teammatesPotential = [this](const float x, const float y, const bool calculateFieldDirection)
+    {
+      return getGridPotential(teammatesGrid, &FieldRatingProvider::getTeammatesPotential, x, y, calculateFieldDirection);
+    };
+  }
+  else
+  {
+    fieldRating.potentialFieldOnly = memoizedPotentialFieldOnly.bind(theFrameInfo.time, [this](const float x, const float y, const bool calculateFieldDirection)
+    {
+      return getFieldOnlyPotential(x, y, calculateFieldDirection);
+    });
+    obstaclePotential = memoizedObstaclePotential.bind(theFrameInfo.time, [this](const float x, const float y, const bool calculateFieldDirection)
+    {
+      return getObstaclePotential(x, y, calculateFieldDirection);
+    });
+    teammatesPotential = memoizedTeammatesPotential.bind(theFrameInfo.time, [this](const float x, const float y, const bool calculateFieldDirection)
+    {
+      return getTeammatesPotential(x, y, calculateFieldDirection);
+    });
+  }
 
-  fieldRating.getObstaclePotential = [this](PotentialValue& pv, const float x, const float y, const bool calculateFieldDirection)
+  fieldRating.getObstaclePotential = [obstaclePotential](PotentialValue& pv, const float x, const float y, const bool calculateFieldDirection)
   {
-    pv += getObstaclePotential(x, y, calculateFieldDirection);
+    pv += obstaclePotential(x, y, calculateFieldDirection);
   };
 
-  fieldRating.potentialOverall = [this](PotentialValue& pv, const float x, const float y, bool& teammateArea, const bool calculateFieldDirection)
+  fieldRating.potentialOverall = [teammatesPotential](PotentialValue& pv, const float x, const float y, bool& teammateArea, const bool calculateFieldDirection)
   {
-    PotentialValue teammatePV = getTeammatesPotential(x, y, calculateFieldDirection);
+    PotentialValue teammatePV = teammatesPotential(x, y, calculateFieldDirection);
     teammateArea = teammatePV.value < 0.f;
     pv += teammatePV;
   };
@@ -116,6 +184,8 @@ void FieldRatingProvider::update(FieldRating& fieldRating)
     draw();
   DEBUG_RESPONSE("module:FieldRatingProvider:updateParameters")
     updateParameters();
+  DEBUG_RESPONSE("module:FieldRatingProvider:memoization")
+    MemoizedFunctionBase::printStatistics("FieldRating", {&memoizedPotentialFieldOnly, &memoizedObstaclePotential, &memoizedTeammatesPotential});
 }
 
 float FieldRatingProvider::functionLinear(const float distance, const float radius, const float radiusTimesValue)
@@ -219,6 +289,15 @@ void FieldRatingProvider::draw()
   }
 }
 
+PotentialValue FieldRatingProvider::getFieldOnlyPotential(const float x, const float y, const bool calculateFieldDirection)
+{
+  PotentialValue pv;
+  pv += getFieldBorderPotential(x, y, calculateFieldDirection);
+  pv += getGoalPotential(x, y, calculateFieldDirection);
+  pv += getGoalAnglePotential(x, y, calculateFieldDirection);
+  return pv;
+}
+
 PotentialValue FieldRatingProvider::getFieldBorderPotential(const float x, const float y, const bool calculateFieldDirection)
 {
   PotentialValue pv;
@@ -17,6 +17,8 @@
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Modeling/BallModel.h"
 #include "Representations/BehaviorControl/FieldBall.h"
+#include "Tools/Math/BilinearGrid.h"
+#include "Tools/MemoizedFunction.h"
 #include "Tools/Module/Module.h"
 #include <vector>
 
@@ -77,6 +79,11 @@ MODULE(FieldRatingProvider,
     (float)(500.f) ballRange,
     (float)(0.5f) ballRating,
 
+    // grids
+    (bool)(false) useGrid, // answer potentialFieldOnly, getObstaclePotential, and potentialOverall by interpolating in precomputed grids
+    (float)(50.f) staticGridCellSize, // distance between the grid nodes for field border, goal, and goal angle (computed once)
+    (float)(200.f) dynamicGridCellSize, // distance between the grid nodes for obstacles and teammates (computed every frame)
+
     // drawing
     (float) drawMinX,
     (float) drawMaxX,
@@ -132,6 +139,16 @@ private:
 
   Vector2f robotRotation;
 
+  // The potentials are only computed once per frame and position.
+  MemoizedFunction<PotentialValue(float, float, bool)> memoizedPotentialFieldOnly{"potentialFieldOnly", 64};
+  MemoizedFunction<PotentialValue(float, float, bool)> memoizedObstaclePotential{"getObstaclePotential", 64};
+  MemoizedFunction<PotentialValue(float, float, bool)> memoizedTeammatesPotential{"getTeammatesPotential", 64};
+
+  // The potentials sampled if useGrid is set.
+  BilinearGrid fieldGrid; /**< Field border, goal, and goal angle. */
+  BilinearGrid obstacleGrid; /**< The obstacles. */
+  BilinearGrid teammatesGrid; /**< The teammates. */
+
   Vector2f rightInnerGoalPost;
   Vector2f leftInnerGoalPost;
 
@@ -149,6 +166,19 @@ private:
 
   void updateParameters();
 
+  /** Samples the potentials in the grids. The static ones are only computed if they are not valid. */
+  void updateGrids();
+
+  /**
+   * Interpolates a potential in a grid. Outside of the grid, it is computed directly.
+   * @param grid The grid that samples the potential.
+   * @param potential The method that computes the potential.
+   */
+  PotentialValue getGridPotential(const BilinearGrid& grid, PotentialValue (FieldRatingProvider::*potential)(float, float, bool),
+                                  const float x, const float y, const bool calculateFieldDirection);
+
+  PotentialValue getFieldOnlyPotential(const float x, const float y, const bool calculateFieldDirection);
+
   PotentialValue getFieldBorderPotential(const float x, const float y, const bool calculateFieldDirection);
 
   PotentialValue getObstaclePotential(const float x, const float y, const bool calculateFieldDirection);
@@ -15,9 +15,17 @@ void LibPassProvider::update(LibPass& libPass)
 {
   DECLARE_DEBUG_DRAWING3D("module:LibPassProvider:passageModelBased", "field");
 
+  updatePassingLanes();
+
   libPass.findPassingLine = [this](Vector2f target, std::vector<Vector2f> mates) -> Vector2f {
     return findPassingLine(target, mates);
   };
+  libPass.isPassingLineFree = [this](const Vector2f& target) -> bool {
+    return passingLanes.isFree(target);
+  };
+  libPass.getFreePassingLanes = [this]() -> std::vector<PassingLanes::Lane> {
+    return passingLanes.getLanes();
+  };
   libPass.poseToPass = [this, &libPass]() -> Pose2f {
     return poseToPass(libPass);
   };
@@ -27,42 +35,31 @@ void LibPassProvider::update(LibPass& libPass)
   libPass.getInversePassUtility = [this](Vector2f position) -> float {
     return getInversePassUtility(position);
   };
-  libPass.getBestPassage = [this]() -> std::tuple<Vector2f, float> {
+  libPass.getBestPassage = memoizedGetBestPassage.bind(theFrameInfo.time, [this]() -> std::tuple<Vector2f, float> {
     return getBestPassage();
-  };
-  libPass.getBestPassageSpecial = [this]() -> std::tuple<Vector2f, float> {
+  });
+  libPass.getBestPassageSpecial = memoizedGetBestPassageSpecial.bind(theFrameInfo.time, [this]() -> std::tuple<Vector2f, float> {
     return getBestPassageSpecial();
-  };
+  });
+
+  DEBUG_RESPONSE("module:LibPassProvider:memoization")
+    MemoizedFunctionBase::printStatistics("LibPass", {&memoizedGetBestPassage, &memoizedGetBestPassageSpecial});
 
   // isTargetToPass provided by calls to poseToPass
 }
 
 
-bool LibPassProvider::findPassingLineAux(std::vector<Obstacle> opponents, Vector2f& target, const Vector2f& translation) {
-  if(opponents.empty()) {
-    target = translation;
-    return true;
-  }
-
-  // compare against translation
-  Eigen::ParametrizedLine<float,2> line = Eigen::ParametrizedLine<float,2>::Through(theRobotPose.translation, translation);
-
-  // in case of failure
-  std::vector<Obstacle> originalVector = opponents;
-
-  for(auto it=opponents.begin(); it!=opponents.end(); ++it) {
-    if(line.distance(it->center) > 400.f) {
-      // call this with reduced obstacles
-      opponents.erase(it);
-      if(findPassingLineAux(opponents, target, translation)) {
-        target = translation;
-        return true;
-      }
+void LibPassProvider::updatePassingLanes() {
+  passingLanes.begin(theRobotPose.translation, passingLaneClearance);
+  for(const auto& obs : theTeamPlayersModel.obstacles) {
+    // use those ahead, and if theRobot is beyond the opponent penalty mark also those from 2000f to theRobot position
+    if(obs.type == Obstacle::opponent &&
+       PassingLanes::isConsidered(theRobotPose.translation, obs.center, theFieldDimensions.xPosOpponentPenaltyMark, 2000.f)) {
+      passingLanes.addOpponent(obs.center);
     }
-    opponents = originalVector;
   }
-  return false;
-};
+  passingLanes.finish();
+}
 
 Vector2f LibPassProvider::findPassingLine(Vector2f target, std::vector<Vector2f> mates) {
   bool found = false;
@@ -75,25 +72,7 @@ Vector2f LibPassProvider::findPassingLine(Vector2f target, std::vector<Vector2f>
   float nobacknormalization = 1;
   bool isThrowingOnTheBack = false;
 
-  // only use opponents ahead
-  // or if behind the opponent penalty mark also use those behind
-  std::vector<Obstacle> opponents;
-  for(const auto& obs : theTeamPlayersModel.obstacles) {
-    if(obs.type == Obstacle::opponent) {
-      // if theRobot is inside penalty area then push robots from 2000f to theRobot position
-      // else push those ahead only
-      if(theRobotPose.translation.x() > theFieldDimensions.xPosOpponentPenaltyMark &&
-        obs.center.x() < theRobotPose.translation.x() &&
-        obs.center.x() > 2000.f) {
-        opponents.push_back(obs);
-      } else if(obs.center.x() > theRobotPose.translation.x() &&
-        obs.center.x() < target.x()) {
-        opponents.push_back(obs);
-      }
-    }
-  }
-
-  // now cycle over the merged obstacles
+  // widen the search until a free line is found (opponents were collected in updatePassingLanes)
   while(!found &&
         leftTarget.y() < theFieldDimensions.yPosLeftSideline &&
         rightTarget.y() > theFieldDimensions.yPosRightSideline) {
@@ -120,16 +99,13 @@ Vector2f LibPassProvider::findPassingLine(Vector2f target, std::vector<Vector2f>
       isThrowingOnTheBack = false;
     } else {
       // compute the actual passage
-      if(target.y() > theRobotPose.translation.y()) {
-        if(findPassingLineAux(opponents, target, rightTarget) ||
-          findPassingLineAux(opponents, target, leftTarget)) {
-          return target;
-        }
-      } else {
-        if(findPassingLineAux(opponents, target, leftTarget) ||
-          findPassingLineAux(opponents, target, rightTarget)) {
-          return target;
-        }
+      const Vector2f& first = target.y() > theRobotPose.translation.y() ? rightTarget : leftTarget;
+      const Vector2f& second = target.y() > theRobotPose.translation.y() ? leftTarget : rightTarget;
+      if(passingLanes.isFree(first)) {
+        return first;
+      }
+      if(passingLanes.isFree(second)) {
+        return second;
       }
     }
 
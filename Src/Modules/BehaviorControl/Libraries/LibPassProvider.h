@@ -19,7 +19,9 @@
 #include "Representations/BehaviorControl/Libraries/LibMisc.h"
 #include "Representations/BehaviorControl/PlayerRole.h"
 #include "Representations/BehaviorControl/Libraries/LibPass.h"
+#include "Tools/BehaviorControl/PassingLanes.h"
 #include "Tools/Math/Probabilistics.h"
+#include "Tools/MemoizedFunction.h"
 #include "Tools/Module/Module.h"
 #include "Tools/Debugging/DebugDrawings3D.h"
 #include "Tools/Math/BHMath.h"
@@ -44,13 +46,19 @@ MODULE(LibPassProvider,
     (float) passageVariance, // the variance of distance to do a passage
     (float) closestInterceptorThreshold, // the maximum distance of the closest opponent interceptor after which the passage line is considered completely free. 
     (float) minDistanceGain, // minimum euclidean distance difference between the sender and the receiver of the ball to consider a passage
+    (float) passingLaneClearance, // the minimum distance of opponents from a free passing line
   }),
 });
 
 class LibPassProvider : public LibPassProviderBase
 {
 private:
-  
+  PassingLanes passingLanes; /**< The directions in which the robot can pass without getting close to an opponent. */
+
+  // The expensive queries are only computed once per frame.
+  MemoizedFunction<std::tuple<Vector2f, float>()> memoizedGetBestPassage{"getBestPassage"};
+  MemoizedFunction<std::tuple<Vector2f, float>()> memoizedGetBestPassageSpecial{"getBestPassageSpecial"};
+
   /**
    * Updates LibPass
    * @param libPass The representation provided
@@ -96,11 +104,10 @@ private:
 
   // ===== FOR INTERNAL USE =====
 
-  /** 
-   * An auxiliary for findPassingLine.
-   * No other doc was available at the time of this port (2022->2023).
+  /**
+   * Determines the free passing lanes from the position of the robot.
+   * Opponents ahead are considered. If the robot is beyond the opponent
+   * penalty mark, those between x = 2000 and the robot are considered as well.
    */
-  bool findPassingLineAux(std::vector<Obstacle> opponents, Vector2f& target, const Vector2f& translation);
-
-
+  void updatePassingLanes();
 };
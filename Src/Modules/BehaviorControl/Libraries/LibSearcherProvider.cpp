@@ -25,10 +25,10 @@ Vector2f LibSearcherProvider::getActiveSearcherPosition() const{
   
   float max = 0;
   Vector2f maxPositionTmp;
-  for(SearcherModel::Cell c : theSearcherModel.grid){
-      if(c.searchWeight > max){
-          max = c.searchWeight;
-          maxPositionTmp = c.positionOnField;
+  for(int i = 0; i < static_cast<int>(theSearcherModel.searchWeights.size()); ++i){
+      if(theSearcherModel.searchWeights[i] > max){
+          max = theSearcherModel.searchWeights[i];
+          maxPositionTmp = theSearcherModel.getCellPosition(i);
       }
   }
   return maxPositionTmp;
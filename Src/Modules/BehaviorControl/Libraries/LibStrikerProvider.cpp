@@ -20,15 +20,15 @@ void LibStrikerProvider::update(LibStriker& libStriker)
   libStriker.projectGazeOntoOpponentGroundline = [this]() -> float {
     return projectGazeOntoOpponentGroundline();
   };
-  libStriker.computeFreeAreas = [this](float minimumDiscretizedAreaSize) -> std::vector<FreeGoalTargetableArea> {
+  libStriker.computeFreeAreas = memoizedComputeFreeAreas.bind(theFrameInfo.time, [this](float minimumDiscretizedAreaSize) -> std::vector<FreeGoalTargetableArea> {
     return computeFreeAreas(minimumDiscretizedAreaSize);
-  };
-  libStriker.goalTarget = [this](bool shootASAP, bool forceHeuristic) -> Vector2f {
+  });
+  libStriker.goalTarget = memoizedGoalTarget.bind(theFrameInfo.time, [this](bool shootASAP, bool forceHeuristic) -> Vector2f {
     return goalTarget(shootASAP, forceHeuristic);
-  };
-  libStriker.goalTargetWithArea = [this](bool shootASAP, bool forceHeuristic) -> std::pair<Vector2f, FreeGoalTargetableArea> {
+  });
+  libStriker.goalTargetWithArea = memoizedGoalTargetWithArea.bind(theFrameInfo.time, [this](bool shootASAP, bool forceHeuristic) -> std::pair<Vector2f, FreeGoalTargetableArea> {
     return goalTargetWithArea(shootASAP, forceHeuristic);
-  };
+  });
   libStriker.getKick = [this](bool kickAsap, bool kickRight) -> KickInfo::KickType {
     return getKick(kickAsap, kickRight);
   };
@@ -45,6 +45,9 @@ void LibStrikerProvider::update(LibStriker& libStriker)
   DECLARE_DEBUG_DRAWING3D("module:LibStrikerProvider:strikerPosition", "field");
   DECLARE_DEBUG_DRAWING3D("module:LibStrikerProvider:strikerDribblePoint", "field");
   DECLARE_DEBUG_DRAWING3D("module:LibStrikerProvider:strikerDribblePointVerbose", "field");
+
+  DEBUG_RESPONSE("module:LibStrikerProvider:memoization")
+    MemoizedFunctionBase::printStatistics("LibStriker", {&memoizedComputeFreeAreas, &memoizedGoalTarget, &memoizedGoalTargetWithArea});
   // if(thePlayerRole.role==PlayerRole::striker){
   //   CYLINDER3D("module:LibStrikerProvider:strikerPosition", libStriker.strikerPosition.x(), libStriker.strikerPosition.y(), 0.0f, 0.0f, 0.0f, 0.0f, 50.0f, 20.0f, ColorRGBA::red);
   // }
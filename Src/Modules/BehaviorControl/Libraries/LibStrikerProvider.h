@@ -5,6 +5,7 @@
  */
 
 #pragma once
+#include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Modeling/OpponentGoalModel.h"
 #include "Representations/Modeling/TeamPlayersModel.h"
@@ -21,10 +22,12 @@
 #include "Representations/Communication/RobotInfo.h"
 #include "Representations/spqr_representations/GameState.h"
 #include "Tools/Math/BHMath.h"
+#include "Tools/MemoizedFunction.h"
 #include "Tools/Module/Module.h"
 
 MODULE(LibStrikerProvider,
 {,
+  REQUIRES(FrameInfo),
   REQUIRES(RobotPose),
   USES(OpponentGoalModel),
   REQUIRES(TeamPlayersModel),
@@ -49,7 +52,11 @@ MODULE(LibStrikerProvider,
 class LibStrikerProvider : public LibStrikerProviderBase
 {
 private:
-  
+  // The expensive queries are only computed once per frame and set of arguments.
+  MemoizedFunction<std::vector<FreeGoalTargetableArea>(float)> memoizedComputeFreeAreas{"computeFreeAreas"};
+  MemoizedFunction<Vector2f(bool, bool)> memoizedGoalTarget{"goalTarget"};
+  MemoizedFunction<std::pair<Vector2f, FreeGoalTargetableArea>(bool, bool)> memoizedGoalTargetWithArea{"goalTargetWithArea"};
+
   /**
    * @brief Updates the LibStriker representation
    * 
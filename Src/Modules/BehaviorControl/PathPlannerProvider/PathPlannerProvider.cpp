@@ -14,7 +14,9 @@
 #include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Debugging/DebugDrawings3D.h"
 #include "Tools/Debugging/Annotation.h"
+#include "Tools/BehaviorControl/CircleSectors.h"
 #include <algorithm>
+#include <chrono>
 
 /**
  * Draw a 3D circle parallel to the field plane.
@@ -62,6 +64,7 @@
 MAKE_MODULE(PathPlannerProvider, behaviorControl);
 
 static const float epsilon = 0.1f; /**< Small offset in mm. */
+static constexpr int statisticsWindow = 5000; /**< The duration of a statistics window in ms. */
 
 PathPlannerProvider::PathPlannerProvider()
 {
@@ -69,6 +72,16 @@ PathPlannerProvider::PathPlannerProvider()
   borders.emplace_back(theFieldDimensions.xPosOwnGroundLine - fieldBorderLimit, 0.f, 0.f, 1.f);
   borders.emplace_back(0.f, theFieldDimensions.yPosLeftSideline + fieldBorderLimit, 1.f, 0.f);
   borders.emplace_back(0.f, theFieldDimensions.yPosRightSideline - fieldBorderLimit, -1.f, 0.f);
+
+  // The buffers are reused in every planning, so they only grow in the first frames.
+  nodes.reserve(64);
+  edges.reserve(2048);
+  blockedSectors.reserve(64);
+  openList.clear(128);
+  FOREACH_ENUM(Rotation, rotation)
+    tangents[rotation].reserve(256);
+  tangentsByAngle.reserve(256);
+  sweepLine.reserve(256);
 }
 
 void PathPlannerProvider::update(PathPlanner& pathPlanner)
@@ -84,23 +97,42 @@ void PathPlannerProvider::update(PathPlanner& pathPlanner)
 
   pathPlanner.plan = [this](const Pose2f& target, const Pose2f& speed) -> MotionRequest::ObstacleAvoidance
   {
+    const auto start = std::chrono::steady_clock::now();
     bool excludeOwnPenaltyArea = theRobotInfo.number!=1 && theLibTeammates.nonKeeperTeammatesInOwnPenaltyArea >= 2;
     bool excludeOpponentPenaltyArea = theLibTeammates.teammatesInOpponentPenaltyArea >= 3;
     pathPlannerWasActive = true;
     createBarriers(target, excludeOwnPenaltyArea, excludeOpponentPenaltyArea);
     createNodes(target, excludeOwnPenaltyArea, excludeOpponentPenaltyArea);
-    plan(nodes[0], nodes[1], speed.translation.x() / speed.rotation);
+
+    // Only plan a new path if the cached one was planned for a different problem or is not valid anymore.
+    bool reused = false;
+    if(useCache && cachedPath.valid
+       && cachedPath.excludeOwnPenaltyArea == excludeOwnPenaltyArea
+       && cachedPath.excludeOpponentPenaltyArea == excludeOpponentPenaltyArea
+       && (cachedPath.target - target.translation).squaredNorm() <= sqr(cacheTargetTolerance)
+       && theFrameInfo.getTimeSince(cachedPath.timestamp) <= cacheMaxAge)
+    {
+      reused = reusePath();
+      if(!reused)
+        ++invalidations;
+    }
+    if(!reused)
+    {
+      plan(0, 1, speed.translation.x() / speed.rotation);
+      cachePath(target, excludeOwnPenaltyArea, excludeOpponentPenaltyArea);
+    }
 
     bool foundPath = false;
     MotionRequest::ObstacleAvoidance obstacleAvoidance;
     FOREACH_ENUM(Rotation, rotation)
-      if(nodes[1].fromEdge[rotation])
+      if(nodes[1].fromEdge[rotation] != -1)
       {
-        Edge* edge;
-        for(edge = nodes[1].fromEdge[rotation]; edge->fromNode != &nodes[0]; edge = edge->fromNode->fromEdge[edge->fromRotation])
+        const Edge* edge;
+        for(edge = &edges[nodes[1].fromEdge[rotation]]; edge->fromNode != 0; edge = &edges[nodes[edge->fromNode].fromEdge[edge->fromRotation]])
         {
+          const Node& fromNode = nodes[edge->fromNode];
           obstacleAvoidance.path.emplace_back();
-          obstacleAvoidance.path.back().obstacle = Geometry::Circle(theRobotPose.inversePose * edge->fromNode->center, edge->fromNode->radius + radiusControlOffset);
+          obstacleAvoidance.path.back().obstacle = Geometry::Circle(theRobotPose.inversePose * fromNode.center, fromNode.radius + radiusControlOffset);
           obstacleAvoidance.path.back().clockwise = edge->fromRotation == cw;
         }
         lastDir = edge->toRotation;
@@ -115,7 +147,7 @@ void PathPlannerProvider::update(PathPlanner& pathPlanner)
     if(!foundPath)
     {
       // Walk straight to target (but still avoid close obstacles)
-      obstacleAvoidance.avoidance = calcAvoidanceVector(&nodes[1]);
+      obstacleAvoidance.avoidance = calcAvoidanceVector(1);
 
       if(theFrameInfo.getTimeSince(timeWhenLastPlayedSound) > 5000)
       {
@@ -126,6 +158,19 @@ void PathPlannerProvider::update(PathPlanner& pathPlanner)
     }
     draw();
 
+    const float duration = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ++requests;
+    if(reused)
+    {
+      ++cacheHits;
+      reuseTime += duration;
+    }
+    else
+    {
+      replanningTime += duration;
+      maxReplanningTime = std::max(maxReplanningTime, duration);
+    }
+
     return obstacleAvoidance;
   };
 
@@ -135,6 +180,26 @@ void PathPlannerProvider::update(PathPlanner& pathPlanner)
     pathPlannerWasActive = false;
 }
 
+void PathPlannerProvider::update(PathPlannerStatistics& pathPlannerStatistics)
+{
+  if(theFrameInfo.getTimeSince(statisticsWindowStart) >= statisticsWindow)
+  {
+    const unsigned replans = requests - cacheHits;
+    pathPlannerStatistics.timestamp = theFrameInfo.time;
+    pathPlannerStatistics.requests = requests;
+    pathPlannerStatistics.cacheHits = cacheHits;
+    pathPlannerStatistics.invalidations = invalidations;
+    pathPlannerStatistics.hitRate = requests ? static_cast<float>(cacheHits) / static_cast<float>(requests) : 0.f;
+    pathPlannerStatistics.meanReplanningTime = replans ? replanningTime / static_cast<float>(replans) : 0.f;
+    pathPlannerStatistics.maxReplanningTime = maxReplanningTime;
+    pathPlannerStatistics.meanReuseTime = cacheHits ? reuseTime / static_cast<float>(cacheHits) : 0.f;
+
+    statisticsWindowStart = theFrameInfo.time;
+    requests = cacheHits = invalidations = 0;
+    replanningTime = maxReplanningTime = reuseTime = 0.f;
+  }
+}
+
 void PathPlannerProvider::createBarriers(const Pose2f& target, bool excludeOwnPenaltyArea, bool excludeOpponentPenaltyArea)
 {
   barriers.clear();
@@ -212,16 +277,12 @@ void PathPlannerProvider::clipPenaltyArea(const Vector2f& position, float& left,
 void PathPlannerProvider::createNodes(const Pose2f& target, bool excludeOwnPenaltyArea, bool excludeOpponentPenaltyArea)
 {
   nodes.clear();
-
-  // Reserve enough space that prevents any reallocation, because the addresses of entries are used.
-  nodes.reserve(sqr((excludeOwnPenaltyArea ? 8 : 6) + (excludeOpponentPenaltyArea ? 2 : 0) +
-                    (useObstacles ? theObstacleModel.obstacles.size() : theTeamPlayersModel.obstacles.size())));
+  edges.clear();
+  blockedSectors.clear();
 
   // Insert start and target
   nodes.emplace_back(theRobotPose.translation, 0.f);
   nodes.emplace_back(target.translation, 0.f);
-  Node& from(nodes.front());
-  Node& to(nodes.back());
 
   // Insert goalposts
   nodes.emplace_back(Vector2f(theFieldDimensions.xPosOpponentGoalPost, theFieldDimensions.yPosLeftGoal), goalPostRadius - radiusControlOffset);
@@ -277,7 +338,7 @@ void PathPlannerProvider::createNodes(const Pose2f& target, bool excludeOwnPenal
     const Vector2f& ballPosition = theTeamBehaviorStatus.role.playsTheBall() ? theFieldBall.recentBallEndPositionOnField() : theFieldBall.recentBallPositionOnField();
     if(theGameInfo.setPlay != SET_PLAY_NONE && theGameInfo.kickingTeam != theOwnTeamInfo.teamNumber)
       addObstacle(ballPosition, freeKickRadius);
-    else if((ballPosition - to.center).norm() >= 1.f)
+    else if((ballPosition - nodes[1].center).norm() >= 1.f)
       addObstacle(ballPosition, ballRadius);
   }
 
@@ -298,17 +359,26 @@ void PathPlannerProvider::createNodes(const Pose2f& target, bool excludeOwnPenal
       }
     }
 
+  // Expanding a node that overlaps with a smaller one allows cloning it (see createTangents).
+  for(auto node = nodes.begin(); node != nodes.end(); ++node)
+    for(auto other = nodes.begin(); other != nodes.end() && !node->overlapsSmallerNode; ++other)
+    {
+      const float d2 = (other->center - node->center).squaredNorm();
+      node->overlapsSmallerNode = other->radius < node->radius
+                                  && d2 > sqr(node->radius - other->radius) && d2 < sqr(node->radius + other->radius);
+    }
+
   // If start and target are both inside the field, prevent passing obstacles outside the field.
   Boundaryf border(Rangef(borders[1].base.x(), borders[0].base.x()),
                    Rangef(borders[3].base.y(), borders[2].base.y()));
-  if(border.isInside(from.center) && border.isInside(to.center))
+  if(border.isInside(nodes[0].center) && border.isInside(nodes[1].center))
   {
     Vector2f p1;
     Vector2f p2;
     for(auto node = nodes.begin() + 2; node != nodes.end(); ++node)
       for(const auto& border : borders)
         if(Geometry::getIntersectionOfLineAndCircle(border, *node, p1, p2) == 2)
-          node->blockedSectors.emplace_back((p1 - node->center).angle(), (p2 - node->center).angle());
+          addBlockedSector(*node, BlockedSector((p1 - node->center).angle(), (p2 - node->center).angle()));
   }
 
   // Whenever a barrier intersects a node, add a blocking sector.
@@ -324,12 +394,12 @@ void PathPlannerProvider::createNodes(const Pose2f& target, bool excludeOwnPenal
         if(Geometry::getDistanceToEdge(line, p1) == 0.f)
         {
           const float angle = (p1 - node.center).angle();
-          node.blockedSectors.emplace_back(angle, angle, barrier.costs);
+          addBlockedSector(node, BlockedSector(angle, angle, barrier.costs));
         }
         if(Geometry::getDistanceToEdge(line, p2) == 0.f)
         {
           const float angle = (p2 - node.center).angle();
-          node.blockedSectors.emplace_back(angle, angle, barrier.costs);
+          addBlockedSector(node, BlockedSector(angle, angle, barrier.costs));
         }
       }
     }
@@ -365,122 +435,332 @@ void PathPlannerProvider::addObstacle(const Vector2f& center, float radius)
     nodes.emplace_back(center, radius);
 }
 
-void PathPlannerProvider::plan(Node& from, Node& to, float speedRatio)
+void PathPlannerProvider::addBlockedSector(Node& node, const BlockedSector& sector)
 {
-  candidates.clear();
-  candidates.reserve(nodes.size() * nodes.size() * 4);
+  blockedSectors.push_back(sector);
+  blockedSectors.back().next = node.firstBlockedSector;
+  node.firstBlockedSector = static_cast<int>(blockedSectors.size() - 1);
+}
+
+int PathPlannerProvider::cloneNode(int index)
+{
+  const int clone = static_cast<int>(nodes.size());
+  nodes.push_back(nodes[index]);
+  Node& node = nodes.back();
+  node.allowedClones = 0;
+  node.original = index;
+  FOREACH_ENUM(Rotation, rotation)
+  {
+    node.fromEdge[rotation] = -1;
+    const int firstEdge = static_cast<int>(edges.size());
+    for(int i = node.firstEdge[rotation]; i < node.endEdge[rotation]; ++i)
+    {
+      edges.push_back(edges[i]);
+      edges.back().fromNode = clone;
+    }
+    node.firstEdge[rotation] = firstEdge;
+    node.endEdge[rotation] = static_cast<int>(edges.size());
+  }
+  return clone;
+}
+
+void PathPlannerProvider::plan(int from, int to, float speedRatio)
+{
+  openList.clear(nodes.size() * numOfRotations);
 
   expand(from, to, cw, speedRatio);
   expand(from, to, ccw, speedRatio);
 
   // Do A* search
-  while(!candidates.empty())
+  while(!openList.empty())
   {
-    Candidate candidate = candidates.front();
-
-    std::pop_heap(candidates.begin(), candidates.end());
-    candidates.pop_back();
+    const int edge = openList.pop();
+    int toNode = edges[edge].toNode;
+    const Rotation toRotation = edges[edge].toRotation;
 
     // Clone target node if it was already reached and clones are allowed.
-    if(candidate.edge->toNode->fromEdge[candidate.edge->toRotation] &&
-       candidate.edge->toNode->allowedClones > 0)
+    if(nodes[toNode].fromEdge[toRotation] != -1 && nodes[toNode].allowedClones > 0)
     {
-      nodes.emplace_back(*candidate.edge->toNode);
-      --candidate.edge->toNode->allowedClones;
-      candidate.edge->toNode = &nodes.back();
+      --nodes[toNode].allowedClones;
+      toNode = cloneNode(toNode);
+      edges[edge].toNode = toNode;
     }
-    if(!candidate.edge->toNode->fromEdge[candidate.edge->toRotation])
+    if(nodes[toNode].fromEdge[toRotation] == -1)
     {
-      candidate.edge->toNode->fromEdge[candidate.edge->toRotation] = candidate.edge;
-      if(candidate.edge->toNode == &to)
+      nodes[toNode].fromEdge[toRotation] = edge;
+      if(toNode == to)
         break;
       else
-        expand(*candidate.edge->toNode, to, candidate.edge->toRotation, speedRatio);
+        expand(toNode, to, toRotation, speedRatio);
     }
   }
 }
 
-void PathPlannerProvider::expand(Node& node, const Node& to, Rotation rotation, float speedRatio)
+void PathPlannerProvider::cachePath(const Pose2f& target, bool excludeOwnPenaltyArea, bool excludeOpponentPenaltyArea)
 {
-  if(!node.expanded)
-  {
-    findNeighbors(node);
-    node.expanded = true;
-  }
+  cachedPath.valid = false;
+  cachedPath.steps.clear();
+  FOREACH_ENUM(Rotation, rotation)
+    if(nodes[1].fromEdge[rotation] != -1)
+    {
+      for(int i = nodes[1].fromEdge[rotation]; i != -1; i = nodes[edges[i].fromNode].fromEdge[edges[i].fromRotation])
+      {
+        const Edge& edge = edges[i];
+        cachedPath.steps.push_back({nodes[edge.toNode].center, nodes[edge.toNode].radius, edge.fromRotation, edge.toRotation});
+      }
+      std::reverse(cachedPath.steps.begin(), cachedPath.steps.end());
+      cachedPath.valid = true;
+      break;
+    }
+
+  cachedPath.target = target.translation;
+  cachedPath.excludeOwnPenaltyArea = excludeOwnPenaltyArea;
+  cachedPath.excludeOpponentPenaltyArea = excludeOpponentPenaltyArea;
+  cachedPath.timestamp = theFrameInfo.time;
+  cachedPath.length = getPathLength();
+}
 
-  for(auto& edge : node.edges[rotation])
+bool PathPlannerProvider::reusePath()
+{
+  const int numOfNodes = static_cast<int>(nodes.size());
+  int from = 0;
+  int fromMatch = 0;
+  for(size_t i = 0; i < cachedPath.steps.size(); ++i)
   {
-    edge.pathLength = edge.length;
-    if(node.fromEdge[rotation])
-    {
-      // This is not the first node, i.e. we arrived here at fromEdge->toPoint.
-      edge.pathLength += node.fromEdge[rotation]->pathLength;
-      const float toAngle = (node.fromEdge[rotation]->toPoint - node.center).angle();
+    const CachedPath::Step& step = cachedPath.steps[i];
 
-      // The sector used on the circle is from toAngle of the incoming edge
-      // to fromAngle of the outgoing edge.
-      Rangef interval;
-      if(rotation == cw)
+    // Find the current node that is closest to the one of the cached path. The last one is the target.
+    int toMatch = 1;
+    if(i < cachedPath.steps.size() - 1)
+    {
+      toMatch = -1;
+      float closest = sqr(cacheObstacleTolerance);
+      for(int j = 2; j < numOfNodes; ++j)
       {
-        interval.min = edge.fromAngle;
-        interval.max = toAngle;
+        const float distance2 = (nodes[j].center - step.center).squaredNorm();
+        if(distance2 <= closest && std::abs(nodes[j].radius - step.radius) <= cacheObstacleTolerance)
+        {
+          closest = distance2;
+          toMatch = j;
+        }
       }
+      if(toMatch == -1)
+        goto invalid;
+
+      // The node was not expanded, i.e. the sectors covered by overlapping obstacles are
+      // still missing. They are added when the node is matched for the first time.
+      if(nodes[toMatch].fromEdge[cw] == -1 && nodes[toMatch].fromEdge[ccw] == -1)
+        for(int j = 2; j < numOfNodes; ++j)
+          if(CircleSectors::intersect(nodes[toMatch].center, nodes[toMatch].radius, nodes[j].center, nodes[j].radius))
+          {
+            const Rangef overlap = CircleSectors::getOverlap(nodes[toMatch].center, nodes[toMatch].radius, nodes[j].center, nodes[j].radius);
+            addBlockedSector(nodes[toMatch], BlockedSector(overlap.min, overlap.max));
+          }
+    }
+
+    // A path can surround a node twice in the same direction. The second time, it reaches a clone.
+    const int to = nodes[toMatch].fromEdge[step.toRotation] == -1 ? toMatch : cloneNode(toMatch);
+    if(!addEdge(from, to, step.fromRotation, step.toRotation))
+      goto invalid;
+
+    // The edge must not intersect with any other obstacle.
+    const Edge& edge = edges.back();
+    const Vector2f fromPoint = Pose2f(edge.fromAngle, nodes[from].center) * Vector2f(nodes[from].radius, 0.f);
+    const Geometry::Line line(fromPoint, edge.toPoint - fromPoint);
+    for(int j = 2; j < numOfNodes; ++j)
+      if(j != fromMatch && j != toMatch && Geometry::getDistanceToEdge(line, nodes[j].center) < nodes[j].radius)
+        goto invalid;
+
+    nodes[to].fromEdge[step.toRotation] = static_cast<int>(edges.size() - 1);
+    from = to;
+    fromMatch = toMatch;
+  }
+
+  // Passing the nodes must still be possible, i.e. no arc crosses an obstacle or barrier,
+  // and the path must not have become too long.
+  if(getPathLength() <= cachedPath.length + cacheLengthTolerance)
+    return true;
+
+invalid:
+  nodes.erase(nodes.begin() + numOfNodes, nodes.end());
+  for(Node& node : nodes)
+    node.fromEdge[cw] = node.fromEdge[ccw] = -1;
+  edges.clear();
+  return false;
+}
+
+bool PathPlannerProvider::addEdge(int from, int to, Rotation fromRotation, Rotation toRotation)
+{
+  // See createTangents for how the tangents are computed. Rotating differently around both nodes means
+  // that the tangent crosses the line between their centers.
+  const Node& fromNode = nodes[from];
+  const Node& toNode = nodes[to];
+  Vector2f v = toNode.center - fromNode.center;
+  const float d2 = v.squaredNorm();
+  if(d2 <= sqr(fromNode.radius - toNode.radius))
+    return false;
+  const float d = std::sqrt(d2);
+  v /= d;
+
+  const float sign1 = fromRotation != toRotation ? -1.f : 1.f;
+  const float c = (fromNode.radius - sign1 * toNode.radius) / d;
+  if(c * c > 1.f)
+    return false;
+
+  const float h = std::sqrt(std::max(0.f, 1.f - c * c));
+  const float sign2 = fromRotation == ccw ? -1.f : 1.f;
+  const Vector2f n(v.x() * c - sign2 * h * v.y(), v.y() * c + sign2 * h * v.x());
+  const Vector2f p1 = fromNode.center + n * fromNode.radius;
+  const Vector2f p2 = toNode.center + n * sign1 * toNode.radius;
+  float distance = (p2 - p1).norm();
+  const float fromAngle = fromNode.radius == 0.f ? (v * d + n * sign1 * toNode.radius).angle() : n.angle();
+
+  for(const auto& barrier : barriers)
+    if(barrier.intersects(p1, p2))
+    {
+      if(barrier.costs == std::numeric_limits<float>::infinity())
+        return false;
       else
+        distance += barrier.costs;
+    }
+
+  edges.emplace_back(from, to, fromAngle, p2, fromRotation, toRotation, distance);
+  return true;
+}
+
+float PathPlannerProvider::getPathLength() const
+{
+  FOREACH_ENUM(Rotation, rotation)
+    if(nodes[1].fromEdge[rotation] != -1)
+    {
+      float length = 0.f;
+      for(int i = nodes[1].fromEdge[rotation]; i != -1; i = nodes[edges[i].fromNode].fromEdge[edges[i].fromRotation])
       {
-        interval.min = toAngle;
-        interval.max = edge.fromAngle;
+        const Edge& edge = edges[i];
+        const Node& node = nodes[edge.fromNode];
+        length += edge.length;
+        if(node.fromEdge[edge.fromRotation] != -1)
+          length += getArcCosts(node, edge.fromRotation, edges[node.fromEdge[edge.fromRotation]], edge);
       }
+      return length;
+    }
+  return std::numeric_limits<float>::infinity();
+}
 
-      // If an blocking sector overlaps with this interval, at least one limit
-      // of one interval must be inside the other interval.
-      // If it is, reaching the outgoing edge is not possible.
-      for(const auto& sector : node.blockedSectors)
-        if(interval.isInside(sector.min) || interval.isInside(sector.max) ||
-           sector.isInside(interval.min) || sector.isInside(interval.max))
-        {
-          if(sector.costs == std::numeric_limits<float>::infinity())
-            goto continueOuterLoop;
-          else
-            edge.pathLength += sector.costs;
-        }
-
-      // Compute the positive angle from incoming to outgoing edge in the fixed direction (cw/ccw).
-      float angle = interval.max - interval.min;
-      if(angle < 0.f)
-        angle += pi2;
+void PathPlannerProvider::expand(int nodeIndex, int to, Rotation rotation, float speedRatio)
+{
+  if(!nodes[nodeIndex].expanded)
+  {
+    findNeighbors(nodeIndex);
+    nodes[nodeIndex].expanded = true;
+  }
 
-      edge.pathLength += angle * node.radius;
+  // Adding candidates can clone nodes, which reallocates the buffers. Therefore, indices are used.
+  for(int edgeIndex = nodes[nodeIndex].firstEdge[rotation]; edgeIndex < nodes[nodeIndex].endEdge[rotation]; ++edgeIndex)
+  {
+    const Node& node = nodes[nodeIndex];
+    Edge& edge = edges[edgeIndex];
+    edge.pathLength = edge.length;
+    if(node.fromEdge[rotation] != -1)
+    {
+      // This is not the first node, i.e. we arrived here at fromEdge->toPoint.
+      const Edge& fromEdge = edges[node.fromEdge[rotation]];
+      const float arcCosts = getArcCosts(node, rotation, fromEdge, edge);
+      if(arcCosts == std::numeric_limits<float>::infinity())
+        continue;
+      edge.pathLength += fromEdge.pathLength + arcCosts;
     }
     else
     {
       // This is the first node. Add penalty for rotating to outgoing edge.
-      const float toRotate = std::abs((theRobotPose.translation - edge.toNode->center).norm() > edge.toNode->radius
+      const Node& toNode = nodes[edge.toNode];
+      const float toRotate = std::abs((theRobotPose.translation - toNode.center).norm() > toNode.radius
                                       ? (Pose2f(edge.toPoint) - theRobotPose).translation.angle()
-                                      : Angle::normalize((edge.toPoint - edge.toNode->center).angle() + (edge.toRotation == cw ? -pi_2 : pi_2) - theRobotPose.rotation));
+                                      : Angle::normalize((edge.toPoint - toNode.center).angle() + (edge.toRotation == cw ? -pi_2 : pi_2) - theRobotPose.rotation));
       const float distanceRatio = toRotate * speedRatio;
       edge.pathLength += distanceRatio * rotationPenalty + (lastDir == edge.toRotation ? 0.f : switchPenalty);
     }
 
-    candidates.emplace_back(&edge, (to.center - edge.toPoint).norm());
-    std::push_heap(candidates.begin(), candidates.end());
+    addCandidate(edgeIndex, edge.pathLength + (nodes[to].center - edge.toPoint).norm());
+  }
+}
+
+float PathPlannerProvider::getArcCosts(const Node& node, Rotation rotation, const Edge& incoming, const Edge& outgoing) const
+{
+  const float toAngle = (incoming.toPoint - node.center).angle();
+
+  // The sector used on the circle is from toAngle of the incoming edge
+  // to fromAngle of the outgoing edge.
+  Rangef interval;
+  if(rotation == cw)
+  {
+    interval.min = outgoing.fromAngle;
+    interval.max = toAngle;
+  }
+  else
+  {
+    interval.min = toAngle;
+    interval.max = outgoing.fromAngle;
+  }
+
+  // If a blocking sector overlaps with this interval, reaching the outgoing edge is not possible.
+  float costs = 0.f;
+  for(int i = node.firstBlockedSector; i != -1; i = blockedSectors[i].next)
+  {
+    const BlockedSector& sector = blockedSectors[i];
+    if(CircleSectors::overlap(interval, sector))
+    {
+      if(sector.costs == std::numeric_limits<float>::infinity())
+        return std::numeric_limits<float>::infinity();
+      else
+        costs += sector.costs;
+    }
+  }
+
+  // Compute the positive angle from incoming to outgoing edge in the fixed direction (cw/ccw).
+  float angle = interval.max - interval.min;
+  if(angle < 0.f)
+    angle += pi2;
+
+  return costs + angle * node.radius;
+}
 
-  continueOuterLoop:
-    ;
+void PathPlannerProvider::addCandidate(int edge, float estimatedPathLength)
+{
+  const int toNode = edges[edge].toNode;
+  const Rotation toRotation = edges[edge].toRotation;
+  const Node& node = nodes[toNode];
+  if(node.allowedClones > 0 || (!node.expanded && node.overlapsSmallerNode))
+  {
+    // If the node is reached again later, this edge might reach a clone of it. Therefore,
+    // it cannot replace other edges to this node.
+    openList.push(-1, edge, estimatedPathLength);
   }
+  else if(node.fromEdge[toRotation] == -1)
+    openList.push(toNode * numOfRotations + toRotation, edge, estimatedPathLength);
 }
 
-void PathPlannerProvider::findNeighbors(Node& node)
+void PathPlannerProvider::findNeighbors(int node)
 {
-  Tangents tangents;
+  FOREACH_ENUM(Rotation, rotation)
+    tangents[rotation].clear();
   createTangents(node, tangents);
   addNeighborsFromTangents(node, tangents);
 }
 
-void PathPlannerProvider::createTangents(Node& node, Tangents& tangents)
+void PathPlannerProvider::createTangents(int nodeIndex, Tangents& tangents)
 {
+  // Neighbors might be cloned below. Reserve space for all clones possible, so that references stay valid.
+  int clones = 0;
+  for(const Node& node : nodes)
+    clones += node.allowedClones;
+  nodes.reserve(nodes.size() + clones);
+  Node& node = nodes[nodeIndex];
+
   // search all nodes except for start node
   for(auto neighbor = nodes.begin() + 1; neighbor != nodes.end(); ++neighbor)
   {
+    const int neighborIndex = static_cast<int>(neighbor - nodes.begin());
     Vector2f v = neighbor->center - node.center;
     const float d2 = v.squaredNorm();
     if(d2 > (node.radius - neighbor->radius) * (node.radius - neighbor->radius))
@@ -537,14 +817,14 @@ void PathPlannerProvider::createTangents(Node& node, Tangents& tangents)
               const Vector2f p2 = neighbor->center + n * sign1 * neighbor->radius;
               float distance = (p2 - p1).norm();
               const float fromAngle = node.radius == 0.f ? (v * d + n * sign1 * neighbor->radius).angle() : n.angle();
-              bool dummy = neighbor->fromEdge[i ^ j] != nullptr;
+              bool dummy = neighbor->fromEdge[i ^ j] != -1;
               if(dummy)
               {
                 // Clone target node if it was already reached and clones are allowed.
                 if(neighbor->allowedClones > 0)
                 {
-                  nodes.push_back(*neighbor);
                   --neighbor->allowedClones;
+                  cloneNode(neighborIndex);
                 }
               }
               else
@@ -560,7 +840,7 @@ void PathPlannerProvider::createTangents(Node& node, Tangents& tangents)
                       distance += barrier.costs;
                   }
 
-              tangents[j].emplace_back(Edge(&node, &*neighbor, fromAngle, p2, static_cast<Rotation>(j), static_cast<Rotation>(i ^ j), distance),
+              tangents[j].emplace_back(Edge(nodeIndex, neighborIndex, fromAngle, p2, static_cast<Rotation>(j), static_cast<Rotation>(i ^ j), distance),
                                        neighbor->radius == 0.f ? Tangent::none : i ^ j ? Tangent::right : Tangent::left, d - neighbor->radius, dummy);
 
               // If both nodes are points, there is only a single connection. Skip the rest.
@@ -576,14 +856,12 @@ void PathPlannerProvider::createTangents(Node& node, Tangents& tangents)
           // Add (dummy) tangents as end points for these ranges.
           for(auto& t : tangents)
           {
-            const float d1 = 0.5f * (d + (sqr(node.radius) - sqr(neighbor->radius)) / d);
-            const float a = std::acos(d1 / node.radius);
-            const float dir = v.angle();
+            const Rangef overlap = CircleSectors::getOverlap(node.center, node.radius, neighbor->center, neighbor->radius);
             t.emplace_back(t.back());
-            BlockedSector blocked(Angle::normalize(dir - a), Angle::normalize(dir + a));
+            BlockedSector blocked(overlap.min, overlap.max);
             if(t.back().side == Tangent::left)
             {
-              node.blockedSectors.emplace_back(blocked);
+              addBlockedSector(node, blocked);
               if(neighbor->radius < node.radius)
                 ++node.allowedClones;
               t.back().side = Tangent::right;
@@ -641,32 +919,32 @@ void PathPlannerProvider::createTangents(Node& node, Tangents& tangents)
   }
 }
 
-void PathPlannerProvider::addNeighborsFromTangents(Node& node, Tangents& tangents)
+void PathPlannerProvider::addNeighborsFromTangents(int nodeIndex, Tangents& tangents)
 {
+  Node& node = nodes[nodeIndex];
   FOREACH_ENUM(Rotation, rotation)
   {
     auto& t = tangents[rotation];
+    node.firstEdge[rotation] = static_cast<int>(edges.size());
 
     // Create index for tangents sorted by angle.
     // Since indices are used to reference between tangents,
     // the original vector of tangents must stay unchanged.
-    std::vector<Tangent*> index;
-    index.reserve(t.size());
+    tangentsByAngle.clear();
     for(auto& tangent : t)
-      index.push_back(&tangent);
-    std::sort(index.begin(), index.end(), [](const Tangent* t1, const Tangent* t2) -> bool
+      tangentsByAngle.push_back(&tangent);
+    std::sort(tangentsByAngle.begin(), tangentsByAngle.end(), [](const Tangent* t1, const Tangent* t2) -> bool
     {
       return t1->fromAngle < t2->fromAngle;
     });
 
     // Sweep through all tangents, managing a set of current nodes sorted by their distance.
-    std::vector<Tangent*> sweepLine;
-    sweepLine.reserve(t.size());
+    sweepLine.clear();
     const auto byDistance = [](const Tangent* t1, const Tangent* t2) -> bool
     {
       return t1->circleDistance > t2->circleDistance;
     };
-    for(auto& tangent : index)
+    for(auto& tangent : tangentsByAngle)
     {
       // In general, if the node of the current tangent is not further away than the closest node
       // in the sweep line, it is a neighbor. However, since the obstacles are modeled as circles,
@@ -679,7 +957,7 @@ void PathPlannerProvider::addNeighborsFromTangents(Node& node, Tangents& tangent
           {
             if(s->circleDistance >= tangent->circleDistance)
               break;
-            else if(s->circleDistance + 2.f * s->toNode->radius < tangent->circleDistance)
+            else if(s->circleDistance + 2.f * nodes[s->toNode].radius < tangent->circleDistance)
               goto doNotAddTangent;
             else
             {
@@ -687,12 +965,12 @@ void PathPlannerProvider::addNeighborsFromTangents(Node& node, Tangents& tangent
               Geometry::Line line(fromPoint, tangent->toPoint - fromPoint);
               Vector2f p1;
               Vector2f p2;
-              if(Geometry::getIntersectionOfLineAndCircle(line, *s->toNode, p1, p2) &&
+              if(Geometry::getIntersectionOfLineAndCircle(line, nodes[s->toNode], p1, p2) &&
                  line.direction.squaredNorm() >= (p1 - fromPoint).squaredNorm())
                 goto doNotAddTangent;
             }
           }
-        node.edges[rotation].emplace_back(*tangent);
+        edges.emplace_back(*tangent);
 
       doNotAddTangent:
         ;
@@ -729,11 +1007,98 @@ void PathPlannerProvider::addNeighborsFromTangents(Node& node, Tangents& tangent
         }
       }
     }
+    node.endEdge[rotation] = static_cast<int>(edges.size());
   }
 }
 
-Vector2f PathPlannerProvider::calcAvoidanceVector(const Node* nextNode) const
+void PathPlannerProvider::OpenList::clear(size_t numOfStates)
 {
+  heap.clear();
+  positions.assign(numOfStates, -1);
+}
+
+void PathPlannerProvider::OpenList::push(int state, int edge, float estimatedPathLength)
+{
+  if(state != -1 && contains(state))
+  {
+    const int position = positions[state];
+    if(estimatedPathLength < heap[position].estimatedPathLength)
+    {
+      heap[position].edge = edge;
+      heap[position].estimatedPathLength = estimatedPathLength;
+      moveUp(position);
+    }
+  }
+  else
+  {
+    if(static_cast<size_t>(state + 1) > positions.size())
+      positions.resize(state + 1, -1);
+    heap.push_back({state, edge, estimatedPathLength});
+    moveUp(static_cast<int>(heap.size() - 1));
+  }
+}
+
+int PathPlannerProvider::OpenList::pop()
+{
+  const Entry entry = heap.front();
+  if(entry.state != -1)
+    positions[entry.state] = -1;
+  const Entry last = heap.back();
+  heap.pop_back();
+  if(!heap.empty())
+  {
+    place(0, last);
+    moveDown(0);
+  }
+  return entry.edge;
+}
+
+void PathPlannerProvider::OpenList::place(int position, const Entry& entry)
+{
+  heap[position] = entry;
+  if(entry.state != -1)
+    positions[entry.state] = position;
+}
+
+void PathPlannerProvider::OpenList::moveUp(int position)
+{
+  const Entry entry = heap[position];
+  while(position > 0)
+  {
+    const int parent = (position - 1) / 2;
+    if(heap[parent].estimatedPathLength <= entry.estimatedPathLength)
+      break;
+    place(position, heap[parent]);
+    position = parent;
+  }
+  place(position, entry);
+}
+
+void PathPlannerProvider::OpenList::moveDown(int position)
+{
+  const Entry entry = heap[position];
+  const int size = static_cast<int>(heap.size());
+  while(true)
+  {
+    int child = 2 * position + 1;
+    if(child >= size)
+      break;
+    if(child + 1 < size && heap[child + 1].estimatedPathLength < heap[child].estimatedPathLength)
+      ++child;
+    if(entry.estimatedPathLength <= heap[child].estimatedPathLength)
+      break;
+    place(position, heap[child]);
+    position = child;
+  }
+  place(position, entry);
+}
+
+Vector2f PathPlannerProvider::calcAvoidanceVector(int nextNode) const
+{
+  // Clones are only copies of obstacles.
+  if(nodes[nextNode].original != -1)
+    nextNode = nodes[nextNode].original;
+
   // Determine general avoidance direction.
   Vector2f avoidance = Vector2f::Zero();
   bool closeToNextNode = false;
@@ -742,13 +1107,13 @@ Vector2f PathPlannerProvider::calcAvoidanceVector(const Node* nextNode) const
   for(auto node = nodes.begin() + 2; node != nodes.end(); ++node)
   {
     const Vector2f offset = node->center - theRobotPose.translation;
-    if(offset.squaredNorm() < sqr(node->originalRadius + radiusControlOffset))
+    if(node->original == -1 && offset.squaredNorm() < sqr(node->originalRadius + radiusControlOffset))
     {
       inFront |= (Pose2f(node->center) - theRobotPose).translation.x() >= 0.f;
       const float factor = std::min(1.f, (node->originalRadius + radiusControlOffset - offset.norm()) / radiusAvoidanceTolerance);
       avoidance += -(Pose2f(node->center) - theRobotPose).translation.normalized(factor);
-      closeToNextNode |= &*node == nextNode;
-      closeToOtherNode |= &*node != nextNode;
+      closeToNextNode |= node - nodes.begin() == nextNode;
+      closeToOtherNode |= node - nodes.begin() != nextNode;
     }
   }
 
@@ -788,8 +1153,9 @@ void PathPlannerProvider::draw() const
     {
       CIRCLE("module:PathPlannerProvider:obstacles", node.center.x(), node.center.y(), node.radius > 0.f ? node.radius : 50.f,
              10, Drawings::solidPen, ColorRGBA::yellow, Drawings::noPen, ColorRGBA());
-      for(const auto& blockedSector : node.blockedSectors)
+      for(int i = node.firstBlockedSector; i != -1; i = blockedSectors[i].next)
       {
+        const BlockedSector& blockedSector = blockedSectors[i];
         float span = blockedSector.max - blockedSector.min;
         if(span < 0.f)
           span += pi2;
@@ -804,8 +1170,9 @@ void PathPlannerProvider::draw() const
     for(const auto& node : nodes)
     {
       CIRCLE3D("module:PathPlannerProvider:obstacles", node.center.x(), node.center.y(), 0, node.radius > 0.f ? node.radius : 20.f, 5, ColorRGBA::yellow);
-      for(const auto& blockedSector : node.blockedSectors)
+      for(int i = node.firstBlockedSector; i != -1; i = blockedSectors[i].next)
       {
+        const BlockedSector& blockedSector = blockedSectors[i];
         float span = blockedSector.max - blockedSector.min;
         if(span < 0.f)
           span += pi2;
@@ -820,8 +1187,9 @@ void PathPlannerProvider::draw() const
     for(const auto& node : nodes)
     {
       FOREACH_ENUM(Rotation, rotation)
-        for(const auto& edge : node.edges[rotation])
+        for(int i = node.firstEdge[rotation]; i < node.endEdge[rotation]; ++i)
         {
+          const Edge& edge = edges[i];
           Vector2f p1 = Pose2f(edge.fromAngle, node.center) * Vector2f(node.radius, 0.f);
           const Vector2f& p2 = edge.toPoint;
           LINE("module:PathPlannerProvider:expanded", p1.x(), p1.y(), p2.x(), p2.y(), 10, Drawings::solidPen, ColorRGBA::yellow);
@@ -834,8 +1202,9 @@ void PathPlannerProvider::draw() const
     for(const auto& node : nodes)
     {
       FOREACH_ENUM(Rotation, rotation)
-        for(const auto& edge : node.edges[rotation])
+        for(int i = node.firstEdge[rotation]; i < node.endEdge[rotation]; ++i)
         {
+          const Edge& edge = edges[i];
           Vector2f p1 = Pose2f(edge.fromAngle, node.center) * Vector2f(node.radius, 0.f);
           const Vector2f& p2 = edge.toPoint;
           LINE3D("module:PathPlannerProvider:expanded", p1.x(), p1.y(), 0, p2.x(), p2.y(), 0, 5, ColorRGBA::yellow);
@@ -846,19 +1215,20 @@ void PathPlannerProvider::draw() const
   COMPLEX_DRAWING("module:PathPlannerProvider:path")
   {
     FOREACH_ENUM(Rotation, rotation)
-      if(nodes[1].fromEdge[rotation])
+      if(nodes[1].fromEdge[rotation] != -1)
       {
-        for(const Edge* edge = nodes[1].fromEdge[rotation]; edge; edge = edge->fromNode->fromEdge[edge->fromRotation])
+        for(int i = nodes[1].fromEdge[rotation]; i != -1; i = nodes[edges[i].fromNode].fromEdge[edges[i].fromRotation])
         {
-          Vector2f p1 = Pose2f(edge->fromAngle, edge->fromNode->center) * Vector2f(edge->fromNode->radius, 0.f);
+          const Edge* edge = &edges[i];
+          const Node& node = nodes[edge->fromNode];
+          Vector2f p1 = Pose2f(edge->fromAngle, node.center) * Vector2f(node.radius, 0.f);
           const Vector2f& p2 = edge->toPoint;
           LINE("module:PathPlannerProvider:path", p1.x(), p1.y(), p2.x(), p2.y(), 20, Drawings::solidPen, ColorRGBA::green);
 
-          if(edge->fromNode->fromEdge[edge->fromRotation])
+          if(node.fromEdge[edge->fromRotation] != -1)
           {
-            const Node& node = *edge->fromNode;
             // This is not the first node, i.e. we arrived here at fromEdge->toPoint.
-            const float toAngle = (node.fromEdge[edge->fromRotation]->toPoint - node.center).angle();
+            const float toAngle = (edges[node.fromEdge[edge->fromRotation]].toPoint - node.center).angle();
 
             // The sector used on the circle is from toAngle of the incoming edge
             // to fromAngle of the outgoing edge.
@@ -889,19 +1259,20 @@ void PathPlannerProvider::draw() const
   COMPLEX_DRAWING3D("module:PathPlannerProvider:path")
   {
     FOREACH_ENUM(Rotation, rotation)
-      if(nodes[1].fromEdge[rotation])
+      if(nodes[1].fromEdge[rotation] != -1)
       {
-        for(const Edge* edge = nodes[1].fromEdge[rotation]; edge; edge = edge->fromNode->fromEdge[edge->fromRotation])
+        for(int i = nodes[1].fromEdge[rotation]; i != -1; i = nodes[edges[i].fromNode].fromEdge[edges[i].fromRotation])
         {
-          Vector2f p1 = Pose2f(edge->fromAngle, edge->fromNode->center) * Vector2f(edge->fromNode->radius, 0.f);
+          const Edge* edge = &edges[i];
+          const Node& node = nodes[edge->fromNode];
+          Vector2f p1 = Pose2f(edge->fromAngle, node.center) * Vector2f(node.radius, 0.f);
           const Vector2f& p2 = edge->toPoint;
           LINE3D("module:PathPlannerProvider:path", p1.x(), p1.y(), 3.f, p2.x(), p2.y(), 3.f, 10, ColorRGBA::green);
 
-          if(edge->fromNode->fromEdge[edge->fromRotation])
+          if(node.fromEdge[edge->fromRotation] != -1)
           {
-            const Node& node = *edge->fromNode;
             // This is not the first node, i.e. we arrived here at fromEdge->toPoint.
-            const float toAngle = (node.fromEdge[edge->fromRotation]->toPoint - node.center).angle();
+            const float toAngle = (edges[node.fromEdge[edge->fromRotation]].toPoint - node.center).angle();
 
             // The sector used on the circle is from toAngle of the incoming edge
             // to fromAngle of the outgoing edge.
@@ -11,6 +11,7 @@
 
 #include "Representations/BehaviorControl/FieldBall.h"
 #include "Representations/BehaviorControl/PathPlanner.h"
+#include "Representations/BehaviorControl/PathPlannerStatistics.h"
 #include "Representations/BehaviorControl/TeamBehaviorStatus.h"
 #include "Representations/BehaviorControl/Libraries/LibTeammates.h"
 #include "Representations/Communication/GameInfo.h"
@@ -38,6 +39,7 @@ MODULE(PathPlannerProvider,
   REQUIRES(TeamPlayersModel),
   REQUIRES(RobotInfo),
   PROVIDES(PathPlanner),
+  PROVIDES(PathPlannerStatistics),
   LOADS_PARAMETERS(
   {,
     (bool) useObstacles, /**< Use TeamPlayersModel or ObstacleModel? */
@@ -56,6 +58,11 @@ MODULE(PathPlannerProvider,
     (float) radiusAvoidanceTolerance, /**< Radius range in which robot is partially pushed away (in mm). */
     (float) rotationPenalty, /**< Penalty factor for rotating towards first intermediate target in mm/radian. Stabilizes path selection. */
     (float) switchPenalty, /**< Penalty for selecting a different turn direction around first obstacle in mm. */
+    (bool) useCache, /**< Reuse the last path as long as it stays valid instead of planning a new one in every frame? */
+    (float) cacheTargetTolerance, /**< The target may move this far before the cached path is replaced (in mm). */
+    (float) cacheObstacleTolerance, /**< Obstacles on the cached path may move and change their radius this much (in mm). */
+    (float) cacheLengthTolerance, /**< The cached path is replaced if it became longer than this compared to when it was planned (in mm). */
+    (int) cacheMaxAge, /**< The cached path is replaced after this time to find shortcuts that opened up (in ms). */
   }),
 });
 
@@ -68,13 +75,11 @@ class PathPlannerProvider : public PathPlannerProviderBase
     ccw,
   });
 
-  struct Node;
-
   /** The edges of the visibility graph. */
   struct Edge
   {
-    Node* fromNode; /**< The node from which this edge starts. */
-    Node* toNode; /**< The node at which this edge ends. */
+    int fromNode; /**< The index of the node from which this edge starts. */
+    int toNode; /**< The index of the node at which this edge ends. */
     float fromAngle; /**< The angle where this edge touches the circle around fromNode. */
     Vector2f toPoint; /**< The point where this edge touches the circle of toNode. */
     Rotation fromRotation; /**< The rotation with which fromNode was surrounded. */
@@ -84,15 +89,15 @@ class PathPlannerProvider : public PathPlannerProviderBase
 
     /**
      * Constructor.
-     * @param fromNode The node from which this edge starts.
-     * @param toNode The node at which this edge ends.
+     * @param fromNode The index of the node from which this edge starts.
+     * @param toNode The index of the node at which this edge ends.
      * @param fromAngle The angle where this edge touches the circle around fromNode.
      * @param toPoint The point where this edge touches the circle of toNode.
      * @param fromRotation The rotation with which fromNode was surrounded.
      * @param toRotation The rotation with which toNode will be surrounded.
      * @param length The length of this edge.
      */
-    Edge(Node* fromNode, Node* toNode, float fromAngle, const Vector2f& toPoint, Rotation fromRotation, Rotation toRotation, float length)
+    Edge(int fromNode, int toNode, float fromAngle, const Vector2f& toPoint, Rotation fromRotation, Rotation toRotation, float length)
       : fromNode(fromNode), toNode(toNode), fromAngle(fromAngle), toPoint(toPoint), fromRotation(fromRotation), toRotation(toRotation), length(length) {}
   };
 
@@ -103,17 +108,25 @@ class PathPlannerProvider : public PathPlannerProviderBase
   struct BlockedSector : public Rangef
   {
     float costs; /**< costs for passing this circle segment. */
+    int next = -1; /**< The index of the next sector of the same node or -1 if this is the last one. */
     BlockedSector(float min, float max, float costs = std::numeric_limits<float>::infinity()) : Rangef(min, max), costs(costs) {}
   };
 
-  /** The nodes of the visibility graph, i.e. the obstacles. */
+  /**
+   * The nodes of the visibility graph, i.e. the obstacles. Nodes are plain values.
+   * Their edges and blocked sectors are stored in buffers shared by all nodes and
+   * are referenced by indices.
+   */
   struct Node : public Geometry::Circle
   {
-    std::vector<Edge> edges[numOfRotations]; /** The outgoing edges per rotation. */
-    std::vector<BlockedSector> blockedSectors; /**< Angular sectors that are blocked by overlapping other obstacles. */
-    Edge* fromEdge[numOfRotations]; /**< From which edge was this node reached first (per rotation) during the A* search? */
+    int firstEdge[numOfRotations]; /**< The index of the first outgoing edge per rotation. */
+    int endEdge[numOfRotations]; /**< The index behind the last outgoing edge per rotation. */
+    int firstBlockedSector = -1; /**< The index of the first angular sector that is blocked by overlapping other obstacles or -1 if there is none. */
+    int fromEdge[numOfRotations]; /**< From which edge was this node reached first (per rotation) during the A* search? -1 if not reached yet. */
     bool expanded = false; /**< Were the outgoing edges of this node already expanded? */
     int allowedClones = 0; /**< The number of times this node can be cloned. */
+    int original = -1; /**< The index of the node this one is a clone of or -1 if it is not a clone. */
+    bool overlapsSmallerNode = false; /**< Does a smaller node overlap with this one, i.e. can it be cloned after being expanded? */
     float originalRadius; /**< The original radius of this node before it was reduced (in mm). */
 
     /**
@@ -123,51 +136,79 @@ class PathPlannerProvider : public PathPlannerProviderBase
      */
     Node(const Vector2f& center, float radius) : Circle(center, radius), originalRadius(radius)
     {
-      fromEdge[cw] = fromEdge[ccw] = nullptr;
+      firstEdge[cw] = firstEdge[ccw] = endEdge[cw] = endEdge[ccw] = 0;
+      fromEdge[cw] = fromEdge[ccw] = -1;
     }
+  };
+
+  /**
+   * The open list of the A* search. It is an indexed binary heap of edges. Edges can be
+   * indexed by the state they reach, i.e. a node surrounded in a certain rotation. Then,
+   * only the shortest edge found so far is kept per state. If a shorter edge to a queued
+   * state is found, its key is decreased instead of adding another entry.
+   */
+  class OpenList
+  {
+    /** An entry of the heap. */
+    struct Entry
+    {
+      int state; /**< The state reached by the edge or -1 if the entry is not indexed. */
+      int edge; /**< The index of the edge. */
+      float estimatedPathLength; /**< The estimated path length including the heuristic. */
+    };
+
+    std::vector<Entry> heap; /**< The entries in heap order. */
+    std::vector<int> positions; /**< The position of the entry of each state in the heap or -1 if it is not queued. */
 
     /**
-     * The copy constructor copies all edges, but sets this node as their origin.
-     * The new node has not been reached by from an edge yet.
-     * @param other The other node that is copied.
+     * Place an entry in the heap and update the index.
+     * @param position The position in the heap.
+     * @param entry The entry.
      */
-    Node(const Node& other) : Node(other.center, other.radius)
-    {
-      FOREACH_ENUM(Rotation, rotation)
-        for(auto& edge : other.edges[rotation])
-        {
-          edges[rotation].emplace_back(this, edge.toNode, edge.fromAngle, edge.toPoint, edge.fromRotation, edge.toRotation, edge.length);
-          edges[rotation].back().pathLength = edge.pathLength;
-        }
-      blockedSectors = other.blockedSectors;
-      expanded = other.expanded;
-      originalRadius = other.originalRadius;
-    }
-  };
+    void place(int position, const Entry& entry);
 
-  /** A structure to manage the open edges during the A* search. */
-  struct Candidate
-  {
-    Edge* edge; /**< The corresponding edge. */
-    float estimatedPathLength; /**< The estimated path length including the heuristic. */
+    /**
+     * Move an entry towards the root of the heap until its parent is not worse.
+     * @param position The current position of the entry in the heap.
+     */
+    void moveUp(int position);
 
     /**
-     * Constructor.
-     * @param edge The corresponding edge.
-     * @param heuristic The estimated path length from the end of the edge to the target position.
+     * Move an entry towards the leaves of the heap until no child is better.
+     * @param position The current position of the entry in the heap.
      */
-    Candidate(Edge* edge, float heuristic)
-      : edge(edge), estimatedPathLength(edge->pathLength + heuristic) {}
+    void moveDown(int position);
 
+  public:
     /**
-     * Comparison operator for the heap that manages the open edges.
-     * @param other The other candidate that is compared with.
-     * @param Which one should be taken out of the heap later?
+     * Empty the list.
+     * @param numOfStates The number of states that will probably be used. More are supported.
      */
-    bool operator<(const Candidate& other) const
-    {
-      return estimatedPathLength > other.estimatedPathLength;
-    }
+    void clear(size_t numOfStates);
+
+    /** Is the list empty? */
+    bool empty() const {return heap.empty();}
+
+    /**
+     * Is a state currently queued?
+     * @param state The state.
+     * @return Is it queued?
+     */
+    bool contains(int state) const {return static_cast<size_t>(state) < positions.size() && positions[state] != -1;}
+
+    /**
+     * Queue an edge. If it is indexed by a state that is already queued, only the shorter edge is kept.
+     * @param state The state that is reached or -1 if the entry should not be indexed.
+     * @param edge The index of the edge.
+     * @param estimatedPathLength The estimated path length including the heuristic.
+     */
+    void push(int state, int edge, float estimatedPathLength);
+
+    /**
+     * Remove the edge with the shortest estimated path length from the list.
+     * @return The index of the edge.
+     */
+    int pop();
   };
 
   /** Barrier lines that cannot be crossed during planning. */
@@ -227,13 +268,47 @@ class PathPlannerProvider : public PathPlannerProviderBase
 
   using Tangents = std::array<std::vector<Tangent>, numOfRotations>;
 
+  /** The path planned last. It is reused as long as it stays valid. */
+  struct CachedPath
+  {
+    /** An edge of the path, described by the node it reaches and the rotations used. */
+    struct Step
+    {
+      Vector2f center; /**< The center of the node reached. */
+      float radius; /**< The radius of the node reached. */
+      Rotation fromRotation; /**< The rotation with which the previous node was surrounded. */
+      Rotation toRotation; /**< The rotation with which the node reached will be surrounded. */
+    };
+
+    bool valid = false; /**< Is there a cached path? */
+    Vector2f target; /**< The target of the path. */
+    bool excludeOwnPenaltyArea; /**< Was the own penalty area excluded when the path was planned? */
+    bool excludeOpponentPenaltyArea; /**< Was the opponent penalty area excluded when the path was planned? */
+    unsigned timestamp; /**< When was the path planned? */
+    float length; /**< The length of the path when it was planned (in mm). */
+    std::vector<Step> steps; /**< The edges of the path from the start to the target. */
+  };
+
   std::vector<Node> nodes; /**< All nodes of the visibility graph, i.e. all obstacles, and starting point (1st entry) and target (2nd entry). */
-  std::vector<Candidate> candidates; /**< All open edges during the A* search. */
+  std::vector<Edge> edges; /**< The outgoing edges of all nodes. The edges of a node are consecutive per rotation. */
+  std::vector<BlockedSector> blockedSectors; /**< The blocked sectors of all nodes. The sectors of a node form a linked list. */
+  OpenList openList; /**< The open states during the A* search. */
+  Tangents tangents; /**< The tangents of the node currently expanded. */
+  std::vector<Tangent*> tangentsByAngle; /**< The tangents sorted by their angle during the sweep. */
+  std::vector<Tangent*> sweepLine; /**< The tangents currently intersected by the sweep line. */
   std::vector<Barrier> barriers; /**< Barrier lines that cannot be crossed during planning. */
   std::vector<Geometry::Line> borders; /**< The border of the field plus a tolerance. */
   Rotation lastDir = cw; /**< Last direction selected when walking around first obstacle. */
   unsigned timeWhenLastPlayedSound = 0; /**< Used to limit frequency of sound playback. */
   bool pathPlannerWasActive = false; /**< Was the path planner active in previous frame? */
+  CachedPath cachedPath; /**< The path planned last. */
+  unsigned statisticsWindowStart = 0; /**< When did the current statistics window start? */
+  unsigned requests = 0; /**< The number of paths requested in the current statistics window. */
+  unsigned cacheHits = 0; /**< The number of requests answered with the cached path in the current statistics window. */
+  unsigned invalidations = 0; /**< The number of times the cached path was invalid in the current statistics window. */
+  float replanningTime = 0.f; /**< The summed duration of the requests that planned a new path in the current statistics window (in ms). */
+  float maxReplanningTime = 0.f; /**< The longest duration of a request that planned a new path in the current statistics window (in ms). */
+  float reuseTime = 0.f; /**< The summed duration of the requests answered with the cached path in the current statistics window (in ms). */
 
   /**
    * Provide a representation that is able to plan a path using this module.
@@ -241,6 +316,12 @@ class PathPlannerProvider : public PathPlannerProviderBase
    */
   void update(PathPlanner& pathPlanner) override;
 
+  /**
+   * Provide the statistics about the requests of the last statistics window.
+   * @param pathPlannerStatistics The representation that is provided.
+   */
+  void update(PathPlannerStatistics& pathPlannerStatistics) override;
+
   /**
    * Compute barrier lines that cannot be crossed during planning.
    * @param target The target the robot tries to reach.
@@ -280,28 +361,100 @@ class PathPlannerProvider : public PathPlannerProviderBase
    */
   void addObstacle(const Vector2f& center, float radius);
 
+  /**
+   * Add a blocked sector to a node.
+   * @param node The node.
+   * @param sector The sector that is blocked.
+   */
+  void addBlockedSector(Node& node, const BlockedSector& sector);
+
+  /**
+   * Append a copy of a node that has not been reached yet. It has copies of all edges
+   * of the original and shares the blocked sectors the original has so far.
+   * @param index The index of the node that is cloned.
+   * @return The index of the clone.
+   */
+  int cloneNode(int index);
+
   /**
    * Plan a shortest path. The result can be tracked backwards from the target node.
-   * @param from The starting node. It is implicitly assumed that this is also the first entry in the vector "nodes".
-   * @param to The target node.
+   * @param from The index of the starting node. It is implicitly assumed that this is 0.
+   * @param to The index of the target node.
    * @param speedRatio The ratio between forward speed and turn speed.
    */
-  void plan(Node& from, Node& to, float speedRatio);
+  void plan(int from, int to, float speedRatio);
+
+  /**
+   * Remember the path just planned in the cache.
+   * @param target The target of the path.
+   * @param excludeOwnPenaltyArea Was the own penalty area excluded?
+   * @param excludeOpponentPenaltyArea Was the opponent penalty area excluded?
+   */
+  void cachePath(const Pose2f& target, bool excludeOwnPenaltyArea, bool excludeOpponentPenaltyArea);
+
+  /**
+   * Try to reconstruct the cached path in the current graph instead of planning a new one.
+   * Its nodes are matched with the current ones, which get the sectors that are blocked by
+   * overlapping obstacles. Then all its edges are recomputed and checked against the
+   * current obstacles, barriers, and blocked sectors. If the path is
+   * still passable and did not become too long, the result can be tracked backwards from
+   * the target node as after planning. Otherwise, the graph is reset.
+   * @return Could the cached path be reused?
+   */
+  bool reusePath();
+
+  /**
+   * Append the edge between two nodes that surrounds them in certain rotations to the edges.
+   * Its length includes the costs of crossing barriers.
+   * @param from The index of the node from which the edge starts.
+   * @param to The index of the node at which the edge ends.
+   * @param fromRotation The rotation with which the node "from" is surrounded.
+   * @param toRotation The rotation with which the node "to" will be surrounded.
+   * @return Does the edge exist, i.e. the circles do not overlap and no barrier blocks it?
+   */
+  bool addEdge(int from, int to, Rotation fromRotation, Rotation toRotation);
+
+  /**
+   * Determine the length of the path that ends at the target node.
+   * @return The length including the costs of passing barriers and blocked sectors (in mm).
+   *         Infinity if the path passes a sector that cannot be passed or if there is no path.
+   */
+  float getPathLength() const;
+
+  /**
+   * Determine the costs of surrounding a node from an incoming to an outgoing edge.
+   * @param node The node that is surrounded.
+   * @param rotation The rotation with which the node is surrounded.
+   * @param incoming The edge through which the node is reached.
+   * @param outgoing The edge through which the node is left.
+   * @return The length of the arc plus the costs of the blocked sectors passed (in mm).
+   *         Infinity if a sector is passed that cannot be passed.
+   */
+  float getArcCosts(const Node& node, Rotation rotation, const Edge& incoming, const Edge& outgoing) const;
 
   /**
    * Expand a node during the A* search and add all suitable outgoing edges to the set of open edges.
-   * @param node The node that is expanded.
-   * @param to The overall target node. Required to calculate the heuristic.
+   * @param node The index of the node that is expanded.
+   * @param to The index of the overall target node. Required to calculate the heuristic.
    * @param rotation Only the outgoing edges with the same rotation are expanded.
    * @param speedRatio The ratio between forward speed and turn speed.
    */
-  void expand(Node& node, const Node& to, Rotation rotation, float speedRatio);
+  void expand(int node, int to, Rotation rotation, float speedRatio);
+
+  /**
+   * Add an edge to the open list. Edges to nodes that were already reached are only added
+   * if the node can still be cloned. If a node is queued and cannot be cloned, only the
+   * shorter edge is kept.
+   * @param edge The index of the edge.
+   * @param estimatedPathLength The path length until the end of the edge plus the heuristic.
+   */
+  void addCandidate(int edge, float estimatedPathLength);
 
   /**
    * Find all nodes reachable from this node without intersecting with other nodes, i.e. determine the outgoing edges.
-   * @param node The node the outgoing edges of which are determined.
+   * @param node The index of the node the outgoing edges of which are determined.
    */
-  void findNeighbors(Node& node);
+  void findNeighbors(int node);
 
   /**
    * Create all tangents from one node to all other nodes. The number of tangents created per other node depends
@@ -309,13 +462,13 @@ class PathPlannerProvider : public PathPlannerProviderBase
    * circles) and whether they overlap (none if one node is inside the other one, two if they intersect, four if two
    * circles do not overlap). If another circle overlaps, the angular range of the overlap is also marked as being
    * blocked in the node passed, i.e. no tangents can start from this ranges.
-   * @param node The node from which the tangents to all neighbors are created.
+   * @param node The index of the node from which the tangents to all neighbors are created.
    * @param tangents The tangents found are returned here. Must be empty when passed. There are two sets of tangents,
    *                 i.e. the ones that start in clockwise direction and the ones that start in counter clockwise
    *                 direction. In addition, some tangents might be marked as dummies, because they are copies of
    *                 tangents in the other direction, but are needed by the sweep line algorithm that is later used.
    */
-  void createTangents(Node& node, Tangents& tangents);
+  void createTangents(int node, Tangents& tangents);
 
   /**
    * Add all outgoing edges of a node to that node based on the tangents to all other nodes. Do not add edges that
@@ -323,17 +476,17 @@ class PathPlannerProvider : public PathPlannerProviderBase
    * tangents in ascending angular direction and keeps track of all nodes in the current direction ordered by their
    * distance. Only the tangents to the closest node in each direction are accepted as outgoing edges. The is done
    * separately for outgoing edges in clockwise and counterclockwise directions.
-   * @param node The starting node of the edges that are created.
+   * @param node The index of the starting node of the edges that are created.
    * @param tangents The tangents as produced by the method "createTangents".
    */
-  void addNeighborsFromTangents(Node& node, Tangents& tangents);
+  void addNeighborsFromTangents(int node, Tangents& tangents);
 
   /**
    * Calculate an avoidance vector in order to avoid close obstacles.
-   * @param nextNode The next node on the path.
+   * @param nextNode The index of the next node on the path.
    * @return A vector pointing in a direction away from obstacles.
    */
-  Vector2f calcAvoidanceVector(const Node* nextNode) const;
+  Vector2f calcAvoidanceVector(int nextNode) const;
 
   /** Some visualizations. */
   void draw() const;
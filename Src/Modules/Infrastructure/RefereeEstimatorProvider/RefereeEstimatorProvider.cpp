@@ -9,80 +9,46 @@
 #include "Platform/File.h"
 #include "Tools/Debugging/Debugging.h"
 #include "Tools/Debugging/DebugDrawings.h"
+#include "Tools/Debugging/Stopwatch.h"
+#include "Tools/ImageProcessing/Resize.h"
 #include "Representations/Infrastructure/RefereeEstimator.h"
 
 #include "Eigen/Dense"
 
 #include <math.h>
 #include <iomanip>
-#include "Tools/OnnxHelper/OnnxHelper.h"
 
 RefereeEstimatorProvider::RefereeEstimatorProvider()
 {
   std::string movenetFilename = std::string(File::getBHDir()) + "/Config/NeuralNets/RefereeEstimator/movenet_singlepose_lightning_4.onnx";
   std::string classifierFilename = std::string(File::getBHDir()) + "/Config/NeuralNets/RefereeEstimator/classifier.onnx";
 
-  movenet = new OnnxHelper<int, float>(movenetFilename);
-  classifier = new OnnxHelper<float, float>(classifierFilename);
+  movenet = InferenceModel::load(movenetFilename);
+  classifier = InferenceModel::load(classifierFilename);
 }
 
 void RefereeEstimatorProvider::update(RefereeEstimator& estimator)
 {
   DECLARE_DEBUG_DRAWING("representation:Referee:image", "drawingOnImage");
-  if (theGameInfo.state != STATE_STANDBY){
+  if (theGameInfo.state != STATE_STANDBY || !movenet || !classifier){
     estimator.isDetected = false;
     return;
   }
 
-  cv::Mat outputImage(theCameraImage.height, theCameraImage.width, CV_8UC3);
-  std::string text = "";
-  for (int x = 0; x < theCameraImage.width; ++x){
-    for (int y = 0; y < theCameraImage.height; ++y){
-      auto& px = theCameraImage[Vector2i(x,y)];
-      std::vector<uchar> rgb_px = px.rgb();
-      outputImage.at<cv::Vec3b>(y, x) = cv::Vec3b(rgb_px[2], rgb_px[1], rgb_px[0]);
-    }
-  }
-
   int crop_width = theCameraImage.width/4;
   int crop_height = theCameraImage.height/2;
-  cv::Rect ROI((theCameraImage.width - crop_width)/2, theCameraImage.height/2 - 30, crop_width, crop_height); // x, y, width, height
-  cv::Mat croppedImage = outputImage(ROI);
+  cv::Rect ROI((theCameraImage.width - crop_width)/2, theCameraImage.height/2 - 30, crop_width, crop_height); // x, y, width, height (in YUYV pixels)
 
   RECTANGLE("representation:Referee:image", ROI.x*2, ROI.y, ROI.x*2+ROI.width*2, ROI.y+ROI.height, 3, Drawings::solidPen, ColorRGBA::black);
 
-  cv::Mat resizedImage;
-  int resized_width;
-  int resized_height;
-  if (crop_width*2 > crop_height)
-  {
-    resized_width = input_size;
-    resized_height = input_size*ROI.height/(ROI.width*2);
-  }
-  else
-  {
-    resized_height = input_size;
-    resized_width = input_size*(ROI.width*2)/ROI.height;
-  }
-
-  cv::resize(croppedImage, resizedImage, cv::Size(resized_width, resized_height));
-
-  cv::Mat paddedImage;
-  int top = crop_width*2 > crop_height ? (resized_width - resized_height) / 2 : 0; // (192 - 144) / 2
-  int bottom = top;
-  int left = crop_width*2 <= crop_height ? (resized_height - resized_width) / 2 : 0;
-  int right = left;
-
-  if (resized_width + 2*left == input_size-1)
-    left++;
-  if (resized_height + 2*bottom == input_size-1)
-    bottom++;
-
-  cv::copyMakeBorder(resizedImage, paddedImage, top, bottom, left, right, cv::BorderTypes::BORDER_CONSTANT, 0);
-  paddedImage.convertTo(paddedImage, CV_32SC3);
+  // Only the ROI is converted, directly into the letterboxed input of the network.
+  STOPWATCH("module:RefereeEstimatorProvider:letterbox")
+    Resize::letterboxRGB(theCameraImage, ROI.x*2, ROI.y, ROI.width*2, ROI.height, input_size, movenet->input<int>());
+  STOPWATCH("module:RefereeEstimatorProvider:movenet")
+    movenet->infer();
 
   std::array<float, 51> movenetOutput;
-  movenet->infer(paddedImage.data, movenetOutput.data());
+  std::copy(movenet->output(), movenet->output() + movenetOutput.size(), movenetOutput.begin());
 
   drawKeypoints(ROI, movenetOutput);
 
@@ -95,10 +61,10 @@ void RefereeEstimatorProvider::update(RefereeEstimator& estimator)
     return;
   }
 
-  std::array<float, 1> classifierOutput;
-  classifier->infer(classifierInput.data(), classifierOutput.data());
+  std::copy(classifierInput.begin(), classifierInput.end(), classifier->input<float>());
+  classifier->infer();
 
-  if (movenetOutput[lefthandy] < movenetOutput[leftshouldery] && movenetOutput[righthandy] < movenetOutput[rightshouldery] && classifierOutput[0] > classifier_threshold){
+  if (movenetOutput[lefthandy] < movenetOutput[leftshouldery] && movenetOutput[righthandy] < movenetOutput[rightshouldery] && classifier->output()[0] > classifier_threshold){
     estimator.measures <<= 1;
     estimator.measures |= 0x1;
     DRAW_TEXT("representation:Referee:image", 0, 50, 50, ColorRGBA::green, "Ready " + std::to_string(estimator.measures));
@@ -16,11 +16,8 @@
 #include "Representations/Communication/GameInfo.h"
 #include "Representations/Infrastructure/FrameInfo.h"
 #include <opencv2/core/core.hpp>
-#include <opencv2/highgui/highgui.hpp>
-#include <opencv2/imgproc/imgproc.hpp>
 
-#include <onnxruntime_cxx_api.h>
-#include "Tools/OnnxHelper/OnnxHelper.h"
+#include "Tools/Inference/InferenceModel.h"
 
 MODULE(RefereeEstimatorProvider,
 {,
@@ -33,9 +30,9 @@ MODULE(RefereeEstimatorProvider,
 
 class RefereeEstimatorProvider : public RefereeEstimatorProviderBase{
   const static int input_size = 192;
-  OnnxHelper<int, float> *movenet;
+  std::unique_ptr<InferenceModel> movenet;
 
-  OnnxHelper<float, float> *classifier;
+  std::unique_ptr<InferenceModel> classifier;
 
   public:
     RefereeEstimatorProvider();
@@ -92,8 +92,13 @@ void WhistleDetector::detect_whistle(Whistle& whistle) {
       compute_fft(); 
       overtone_detection(); 
       
-      whistleNet->infer(input.data(), output.data());
-      nnConfidence = output[0];
+      if (whistleNet) {
+        std::copy(input.begin(), input.end(), whistleNet->input<float>());
+        whistleNet->infer();
+        nnConfidence = whistleNet->output()[0];
+      } else {
+        nnConfidence = 0.f;
+      }
 
       //Merge NN, PM and limit information
       float confidence = ((nnWeight * nnConfidence + pmWeight * pmConfidence) / (nnWeight + pmWeight)) * (1 - (limitWeight * relLimitCount));
@@ -272,7 +277,7 @@ void WhistleDetector::setup() {
   std::string filename = std::string(File::getBHDir()) + whistleNetPath;
   oldWhistleNetPath = whistleNetPath;
 
-  whistleNet = new OnnxHelper<float, float>(filename);
+  whistleNet = InferenceModel::load(filename);
 
   // Setup buffers for pre- and post-processing
   int input_size = 513;
@@ -13,9 +13,8 @@
 #include "Platform/SystemCall.h"
 #include <string>
 #include "Tools/Math/Constants.h"
-#include "Tools/OnnxHelper/OnnxHelper.h"
+#include "Tools/Inference/InferenceModel.h"
 #include "Tools/RingBufferWithSum.h"
-#include <onnxruntime_cxx_api.h>
 
 
 MODULE(WhistleDetector,
@@ -55,8 +54,7 @@ class WhistleDetector : public WhistleDetectorBase {
 
   // onnx stuff
   std::array<float, 513> input{};
-  std::array<float, 1> output{};
-  OnnxHelper<float, float> *whistleNet;
+  std::unique_ptr<InferenceModel> whistleNet;
 
   //physical model detection variables
   int windowSize = 0;
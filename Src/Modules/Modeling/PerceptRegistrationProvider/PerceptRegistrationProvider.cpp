@@ -65,6 +65,7 @@ PerceptRegistrationProvider::PerceptRegistrationProvider()
 
 void PerceptRegistrationProvider::update(PerceptRegistration& perceptRegistration)
 {
+  updateFieldModelIndex();
   preprocessMeasurements(perceptRegistration);
   perceptRegistration.registerAbsolutePoseMeasurements = [this, &perceptRegistration](const Pose2f& pose, std::vector<RegisteredAbsolutePoseMeasurement>& absolutePoseMeasurements) -> void
   {
@@ -90,6 +91,40 @@ void PerceptRegistrationProvider::update(PerceptRegistration& perceptRegistratio
   };
 }
 
+void PerceptRegistrationProvider::updateFieldModelIndex()
+{
+  if(indexedLineAssociationCorridor == lineAssociationCorridor && indexedMaxIntersectionDeviation == maxIntersectionDeviation &&
+     indexedCellSize == fieldModelIndexCellSize)
+    return;
+  indexedLineAssociationCorridor = lineAssociationCorridor;
+  indexedMaxIntersectionDeviation = maxIntersectionDeviation;
+  indexedCellSize = fieldModelIndexCellSize;
+
+  // A point can only be associated with a line, if it is inside the bounding box of the line widened by the corridor.
+  const Vector2f corridor(lineAssociationCorridor, lineAssociationCorridor);
+  for(auto [index, lines] : {std::make_pair(&verticalLinesIndex, &verticalLinesWorldModel), std::make_pair(&horizontalLinesIndex, &horizontalLinesWorldModel)})
+  {
+    index->clear(fieldModelIndexCellSize);
+    for(std::size_t i = 0; i < lines->size(); ++i)
+    {
+      const WorldModelFieldLine& line = (*lines)[i];
+      index->add(static_cast<int>(i), line.start.cwiseMin(line.end) - corridor, line.start.cwiseMax(line.end) + corridor);
+    }
+    index->build();
+  }
+
+  // An intersection can only be associated with a point inside the square around it that contains the circle of the maximum deviation.
+  const Vector2f deviation(maxIntersectionDeviation, maxIntersectionDeviation);
+  FOREACH_ENUM(FieldDimensions::CornerClass, cornerClass)
+  {
+    cornersIndex[cornerClass].clear(fieldModelIndexCellSize);
+    const std::vector<Vector2f>& corners = theFieldDimensions.corners[cornerClass];
+    for(std::size_t i = 0; i < corners.size(); ++i)
+      cornersIndex[cornerClass].add(static_cast<int>(i), corners[i] - deviation, corners[i] + deviation);
+    cornersIndex[cornerClass].build();
+  }
+}
+
 void PerceptRegistrationProvider::preprocessMeasurements(PerceptRegistration& perceptRegistration)
 {
   // Reset counters:
@@ -349,20 +384,20 @@ bool PerceptRegistrationProvider::getCorrespondingGoalPost(const Pose2f& pose, c
 
 bool PerceptRegistrationProvider::getCorrespondingIntersection(const Pose2f& pose, const FieldLineIntersections::Intersection& intersectionPercept, Vector2f& intersectionWorldModel) const
 {
-  const std::vector< Vector2f >* intersectionList = 0;
+  FieldDimensions::CornerClass cornerClass = FieldDimensions::numOfCornerClasss;
   if(intersectionPercept.type == FieldLineIntersections::Intersection::X)
   {
-    intersectionList = &theFieldDimensions.corners[FieldDimensions::xCorner];
+    cornerClass = FieldDimensions::xCorner;
   }
   else if(intersectionPercept.type == FieldLineIntersections::Intersection::T)
   {
     int section = intersectionDirectionTo90DegreeSection(pose, intersectionPercept.dir1);
     switch(section)
     {
-      case 0:   intersectionList = &theFieldDimensions.corners[FieldDimensions::tCorner0];   break;
-      case 90:  intersectionList = &theFieldDimensions.corners[FieldDimensions::tCorner90];  break;
-      case 180: intersectionList = &theFieldDimensions.corners[FieldDimensions::tCorner180]; break;
-      default:  intersectionList = &theFieldDimensions.corners[FieldDimensions::tCorner270]; break;
+      case 0:   cornerClass = FieldDimensions::tCorner0;   break;
+      case 90:  cornerClass = FieldDimensions::tCorner90;  break;
+      case 180: cornerClass = FieldDimensions::tCorner180; break;
+      default:  cornerClass = FieldDimensions::tCorner270; break;
     }
   }
   else if(intersectionPercept.type == FieldLineIntersections::Intersection::L)
@@ -370,36 +405,33 @@ bool PerceptRegistrationProvider::getCorrespondingIntersection(const Pose2f& pos
     int section = intersectionDirectionTo90DegreeSection(pose, intersectionPercept.dir1);
     switch(section)
     {
-      case 0:   intersectionList = &theFieldDimensions.corners[FieldDimensions::lCorner0];   break;
-      case 90:  intersectionList = &theFieldDimensions.corners[FieldDimensions::lCorner90];  break;
-      case 180: intersectionList = &theFieldDimensions.corners[FieldDimensions::lCorner180]; break;
-      default:  intersectionList = &theFieldDimensions.corners[FieldDimensions::lCorner270]; break;
+      case 0:   cornerClass = FieldDimensions::lCorner0;   break;
+      case 90:  cornerClass = FieldDimensions::lCorner90;  break;
+      case 180: cornerClass = FieldDimensions::lCorner180; break;
+      default:  cornerClass = FieldDimensions::lCorner270; break;
     }
   }
-  if(intersectionList != 0)
+  if(cornerClass != FieldDimensions::numOfCornerClasss)
   {
-    // Check for empty list. This might happen for special configurations of demo fields.
-    if(intersectionList->size() == 0)
-      return false;
-    // Initialize variables to store the real world intersection that is closest to the percept:
+    // Only the intersections near the percept can be close enough. Empty lists might happen for special configurations of demo fields.
     const Vector2f perceptWorld = pose * intersectionPercept.pos;
-    Vector2f closestIntersectionWorld = intersectionList->at(0);
-    float sqrDistanceToClosestIntersectionWorld = (perceptWorld - closestIntersectionWorld).squaredNorm();
-    // Iterate over list to find the closest intersection:
-    for(unsigned int i = 1; i < intersectionList->size(); ++i)
+    const std::vector<Vector2f>& intersectionList = theFieldDimensions.corners[cornerClass];
+    const Vector2f* closestIntersectionWorld = nullptr;
+    float sqrDistanceToClosestIntersectionWorld = maxIntersectionDeviation * maxIntersectionDeviation;
+    // Iterate over the candidates to find the closest intersection that is close enough:
+    for(int i : cornersIndex[cornerClass].query(perceptWorld))
     {
-      const Vector2f& intersection = intersectionList->at(i);
+      const Vector2f& intersection = intersectionList[i];
       const float sqrDistance = (perceptWorld - intersection).squaredNorm();
       if(sqrDistance < sqrDistanceToClosestIntersectionWorld)
       {
         sqrDistanceToClosestIntersectionWorld = sqrDistance;
-        closestIntersectionWorld = intersection;
+        closestIntersectionWorld = &intersection;
       }
     }
-    // Check, if closest intersection is close enough:
-    if(sqrDistanceToClosestIntersectionWorld < maxIntersectionDeviation * maxIntersectionDeviation)
+    if(closestIntersectionWorld)
     {
-      intersectionWorldModel = closestIntersectionWorld;
+      intersectionWorldModel = *closestIntersectionWorld;
       return true;
     }
   }
@@ -440,9 +472,10 @@ PerceptRegistrationProvider::getPointerToCorrespondingLineInWorldModel(const Pos
     return nullptr;
   }
   isPartOfCenterCircle = false;
-  // If this point is reached, the line is matched against the "normal" field lines:
+  // If this point is reached, the line is matched against the "normal" field lines
+  // whose corridors contain the start of the perceived line:
   const std::vector<WorldModelFieldLine>& worldModelLines = isVertical ? verticalLinesWorldModel : horizontalLinesWorldModel;
-  for(unsigned int i = 0; i < worldModelLines.size(); ++i)
+  for(int i : (isVertical ? verticalLinesIndex : horizontalLinesIndex).query(startOnField))
   {
     const WorldModelFieldLine& worldModelLine = worldModelLines[i];
     // A perceived line cannot be longer than the original line:
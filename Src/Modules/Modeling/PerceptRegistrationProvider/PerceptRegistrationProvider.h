@@ -24,6 +24,7 @@
 #include "Representations/Perception/FieldFeatures/PenaltyMarkWithPenaltyAreaLine.h"
 #include "Representations/Perception/GoalPercepts/GoalPostsPercept.h"
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Tools/Math/SpatialGrid.h"
 #include "Tools/Module/Module.h"
 
 MODULE(PerceptRegistrationProvider,
@@ -47,6 +48,7 @@ MODULE(PerceptRegistrationProvider,
     (float) maxPenaltyMarkDeviation,                  /**< The maximum distance (in mm) between model and perception for registering a penalty mark percept */
     (float) maxIntersectionDeviation,                 /**< The maximum distance (in mm) between model and perception for registering a field line intersection */
     (float) lineAssociationCorridor,                  /**< Maximum distance between points on a perceived line and a line in the world model */
+    (float) fieldModelIndexCellSize,                  /**< The cell size (in mm) of the grids that find the lines and intersections of the field model near a point */
     (float) globalPoseAssociationMaxDistanceDeviation,/**< Distance threshold (metric) for associating a computed pose (by field feature) and the currently estimated pose */
     (Angle) globalPoseAssociationMaxAngularDeviation, /**< Angular threshold for associating a computed pose (by field feature) and the currently estimated pose */
     (Vector2f) robotRotationDeviation,                /**< Deviation of the rotation of the robot's torso */
@@ -108,6 +110,12 @@ private:
   Vector2f opponentGoalPostsWorldModel[2];                    /**< The positions of the two posts of the opponent goal. */
   std::vector<WorldModelFieldLine> verticalLinesWorldModel;   /**< Field lines to match against, lines in this list are parallel to the field's x axis */
   std::vector<WorldModelFieldLine> horizontalLinesWorldModel; /**< Field lines to match against, lines in this list are parallel to the field's y axis */
+  SpatialGrid verticalLinesIndex;                             /**< Finds the vertical lines that might be associated with a point */
+  SpatialGrid horizontalLinesIndex;                           /**< Finds the horizontal lines that might be associated with a point */
+  SpatialGrid cornersIndex[FieldDimensions::numOfCornerClasses]; /**< Finds the intersections of each class that might be associated with a point */
+  float indexedLineAssociationCorridor = -1.f;                /**< The lineAssociationCorridor the line indices were built for */
+  float indexedMaxIntersectionDeviation = -1.f;               /**< The maxIntersectionDeviation the intersection indices were built for */
+  float indexedCellSize = -1.f;                               /**< The fieldModelIndexCellSize the indices were built for */
 
   Matrix2f penaltyMarkCovariance;                             /**< Covariance of last penalty mark perception (saved, as it is needed multiple times in one frame)*/
   unsigned int timeOfLastPenaltyMarkCovarianceUpdate;         /**< Timestamp of frame in which the penalty mark covariance was computed the last time*/
@@ -130,6 +138,12 @@ private:
    */
   void update(PerceptRegistration& perceptRegistration);
 
+  /**
+   * (Re)builds the grids that find the lines and intersections of the field model
+   * near a point, if the parameters they depend on have changed.
+   */
+  void updateFieldModelIndex();
+
   /**
    * Makes some checks and precomputes values that are the same for
    * all later calls (within one frame) of the registration functions.
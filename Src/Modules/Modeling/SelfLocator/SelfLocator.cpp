@@ -22,14 +22,11 @@ SelfLocator::SelfLocator() : lastTimeFarFieldBorderSeen(0), lastTimeJumpSound(0)
   validitiesHaveBeenUpdated(false)
 {
   // Create sample set with samples at the typical walk-in positions
-  samples = new SampleSet<UKFRobotPoseHypothesis>(numberOfSamples);
-  for(int i = 0; i < samples->size(); ++i)
-    samples->at(i).init(getNewPoseAtWalkInPosition(), walkInPoseDeviation, nextSampleNumber++, 0.5f);
-}
-
-SelfLocator::~SelfLocator()
-{
-  delete samples;
+  samples.resize(numberOfSamples);
+  oldSamples.resize(numberOfSamples);
+  odometryOffsets.resize(numberOfSamples);
+  for(int i = 0; i < samples.size(); ++i)
+    samples.init(i, getNewPoseAtWalkInPosition(), walkInPoseDeviation, nextSampleNumber++, 0.5f);
 }
 
 void SelfLocator::update(RobotPose& robotPose)
@@ -97,10 +94,10 @@ void SelfLocator::update(RobotPose& robotPose)
   float minWeighting = 2.f;
   float maxWeighting = -1.f;
   float weightingSum = 0.f;
+  samples.computeWeightingsBasedOnValidity(baseValidityWeighting);
   for(int i = 0; i < numberOfSamples; ++i)
   {
-    samples->at(i).computeWeightingBasedOnValidity(baseValidityWeighting);
-    const float w = samples->at(i).weighting;
+    const float w = samples.weightings[i];
     weightingSum += w;
     if(w > maxWeighting)
       maxWeighting = w;
@@ -156,12 +153,10 @@ void SelfLocator::update(RobotPose& robotPose)
     {
       for(int i = 0; i < numberOfSamples; ++i)
       {
-        UKFRobotPoseHypothesis newSample;
         if(theSideInformation.robotMustBeInOwnHalf)
-          newSample.init(getNewPoseBasedOnObservations(true, theWorldModelPrediction.robotPose), defaultPoseDeviation, nextSampleNumber++, 0.5f);
+          samples.init(i, getNewPoseBasedOnObservations(true, theWorldModelPrediction.robotPose), defaultPoseDeviation, nextSampleNumber++, 0.5f);
         else
-          newSample.init(getNewPoseBasedOnObservations(false, theWorldModelPrediction.robotPose), defaultPoseDeviation, nextSampleNumber++, 0.5f);
-        samples->at(i) = newSample;
+          samples.init(i, getNewPoseBasedOnObservations(false, theWorldModelPrediction.robotPose), defaultPoseDeviation, nextSampleNumber++, 0.5f);
       }
     }
   }
@@ -193,9 +188,9 @@ void SelfLocator::update(SelfLocalizationHypotheses& selfLocalizationHypotheses)
   for(int i = 0; i < numberOfSamples; ++i)
   {
     SelfLocalizationHypotheses::Hypothesis& h = selfLocalizationHypotheses.hypotheses[i];
-    h.pose = samples->at(i).getPose();
-    h.validity = samples->at(i).validity;
-    Matrix3f cov = samples->at(i).getCov();
+    h.pose = samples.getPose(i);
+    h.validity = samples.validities[i];
+    Matrix3f cov = samples.getCov(i);
     h.xVariance = cov(0, 0);
     h.yVariance = cov(1, 1);
     h.xyCovariance = cov(1, 0);
@@ -205,21 +200,21 @@ void SelfLocator::update(SelfLocalizationHypotheses& selfLocalizationHypotheses)
 
 void SelfLocator::computeModel(RobotPose& robotPose)
 {
-  UKFRobotPoseHypothesis& bestSample = getMostValidSample();
-  Pose2f resultPose = bestSample.getPose();
+  const int bestSample = getMostValidSample();
+  Pose2f resultPose = samples.getPose(bestSample);
   // Override side information for testing in the opponent half of a field only
   if(theSideInformation.robotMustBeInOpponentHalf && resultPose.translation.x() < 0) // TL: This appears a bit too simple. TODO: Make better.
   {
     resultPose = Pose2f(pi) + resultPose;
   }
   robotPose = resultPose;
-  Matrix3f cov = bestSample.getCov();
+  Matrix3f cov = samples.getCov(bestSample);
   robotPose.covariance = cov;
   if(theSideInformation.mirror)
     robotPose.timestampLastJump = theFrameInfo.time;
-  idOfLastBestSample = bestSample.id;
+  idOfLastBestSample = samples.ids[bestSample];
   // Finally, set the quality information:
-  float validityOfBestHypothesis = bestSample.validity;
+  float validityOfBestHypothesis = samples.validities[bestSample];
   setLocalizationQuality(robotPose, validityOfBestHypothesis);
 }
 
@@ -255,7 +250,7 @@ bool SelfLocator::sampleSetIsUnimodal(const RobotPose& robotPose)
   const float sqrMaxDistanceDeviation = maxDistanceDeviation * maxDistanceDeviation;
   for(int i = 0; i < numberOfSamples; ++i)
   {
-    const Pose2f& p = samples->at(i).getPose();
+    const Pose2f p = samples.getPose(i);
     if((robotPose.translation - p.translation).squaredNorm() > sqrMaxDistanceDeviation)
       return false;
     if(robotPoseRotation.diffAbs(Angle(p.rotation)) > maxRotationDeviation)
@@ -292,9 +287,9 @@ void SelfLocator::motionUpdate()
     const Vector2f transOffset((transX - transXError) + (2 * transXError) * Random::uniform(),
                                (transY - transYError) + (2 * transYError) * Random::uniform());
     const float rotationOffset = odometryRotation + Random::uniform(-rotError, rotError);
-
-    samples->at(i).motionUpdate(Pose2f(rotationOffset, transOffset), filterProcessDeviation, odometryDeviation, odometryRotationDeviation);
+    odometryOffsets[i] = Pose2f(rotationOffset, transOffset);
   }
+  samples.motionUpdate(odometryOffsets, filterProcessDeviation, odometryDeviation, odometryRotationDeviation);
 }
 
 void SelfLocator::sensorUpdate()
@@ -316,16 +311,18 @@ void SelfLocator::sensorUpdate()
   std::vector<RegisteredAbsolutePoseMeasurement> absolutePoseMeasurements;
   std::vector<RegisteredLandmark> landmarks;
   std::vector<RegisteredLine> lines;
+  UKFRobotPoseHypothesis sample;
   for(int i = 0; i < numberOfSamples; ++i)
   {
     float numerator = 0.f;
     float denominator = 0.f;
-    const Pose2f samplePose = samples->at(i).getPose();
+    samples.get(i, sample);
+    const Pose2f samplePose = sample.getPose();
     if(usePoses && thePerceptRegistration.totalNumberOfAvailableAbsolutePoseMeasurements > 0)
     {
       thePerceptRegistration.registerAbsolutePoseMeasurements(samplePose, absolutePoseMeasurements);
       for(const auto& pose : absolutePoseMeasurements)
-        samples->at(i).updateByPose(pose, theCameraMatrix, inverseCameraMatrix, currentRotationDeviation, theFieldDimensions);
+        sample.updateByPose(pose, theCameraMatrix, inverseCameraMatrix, currentRotationDeviation, theFieldDimensions);
       numerator += validityFactorPoseMeasurement * (static_cast<float>(absolutePoseMeasurements.size()) / thePerceptRegistration.totalNumberOfAvailableAbsolutePoseMeasurements);
       denominator += validityFactorPoseMeasurement;
     }
@@ -333,7 +330,7 @@ void SelfLocator::sensorUpdate()
     {
       thePerceptRegistration.registerLandmarks(samplePose, landmarks);
       for(const auto& landmark : landmarks)
-        samples->at(i).updateByLandmark(landmark);
+        sample.updateByLandmark(landmark);
       numerator += validityFactorLandmarkMeasurement * (static_cast<float>(landmarks.size()) / thePerceptRegistration.totalNumberOfAvailableLandmarks);
       denominator += validityFactorLandmarkMeasurement;
     }
@@ -343,9 +340,9 @@ void SelfLocator::sensorUpdate()
       for(const auto& line : lines)
       {
         if(line.partOfCenterCircle) // This is not a classic line and is thus treated as a different kind of measurement
-          samples->at(i).updateByLineOnCenterCircle(line, theFieldDimensions.centerCircleRadius);
+          sample.updateByLineOnCenterCircle(line, theFieldDimensions.centerCircleRadius);
         else // Normal line
-          samples->at(i).updateByLine(line);
+          sample.updateByLine(line);
       }
       if(considerLinesForValidityComputation)
       {
@@ -357,11 +354,12 @@ void SelfLocator::sensorUpdate()
         }
       }
     }
+    samples.set(i, sample);
     // Update validities, if any features have been observed (no matter, if they have actually been used):
     if(denominator != 0.f)
     {
       const float currentValidity = numerator / denominator;
-      samples->at(i).updateValidity(numberOfConsideredFramesForValidity, currentValidity);
+      samples.updateValidity(i, numberOfConsideredFramesForValidity, currentValidity);
       validitiesHaveBeenUpdated = true;
     }
   }
@@ -371,17 +369,17 @@ void SelfLocator::sensorUpdate()
   {
     for(int i = 0; i < numberOfSamples; ++i)
     {
-      if(samples->at(i).getPose().translation.x() > theSideInformation.largestXCoordinatePossible)
-        samples->at(i).invalidate();
+      if(samples.getPose(i).translation.x() > theSideInformation.largestXCoordinatePossible)
+        samples.invalidate(i);
     }
   }
 
   // Check, if sample is still on the carpet
   for(int i = 0; i < numberOfSamples; ++i)
   {
-    const Vector2f& position = samples->at(i).getPose().translation;
+    const Vector2f position = samples.getPose(i).translation;
     if(!theFieldDimensions.isInsideCarpet(position))
-      samples->at(i).invalidate();
+      samples.invalidate(i);
   }
 }
 
@@ -433,21 +431,19 @@ bool SelfLocator::sensorResetting(const RobotPose& robotPose)
     // Resetting seems to be required:
     float resettingValidity = max(0.5f, averageWeighting); // TODO: Recompute?
     int worstSampleIdx = 0;
-    float worstSampleValidity = samples->at(0).validity;
+    float worstSampleValidity = samples.validities[0];
     for(int i = 1; i < numberOfSamples; ++i)
     {
-      if(samples->at(i).validity < worstSampleValidity)
+      if(samples.validities[i] < worstSampleValidity)
       {
         worstSampleIdx = i;
-        worstSampleValidity = samples->at(i).validity;
+        worstSampleValidity = samples.validities[i];
       }
     }
-    UKFRobotPoseHypothesis newSample;
     if(theSideInformation.robotMustBeInOwnHalf)
-      newSample.init(getNewPoseBasedOnObservations(true, theWorldModelPrediction.robotPose), defaultPoseDeviation, nextSampleNumber++, resettingValidity);
+      samples.init(worstSampleIdx, getNewPoseBasedOnObservations(true, theWorldModelPrediction.robotPose), defaultPoseDeviation, nextSampleNumber++, resettingValidity);
     else
-      newSample.init(getNewPoseBasedOnObservations(false, theWorldModelPrediction.robotPose), defaultPoseDeviation, nextSampleNumber++, resettingValidity);
-    samples->at(worstSampleIdx) = newSample;
+      samples.init(worstSampleIdx, getNewPoseBasedOnObservations(false, theWorldModelPrediction.robotPose), defaultPoseDeviation, nextSampleNumber++, resettingValidity);
     lastAlternativePoseTimestamp = theAlternativeRobotPoseHypothesis.timeOfLastPerceptionUpdate;
     return true;
   }
@@ -468,7 +464,7 @@ void SelfLocator::resampling()
   if(averageWeighting == 0.f)
     return;
   // actual resampling step:
-  UKFRobotPoseHypothesis* oldSet = samples->swap();
+  std::swap(samples, oldSamples);
   const float weightingBetweenTwoDrawnSamples = averageWeighting;
   float nextPos(Random::uniform() * weightingBetweenTwoDrawnSamples);
   float currentSum(0);
@@ -478,14 +474,14 @@ void SelfLocator::resampling()
   int j(0);
   for(int i = 0; i < numberOfSamples; ++i)
   {
-    currentSum += oldSet[i].weighting;
+    currentSum += oldSamples.weightings[i];
     int replicationCount(0);
     while(currentSum > nextPos && j < numberOfSamples)
     {
-      samples->at(j) = oldSet[i];
+      samples.copy(j, oldSamples, i);
       if(replicationCount) // An old sample becomes copied multiple times: we need new identifier for the new instances
       {
-        samples->at(j).id = nextSampleNumber++;
+        samples.ids[j] = nextSampleNumber++;
         replacements++;
       }
       replicationCount++;
@@ -500,13 +496,13 @@ void SelfLocator::resampling()
     if(theAlternativeRobotPoseHypothesis.isValid) // Try to use the currently best available alternative
     {
       const Pose2f pose = getNewPoseBasedOnObservations(false, theWorldModelPrediction.robotPose);
-      samples->at(j).init(pose, defaultPoseDeviation, nextSampleNumber++, averageWeighting);
+      samples.init(j, pose, defaultPoseDeviation, nextSampleNumber++, averageWeighting);
       ANNOTATION("SelfLocator", "Missing sample was replaced by alternative hypothesis! Current number of samples: " << j);
     }
     else if(j > 0) // if no alternative is available, just use the first sample
     {
-      const Pose2f pose = samples->at(0).getPose();
-      samples->at(j).init(pose, defaultPoseDeviation, nextSampleNumber++, averageWeighting);
+      const Pose2f pose = samples.getPose(0);
+      samples.init(j, pose, defaultPoseDeviation, nextSampleNumber++, averageWeighting);
       ANNOTATION("SelfLocator", "Missing sample was replaced by sample #0! Current number of samples: " << j);
     }
     else
@@ -525,7 +521,7 @@ void SelfLocator::handleSideInformation()
     return;
   for(int i = 0; i < numberOfSamples; ++i)
   {
-    samples->at(i).mirror();
+    samples.mirror(i);
   }
   ANNOTATION("SelfLocator", "Mirrrrrrooaaaarred!");
 }
@@ -538,17 +534,17 @@ void SelfLocator::handleGameStateChanges()
     if((theExtendedGameInfo.gameStateLastFrame != STATE_PLAYING && theGameInfo.state == STATE_PLAYING) ||
        (theExtendedGameInfo.penaltyLastFrame != PENALTY_NONE && theRobotInfo.penalty == PENALTY_NONE))
     {
-      for(int i = 0; i < samples->size(); ++i)
-        samples->at(i).init(getNewPoseAtPenaltyShootoutPosition(), penaltyShootoutPoseDeviation, nextSampleNumber++, 1.f);
+      for(int i = 0; i < samples.size(); ++i)
+        samples.init(i, getNewPoseAtPenaltyShootoutPosition(), penaltyShootoutPoseDeviation, nextSampleNumber++, 1.f);
       sampleSetHasBeenReset = true;
     }
   }
   // If the robot has been lifted during SET, reset samples to manual positioning line positions
   else if(theExtendedGameInfo.manuallyPlaced && theGameInfo.state == STATE_SET)
   {
-    for(int i = 0; i < samples->size(); ++i)
+    for(int i = 0; i < samples.size(); ++i)
     {
-      samples->at(i).init(getNewPoseAtManualPlacementPosition(), manualPlacementPoseDeviation, nextSampleNumber++, 0.5f);
+      samples.init(i, getNewPoseAtManualPlacementPosition(), manualPlacementPoseDeviation, nextSampleNumber++, 0.5f);
     }
     sampleSetHasBeenReset = true;
     timeOfLastReturnFromPenalty = theFrameInfo.time;
@@ -556,13 +552,13 @@ void SelfLocator::handleGameStateChanges()
   // If a penalty is over, reset samples to reenter positions
   else if(theExtendedGameInfo.returnFromGameControllerPenalty || theExtendedGameInfo.returnFromManualPenalty || theExtendedGameInfo.startingCalibration)
   {
-    int startOfSecondHalfOfSampleSet = samples->size() / 2;
+    int startOfSecondHalfOfSampleSet = samples.size() / 2;
     // The first half of the new sample set is left of the own goal ...
     for(int i = 0; i < startOfSecondHalfOfSampleSet; ++i)
-      samples->at(i).init(getNewPoseReturnFromPenaltyPosition(true), returnFromPenaltyPoseDeviation, nextSampleNumber++, 0.5f);
+      samples.init(i, getNewPoseReturnFromPenaltyPosition(true), returnFromPenaltyPoseDeviation, nextSampleNumber++, 0.5f);
     // ... and the second half of new sample set is right of the own goal.
-    for(int i = startOfSecondHalfOfSampleSet; i < samples->size(); ++i)
-      samples->at(i).init(getNewPoseReturnFromPenaltyPosition(false), returnFromPenaltyPoseDeviation, nextSampleNumber++, 0.5f);
+    for(int i = startOfSecondHalfOfSampleSet; i < samples.size(); ++i)
+      samples.init(i, getNewPoseReturnFromPenaltyPosition(false), returnFromPenaltyPoseDeviation, nextSampleNumber++, 0.5f);
     sampleSetHasBeenReset = true;
     timeOfLastReturnFromPenalty = theFrameInfo.time;
   }
@@ -572,15 +568,15 @@ void SelfLocator::handleGameStateChanges()
           (theExtendedGameInfo.gameStateLastFrame != STATE_STANDBY && theGameInfo.state == STATE_STANDBY) ||
           (theExtendedGameInfo.gameStateLastFrame == STATE_STANDBY && theGameInfo.state == STATE_READY))
   {
-    for(int i = 0; i < samples->size(); ++i)
-      samples->at(i).init(getNewPoseAtWalkInPosition(), walkInPoseDeviation, nextSampleNumber++, 0.5f);
+    for(int i = 0; i < samples.size(); ++i)
+      samples.init(i, getNewPoseAtWalkInPosition(), walkInPoseDeviation, nextSampleNumber++, 0.5f);
     sampleSetHasBeenReset = true;
   }
   /* For testing purposes in simulator */
   else if(theStaticInitialPose.isActive && theStaticInitialPose.jump)
   {
-    for(int i = 0; i < samples->size(); ++i)
-      samples->at(i).init(theStaticInitialPose.staticPoseOnField, manualPlacementPoseDeviation, nextSampleNumber++, 0.5f);
+    for(int i = 0; i < samples.size(); ++i)
+      samples.init(i, theStaticInitialPose.staticPoseOnField, manualPlacementPoseDeviation, nextSampleNumber++, 0.5f);
     sampleSetHasBeenReset = true;
   }
   if(sampleSetHasBeenReset)
@@ -589,49 +585,49 @@ void SelfLocator::handleGameStateChanges()
   }
 }
 
-UKFRobotPoseHypothesis& SelfLocator::getMostValidSample()
+int SelfLocator::getMostValidSample()
 {
   float validityOfLastBestSample = -1.f;
-  UKFRobotPoseHypothesis* lastBestSample = 0;
+  int lastBestSample = -1;
   if(idOfLastBestSample != -1)
   {
     for(int i = 0; i < numberOfSamples; ++i)
     {
-      if(samples->at(i).id == idOfLastBestSample)
+      if(samples.ids[i] == idOfLastBestSample)
       {
-        validityOfLastBestSample = samples->at(i).validity;
-        lastBestSample = &(samples->at(i));
+        validityOfLastBestSample = samples.validities[i];
+        lastBestSample = i;
         break;
       }
     }
   }
-  UKFRobotPoseHypothesis* returnSample = &(samples->at(0));
+  int returnSample = 0;
   float maxValidity = -1.f;
   float minVariance = 0.f; // Initial value does not matter
   for(int i = 0; i < numberOfSamples; ++i)
   {
-    const float val = samples->at(i).validity;
+    const float val = samples.validities[i];
     if(val > maxValidity)
     {
       maxValidity = val;
-      minVariance = samples->at(i).getCombinedVariance();
-      returnSample = &(samples->at(i));
+      minVariance = samples.getCombinedVariance(i);
+      returnSample = i;
     }
     else if(val == maxValidity)
     {
-      float variance = samples->at(i).getCombinedVariance();
+      float variance = samples.getCombinedVariance(i);
       if(variance < minVariance)
       {
         maxValidity = val;
         minVariance = variance;
-        returnSample = &(samples->at(i));
+        returnSample = i;
       }
     }
   }
-  if(lastBestSample && returnSample->validity <= validityOfLastBestSample * 1.1f) // Bonus for stability
-    return *lastBestSample;
+  if(lastBestSample != -1 && samples.validities[returnSample] <= validityOfLastBestSample * 1.1f) // Bonus for stability
+    return lastBestSample;
   else
-    return *returnSample;
+    return returnSample;
 }
 
 void SelfLocator::domainSpecificSituationHandling()
@@ -677,7 +673,7 @@ void SelfLocator::domainSpecificSituationHandling()
     {
       ANNOTATION("SelfLocator", "Goalie Twist!");
       for(int i = 0; i < numberOfSamples; ++i)
-        samples->at(i).twist();
+        samples.twist(i);
     }
   }
 }
@@ -755,7 +751,7 @@ bool SelfLocator::allSamplesIDsAreUnique()
   {
     for(int j = i + 1; j < numberOfSamples; ++j)
     {
-      if(samples->at(i).id == samples->at(j).id)
+      if(samples.ids[i] == samples.ids[j])
         return false;
     }
   }
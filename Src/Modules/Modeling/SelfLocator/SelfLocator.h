@@ -8,7 +8,7 @@
 
 #pragma once
 
-#include "UKFRobotPoseHypothesis.h"
+#include "UKFRobotPoseHypotheses.h"
 #include "Representations/Communication/GameInfo.h"
 #include "Representations/Communication/RobotInfo.h"
 #include "Representations/Communication/TeamInfo.h"
@@ -36,7 +36,6 @@
 #include "Representations/Sensing/GyroState.h"
 #include "Representations/Configuration/SetupPoses.h"
 #include "Representations/Configuration/StaticInitialPose.h"
-#include "Tools/Modeling/SampleSet.h"
 #include "Tools/Module/Module.h"
 
 MODULE(SelfLocator,
@@ -122,7 +121,9 @@ MODULE(SelfLocator,
 class SelfLocator : public SelfLocatorBase
 {
 private:
-  SampleSet<UKFRobotPoseHypothesis>* samples;   /**< Container for all samples. */
+  UKFRobotPoseHypotheses samples;               /**< Container for all samples. */
+  UKFRobotPoseHypotheses oldSamples;            /**< The previous samples during resampling. */
+  std::vector<Pose2f> odometryOffsets;          /**< The noisy odometry offsets of all samples in the motion update. */
   unsigned lastTimeFarFieldBorderSeen;          /**< Timestamp for checking goalie localization */
   unsigned lastTimeJumpSound;                   /**< When has the last sound been played? Avoid to flood the sound player in some situations */
   unsigned timeOfLastReturnFromPenalty;         /**< Point of time when the last penalty of this robot was over */
@@ -203,10 +204,10 @@ private:
   /** Method for hacks. Currently: The 180 degree goalie turn problem */
   void domainSpecificSituationHandling();
 
-  /** Returns a reference to the sample that has the highest validity
-   * @return A reference sample
+  /** Returns the index of the sample that has the highest validity
+   * @return The index of the sample
    */
-  UKFRobotPoseHypothesis& getMostValidSample();
+  int getMostValidSample();
 
   /** Check to avoid samples with the same ID
    * @return Always true ;-)
@@ -260,7 +261,4 @@ private:
 public:
   /** Default constructor */
   SelfLocator();
-
-  /** Destructor */
-  ~SelfLocator();
 };
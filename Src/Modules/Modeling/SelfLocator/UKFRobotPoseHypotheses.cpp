@@ -0,0 +1,50 @@
+/**
+ * @file UKFRobotPoseHypotheses.cpp
+ *
+ * Implementation of the set of robot pose estimates maintained by the SelfLocator.
+ */
+
+#include "UKFRobotPoseHypotheses.h"
+
+void UKFRobotPoseHypotheses::resize(int size)
+{
+  UKFPose2DBatch::resize(size);
+  weightings.resize(size);
+  validities.resize(size);
+  ids.resize(size);
+}
+
+void UKFRobotPoseHypotheses::init(int i, const Pose2f& pose, const Pose2f& poseDeviation, int id, float validity)
+{
+  UKFPose2DBatch::init(i, pose, poseDeviation);
+  ids[i] = id;
+  validities[i] = validity;
+}
+
+void UKFRobotPoseHypotheses::copy(int to, const UKFRobotPoseHypotheses& other, int from)
+{
+  UKFPose2DBatch::copy(to, other, from);
+  weightings[to] = other.weightings[from];
+  validities[to] = other.validities[from];
+  ids[to] = other.ids[from];
+}
+
+void UKFRobotPoseHypotheses::mirror(int i)
+{
+  const Pose2f newPose = Pose2f(pi) + getPose(i);
+  x[i] = newPose.translation.x();
+  y[i] = newPose.translation.y();
+  r[i] = newPose.rotation;
+}
+
+void UKFRobotPoseHypotheses::twist(int i)
+{
+  r[i] = Angle::normalize(r[i] + pi);
+}
+
+void UKFRobotPoseHypotheses::computeWeightingsBasedOnValidity(float baseValidityWeighting)
+{
+  const int n = size();
+  for(int i = 0; i < n; ++i)
+    weightings[i] = baseValidityWeighting + (1.f - baseValidityWeighting) * validities[i];
+}
@@ -0,0 +1,87 @@
+/**
+ * @file UKFRobotPoseHypotheses.h
+ *
+ * Declaration of the set of robot pose estimates maintained by the SelfLocator.
+ * The filters, validities, weightings, and identifiers of all samples are stored
+ * as structure of arrays, so that the updates that are the same for all samples
+ * are computed in batches.
+ */
+
+#pragma once
+
+#include "UKFRobotPoseHypothesis.h"
+#include "Tools/Modeling/UKFPose2DBatch.h"
+#include <algorithm>
+
+/**
+ * @class UKFRobotPoseHypotheses
+ *
+ * The samples of the SelfLocator. Each sample is a robot pose hypothesis, modeled as an
+ * Unscented Kalman Filter. Sensor updates are done one sample at a time in an
+ * UKFRobotPoseHypothesis that is loaded by get and written back by set.
+ */
+class UKFRobotPoseHypotheses : public UKFPose2DBatch
+{
+public:
+  std::vector<float> weightings; /**< The weightings required for the resampling process. Computation is based on validity and a base weighting. */
+  std::vector<float> validities; /**< The validities represent the average success rate of the measurement matching process. 1 means that all recent measurements are compatible to the sample, 0 means that no measurements are compatible.*/
+  std::vector<int> ids;          /**< Each sample has a unique identifier, which is set at initialization. */
+
+  /** Sets the number of samples. The states of new samples are undefined.
+   * @param size The number of samples.
+   */
+  void resize(int size);
+
+  /** Initializes a sample.
+   * @param i The index of the sample
+   * @param pose The initial pose
+   * @param poseDeviation The initial deviations of the estimates of the different dimensions
+   * @param id The unique identifier (caller must make sure that it is really unique)
+   * @param validity The initial validity [0,..,1]
+   */
+  void init(int i, const Pose2f& pose, const Pose2f& poseDeviation, int id, float validity);
+
+  /** Copies a sample of another set.
+   * @param to The index of the sample in this set that is replaced.
+   * @param other The other set. It must not be this set.
+   * @param from The index of the sample in the other set.
+   */
+  void copy(int to, const UKFRobotPoseHypotheses& other, int from);
+
+  /** The RoboCup field is point-symmetric. Calling this function turns the whole pose of a sample by 180 degrees around the field's center.
+   * @param i The index of the sample
+   */
+  void mirror(int i);
+
+  /** Turns the robot by 180 degrees but does not change its position. Used only by a special handling for goalie delocalization.
+   * @param i The index of the sample
+   */
+  void twist(int i);
+
+  /** Computes a new validity value based on the current validity and the previous validity.
+   * @param i The index of the sample
+   * @param frames The old validity is weighted by (frames-1)
+   * @param currentValidity The validity of this frame's measurements, weighted by 1
+   */
+  void updateValidity(int i, int frames, float currentValidity)
+  {
+    validities[i] = (validities[i] * (frames - 1) + currentValidity) / frames;
+  }
+
+  /** Sets the validity of a sample to 0, which will automatically lead to 0 weighting, too.
+   *  This will cause the sample to be eliminated during the next resampling.
+   * @param i The index of the sample
+   */
+  void invalidate(int i) {validities[i] = 0.f;}
+
+  /** Computes the weightings of all samples from their validities.
+   *  Call after measurement / sensor updates.
+   *  @param baseValidityWeighting The weightings will have at least this value
+   */
+  void computeWeightingsBasedOnValidity(float baseValidityWeighting);
+
+  /** Returns one variance value by combining x+y+rotational variance in some way
+   * @param i The index of the sample
+   */
+  float getCombinedVariance(int i) const {return std::max(xx[i], yy[i]) * rr[i];}
+};
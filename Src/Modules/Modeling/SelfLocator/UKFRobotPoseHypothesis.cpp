@@ -16,53 +16,6 @@
 
 using namespace std;
 
-void UKFRobotPoseHypothesis::init(const Pose2f& pose, const Pose2f& poseDeviation, int id, float validity)
-{
-  this->id = id;
-  this->validity = validity;
-  mean << pose.translation.x(), pose.translation.y(), pose.rotation;
-  cov = Matrix3f::Zero();
-  cov(0, 0) = sqr(poseDeviation.translation.x());
-  cov(1, 1) = sqr(poseDeviation.translation.y());
-  cov(2, 2) = sqr(poseDeviation.rotation);
-  for(int i = 0; i < 7; ++i)
-    sigmaPoints[i] = Vector3f::Zero();
-}
-
-void UKFRobotPoseHypothesis::mirror()
-{
-  const Pose2f newPose = Pose2f(pi) + getPose();
-  mean.x() = newPose.translation.x();
-  mean.y() = newPose.translation.y();
-  mean.z() = newPose.rotation;
-}
-
-void UKFRobotPoseHypothesis::updateValidity(int frames, float currentValidity)
-{
-  validity = (validity * (frames - 1) + currentValidity) / frames;
-}
-
-void UKFRobotPoseHypothesis::computeWeightingBasedOnValidity(float baseValidityWeighting)
-{
-  weighting = baseValidityWeighting + (1.f - baseValidityWeighting) * validity;
-}
-
-void UKFRobotPoseHypothesis::invalidate()
-{
-  validity = 0.f;
-}
-
-float UKFRobotPoseHypothesis::getCombinedVariance() const
-{
-  return std::max(cov(0, 0), cov(1, 1)) * cov(2, 2);
-}
-
-void UKFRobotPoseHypothesis::twist()
-{
-  mean.z() += pi;
-  mean.z() = Angle::normalize(mean.z());
-}
-
 void UKFRobotPoseHypothesis::updateByLandmark(const RegisteredLandmark& landmark)
 {
   landmarkSensorUpdate(landmark.model, landmark.percept, landmark.covPercept);
@@ -34,25 +34,28 @@ void BallPerceptorOnnx::update(BallPercept& theBallPercept) {
   theBallPercept.status = BallPercept::notSeen;
 
   const auto& ballSpots = theBallSpots.ballSpots;
-  if(ballSpots.empty()) return;
+  if(ballSpots.empty() || !feature_extractor || !classifier || !detector) return;
 
   float prob, bestProb = guessedThreshold;
   Vector2f ballPosition, bestBallPosition;
   float radius, bestRadius;
-  for(std::size_t i = 0; i < ballSpots.size(); ++i) {
-    prob = apply(ballSpots[i], ballPosition, radius);
-    COMPLEX_DRAWING("module:BallPerceptorOnnx:spots") {
-      std::stringstream ss;
-      ss << i << ": " << static_cast<int>(prob * 100);
-      DRAW_TEXT("module:BallPerceptorOnnx:spots", ballSpots[i].x(), ballSpots[i].y(), 15, ColorRGBA::red, ss.str());
+  if(batchedInference && feature_extractor->getMaxBatchSize() > 1 && classifier->getMaxBatchSize() > 1)
+    applyBatched(ballSpots, bestProb, bestBallPosition, bestRadius);
+  else
+    for(std::size_t i = 0; i < ballSpots.size(); ++i) {
+      prob = apply(ballSpots[i], ballPosition, radius);
+      COMPLEX_DRAWING("module:BallPerceptorOnnx:spots") {
+        std::stringstream ss;
+        ss << i << ": " << static_cast<int>(prob * 100);
+        DRAW_TEXT("module:BallPerceptorOnnx:spots", ballSpots[i].x(), ballSpots[i].y(), 15, ColorRGBA::red, ss.str());
+      }
+      if(prob > bestProb) {
+        bestProb = prob;
+        bestBallPosition = ballPosition;
+        bestRadius = radius;
+        if(SystemCall::getMode() == SystemCall::physicalRobot && prob >= ensureThreshold) break;
+      }
     }
-    if(prob > bestProb) {
-      bestProb = prob;
-      bestBallPosition = ballPosition;
-      bestRadius = radius;
-      if(SystemCall::getMode() == SystemCall::physicalRobot && prob >= ensureThreshold) break;
-    }
-  }
 
   if(bestProb > guessedThreshold) {
     theBallPercept.positionInImage = bestBallPosition;
@@ -67,49 +70,116 @@ void BallPerceptorOnnx::update(BallPercept& theBallPercept) {
   }
 }
 
-float BallPerceptorOnnx::apply(const Vector2i& ballSpot, Vector2f& ballPosition, float& predRadius) {
+bool BallPerceptorOnnx::getBallArea(const Vector2i& ballSpot, int& ballArea) const {
   Vector2f relativePoint;
   Geometry::Circle ball;
   if(!(Transformation::imageToRobotHorizontalPlane(ballSpot.cast<float>(), theBallSpecification.radius, theCameraMatrix, theCameraInfo, relativePoint) &&
        Projection::calculateBallInImage(relativePoint, theCameraMatrix, theCameraInfo, theBallSpecification.radius, ball))) {
-    return -1.f;
+    return false;
   }
 
-  int ballArea = (static_cast<int>(ball.radius * ballAreaFactor) + 4) & ~3;
+  ballArea = (static_cast<int>(ball.radius * ballAreaFactor) + 4) & ~3;
   RECTANGLE("module:BallPerceptorOnnx:spots", ballSpot.x() - ballArea / 2, ballSpot.y() - ballArea / 2, ballSpot.x() + ballArea / 2, ballSpot.y() + ballArea / 2, 2, Drawings::PenStyle::solidPen, ColorRGBA::black);
+  return true;
+}
 
-  const int inputSize = patchSize * patchSize;
-  std::array<float, inputSize> encoder_input_data = {};
-  std::array<float, 512> encoder_output_data = {};
-  
-  STOPWATCH("module:BallPerceptorOnnx:getImageSection")
-  PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(patchSize, patchSize), theECImage.grayscaled, encoder_input_data.data(), extractionMode);
+float BallPerceptorOnnx::apply(const Vector2i& ballSpot, Vector2f& ballPosition, float& predRadius) {
+  int ballArea;
+  if(!getBallArea(ballSpot, ballArea))
+    return -1.f;
 
-  const float stepSize = static_cast<float>(ballArea) / patchSize;
+  STOPWATCH("module:BallPerceptorOnnx:getImageSection")
+  PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(patchSize, patchSize), theECImage.grayscaled, feature_extractor->input<float>(), extractionMode);
 
-  feature_extractor->infer(encoder_input_data.data(), encoder_output_data.data());
+  feature_extractor->infer();
+  const float* embedding = feature_extractor->output();
+  std::copy(embedding, embedding + feature_extractor->getOutputSize(), classifier->input<float>());
+  classifier->infer();
 
-  std::array<float, 1> classification_output_data = {};
-  classifier->infer(encoder_output_data.data(), classification_output_data.data());
+  float pred = classifier->output()[0];
+  if(pred > guessedThreshold)
+    correct(embedding, ballSpot, ballArea, ballPosition, predRadius);
 
-  float pred = classification_output_data[0];
-  if(pred > guessedThreshold) {
-    std::array<float, 3> detector_output_data = {};
-    detector->infer(encoder_output_data.data(), detector_output_data.data());
+  return pred;
+}
 
-    ballPosition.x() = (detector_output_data[0] - patchSize / 2) * stepSize + ballSpot.x();
-    ballPosition.y() = (detector_output_data[1] - patchSize / 2) * stepSize + ballSpot.y();
-    predRadius = detector_output_data[2] * stepSize;
+void BallPerceptorOnnx::applyBatched(const std::vector<Vector2i>& ballSpots, float& bestProb, Vector2f& bestBallPosition, float& bestRadius) {
+  const unsigned embeddingSize = feature_extractor->getOutputSize();
+  const unsigned predictionSize = classifier->getOutputSize();
+  const unsigned batchCapacity = std::min(feature_extractor->getMaxBatchSize(), classifier->getMaxBatchSize());
+
+  ballAreas.resize(ballSpots.size());
+  int bestSpot = -1;
+  for(std::size_t begin = 0; begin < ballSpots.size();) {
+    // Spots that cannot be a ball are not part of the batch.
+    batchCenters.clear();
+    batchSizes.clear();
+    std::size_t end = begin;
+    for(; end < ballSpots.size() && batchCenters.size() < batchCapacity; ++end)
+      if(getBallArea(ballSpots[end], ballAreas[end]))
+      {
+        batchCenters.push_back(ballSpots[end]);
+        batchSizes.emplace_back(ballAreas[end], ballAreas[end]);
+      }
+      else
+        ballAreas[end] = 0;
+    const unsigned batchSize = static_cast<unsigned>(batchCenters.size());
+    STOPWATCH("module:BallPerceptorOnnx:getImageSection")
+      PatchUtilities::extractPatches(batchCenters, batchSizes, Vector2i(patchSize, patchSize), theECImage.grayscaled, feature_extractor->input<float>(), extractionMode);
+
+    if(batchSize > 0) {
+      feature_extractor->infer(batchSize);
+      const float* embeddings = feature_extractor->output();
+      std::copy(embeddings, embeddings + batchSize * embeddingSize, classifier->input<float>());
+      classifier->infer(batchSize);
+      const float* predictions = classifier->output();
+
+      // Same selection as in the sequential version, but the corrector is only run for the winner.
+      for(std::size_t i = begin, sample = 0; i < end; ++i) {
+        const float prob = ballAreas[i] ? predictions[sample++ * predictionSize] : -1.f;
+        COMPLEX_DRAWING("module:BallPerceptorOnnx:spots") {
+          std::stringstream ss;
+          ss << i << ": " << static_cast<int>(prob * 100);
+          DRAW_TEXT("module:BallPerceptorOnnx:spots", ballSpots[i].x(), ballSpots[i].y(), 15, ColorRGBA::red, ss.str());
+        }
+        if(prob > bestProb) {
+          bestProb = prob;
+          bestSpot = static_cast<int>(i);
+          std::copy(embeddings + (sample - 1) * embeddingSize, embeddings + sample * embeddingSize, bestEmbedding.begin());
+          if(SystemCall::getMode() == SystemCall::physicalRobot && prob >= ensureThreshold) {
+            end = ballSpots.size();
+            break;
+          }
+        }
+      }
+    }
+    begin = end;
   }
 
-  return pred;
+  if(bestSpot >= 0)
+    correct(bestEmbedding.data(), ballSpots[bestSpot], ballAreas[bestSpot], bestBallPosition, bestRadius);
+}
+
+void BallPerceptorOnnx::correct(const float* embedding, const Vector2i& ballSpot, int ballArea, Vector2f& ballPosition, float& predRadius) {
+  const float stepSize = static_cast<float>(ballArea) / patchSize;
+
+  std::copy(embedding, embedding + detector->getInputSize(), detector->input<float>());
+  detector->infer();
+  const float* detector_output_data = detector->output();
+
+  ballPosition.x() = (detector_output_data[0] - patchSize / 2) * stepSize + ballSpot.x();
+  ballPosition.y() = (detector_output_data[1] - patchSize / 2) * stepSize + ballSpot.y();
+  predRadius = detector_output_data[2] * stepSize;
 }
 
 void BallPerceptorOnnx::setup() {
   const std::string baseDir = std::string(File::getBHDir()) + "/Config/NeuralNets/BallPerceptor/";
-  env = Ort::Env{ORT_LOGGING_LEVEL_ERROR, "Default"};
 
-  feature_extractor = new OnnxHelper<float, float>(baseDir + encoderName);
-  classifier = new OnnxHelper<float, float>(baseDir + classifierName);
-  detector = new OnnxHelper<float, float>(baseDir + correctorName);
-}
\ No newline at end of file
+  InferenceModel::Settings settings;
+  settings.maxBatchSize = batchedInference ? maxBatchSize : 1;
+  feature_extractor = InferenceModel::load(baseDir + encoderName, settings);
+  classifier = InferenceModel::load(baseDir + classifierName, settings);
+  detector = InferenceModel::load(baseDir + correctorName);
+  if(feature_extractor)
+    bestEmbedding.resize(feature_extractor->getOutputSize());
+}
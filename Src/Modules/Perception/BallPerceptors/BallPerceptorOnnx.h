@@ -25,16 +25,13 @@
 #include "Representations/spqr_representations/OurDefinitions.h"
 #include "Tools/ImageProcessing/PatchUtilities.h"
 #include "Tools/Math/Eigen.h"
+#include "Tools/Inference/InferenceModel.h"
 #include "Tools/Module/Module.h"
-#include "Tools/OnnxHelper/OnnxHelper.h"
-#include <CompiledNN/CompiledNN.h>
-#include <CompiledNN/Model.h>
 
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h> 
 #include <sys/mman.h>
-#include <onnxruntime_cxx_api.h>
 
 MODULE(BallPerceptorOnnx,
 {,
@@ -54,14 +51,15 @@ MODULE(BallPerceptorOnnx,
   PROVIDES(BallPercept),
   LOADS_PARAMETERS(
   {,
-    (std::string) encoderName, 
-    (std::string) classifierName,
-    (std::string) correctorName,
+    (std::string) encoderName, /**< The encoder model (.onnx or .h5). */
+    (std::string) classifierName, /**< The classifier model (.onnx or .h5). */
+    (std::string) correctorName, /**< The corrector model (.onnx or .h5). */
     (float) guessedThreshold, /**< Limit from which a ball is guessed. */
     (float) acceptThreshold, /**< Limit from which a ball is accepted. */
     (float) ensureThreshold, /**< Limit from which a ball is detected for sure. */
     (float) ballAreaFactor,
     (PatchUtilities::ExtractionMode) extractionMode,
+    (bool) batchedInference, /**< Run the encoder and the classifier once on all ball spots of a frame (if the models support dynamic batches). */
   }),
 });
 
@@ -72,18 +70,49 @@ public:
 
 private:
 
-  Ort::Env env;
-  Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
-
-  OnnxHelper<float, float> *feature_extractor;
-  OnnxHelper<float, float> *classifier;
-  OnnxHelper<float, float> *detector;
+  std::unique_ptr<InferenceModel> feature_extractor;
+  std::unique_ptr<InferenceModel> classifier;
+  std::unique_ptr<InferenceModel> detector;
 
   void* shm_ptr;
 
   static constexpr std::size_t patchSize = 32;
+  static constexpr unsigned maxBatchSize = 16; /**< The maximum number of ball spots classified in one run. More spots are split into several runs. */
+
+  std::vector<int> ballAreas; /**< The size of the patch around each ball spot (0 if the spot cannot be a ball). */
+  std::vector<float> bestEmbedding; /**< The encoder output for the best spot of the previous batches. */
+  std::vector<Vector2i> batchCenters; /**< The ball spots of the current batch. */
+  std::vector<Vector2i> batchSizes; /**< The sizes of the patches around the ball spots of the current batch. */
 
   void update(BallPercept& theBallPercept) override;
   float apply(const Vector2i& ballSpot, Vector2f& ballPosition, float& predRadius);
+
+  /**
+   * Classifies the ball spots with one encoder and one classifier run per batch. The corrector only runs
+   * on the spot that is selected, using the same early exit as the sequential version.
+   * @param ballSpots The ball spots to classify.
+   * @param bestProb The probability of the best spot. Must be initialized with the lower limit.
+   * @param bestBallPosition The corrected position of the best spot in the image.
+   * @param bestRadius The corrected radius of the best spot in the image.
+   */
+  void applyBatched(const std::vector<Vector2i>& ballSpots, float& bestProb, Vector2f& bestBallPosition, float& bestRadius);
+
+  /**
+   * Computes the size of the patch that is extracted around a ball spot.
+   * @param ballSpot The ball spot in the image.
+   * @param ballArea The edge length of the patch in pixels.
+   * @return Whether a ball could be at this spot.
+   */
+  bool getBallArea(const Vector2i& ballSpot, int& ballArea) const;
+
+  /**
+   * Runs the corrector on the embedding of a ball spot.
+   * @param embedding The encoder output for the spot.
+   * @param ballSpot The ball spot in the image.
+   * @param ballArea The edge length of the patch in pixels.
+   * @param ballPosition The corrected position in the image.
+   * @param predRadius The corrected radius in the image.
+   */
+  void correct(const float* embedding, const Vector2i& ballSpot, int ballArea, Vector2f& ballPosition, float& predRadius);
   void setup();
 };
\ No newline at end of file
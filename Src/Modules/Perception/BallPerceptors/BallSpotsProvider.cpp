@@ -79,6 +79,7 @@ void BallSpotsProvider::searchScanLines(BallSpots& ballSpots) const
             unsigned char saturationRef = 0;
             int luminanceAverage = 0;
             int saturationAverage = 0;
+            theECImage.prepareRows(region.range.lower, lowestYOfCurrentArea);
             for(int i = region.range.lower; i < lowestYOfCurrentArea; i++)
             {
               const unsigned char luminance = theECImage.grayscaled[i][theColorScanLineRegionsVerticalClipped.scanLines[scanLineIndex].x];
@@ -139,6 +140,7 @@ bool BallSpotsProvider::correctWithScanLeftAndRight(Vector2i& initialPoint, cons
 
   const int maxLeftScanLength = std::min(maxScanLength, initialPoint.x() - leftMaximum);
   const int maxRightScanLength = std::min(maxScanLength, rightMaximum - initialPoint.x());
+  theECImage.prepareRows(initialPoint.y(), initialPoint.y() + 1);
 
   unsigned foundGoodPixel = 0;
   int leftScanLength = 0;
@@ -220,6 +222,7 @@ bool BallSpotsProvider::checkGreenAround(const Vector2i& spot, const float radiu
   const int y12 = spot.y() - useRadius - 1;
   const int y2 = spot.y() + useRadius;
   const int y22 = spot.y() + useRadius + 1;
+  theECImage.prepareRows(y12, y22 + 1);
 
   for(int x = spot.x() - useRadius + 1; x <= lastX; x++)
     if(theRelativeFieldColors.isFieldNearWhite(theECImage.grayscaled[y1][x], theECImage.saturated[y1][x], luminanceRef, saturationRef))
@@ -600,6 +600,9 @@ void LinePerceptor::trimLine(LinesPercept::Line& line) const
   if(start == end)
     return;
 
+  // The scans perpendicular to the line end after maxWidthImage pixels.
+  theECImage.prepareRows(std::min(start.y(), end.y()) - maxWidthImage - 2, std::max(start.y(), end.y()) + maxWidthImage + 3);
+
   for(int i = 0; i < 2; ++i)
   {
     int foundConsecutiveLineSpots = 0;
@@ -1001,6 +1004,7 @@ bool LinePerceptor::isPointWhite(const Vector2f& pointOnField, const Vector2i& p
     if(integerReferenceInImage.x() >= 0 && integerReferenceInImage.x() < theCameraInfo.width &&
        integerReferenceInImage.y() >= 0 && integerReferenceInImage.y() < theCameraInfo.height)
     {
+      theECImage.prepareRows(integerReferenceInImage.y(), integerReferenceInImage.y() + 1);
       luminanceReference = theECImage.grayscaled[integerReferenceInImage];
       saturationReference = theECImage.saturated[integerReferenceInImage];
       isOuterPointInImage = true;
@@ -1019,6 +1023,7 @@ bool LinePerceptor::isPointWhite(const Vector2f& pointOnField, const Vector2i& p
     if(integerReferenceInImage.x() >= 0 && integerReferenceInImage.x() < theCameraInfo.width &&
        integerReferenceInImage.y() >= 0 && integerReferenceInImage.y() < theCameraInfo.height)
     {
+      theECImage.prepareRows(integerReferenceInImage.y(), integerReferenceInImage.y() + 1);
       if(isOuterPointInImage)
       {
         luminanceReference = (luminanceReference + theECImage.grayscaled[integerReferenceInImage] + 1) / 2;
@@ -1037,6 +1042,7 @@ bool LinePerceptor::isPointWhite(const Vector2f& pointOnField, const Vector2i& p
       }
     }
   }
+  theECImage.prepareRows(pointInImage.y(), pointInImage.y() + 1);
   return theRelativeFieldColors.isWhiteNearField(theECImage.grayscaled[pointInImage],theECImage.saturated[pointInImage],
                                                   static_cast<unsigned char>(luminanceReference), static_cast<unsigned char>(saturationReference));
 }
@@ -1045,6 +1051,7 @@ bool LinePerceptor::isPointWhite(const Vector2f& pointInImage, const Vector2f& n
 {
   bool isOuterPointInImage = false;
   unsigned short luminanceReference = 0, saturationReference = 0;
+  theECImage.prepareRows(static_cast<int>(pointInImage.y() - std::abs(n.y())) - 1, static_cast<int>(pointInImage.y() + std::abs(n.y())) + 2);
   Vector2i outerReference = (pointInImage + n).cast<int>();
   if(outerReference.x() >= 0 && outerReference.x() < theCameraInfo.width &&
       outerReference.y() >= 0 && outerReference.y() < theCameraInfo.height)
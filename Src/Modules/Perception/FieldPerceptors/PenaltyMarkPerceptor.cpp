@@ -141,12 +141,14 @@ void PenaltyMarkPerceptor::update(PenaltyMarkPercept& thePenaltyMarkPercept)
       int luminanceAverage = 0, saturationAverage = 0;
       IsGreen isGreen = [&](int x, int y)
       {
+        theECImage.prepareRows(y, y + 1);
         return theRelativeFieldColors.isFieldNearWhite(theECImage.grayscaled[y][x], theECImage.saturated[y][x],
                                                        static_cast<unsigned char>(luminanceAverage), static_cast<unsigned char>(saturationAverage));
       };
       for(const Vector3d& samplePoint : samplePoints)
       {
         detector.camera.camera2Image(object * samplePoint, x, y);
+        theECImage.prepareRows(static_cast<int>(y), static_cast<int>(y) + 1);
         luminanceAverage += theECImage.grayscaled[static_cast<int>(y)][static_cast<int>(x)];
         saturationAverage += theECImage.saturated[static_cast<int>(y)][static_cast<int>(x)];
       }
@@ -11,6 +11,7 @@
 #include "Tools/Debugging/DebugDrawings.h"
 #include "Tools/Math/BHMath.h"
 #include "Tools/ImageProcessing/AVX.h"
+#include "Tools/ImageProcessing/ParallelRows.h"
 #include "Tools/Math/Transformation.h"
 #include "Tools/ImageProcessing/InImageSizeCalculations.h"
 
@@ -225,7 +226,24 @@ void CNSImageProvider::cnsResponse(const unsigned char* src, int width, int heig
                                    int srcOfs, short* cns, float regVar)
 {
   ASSERT(CNSResponse::SCALE == 128);
+  ASSERT((reinterpret_cast<size_t>(cns) & 0xf) == 0);
+  ASSERT(intptr_t(src) % 16 == 0);
+  ASSERT(srcOfs % 8 == 0);
+  ASSERT(width % 8 == 0);
+
+  // Each stripe recomputes the intermediate values of the two rows above it.
+  ParallelRows::parallelForRows(1, height - 1, 48, [&](int yMin, int yMax)
+  {
+    cnsResponseRows(src, width, srcOfs, cns, regVar, yMin, yMax);
+  });
+
+  // **** Finally set the top and bottom margin in the cns output if necessary
+  fillWithCNSOffsetUsingSSE(cns, width);
+  fillWithCNSOffsetUsingSSE(cns + (height - 1) * srcOfs, width);
+}
 
+void CNSImageProvider::cnsResponseRows(const unsigned char* src, int width, int srcOfs, short* cns, float regVar, int yMin, int yMax)
+{
   __m128i offset = _mm_set1_epi8(static_cast<unsigned char>(CNSResponse::OFFSET));
 
   // Image noise of variance \c regVar increases Gauss*I^2 by 16*regVar
@@ -240,15 +258,11 @@ void CNSImageProvider::cnsResponse(const unsigned char* src, int width, int heig
 
   // Buffers for intermediate values for two lines
   alignas(16) IntermediateValues iv[2][CameraImage::maxResolutionWidth / 8]; // always 8 Pixel in one IntermediateValues object
-  ASSERT((reinterpret_cast<size_t>(cns) & 0xf) == 0);
 
-  int srcY = 0; // line in the source image
+  int srcY = yMin - 1; // line in the source image
 
   // *** Go through two lines to fill up the intermediate Buffers
   // This is exactly the same code as below apart from the final computations being removed
-  ASSERT(intptr_t(src) % 16 == 0);
-  ASSERT(srcOfs % 8 == 0);
-  ASSERT(width % 8 == 0);
   for(int i = 0; i < 2; ++i, ++srcY)
   {
     IntermediateValues* ivCurrent = &iv[srcY & 1][0];
@@ -268,8 +282,8 @@ void CNSImageProvider::cnsResponse(const unsigned char* src, int width, int heig
     }
   }
 
-  // **** Now continue until the end of the image
-  int yEnd = height;
+  // **** Now continue until the end of the stripe
+  int yEnd = yMax + 1;
   for(; srcY != yEnd; ++srcY)
   {
     IntermediateValues* ivCurrent = &iv[srcY & 1][0];
@@ -299,10 +313,6 @@ void CNSImageProvider::cnsResponse(const unsigned char* src, int width, int heig
     // Left and right margin: set cns to offset (means 0) and ds to the source pixel
     myCns[-1] = myCns[-width] = static_cast<short>(static_cast<unsigned short>(CNSResponse::OFFSET + (CNSResponse::OFFSET << 8)));
   }
-
-  // **** Finally set the top and bottom margin in the cns output if necessary
-  fillWithCNSOffsetUsingSSE(cns, width);
-  fillWithCNSOffsetUsingSSE(cns + (height - 1) * srcOfs, width);
 }
 
 void CNSImageProvider::update(CNSImage& cnsImage)
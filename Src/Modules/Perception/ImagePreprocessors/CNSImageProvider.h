@@ -40,7 +40,17 @@ class CNSImageProvider : public CNSImageProviderBase
    * The result is stored in \c dst, where pixel \c dst(x,y) corresponds to
    * \c dst[x + y * width]. \c cns(x,y) is the result of the CNS computations based on
    * a 3*3 filter centered at \c src(x,y).
+   * The rows are computed in stripes by the threads that help executing image kernels.
    */
   static void cnsResponse(const unsigned char* src, int width, int height,
                           int srcOfs, short* cns, float regVar);
+
+  /**
+   * Computes the rows [yMin, yMax[ of the cns response image without the top and
+   * bottom margin (see cnsResponse).
+   * @param yMin The first row. Must be at least 1.
+   * @param yMax The row after the last one. Must be at most the height - 1.
+   */
+  static void cnsResponseRows(const unsigned char* src, int width, int srcOfs, short* cns, float regVar,
+                              int yMin, int yMax);
 };
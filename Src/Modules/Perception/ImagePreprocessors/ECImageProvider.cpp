@@ -6,37 +6,92 @@
 
 #include "ECImageProvider.h"
 #include "Tools/Global.h"
+#include "Tools/ImageProcessing/ParallelRows.h"
 #include <asmjit/asmjit.h>
 
 MAKE_MODULE(ECImageProvider, perception);
 
-#ifndef __arm64__
-
 void ECImageProvider::update(ECImage& ecImage)
 {
   ecImage.grayscaled.setResolution(theCameraInfo.width, theCameraInfo.height);
   ecImage.saturated.setResolution(theCameraInfo.width, theCameraInfo.height);
   ecImage.hued.setResolution(theCameraInfo.width, theCameraInfo.height);
 
+  validTiles = ~0ull;
+  ecImage.prepareRows = [this, &ecImage](int yMin, int yMax)
+  {
+    prepareRows(ecImage, yMin, yMax);
+  };
+
   if(theCameraImage.timestamp > 10 && static_cast<int>(theCameraImage.width) == theCameraInfo.width / 2)
   {
+#ifndef __arm64__
+    if(!eFunc)
+      compileE();
+    if(!ecFunc && !disableColor)
+      compileEC();
+#endif
+
+    // Saturation and hue are computed in advance from the first tile that might
+    // contain the field. The tiles above are only computed when they are prepared.
+    int yStart = 0;
     if(disableColor)
+      yStart = theCameraInfo.height;
+    else if(lazy)
     {
-      if(!eFunc)
-        compileE();
-      eFunc(theCameraInfo.width * theCameraInfo.height / 16, theCameraImage[0], ecImage.grayscaled[0]);
+      ASSERT(theCameraInfo.height <= 64 * tileHeight);
+      const int yField = std::max(theScanGrid.fieldLimit, theFieldBoundary.getBoundaryTopmostY(theCameraInfo.width) - fieldBoundaryMargin);
+      const int firstTile = std::max(0, std::min(yField, theCameraInfo.height)) / tileHeight;
+      tileGrayscaled.setResolution(theCameraInfo.width, tileHeight);
+      validTiles = firstTile < 64 ? ~((1ull << firstTile) - 1) : 0ull;
+      yStart = firstTile * tileHeight;
     }
-    else
+    ParallelRows::parallelForRows(0, theCameraInfo.height, stripeHeight, [&](int yMin, int yMax)
     {
-      if(!ecFunc)
-        compileEC();
-
-      ecFunc(theCameraInfo.width * theCameraInfo.height / 16, theCameraImage[0], ecImage.grayscaled[0], ecImage.saturated[0], ecImage.hued[0]);
-    }
+      const int ySplit = std::max(yMin, std::min(yStart, yMax));
+      computeRows(yMin, ySplit, ecImage.grayscaled[yMin], nullptr, nullptr);
+      computeRows(ySplit, yMax, ecImage.grayscaled[ySplit], ecImage.saturated[ySplit], ecImage.hued[ySplit]);
+    });
     ecImage.timestamp = theCameraImage.timestamp;
   }
 }
 
+void ECImageProvider::prepareRows(ECImage& ecImage, int yMin, int yMax)
+{
+  const int tileMin = std::max(0, yMin) / tileHeight;
+  const int tileMax = (std::min(yMax, static_cast<int>(ecImage.saturated.height)) + tileHeight - 1) / tileHeight;
+  if(tileMin >= tileMax)
+    return;
+  const unsigned long long required = (tileMax - tileMin < 64 ? (1ull << (tileMax - tileMin)) - 1 : ~0ull) << tileMin;
+  if((validTiles.load(std::memory_order_acquire) & required) == required)
+    return;
+
+  std::lock_guard<std::mutex> lock(tileMutex);
+  for(int tile = tileMin; tile < tileMax; ++tile)
+    if(!(validTiles.load(std::memory_order_relaxed) & (1ull << tile)))
+    {
+      // The luminance is already complete and might be read concurrently, so it is written elsewhere.
+      const int y = tile * tileHeight;
+      computeRows(y, std::min(y + tileHeight, static_cast<int>(ecImage.saturated.height)),
+                  tileGrayscaled[0], ecImage.saturated[y], ecImage.hued[y]);
+      validTiles.fetch_or(1ull << tile, std::memory_order_release);
+    }
+}
+
+#ifndef __arm64__
+
+void ECImageProvider::computeRows(int yMin, int yMax, PixelTypes::GrayscaledPixel* grayscaled,
+                                  PixelTypes::GrayscaledPixel* saturated, PixelTypes::HuePixel* hued)
+{
+  if(yMin >= yMax)
+    return;
+  const unsigned int steps = theCameraInfo.width * (yMax - yMin) / 16;
+  if(saturated)
+    ecFunc(steps, theCameraImage[yMin], grayscaled, saturated, hued);
+  else
+    eFunc(steps, theCameraImage[yMin], grayscaled);
+}
+
 using namespace asmjit;
 
 void ECImageProvider::compileE()
@@ -279,6 +334,9 @@ void ECImageProvider::compileEC()
   a.dec(remainingSteps);
   a.jnz(loop);
 
+  // Make the non-temporal stores visible to other threads
+  a.sfence();
+
   // Return
 #ifdef WINDOWS
   a.pop(a.zsi());
@@ -324,23 +382,21 @@ ECImageProvider::~ECImageProvider()
 
 #include "Tools/ImageProcessing/YHSColorConversion.h"
 
-template<bool aligned, bool avx>
-void updateSSE(const PixelTypes::YUYVPixel* const srcImage, const int srcWidth, const int srcHeight,
-               Image<PixelTypes::GrayscaledPixel>& grayscaled,
-               Image<PixelTypes::HuePixel>& hued, Image<PixelTypes::GrayscaledPixel>& saturated)
+template<bool aligned, bool avx, bool color>
+void updateSSE(const PixelTypes::YUYVPixel* const srcImage, const int srcSize,
+               PixelTypes::GrayscaledPixel* grayscaled,
+               PixelTypes::HuePixel* hued, PixelTypes::GrayscaledPixel* saturated)
 {
-  ASSERT(srcWidth % 32 == 0);
-
-  __m_auto_i* grayscaledDest = reinterpret_cast<__m_auto_i*>(grayscaled[0]) - 1;
-  __m_auto_i* saturatedDest = reinterpret_cast<__m_auto_i*>(saturated[0]) - 1;
-  __m_auto_i* huedDest = reinterpret_cast<__m_auto_i*>(hued[0]) - 1;
-  const __m_auto_i* const imageEnd = reinterpret_cast<const __m_auto_i*>(srcImage + srcWidth * srcHeight) - 1;
+  __m_auto_i* grayscaledDest = reinterpret_cast<__m_auto_i*>(grayscaled) - 1;
+  __m_auto_i* saturatedDest = reinterpret_cast<__m_auto_i*>(saturated) - 1;
+  __m_auto_i* huedDest = reinterpret_cast<__m_auto_i*>(hued) - 1;
+  const __m_auto_i* const imageEnd = reinterpret_cast<const __m_auto_i*>(srcImage + srcSize) - 1;
 
   static const __m_auto_i c_128 = _mmauto_set1_epi8(char(128));
   static const __m_auto_i channelMask = _mmauto_set1_epi16(0x00FF);
 
   const char* prefetchSrc = reinterpret_cast<const char*>(srcImage) + (avx ? 128 : 64);
-  const char* prefetchGrayscaledDest = reinterpret_cast<const char*>(grayscaled[0]) + (avx ? 64 : 32);
+  const char* prefetchGrayscaledDest = reinterpret_cast<const char*>(grayscaled) + (avx ? 64 : 32);
 
   const __m_auto_i* src = reinterpret_cast<__m_auto_i const*>(srcImage) - 1;
   while(src < imageEnd)
@@ -364,6 +420,9 @@ void updateSSE(const PixelTypes::YUYVPixel* const srcImage, const int srcWidth,
     _mm_prefetch(prefetchGrayscaledDest += 32, _MM_HINT_T0);
     if(avx) _mm_prefetch(prefetchGrayscaledDest += 32, _MM_HINT_T0);
 
+    if(!color)
+      continue;
+
     // Compute saturation
     const __m_auto_i uv0 = _mmauto_sub_epi8(_mmauto_correct_256op(_mmauto_packus_epi16(_mmauto_and_si_all(_mmauto_srli_si_all(p0, 1), channelMask), _mmauto_and_si_all(_mmauto_srli_si_all(p1, 1), channelMask))), c_128);
     const __m_auto_i uv1 = _mmauto_sub_epi8(_mmauto_correct_256op(_mmauto_packus_epi16(_mmauto_and_si_all(_mmauto_srli_si_all(p2, 1), channelMask), _mmauto_and_si_all(_mmauto_srli_si_all(p3, 1), channelMask))), c_128);
@@ -383,20 +442,27 @@ void updateSSE(const PixelTypes::YUYVPixel* const srcImage, const int srcWidth,
   }
 }
 
-void ECImageProvider::update(ECImage& ecImage)
+void ECImageProvider::computeRows(int yMin, int yMax, PixelTypes::GrayscaledPixel* grayscaled,
+                                  PixelTypes::GrayscaledPixel* saturated, PixelTypes::HuePixel* hued)
 {
-  ecImage.grayscaled.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.saturated.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.hued.setResolution(theCameraInfo.width, theCameraInfo.height);
-
-  if(theCameraImage.timestamp > 10 && static_cast<int>(theCameraImage.width) == theCameraInfo.width / 2)
+  ASSERT(theCameraImage.width % 32 == 0);
+  if(yMin >= yMax)
+    return;
+  const PixelTypes::YUYVPixel* const src = reinterpret_cast<const PixelTypes::YUYVPixel*>(theCameraImage[yMin]);
+  const int srcSize = static_cast<int>(theCameraImage.width) * (yMax - yMin);
+  if(saturated)
   {
-    const PixelTypes::YUYVPixel* const src = reinterpret_cast<const PixelTypes::YUYVPixel* const>(theCameraImage[0]);
     if(simdAligned<_supportsAVX2>(src))
-      updateSSE<true, _supportsAVX2>(src, theCameraImage.width, theCameraImage.height, ecImage.grayscaled, ecImage.hued, ecImage.saturated);
+      updateSSE<true, _supportsAVX2, true>(src, srcSize, grayscaled, hued, saturated);
     else
-      updateSSE<false, _supportsAVX2>(src, theCameraImage.width, theCameraImage.height, ecImage.grayscaled, ecImage.hued, ecImage.saturated);
-    ecImage.timestamp = theCameraImage.timestamp;
+      updateSSE<false, _supportsAVX2, true>(src, srcSize, grayscaled, hued, saturated);
+  }
+  else
+  {
+    if(simdAligned<_supportsAVX2>(src))
+      updateSSE<true, _supportsAVX2, false>(src, srcSize, grayscaled, hued, saturated);
+    else
+      updateSSE<false, _supportsAVX2, false>(src, srcSize, grayscaled, hued, saturated);
   }
 }
 
@@ -9,16 +9,24 @@
 #include "Representations/Infrastructure/CameraImage.h"
 #include "Representations/Infrastructure/CameraInfo.h"
 #include "Representations/Perception/ImagePreprocessing/ECImage.h"
+#include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
+#include "Representations/Perception/ImagePreprocessing/ScanGrid.h"
 #include "Tools/Module/Module.h"
+#include <atomic>
+#include <mutex>
 
 MODULE(ECImageProvider,
 {,
   REQUIRES(CameraInfo),
   REQUIRES(CameraImage),
+  REQUIRES(ScanGrid),
+  USES(FieldBoundary),
   PROVIDES(ECImage),
   LOADS_PARAMETERS(
   {,
     (bool) disableColor,
+    (bool) lazy, /**< Compute saturation and hue only where the field is expected and the other rows when they are prepared. */
+    (int) fieldBoundaryMargin, /**< Rows above the field boundary of the previous frame that are computed in advance (in pixels). */
   }),
 });
 
@@ -31,13 +39,41 @@ private:
   using EcFunc = void (*)(unsigned int, const void*, void*, void*, void*);
   using EFunc = void (*)(unsigned int, const void*, void*);
 
+  static constexpr int tileHeight = 16; /**< The number of rows of the tiles that are computed together. */
+  static constexpr int stripeHeight = 48; /**< The number of rows converted together by one thread. */
+
   EcFunc ecFunc = nullptr;
   EFunc eFunc = nullptr;
 
+  std::atomic<unsigned long long> validTiles; /**< A bit per tile that is set if its saturation and hue were computed. */
+  std::mutex tileMutex; /**< Serializes computing tiles on demand. */
+  Image<PixelTypes::GrayscaledPixel> tileGrayscaled; /**< Discarded luminance of tiles computed on demand. */
+
   void update(ECImage& ecImage) override;
   void compileE();
   void compileEC();
 
+  /**
+   * Converts a range of rows of the camera image.
+   * @param yMin The first row converted.
+   * @param yMax The row after the last one converted.
+   * @param grayscaled The luminance of row yMin is written here.
+   * @param saturated The saturation of row yMin is written here. If nullptr, only
+   *                  the luminance is computed.
+   * @param hued The hue of row yMin is written here.
+   */
+  void computeRows(int yMin, int yMax, PixelTypes::GrayscaledPixel* grayscaled,
+                   PixelTypes::GrayscaledPixel* saturated, PixelTypes::HuePixel* hued);
+
+  /**
+   * Computes the saturation and hue of all tiles overlapping a range of rows
+   * that were not computed yet.
+   * @param ecImage The images to fill.
+   * @param yMin The first row required.
+   * @param yMax The row after the last one required.
+   */
+  void prepareRows(ECImage& ecImage, int yMin, int yMax);
+
 public:
   ~ECImageProvider();
 };
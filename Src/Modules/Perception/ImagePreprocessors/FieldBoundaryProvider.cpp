@@ -20,27 +20,23 @@
 
 MAKE_MODULE(FieldBoundaryProvider, perception);
 
-FieldBoundaryProvider::FieldBoundaryProvider() :
-  network(&Global::getAsmjitRuntime())
+FieldBoundaryProvider::FieldBoundaryProvider()
 {
-  model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + ((theCameraInfo.camera == CameraInfo::upper) ? "/Config/NeuralNets/FieldBoundary/net.h5" : "/Config/NeuralNets/FieldBoundary/net-uncertainty.h5"));
-  model->setInputUInt8(0);
+  InferenceModel::Settings settings;
+  settings.uint8Input = true;
+  network = InferenceModel::load(std::string(File::getBHDir()) + "/Config/NeuralNets/FieldBoundary/"
+                                 + (theCameraInfo.camera == CameraInfo::upper ? upperModelName : lowerModelName), settings);
 
-  network.compile(*model);
+  ASSERT(network);
 
-  ASSERT(network.valid());
+  ASSERT(network->getInputDimensions().size() == 3);
+  ASSERT(network->getInputDimensions()[2] == 1 || network->getInputDimensions()[2] == 3);
 
-  ASSERT(network.numOfInputs() == 1);
-  ASSERT(network.numOfOutputs() == 1);
+  patchSize = Vector2i(network->getInputDimensions()[1], network->getInputDimensions()[0]);
 
-  ASSERT(network.input(0).rank() == 3);
-  ASSERT(network.input(0).dims(2) == 1 || network.input(0).dims(2) == 3);
-
-  patchSize = Vector2i(network.input(0).dims(1), network.input(0).dims(0));
-
-  ASSERT(network.output(0).rank() == 1 || network.output(0).rank() == 2);
-  ASSERT(network.output(0).dims(0) == static_cast<unsigned>(patchSize.x()));
-  ASSERT(network.output(0).rank() == 1 || network.output(0).dims(1) == 2);
+  ASSERT(network->getOutputDimensions().size() == 1 || network->getOutputDimensions().size() == 2);
+  ASSERT(network->getOutputDimensions()[0] == static_cast<unsigned>(patchSize.x()));
+  ASSERT(network->getOutputDimensions().size() == 1 || network->getOutputDimensions()[1] == 2);
 }
 
 void FieldBoundaryProvider::update(FieldBoundary& fieldBoundary)
@@ -50,7 +46,7 @@ void FieldBoundaryProvider::update(FieldBoundary& fieldBoundary)
 
   fieldBoundary.boundaryInImage.clear();
   fieldBoundary.boundaryOnField.clear();
-  if((fieldBoundary.isValid = network.valid() && theCameraMatrix.isValid))
+  if((fieldBoundary.isValid = network && theCameraMatrix.isValid))
   {
     if(!fieldBoundary.isValid)
     {
@@ -144,25 +140,25 @@ void FieldBoundaryProvider::projectPrevious(FieldBoundary& fieldBoundary)
 
 void FieldBoundaryProvider::predictSpots(std::vector<Spot>& spots)
 {
-  unsigned char* input = reinterpret_cast<std::uint8_t*>(network.input(0).data());
+  unsigned char* input = network->input<std::uint8_t>();
 
-  if(network.input(0).dims(2) == 1)
+  if(network->getInputDimensions()[2] == 1)
     PatchUtilities::extractInput<std::uint8_t, true>(theCameraImage, patchSize, input);
   else
     PatchUtilities::extractInput<std::uint8_t, false>(theCameraImage, patchSize, input);
 
-  network.apply();
-  const float* output = network.output(0).data();
+  network->infer();
+  const float* output = network->output();
 
   const unsigned int xScale = theCameraInfo.width / patchSize(0);
-  const unsigned int stepSize = network.output(0).rank() == 2 ? 2 : 1;
+  const unsigned int stepSize = network->getOutputDimensions().size() == 2 ? 2 : 1;
   for(int x = 0, idx = 0; x < patchSize(0); ++x, idx += stepSize)
   {
     const Vector2f spotInImage(x * xScale + xScale / 2, std::max(0.f, std::min(output[idx], 1.f)) * static_cast<float>(theCameraInfo.height - 1));
     DOT("module:FieldBoundaryProvider:prediction", spotInImage.x(), spotInImage.y(), ColorRGBA::orange, ColorRGBA::orange);
     float uncertainty = 0;
 
-    if(network.output(0).rank() == 2)
+    if(network->getOutputDimensions().size() == 2)
     {
       uncertainty = 1.f / (output[idx + 1] * output[idx + 1]) * static_cast<float>(theCameraInfo.height - 1);
       DOT("module:FieldBoundaryProvider:prediction", spotInImage.x(), spotInImage.y() + uncertainty, ColorRGBA::blue, ColorRGBA::blue);
@@ -15,10 +15,10 @@
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Tools/Inference/InferenceModel.h"
 #include "Tools/Math/Geometry.h"
 #include "Tools/Math/LeastSquares.h"
 #include "Tools/Module/Module.h"
-#include <CompiledNN/CompiledNN.h>
 #include <memory>
 
 ENUM(FittingMethod,
@@ -39,6 +39,8 @@ MODULE(FieldBoundaryProvider,
   PROVIDES(FieldBoundary),
   DEFINES_PARAMETERS(
   {,
+    (std::string)("net.h5") upperModelName, /**< The network for the upper camera in Config/NeuralNets/FieldBoundary (.h5 or .onnx). */
+    (std::string)("net-uncertainty.h5") lowerModelName, /**< The network for the lower camera in Config/NeuralNets/FieldBoundary (.h5 or .onnx). */
     (float)(100.f) minDistance, /**< Boundary spots closer than this distance will be ignored (in mm). */
     (FittingMethod)(NoFitting) fittingMethod, /**< Which line fitting should be used? */
     (unsigned)(10) minNumberOfSpots, /**< The minimum number of valid spots to calculate a field boundary. */
@@ -145,7 +147,6 @@ private:
 
   void fitBoundaryNotRansac(const std::vector<Spot>& spots, FieldBoundary& fieldBoundary);
 
-  std::unique_ptr<NeuralNetwork::Model> model; /** The model of the neural network. */
-  NeuralNetwork::CompiledNN network; /**< The compiled neural network. */
+  std::unique_ptr<InferenceModel> network; /**< The neural network. */
   Vector2i patchSize;  /**< The width and height of the neural network input image. */
 };
@@ -46,7 +46,10 @@ float RelativeFieldColorsProvider::approximateAverage(const Image<PixelTypes::Gr
   int step = 8;
   unsigned int samples = image.width / step;
   for(const auto y : yList)
+  {
+    theECImage.prepareRows(static_cast<int>(y), static_cast<int>(y) + 1);
     for(unsigned int x = 0; x < samples; ++x)
       sum += image[y][step * x + 2];
+  }
   return static_cast<float>(sum) / (static_cast<float>(yList.size()) * static_cast<float>(samples));
 }
@@ -124,6 +124,7 @@ void JerseyClassifierProvider::detectJersey(const ObstaclesImagePercept::Obstacl
       const std::function<bool(int, int)>& isOpponentKeeper = getPixelClassifier(theOpponentTeamInfo.goalkeeperColour, theOwnTeamInfo.goalkeeperColour, maxBrightness);
       float ownPixels = 0;
       float opponentPixels = 0;
+      theECImage.prepareRows(static_cast<int>(upperInImage.y()), static_cast<int>(lowerInImage.y()) + 1);
 
       for(float y = upperInImage.y(); y < lowerInImage.y();
           y += yStep, left = std::max(left + xyStep, 0.f), right = std::min(right + xyStep, static_cast<float>(theCameraInfo.width)))
@@ -16,30 +16,25 @@
 #include "Tools/Math/Eigen.h"
 #include "Tools/Math/Projection.h"
 #include "Tools/Math/Transformation.h"
-#include <CompiledNN/Model.h>
 
 MAKE_MODULE(PlayersDeeptector, perception);
 
-PlayersDeeptector::PlayersDeeptector() :
-  convModel(&Global::getAsmjitRuntime())
+PlayersDeeptector::PlayersDeeptector()
 {
-  NeuralNetwork::CompilationSettings settings;
-  settings.useExpApproxInSigmoid = false;
-  settings.useExpApproxInTanh = false;
+  InferenceModel::Settings settings;
+  settings.uint8Input = true;
+  settings.approximateExp = false;
 
   if(theCameraInfo.camera == CameraInfo::upper)
   {
-    model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + "/Config/NeuralNets/PlayersDeeptector/players_deeptector.h5");
-    model->setInputUInt8(0);
-    convModel.compile(*model, settings);
-    ASSERT(convModel.numOfInputs() == 1);
-    ASSERT(convModel.input(0).rank() == 3);
-    patchSize(0) = convModel.input(0).dims(1); // width
-    patchSize(1) = convModel.input(0).dims(0); // height
-    ASSERT(convModel.input(0).dims(2) == 1);
-    ASSERT(convModel.numOfOutputs() == 1);
-    ASSERT(convModel.output(0).rank() == 3);
-    ASSERT(convModel.output(0).dims(2) == 4 * 6);
+    convModel = InferenceModel::load(std::string(File::getBHDir()) + "/Config/NeuralNets/PlayersDeeptector/" + modelName, settings);
+    ASSERT(convModel);
+    ASSERT(convModel->getInputDimensions().size() == 3);
+    patchSize(0) = convModel->getInputDimensions()[1]; // width
+    patchSize(1) = convModel->getInputDimensions()[0]; // height
+    ASSERT(convModel->getInputDimensions()[2] == 1);
+    ASSERT(convModel->getOutputDimensions().size() == 3);
+    ASSERT(convModel->getOutputDimensions()[2] == 4 * 6);
 
     anchors.row(0) = Vector2f(0.5f, 1.f);
     anchors.row(1) = Vector2f(1.f, 2.f);
@@ -65,7 +60,7 @@ void PlayersDeeptector::update(ObstaclesFieldPercept& theObstaclesFieldPercept)
   if(theCameraInfo.camera == CameraInfo::upper)
   {
     LabelImage labelImage;
-    if(!convModel.valid() || !theFieldBoundary.isValid || !theECImage.grayscaled.width || !theECImage.grayscaled.height)
+    if(!convModel || !theFieldBoundary.isValid || !theECImage.grayscaled.width || !theECImage.grayscaled.height)
       return;
 
     const unsigned int scale = static_cast<unsigned int>(std::log2(theECImage.grayscaled.width / patchSize(0)) + 0.5);
@@ -76,10 +71,10 @@ void PlayersDeeptector::update(ObstaclesFieldPercept& theObstaclesFieldPercept)
     STOPWATCH("module:PlayersDeeptector:shrinkY") Resize::shrinkY(scale, theECImage.grayscaled, thumbnail);
     ASSERT(patchSize(0) == static_cast<int>(thumbnail.width));
     ASSERT(patchSize(1) == static_cast<int>(thumbnail.height));
-    std::memcpy(reinterpret_cast<unsigned char*>(convModel.input(0).data()), thumbnail[0], thumbnail.width * thumbnail.height * sizeof(unsigned char));
+    std::memcpy(convModel->input<unsigned char>(), thumbnail[0], thumbnail.width * thumbnail.height * sizeof(unsigned char));
     STOPWATCH("module:PlayersDeeptector:normalizeContrast")
-      PatchUtilities::normalizeContrast<unsigned char>(reinterpret_cast<unsigned char*>(convModel.input(0).data()), patchSize, 0.02f);
-    STOPWATCH("module:PlayersDeeptector:apply") convModel.apply();
+      PatchUtilities::normalizeContrast<unsigned char>(convModel->input<unsigned char>(), patchSize, 0.02f);
+    STOPWATCH("module:PlayersDeeptector:apply") convModel->infer();
     STOPWATCH("module:PlayersDeeptector:boundingBoxes") boundingBoxes(labelImage);
 
     STOPWATCH("module:PlayersDeeptector:nonMaximumSuppression") labelImage.nonMaximumSuppression(0.3f);
@@ -243,20 +238,22 @@ void PlayersDeeptector::update(ObstaclesPerceptorData& theObstaclesPerceptorData
 void PlayersDeeptector::boundingBoxes(LabelImage& labelImage)
 {
   const float threshold = -std::log(1.f / objectThres - 1);
-  for(unsigned y = 0; y < convModel.output(0).dims(0); ++y)
-    for(unsigned x = 0; x < convModel.output(0).dims(1); ++x)
+  const std::vector<unsigned>& outputDimensions = convModel->getOutputDimensions();
+  float* output = convModel->output();
+  for(unsigned y = 0; y < outputDimensions[0]; ++y)
+    for(unsigned x = 0; x < outputDimensions[1]; ++x)
       for(unsigned b = 0; b < 4; ++b)
       {
-        const size_t offset = (y * convModel.output(0).dims(1) + x) * 4 * 6;
-        if(convModel.output(0)[offset + b * 6 + 4] > threshold)
+        const size_t offset = (y * outputDimensions[1] + x) * 4 * 6;
+        if(output[offset + b * 6 + 4] > threshold)
         {
-          Eigen::Map<Eigen::Matrix<float, 4, 6, Eigen::RowMajor>> pred(convModel.output(0).data() + offset);
+          Eigen::Map<Eigen::Matrix<float, 4, 6, Eigen::RowMajor>> pred(output + offset);
           pred.array() = 1.f / (1.f + (pred * -1).array().exp());
 
-          pred.col(0) = (x + pred.col(0).array()).matrix() / convModel.output(0).dims(1) * theCameraInfo.width;
-          pred.col(1) = (y + pred.col(1).array()).matrix() / convModel.output(0).dims(0) * theCameraInfo.height;
-          pred.col(2).array() *= 10 * anchors.col(0).array() / convModel.output(0).dims(1) * theCameraInfo.width;
-          pred.col(3).array() *= 10 * anchors.col(1).array() / convModel.output(0).dims(0) * theCameraInfo.height;
+          pred.col(0) = (x + pred.col(0).array()).matrix() / outputDimensions[1] * theCameraInfo.width;
+          pred.col(1) = (y + pred.col(1).array()).matrix() / outputDimensions[0] * theCameraInfo.height;
+          pred.col(2).array() *= 10 * anchors.col(0).array() / outputDimensions[1] * theCameraInfo.width;
+          pred.col(3).array() *= 10 * anchors.col(1).array() / outputDimensions[0] * theCameraInfo.height;
           pred.col(5).array() *= 10;
 
           LabelImage::Annotation box;
@@ -316,6 +313,7 @@ bool PlayersDeeptector::trimObstacle(bool trimHeight, ObstaclesImagePercept::Obs
   {
     const Rangei yRange = Rangei(minY + (maxY - minY) / 4, maxY - 1);
     int step = stepSize, upperY = -1, lowerY = -1, botCan = obstacleInImage.bottom;
+    theECImage.prepareRows(yRange.min, yRange.max + 1);
     for(int side = 0; side < 2; ++side, step *= -1)
     {
       bool satRow = false, nonSatRow = false;
@@ -353,6 +351,9 @@ void PlayersDeeptector::scanImage(std::vector<std::vector<Region>>& regions)
     yLimits[index] = std::make_pair(theFieldBoundary.getBoundaryY(x), theBodyContour.getBottom(x, theCameraInfo.height));
   const float yRegionsDivisor = static_cast<float>(theECImage.grayscaled.height) / xyRegions, xRegionsDivisor = static_cast<float>(theECImage.grayscaled.width) / xyRegions;
 
+  // Saturation is only considered below the field boundary.
+  theECImage.prepareRows(theFieldBoundary.getBoundaryTopmostY(theCameraInfo.width), theCameraInfo.height);
+
   std::pair<const PixelTypes::GrayscaledPixel*, const PixelTypes::GrayscaledPixel*> upperRow = {theECImage.grayscaled[0], theECImage.saturated[0]};
   std::pair<const PixelTypes::GrayscaledPixel*, const PixelTypes::GrayscaledPixel*> midRow = upperRow;
   std::pair<const PixelTypes::GrayscaledPixel*, const PixelTypes::GrayscaledPixel*> lowerRow;
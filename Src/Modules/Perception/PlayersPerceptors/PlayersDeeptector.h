@@ -24,8 +24,8 @@
 #include "Representations/Perception/ObstaclesPercepts/ObstaclesPerceptorData.h"
 #include "Tools/Math/Eigen.h"
 #include "Tools/ImageProcessing/InImageSizeCalculations.h"
+#include "Tools/Inference/InferenceModel.h"
 #include "Tools/Module/Module.h"
-#include <CompiledNN/CompiledNN.h>
 
 MODULE(PlayersDeeptector,
 {,
@@ -47,6 +47,7 @@ MODULE(PlayersDeeptector,
   PROVIDES(ObstaclesPerceptorData),
   DEFINES_PARAMETERS(
   {,
+    (std::string)("players_deeptector.h5") modelName, /**< The network in Config/NeuralNets/PlayersDeeptector (.h5 or .onnx). */
     (float)(0.7f) objectThres, /**< Limit from which a robot is accepted. */ // 0.6f
     (unsigned int)(2) xyStep, /** Step size in x/y direction for scanning the image. */
     (unsigned int)(16) xyRegions, /** Number of regions in x/y direction. */
@@ -71,8 +72,7 @@ public:
 
 private:
   Vector2i patchSize;
-  std::unique_ptr<NeuralNetwork::Model> model;
-  NeuralNetwork::CompiledNN convModel;
+  std::unique_ptr<InferenceModel> convModel;
   Image<PixelTypes::GrayscaledPixel> thumbnail;
   Matrix4x2f anchors;
   std::vector<ObstaclesImagePercept::Obstacle> obstaclesUpper, obstaclesLower;
@@ -48,6 +48,7 @@ void ScanLineRegionizer::update(ColorScanLineRegionsHorizontal& colorScanLineReg
   LINE("module:ScanLineRegionizer:horizontalRegionSplit", 0, middle, theECImage.grayscaled.width, middle, 3, Drawings::PenStyle::dottedPen, ColorRGBA(80, 6, 80));
 
   const int top = std::max(theFieldBoundary.getBoundaryTopmostY(theCameraInfo.width), theScanGrid.fieldLimit);
+  theECImage.prepareRows(top, theCameraInfo.height);
   int usedY = static_cast<int>(theECImage.grayscaled.height) + minHorizontalScanLineDistance;
   for(int y : theScanGrid.y)
   {
@@ -142,12 +143,25 @@ void ScanLineRegionizer::update(ColorScanLineRegionsVerticalClipped& colorScanLi
                      Transformation::robotWithCameraRotationToImage(additionalSmoothingPoint, theCameraMatrix, theCameraInfo, pointInImage) ?
                      static_cast<const int>(pointInImage.y()) : theCameraInfo.height - 1;
   LINE("module:ScanLineRegionizer:verticalRegionSplit", 0, middle, theECImage.grayscaled.width, middle, 3, Drawings::PenStyle::dottedPen, ColorRGBA(80, 6, 80));
-  for(std::size_t i = 0; i < theScanGrid.lines.size(); ++i)
+  theECImage.prepareRows(std::max(theFieldBoundary.getBoundaryTopmostY(theCameraInfo.width), theScanGrid.fieldLimit), theCameraInfo.height);
+  std::vector<int> tops(numOfScanLines);
+  for(std::size_t i = 0; i < numOfScanLines; ++i)
   {
     xPerScanLine[i] = static_cast<unsigned short>(theScanGrid.lines[i].x);
-    const int top = std::max(theFieldBoundary.getBoundaryY(theScanGrid.lines[i].x), theScanGrid.fieldLimit) + 1;
-    scanVertical(theScanGrid.lines[i], middle, top, regionsPerScanLine[i]);
+    tops[i] = std::max(theFieldBoundary.getBoundaryY(theScanGrid.lines[i].x), theScanGrid.fieldLimit) + 1;
+  }
+  if(transposeVerticalScanLines)
+  {
+    columnsToCopy.clear();
+    for(std::size_t i = 0; i < numOfScanLines; ++i)
+      columnsToCopy.emplace_back(getColumnToCopy(theScanGrid.lines[i], tops[i]));
+    scanLineColumns.update(theECImage.grayscaled, theECImage.saturated, theECImage.hued, columnsToCopy);
+    for(std::size_t i = 0; i < numOfScanLines; ++i)
+      scanVertical(theScanGrid.lines[i], TransposedColumn{scanLineColumns, i}, middle, tops[i], regionsPerScanLine[i]);
   }
+  else
+    for(std::size_t i = 0; i < numOfScanLines; ++i)
+      scanVertical(theScanGrid.lines[i], ImageColumn{theECImage, theScanGrid.lines[i].x}, middle, tops[i], regionsPerScanLine[i]);
 
   // 2. Classify field regions.
   uniteVerticalFieldRegions(xPerScanLine, regionsPerScanLine);
@@ -509,7 +523,69 @@ int ScanLineRegionizer::horizontalScanStop(const int x, const int y) const
   return 1;
 }
 
-void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, int top, std::vector<InternalRegion>& regions) const
+ScanLineColumns::Column ScanLineRegionizer::getColumnToCopy(const ScanGrid::Line& line, int top) const
+{
+  // The same conditions and ranges as in scanVertical.
+  if(line.x < 1 || static_cast<unsigned int>(line.x + 1) >= theECImage.grayscaled.width || line.yMax <= std::max(2, top))
+    return {line.x, 0, 0};
+  const int lowestY = std::min<int>(line.yMax - 2, static_cast<int>(theECImage.grayscaled.height) - 3);
+  return {line.x, top, lowestY + 3};
+}
+
+int ScanLineRegionizer::ImageColumn::gauss3(int y) const
+{
+  const PixelTypes::GrayscaledPixel* const p = &image.grayscaled[y][x];
+  return static_cast<int>(p[-1] + 2 * p[0] + p[1]);
+}
+
+int ScanLineRegionizer::ImageColumn::gauss5(int y) const
+{
+  const PixelTypes::GrayscaledPixel* const p = &image.grayscaled[y][x];
+  return static_cast<int>(p[-2] + 2 * p[-1] + 4 * p[0] + 2 * p[1] + p[2]);
+}
+
+PixelTypes::GrayscaledPixel ScanLineRegionizer::ImageColumn::grayscaled(unsigned int from, unsigned int to) const
+{
+  return getVerticalRepresentativeValue(image.grayscaled, x, from, to);
+}
+
+PixelTypes::GrayscaledPixel ScanLineRegionizer::ImageColumn::saturated(unsigned int from, unsigned int to) const
+{
+  return getVerticalRepresentativeValue(image.saturated, x, from, to);
+}
+
+PixelTypes::HuePixel ScanLineRegionizer::ImageColumn::hued(unsigned int from, unsigned int to) const
+{
+  return getVerticalRepresentativeHueValue(image.hued, x, from, to);
+}
+
+int ScanLineRegionizer::TransposedColumn::gauss3(int y) const
+{
+  return columns.gauss3(index)[y];
+}
+
+int ScanLineRegionizer::TransposedColumn::gauss5(int y) const
+{
+  return columns.gauss5(index)[y];
+}
+
+PixelTypes::GrayscaledPixel ScanLineRegionizer::TransposedColumn::grayscaled(unsigned int from, unsigned int to) const
+{
+  return getRepresentativeValue(columns.grayscaled(index), from, to);
+}
+
+PixelTypes::GrayscaledPixel ScanLineRegionizer::TransposedColumn::saturated(unsigned int from, unsigned int to) const
+{
+  return getRepresentativeValue(columns.saturated(index), from, to);
+}
+
+PixelTypes::HuePixel ScanLineRegionizer::TransposedColumn::hued(unsigned int from, unsigned int to) const
+{
+  return getRepresentativeHueValue(columns.hued(index), from, to);
+}
+
+template<typename Column>
+void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, const Column& column, int middle, int top, std::vector<InternalRegion>& regions) const
 {
   if(line.x < 1 || static_cast<unsigned int>(line.x + 1) >= theECImage.grayscaled.width || line.yMax <= std::max(2, top))
     return;
@@ -521,7 +597,6 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
   ASSERT(top >= 0); // 3x3 filter stop exclusive
   const int lowestY = std::min<int>(line.yMax - 2, static_cast<int>(theECImage.grayscaled.height) - 3); // 5x5 filter start
   const int middleY = std::min(std::max<int>(middle + 1, top + 1), lowestY + 1); // 5x5 filter stop exclusive, 3x3 filter start
-  const PixelTypes::GrayscaledPixel* luminance = &theECImage.grayscaled[lowestY][line.x];
   // grid variables
   int gridY = std::max(lowestY, middleY);
   int gridValue = 0;
@@ -536,10 +611,6 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
   // start with 5x5 filter
   if(lowestY > middleY)
   {
-    auto smoothedGauss = [](const PixelTypes::GrayscaledPixel* line) // 5x5 gauss horizontal
-    {
-      return static_cast<int>(line[-2] + 2 * line[-1] + 4 * line[0] + 2 * line[1] + line[2]);
-    };
     auto smoothedGaussSecond = [](std::array<int, 5>& gaussBuffer, int y) // 5x5 gauss vertical
     {
       return gaussBuffer[(y - 2) % 5] + 2 * gaussBuffer[(y - 1) % 5] + 4 * gaussBuffer[y % 5] +
@@ -552,31 +623,30 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
     // Initialize the buffer of smoothed values.
     std::array<int, 5> lowerGauss = {}; // buffer for the lower grid point and for sobel scans
     std::array<int, 5> upperGauss = {}; // buffer for the upper grid point, centered around grid point -> gridX is at index 2
-    lowerGauss[0] = smoothedGauss(luminance + 2 * theECImage.grayscaled.width);
-    lowerGauss[1] = smoothedGauss(luminance + theECImage.grayscaled.width);
-    lowerGauss[2] = smoothedGauss(luminance);
-    lowerGauss[3] = smoothedGauss(luminance -= theECImage.grayscaled.width);
-    lowerGauss[4] = smoothedGauss(luminance -= theECImage.grayscaled.width);
+    lowerGauss[0] = column.gauss5(lowestY + 2); // 5x5 gauss horizontal
+    lowerGauss[1] = column.gauss5(lowestY + 1);
+    lowerGauss[2] = column.gauss5(lowestY);
+    lowerGauss[3] = column.gauss5(lowestY - 1);
+    lowerGauss[4] = column.gauss5(lowestY - 2);
     gridValue = smoothedGaussSecond(lowerGauss, 2);
 
     while(nextGridY > middleY && gridYIndex <= theScanGrid.y.size())
     {
-      upperGauss[0] = smoothedGauss(&theECImage.grayscaled[nextGridY + 2][line.x]);
-      upperGauss[1] = smoothedGauss(&theECImage.grayscaled[nextGridY + 1][line.x]);
-      upperGauss[2] = smoothedGauss(&theECImage.grayscaled[nextGridY][line.x]);
-      upperGauss[3] = smoothedGauss(&theECImage.grayscaled[nextGridY - 1][line.x]);
-      upperGauss[4] = smoothedGauss(&theECImage.grayscaled[nextGridY - 2][line.x]);
+      upperGauss[0] = column.gauss5(nextGridY + 2);
+      upperGauss[1] = column.gauss5(nextGridY + 1);
+      upperGauss[2] = column.gauss5(nextGridY);
+      upperGauss[3] = column.gauss5(nextGridY - 1);
+      upperGauss[4] = column.gauss5(nextGridY - 2);
       nextGridValue = smoothedGaussSecond(upperGauss, 2);
       if(gridValue - nextGridValue >= threshold)
       {
         // find exact edge position
         unsigned int edgeYMax = gridY;
         int sobelMax = smoothedGradient(lowerGauss, 2);
-        luminance = &theECImage.grayscaled[gridY - 1][line.x];
         int gaussBufferIndex = 0;
-        for(int y = gridY - 1; y > nextGridY; --y, ++gaussBufferIndex, luminance -= theECImage.grayscaled.width)
+        for(int y = gridY - 1; y > nextGridY; --y, ++gaussBufferIndex)
         {
-          lowerGauss[gaussBufferIndex % 5] = smoothedGauss(luminance);
+          lowerGauss[gaussBufferIndex % 5] = column.gauss5(y);
           int sobelL = smoothedGradient(lowerGauss, gaussBufferIndex + 3);
           if(sobelL > sobelMax)
           {
@@ -586,9 +656,7 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
         }
         // save region
         ASSERT(lowerY > edgeYMax);
-        regions.emplace_back(edgeYMax, lowerY, getVerticalRepresentativeValue(theECImage.grayscaled, line.x, edgeYMax, lowerY),
-                             getVerticalRepresentativeHueValue(theECImage.hued, line.x, edgeYMax, lowerY),
-                             getVerticalRepresentativeValue(theECImage.saturated, line.x, edgeYMax, lowerY));
+        regions.emplace_back(edgeYMax, lowerY, column.grayscaled(edgeYMax, lowerY), column.hued(edgeYMax, lowerY), column.saturated(edgeYMax, lowerY));
         lowerY = edgeYMax;
         MID_DOT("module:ScanLineRegionizer:verticalRegionSplit", line.x, edgeYMax, ColorRGBA::magenta, ColorRGBA::magenta);
       }
@@ -597,11 +665,10 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
         // find exact edge position
         unsigned int edgeYMin = gridY;
         int sobelMin = smoothedGradient(lowerGauss, 2);
-        luminance = &theECImage.grayscaled[gridY - 1][line.x];
         int gaussBufferIndex = 0;
-        for(int y = gridY - 1; y > nextGridY; --y, ++gaussBufferIndex, luminance -= theECImage.grayscaled.width)
+        for(int y = gridY - 1; y > nextGridY; --y, ++gaussBufferIndex)
         {
-          lowerGauss[gaussBufferIndex % 5] = smoothedGauss(luminance);
+          lowerGauss[gaussBufferIndex % 5] = column.gauss5(y);
           int sobelL = smoothedGradient(lowerGauss, gaussBufferIndex + 3);
           if(sobelL < sobelMin)
           {
@@ -611,9 +678,7 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
         }
         // save region
         ASSERT(lowerY > edgeYMin);
-        regions.emplace_back(edgeYMin, lowerY, getVerticalRepresentativeValue(theECImage.grayscaled, line.x, edgeYMin, lowerY),
-                             getVerticalRepresentativeHueValue(theECImage.hued, line.x, edgeYMin, lowerY),
-                             getVerticalRepresentativeValue(theECImage.saturated, line.x, edgeYMin, lowerY));
+        regions.emplace_back(edgeYMin, lowerY, column.grayscaled(edgeYMin, lowerY), column.hued(edgeYMin, lowerY), column.saturated(edgeYMin, lowerY));
         lowerY = edgeYMin;
         MID_DOT("module:ScanLineRegionizer:verticalRegionSplit", line.x, edgeYMin, ColorRGBA::magenta, ColorRGBA::magenta);
       }
@@ -637,10 +702,6 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
   // switch to 3x3 filter
   if(middleY > top)
   {
-    auto gauss = [](const PixelTypes::GrayscaledPixel* line) // 3x3 gauss horizontal
-    {
-      return static_cast<int>(line[-1] + 2 * line[0] + line[1]);
-    };
     auto gaussSecond = [](std::array<int, 3>& gaussBuffer, int y) // 3x3 gauss vertical
     {
       return gaussBuffer[(y - 1) % 3] + 2 * gaussBuffer[y % 3] + gaussBuffer[(y + 1) % 3];
@@ -651,9 +712,8 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
     };
     // Initialize the buffer of smoothed values.
     std::array<int, 3> gaussBuffer{};
-    luminance = &theECImage.grayscaled[gridY][line.x];
-    gaussBuffer[0] = gauss(luminance + theECImage.grayscaled.width);
-    gaussBuffer[1] = gauss(luminance);
+    gaussBuffer[0] = column.gauss3(gridY + 1); // 3x3 gauss horizontal
+    gaussBuffer[1] = column.gauss3(gridY);
     int gaussBufferIndex = 2;
     int prevSobelMin = std::numeric_limits<int>::max();
     int prevSobelMax = std::numeric_limits<int>::min();
@@ -665,7 +725,7 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
     for(int y = gridY; y > top; --y)
     {
       // This line is one above the current y.
-      gaussBuffer[gaussBufferIndex % 3] = gauss(luminance -= theECImage.grayscaled.width);
+      gaussBuffer[gaussBufferIndex % 3] = column.gauss3(y - 1);
       ++gaussBufferIndex;
       // This gradient is centered around the current y.
       int sobelL = gradient(gaussBuffer, gaussBufferIndex - 2);
@@ -689,9 +749,7 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
         if(gridValue - nextGridValue >= threshold)
         {
           ASSERT(lowerY > edgeYMax);
-          regions.emplace_back(edgeYMax, lowerY, getVerticalRepresentativeValue(theECImage.grayscaled, line.x, edgeYMax, lowerY),
-                               getVerticalRepresentativeHueValue(theECImage.hued, line.x, edgeYMax, lowerY),
-                               getVerticalRepresentativeValue(theECImage.saturated, line.x, edgeYMax, lowerY));
+          regions.emplace_back(edgeYMax, lowerY, column.grayscaled(edgeYMax, lowerY), column.hued(edgeYMax, lowerY), column.saturated(edgeYMax, lowerY));
           lowerY = edgeYMax;
           MID_DOT("module:ScanLineRegionizer:verticalRegionSplit", line.x, edgeYMax, ColorRGBA::magenta, ColorRGBA::magenta);
           if(prelabelAsWhite && nextRegionWhite && prelabelWhiteCheck(regions.back()) &&
@@ -702,9 +760,7 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
         else if(gridValue - nextGridValue <= -threshold)
         {
           ASSERT(lowerY > edgeYMin);
-          regions.emplace_back(edgeYMin, lowerY, getVerticalRepresentativeValue(theECImage.grayscaled, line.x, edgeYMin, lowerY),
-                               getVerticalRepresentativeHueValue(theECImage.hued, line.x, edgeYMin, lowerY),
-                               getVerticalRepresentativeValue(theECImage.saturated, line.x, edgeYMin, lowerY));
+          regions.emplace_back(edgeYMin, lowerY, column.grayscaled(edgeYMin, lowerY), column.hued(edgeYMin, lowerY), column.saturated(edgeYMin, lowerY));
           lowerY = edgeYMin;
           MID_DOT("module:ScanLineRegionizer:verticalRegionSplit", line.x, edgeYMin, ColorRGBA::magenta, ColorRGBA::magenta);
           nextRegionWhite = true;
@@ -733,8 +789,7 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
   }
   // add last region
   ASSERT(lowerY > static_cast<unsigned int>(top));
-  regions.emplace_back(top, lowerY, getVerticalRepresentativeValue(theECImage.grayscaled, line.x, top, lowerY),
-                       getVerticalRepresentativeHueValue(theECImage.hued, line.x, top, lowerY), getVerticalRepresentativeValue(theECImage.saturated, line.x, top, lowerY));
+  regions.emplace_back(top, lowerY, column.grayscaled(top, lowerY), column.hued(top, lowerY), column.saturated(top, lowerY));
 }
 
 void ScanLineRegionizer::uniteHorizontalFieldRegions(const std::vector<unsigned short>& y, std::vector<std::vector<InternalRegion>>& regions) const
@@ -1149,34 +1204,34 @@ bool ScanLineRegionizer::isEstimatedFieldColorValid() const
   return theFrameInfo.getTimeSince(estimatedFieldColor.lastSet) <= estimatedFieldColorInvalidationTime;
 }
 
-PixelTypes::GrayscaledPixel ScanLineRegionizer::getHorizontalRepresentativeValue(const Image<PixelTypes::GrayscaledPixel>& image,
-                                                                                 const unsigned int from, const unsigned int to, const unsigned int y)
+PixelTypes::GrayscaledPixel ScanLineRegionizer::getRepresentativeValue(const PixelTypes::GrayscaledPixel* pixels,
+                                                                       const unsigned int from, const unsigned int to)
 {
   ASSERT(to > from);
   const unsigned int length = to - from;
   unsigned int sum = 0;
   if(length <= 6)
   {
-    for(unsigned int x = from; x < to; ++x) // take every pixel from very small regions
-      sum += image[y][x];
+    for(unsigned int i = from; i < to; ++i) // take every pixel from very small regions
+      sum += pixels[i];
     return static_cast<unsigned char>(sum / length);
   }
   if(length <= 19)
   {
     // take every second pixel from small to middle sized regions
-    for(unsigned int x = from + 1; x < to - 1; x += 2) // don't start or stop in the edge of the region
-      sum += image[y][x];
+    for(unsigned int i = from + 1; i < to - 1; i += 2) // don't start or stop in the edge of the region
+      sum += pixels[i];
     return static_cast<unsigned char>(sum / ((length - 1) / 2));
   }
   // take every fourth pixel for bigger regions
-  for(unsigned int x = from + 2; x < to - 1; x += 4) // don't start or stop in the edge of the region
-    sum += image[y][x];
+  for(unsigned int i = from + 2; i < to - 1; i += 4) // don't start or stop in the edge of the region
+    sum += pixels[i];
   // this relies on (length / 4) being floored; expanding to 4*sum/length will lead to false results
   return static_cast<unsigned char>(sum / (length / 4));
 }
 
-PixelTypes::HuePixel ScanLineRegionizer::getHorizontalRepresentativeHueValue(const Image<PixelTypes::HuePixel>& image,
-                                                                             unsigned int from, unsigned int to, unsigned int y)
+PixelTypes::HuePixel ScanLineRegionizer::getRepresentativeHueValue(const PixelTypes::HuePixel* pixels,
+                                                                   const unsigned int from, const unsigned int to)
 {
   ASSERT(to > from);
   const unsigned int length = to - from;
@@ -1184,23 +1239,35 @@ PixelTypes::HuePixel ScanLineRegionizer::getHorizontalRepresentativeHueValue(con
   int currentStep = 1;
   if(length <= 6)
   {
-    for(unsigned int x = from; x < to; ++x, ++currentStep) // take every pixel from very small regions
-      hueValue = ScanLineRegionizer::hueAverage(hueValue, image[y][x], currentStep);
+    for(unsigned int i = from; i < to; ++i, ++currentStep) // take every pixel from very small regions
+      hueValue = ScanLineRegionizer::hueAverage(hueValue, pixels[i], currentStep);
     return static_cast<unsigned char>(hueValue);
   }
   if(length <= 19)
   {
     // take every second pixel from small to middle sized regions
-    for(unsigned int x = from + 1; x < to - 1; x += 2, ++currentStep) // don't start or stop in the edge of the region
-      hueValue = ScanLineRegionizer::hueAverage(hueValue, image[y][x], currentStep);
+    for(unsigned int i = from + 1; i < to - 1; i += 2, ++currentStep) // don't start or stop in the edge of the region
+      hueValue = ScanLineRegionizer::hueAverage(hueValue, pixels[i], currentStep);
     return static_cast<unsigned char>(hueValue);
   }
   // take every fourth pixel for bigger regions
-  for(unsigned int x = from + 2; x < to - 1; x += 4, ++currentStep) // don't start or stop in the edge of the region
-    hueValue = ScanLineRegionizer::hueAverage(hueValue, image[y][x], currentStep);
+  for(unsigned int i = from + 2; i < to - 1; i += 4, ++currentStep) // don't start or stop in the edge of the region
+    hueValue = ScanLineRegionizer::hueAverage(hueValue, pixels[i], currentStep);
   return static_cast<unsigned char>(hueValue);
 }
 
+PixelTypes::GrayscaledPixel ScanLineRegionizer::getHorizontalRepresentativeValue(const Image<PixelTypes::GrayscaledPixel>& image,
+                                                                                 const unsigned int from, const unsigned int to, const unsigned int y)
+{
+  return getRepresentativeValue(image[y], from, to);
+}
+
+PixelTypes::HuePixel ScanLineRegionizer::getHorizontalRepresentativeHueValue(const Image<PixelTypes::HuePixel>& image,
+                                                                             unsigned int from, unsigned int to, unsigned int y)
+{
+  return getRepresentativeHueValue(image[y], from, to);
+}
+
 PixelTypes::GrayscaledPixel ScanLineRegionizer::getVerticalRepresentativeValue(const Image<PixelTypes::GrayscaledPixel>& image,
                                                                                const unsigned int x, const unsigned int from, const unsigned int to)
 {
@@ -22,6 +22,7 @@
 #include "Representations/Perception/ImagePreprocessing/RelativeFieldColors.h"
 #include "Representations/Perception/ImagePreprocessing/ScanGrid.h"
 #include "Tools/ImageProcessing/PixelTypes.h"
+#include "Tools/ImageProcessing/ScanLineColumns.h"
 #include "Tools/Module/Module.h"
 
 #include <limits>
@@ -55,6 +56,7 @@ MODULE(ScanLineRegionizer,
     (short)(20) maxPrelabelRegionSize,                 /**< Maximum region size to prelabel as white */
     (short)(12) maxRegionSizeForStitching,             /**< Maximum size in pixels of a none region between field and white or field and field for stitching */
     (int)(400) estimatedFieldColorInvalidationTime,    /**< Time in ms until the EstimatedFieldColor is invalidated */
+    (bool)(false) transposeVerticalScanLines,          /**< Copy the columns of the vertical scan lines to contiguous memory before scanning them */
       }),
 });
 
@@ -152,6 +154,35 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
     }
   };
 
+  /** Accesses the column of a vertical scan line directly in the image. */
+  struct ImageColumn
+  {
+    const ECImage& image; /**< The image. */
+    int x; /**< The x coordinate of the scan line. */
+
+    int gauss3(int y) const;
+    int gauss5(int y) const;
+    PixelTypes::GrayscaledPixel grayscaled(unsigned int from, unsigned int to) const;
+    PixelTypes::GrayscaledPixel saturated(unsigned int from, unsigned int to) const;
+    PixelTypes::HuePixel hued(unsigned int from, unsigned int to) const;
+  };
+
+  /** Accesses the column of a vertical scan line in the contiguous copies. */
+  struct TransposedColumn
+  {
+    const ScanLineColumns& columns; /**< The copied columns. */
+    std::size_t index; /**< The index of the scan line. */
+
+    int gauss3(int y) const;
+    int gauss5(int y) const;
+    PixelTypes::GrayscaledPixel grayscaled(unsigned int from, unsigned int to) const;
+    PixelTypes::GrayscaledPixel saturated(unsigned int from, unsigned int to) const;
+    PixelTypes::HuePixel hued(unsigned int from, unsigned int to) const;
+  };
+
+  ScanLineColumns scanLineColumns; /**< The contiguous copies of the columns of the vertical scan lines. */
+  std::vector<ScanLineColumns::Column> columnsToCopy; /**< The ranges of the columns that are copied. */
+
   /**
    * Updates the horizontal color scan line regions.
    * @param colorScanLineRegionsHorizontal The provided representation.
@@ -217,12 +248,23 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
 
   /**
    * Creates regions along a vertical scan line.
+   * @tparam Column The type that accesses the pixels of the scan line.
    * @param line The scan grid line on which the scan is performed.
+   * @param column The pixels of the scan line.
    * @param middle The y coordinate at which to switch between 5x5 and 3x3 filter
    * @param top The y coordinate (inclusive) below which the useful part of the image is located.
    * @param regions he regions to be filled.
    */
-  void scanVertical(const ScanGrid::Line& line, int middle, int top, std::vector<InternalRegion>& regions) const;
+  template<typename Column>
+  void scanVertical(const ScanGrid::Line& line, const Column& column, int middle, int top, std::vector<InternalRegion>& regions) const;
+
+  /**
+   * Determines the rows of a vertical scan line that scanVertical reads.
+   * @param line The scan grid line on which the scan is performed.
+   * @param top The y coordinate (inclusive) below which the useful part of the image is located.
+   * @return The column to copy. Its range is empty if the scan line is not scanned.
+   */
+  [[nodiscard]] ScanLineColumns::Column getColumnToCopy(const ScanGrid::Line& line, int top) const;
 
   /**
    * Unites similar horizontal scan line regions.
@@ -301,6 +343,22 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    */
   [[nodiscard]] bool isEstimatedFieldColorValid() const;
 
+  /**
+   * Gets a grayscale value that is representative for a region of consecutive pixels.
+   * @param pixels The pixels.
+   * @param from The index of the first pixel of the region (inclusive).
+   * @param to The index of the last pixel of the region (exclusive).
+   */
+  static PixelTypes::GrayscaledPixel getRepresentativeValue(const PixelTypes::GrayscaledPixel* pixels, unsigned int from, unsigned int to);
+
+  /**
+   * Gets a hue value that is representative for a region of consecutive pixels.
+   * @param pixels The pixels.
+   * @param from The index of the first pixel of the region (inclusive).
+   * @param to The index of the last pixel of the region (exclusive).
+   */
+  static PixelTypes::HuePixel getRepresentativeHueValue(const PixelTypes::HuePixel* pixels, unsigned int from, unsigned int to);
+
   /**
    * Gets an image grayscale value that is representative for a given horizontal region.
    * @param image The image.
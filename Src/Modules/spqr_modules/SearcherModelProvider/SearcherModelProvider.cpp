@@ -5,71 +5,104 @@
 
 
 #include "SearcherModelProvider.h"
+#include "Tools/Math/Approx.h"
+#include <algorithm>
+#include <cmath>
 using namespace std;
 
-Vector2f fieldOfViewVector1, fieldOfViewVector2;
+static void assignWeight(SearcherModel& model, int i, float timestampComponent, float distanceComponent){
+  if(model.types[i] == SearcherModel::CellType::standard)
+    model.searchWeights[i] = timestampComponent*(distanceComponent+model.ballComponentValues[i]);
+
+  else if(model.types[i] == SearcherModel::CellType::ballComponentSeenWeak ||
+          model.types[i] == SearcherModel::CellType::ballComponentSeenStrong)
+    model.searchWeights[i] = timestampComponent*distanceComponent;
 
-static void assignWeight(SearcherModel::Cell& c, float timestampComponent, float distanceComponent){
-  if(c.type == SearcherModel::Cell::CellType::standard)
-    c.searchWeight = timestampComponent*(distanceComponent+c.ballComponentValue);
-      
-  else if(c.type == SearcherModel::Cell::CellType::ballComponentSeenWeak ||
-          c.type == SearcherModel::Cell::CellType::ballComponentSeenStrong)
-    c.searchWeight = timestampComponent*distanceComponent;
-      
   else
-    c.searchWeight = 0;
+    model.searchWeights[i] = 0;
 }
 
-float SearcherModelProvider::compute2dGaussianKernel(SearcherModel::Cell cell){ 
-
-  auto getBestBall = [&](){
-    if(theFieldBall.ballWasSeen(10000))
-      return theFieldBall.endPositionOnField;
-    else
-      return theFieldBall.teamEndPositionOnField;
-  };
+bool SearcherModelProvider::computeFieldOfView(){
+  if(!theCameraMatrix.isValid)
+    return false;
 
-  Vector2f maxPoint = getBestBall();
-  double sigma = sigmaNormalizationRate * (theFrameInfo.time - theTeamBallModel.timeWhenLastSeen);
-  sigma = std::max(0.0001, sigma); //avoid division by zero -> Nan
-  double sigma2 = sigma*sigma;
+  Projection::computeFieldOfViewInFieldCoordinates(theRobotPose, theCameraMatrix, theCameraInfo, theFieldDimensions, fieldOfViewCorners);
 
-  Vector2f translation = cell.positionOnField - maxPoint;
-  double res = 1.f / (2 * M_PI * sigma2) * exp(-(translation.x() * translation.x() + translation.y() * translation.y()) / (2 * sigma2));
+  // The cameras sees the sector between the rays through the corners 2 and 3.
+  const Vector2f& robot = theRobotPose.translation;
+  float start = (fieldOfViewCorners[2] - robot).angle();
+  float opening = Angle::normalize((fieldOfViewCorners[3] - robot).angle() - start);
+  if(opening < 0){
+    start += opening;
+    opening = -opening;
+  }
+  if(Approx::isZero(opening))
+    return false;
 
-  double normalizedWeight = 2*gaussianMax * M_PI * sigma2;
-  return res*normalizedWeight;
+  constexpr int arcSegments = 8;
+  sector.clear();
+  sector.push_back(robot);
+  for(int i = 0; i <= arcSegments; ++i)
+    sector.push_back(robot + Vector2f(fieldOfViewFarTh, 0.f).rotate(start + opening * static_cast<float>(i) / arcSegments));
+
+  // Only the part in front of the robot is considered seen.
+  const Vector2f forward = Vector2f(1.f, 0.f).rotate(theRobotPose.rotation);
+  fieldOfView.clear();
+  for(size_t i = 0; i < sector.size(); ++i){
+    const Vector2f& current = sector[i];
+    const Vector2f& next = sector[(i + 1) % sector.size()];
+    const float currentDistance = (current - robot).dot(forward);
+    const float nextDistance = (next - robot).dot(forward);
+    if(currentDistance >= 0)
+      fieldOfView.push_back(current);
+    if((currentDistance >= 0) != (nextDistance >= 0))
+      fieldOfView.push_back(current + (next - current) * (currentDistance / (currentDistance - nextDistance)));
+  }
+  return fieldOfView.size() >= 3;
 }
 
-bool SearcherModelProvider::isInsideFieldOfView(SearcherModel::Cell cell){
-  LocalPose2f cellPositionRelative = theLibMisc.glob2Rel(cell.positionOnField.x(), cell.positionOnField.y()).translation;
-
-  if(cellPositionRelative.translation.x() < 0)
-    return false;
+void SearcherModelProvider::rasterize(const SearcherModel& searcherModel, const std::vector<Vector2f>& polygon, Visibility from, Visibility to){
+  if(polygon.size() < 3)
+    return;
 
-  //the cell is too far
-  if((theRobotPose.translation-cell.positionOnField).norm() > fieldOfViewFarTh)
-    return false;
-      
-  int pointsInsideFov = 0;
-  Vector2f cellPointVector;
-  float fieldOfViewAngle1, fieldOfViewAngle2;
-
-  for(int i = 0; i < 4 && pointsInsideFov < 3; ++i){
-    cellPointVector = Vector2f(cell.polygon[i].x() - theRobotPose.translation.x(), cell.polygon[i].y() - theRobotPose.translation.y());
-    fieldOfViewAngle1 = theLibMisc.angleBetweenVectors(fieldOfViewVector1, cellPointVector);
-    fieldOfViewAngle2 = theLibMisc.angleBetweenVectors(fieldOfViewVector2, cellPointVector);
-    pointsInsideFov += (fieldOfViewAngle1 * fieldOfViewAngle2) > 0 ? 0 : 1 ;
+  float yMin = polygon[0].y(),
+        yMax = polygon[0].y();
+  for(const Vector2f& corner : polygon){
+    yMin = min(yMin, corner.y());
+    yMax = max(yMax, corner.y());
   }
 
-  if(pointsInsideFov < 3){
-    cellPointVector = Vector2f(cell.positionOnField.x() - theRobotPose.translation.x(), cell.positionOnField.y() - theRobotPose.translation.y());
-    fieldOfViewAngle1 = theLibMisc.angleBetweenVectors(fieldOfViewVector1, cellPointVector);
-    fieldOfViewAngle2 = theLibMisc.angleBetweenVectors(fieldOfViewVector2, cellPointVector);
-    pointsInsideFov += fieldOfViewAngle1 * fieldOfViewAngle2 > 0 ? 0 : 1 ;
+  // the rows whose centers are inside the vertical extent of the polygon
+  const int firstRow = max(0, static_cast<int>(ceil((yMin - searcherModel.origin.y()) / searcherModel.cellLengthY - 0.5f)));
+  const int lastRow = min(searcherModel.numOfCellsY - 1,
+                          static_cast<int>(floor((yMax - searcherModel.origin.y()) / searcherModel.cellLengthY - 0.5f)));
+
+  for(int row = firstRow; row <= lastRow; ++row){
+    const float y = searcherModel.origin.y() + (static_cast<float>(row) + 0.5f) * searcherModel.cellLengthY;
+
+    // a scanline intersects a convex polygon in a single interval
+    float xMin = INFINITY,
+          xMax = -INFINITY;
+    for(size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++){
+      const Vector2f& a = polygon[j];
+      const Vector2f& b = polygon[i];
+      if((a.y() <= y) != (b.y() <= y)){
+        const float x = a.x() + (y - a.y()) / (b.y() - a.y()) * (b.x() - a.x());
+        xMin = min(xMin, x);
+        xMax = max(xMax, x);
+      }
+    }
+    if(xMin > xMax)
+      continue;
+
+    const int firstColumn = max(0, static_cast<int>(ceil((xMin - searcherModel.origin.x()) / searcherModel.cellLengthX - 0.5f)));
+    const int lastColumn = min(searcherModel.numOfCellsX - 1,
+                               static_cast<int>(floor((xMax - searcherModel.origin.x()) / searcherModel.cellLengthX - 0.5f)));
+    Visibility* cells = visibility.data() + searcherModel.coordinatesFlattening(0, row);
+    for(int column = firstColumn; column <= lastColumn; ++column)
+      if(cells[column] == from)
+        cells[column] = to;
   }
-  return pointsInsideFov >= 3;
 }
 
 void SearcherModelProvider::update(SearcherModel& SearcherModel){
@@ -83,232 +116,138 @@ void SearcherModelProvider::update(SearcherModel& SearcherModel){
     if(justSwitched){
 
       //Restore grid type since the current context is no more searching
-      int gridSize = SearcherModel.grid.size();
-      for(int j = 0; j < gridSize; ++j)
-        SearcherModel.grid[j].type = SearcherModel::Cell::CellType::standard;
+      fill(SearcherModel.types.begin(), SearcherModel.types.end(), SearcherModel::CellType::standard);
       justSwitched = false;
     }
     return;
   }
 
   justSwitched = true;
-  
-  if(theFrameInfo.getTimeSince(lastTimeUpdate) < updateTime)
-    return;
-  
-  lastTimeUpdate = theFrameInfo.time;
-
-  function<void(vector<SearcherModel::Cell>&)> updateWeightMatrix = [&](vector<SearcherModel::Cell>& matrix){
-    int              cellIdx, 
-                     r,
-                     c,
-                     zoneSize,
-                     penalizedTeammates;
-    float            maxDistance,
-                     cellDistance,
-                     timestampComponent,
-                     distanceComponent;
-
-    bool             cameraValid = false;
-
-    Vector2f         cellPosition,
-                     robotPoseVec;
-    Vector2i         cellCoordinates;
-
-    vector<Vector2f> fieldOfView;
-
-    const RobotPose&       robotPose = static_cast<const RobotPose&>(theRobotPose);
-    const CameraInfo&      cameraInfo = static_cast<const CameraInfo&>(theCameraInfo);
-    const FieldDimensions& fieldDimensions = static_cast<const FieldDimensions&>(theFieldDimensions);
-    const CameraMatrix&    cameraMatrix = static_cast<const CameraMatrix&>(theCameraMatrix);
-
-    maxDistance = Vector2f(theFieldDimensions.xPosOpponentGroundLine - theFieldDimensions.xPosOwnGroundLine,
-                           theFieldDimensions.yPosLeftSideline - theFieldDimensions.yPosRightSideline).norm();
-    if(cameraMatrix.isValid)
-      Projection::computeFieldOfViewInFieldCoordinates(robotPose, cameraMatrix, cameraInfo, fieldDimensions, fieldOfView);
-    
-    if(cameraMatrix.isValid){
-      fieldOfViewVector1 = Vector2f(fieldOfView[2].x() - theRobotPose.translation.x(), fieldOfView[2].y() - theRobotPose.translation.y());
-      fieldOfViewVector2 = Vector2f(fieldOfView[3].x() - theRobotPose.translation.x(), fieldOfView[3].y() - theRobotPose.translation.y());
-      cameraValid = true;
+
+  const int numOfCellsX = SearcherModel.numOfCellsX,
+            numOfCellsY = SearcherModel.numOfCellsY;
+  const float maxDistance = Vector2f(theFieldDimensions.xPosOpponentGroundLine - theFieldDimensions.xPosOwnGroundLine,
+                                     theFieldDimensions.yPosLeftSideline - theFieldDimensions.yPosRightSideline).norm();
+
+  // STAGE 0: other teammates zone
+  const int zoneX = static_cast<int>(activeSearcherZoneSize / SearcherModel.cellLengthX) / 2,
+            zoneY = static_cast<int>(activeSearcherZoneSize / SearcherModel.cellLengthY) / 2;
+  int penalizedTeammates = 0;
+  for(const Teammate& teammate : theTeamData.teammates){
+    if(teammate.isPenalized)
+      ++penalizedTeammates;
+    if(teammate.theRobotPose.translation.x() < theFieldDimensions.xPosOwnPenaltyArea+300) // TODO: OWN BOX becames OWN PENALTY is it correct????
+      continue;
+
+    const Vector2i cellCoordinates = SearcherModel.flatToCoordinates(SearcherModel.getCellIndexFromPosition(teammate.theRobotPose.translation, theFieldDimensions));
+    for(int r = max(0, cellCoordinates.y() - zoneY); r <= min(numOfCellsY - 1, cellCoordinates.y() + zoneY); ++r){
+      for(int c = max(0, cellCoordinates.x() - zoneX); c <= min(numOfCellsX - 1, cellCoordinates.x() + zoneX); ++c){
+        const int cellIdx = SearcherModel.coordinatesFlattening(c, r);
+        SearcherModel.searchWeights[cellIdx] = 1; // 1 instead of 0 is a workaround in order to fix a shadow cones bug
+        SearcherModel.types[cellIdx] = SearcherModel::CellType::searchedBySomeone;
+        SearcherModel.timestamps[cellIdx] = theFrameInfo.time;
+      }
     }
+  }
 
-    // STAGE 0: other teammates zone
-    penalizedTeammates = 0;
-    for(Teammate teammate : theTeamData.teammates){
-      if(teammate.isPenalized)
-        ++penalizedTeammates;
-      if(teammate.theRobotPose.translation.x() < theFieldDimensions.xPosOwnPenaltyArea+300) // TODO: OWN BOX becames OWN PENALTY is it correct????
-        continue;
+  // STAGE 2 (preparation): visibility of the cells, i.e. the field of view without the shadow cones of the obstacles
+  const bool cameraValid = computeFieldOfView();
+  if(cameraValid){
+    fill(visibility.begin(), visibility.end(), hidden);
+    rasterize(SearcherModel, fieldOfView, hidden, visible);
 
-      robotPoseVec = Vector2f(teammate.theRobotPose.translation.x(), teammate.theRobotPose.translation.y());
-      cellIdx = SearcherModel.getCellIndexFromPosition(robotPoseVec, theFieldDimensions);
-      cellCoordinates = SearcherModel.flatToCoordinates(cellIdx);
-      
-      for(int row = cellCoordinates.x() - activeSearcherZone/2; row <= cellCoordinates.x() + activeSearcherZone/2; row++){
-        for(int col = cellCoordinates.y() - activeSearcherZone/2; col <= cellCoordinates.y() + activeSearcherZone/2; col++){
-          r = min(max(0, row), SearcherModel.numOfCellsX-1);
-          c = min(max(0, col), SearcherModel.numOfCellsY-1);
-          cellIdx = SearcherModel.coordinatesFlattening(r, c);
-          matrix[cellIdx].searchWeight = 1; // 1 instead of 0 is a workaround in order to fix a shadow cones bug
-          matrix[cellIdx].type = SearcherModel::Cell::CellType::searchedBySomeone;
-          matrix[cellIdx].timestamp = theFrameInfo.time;
-        }
-      }
+    for(const Obstacle& obs : theObstacleModel.obstacles){
+      if(obs.center.squaredNorm() > sqr(fieldOfViewFarTh))
+        continue;
+      const Vector2f left = theRobotPose * obs.left,
+                     right = theRobotPose * obs.right;
+      shadowCone.clear();
+      shadowCone.push_back(right);
+      shadowCone.push_back(left);
+      shadowCone.push_back(theRobotPose.translation + (left - theRobotPose.translation).normalized(fieldOfViewFarTh));
+      shadowCone.push_back(theRobotPose.translation + (right - theRobotPose.translation).normalized(fieldOfViewFarTh));
+      rasterize(SearcherModel, shadowCone, visible, shadowed);
     }
+  }
 
-    for(size_t i = 0; i < matrix.size(); ++i){
-      if(matrix[i].type == SearcherModel::Cell::CellType::searchedBySomeone){
-        matrix[i].type = SearcherModel::Cell::CellType::standard;
+  // STAGE 3 (preparation): gaussian distribution representing the ball position
+  const Vector2f bestBall = theFieldBall.ballWasSeen(10000) ? theFieldBall.endPositionOnField : theFieldBall.teamEndPositionOnField;
+  const float sigma = max(0.0001f, sigmaNormalizationRate * static_cast<float>(theFrameInfo.time - theTeamBallModel.timeWhenLastSeen)); //avoid division by zero -> Nan
+  const float gaussianFactor = -1.f / (2.f * sigma * sigma);
+
+  for(int row = 0, i = 0; row < numOfCellsY; ++row){
+    const float cellY = SearcherModel.origin.y() + (static_cast<float>(row) + 0.5f) * SearcherModel.cellLengthY;
+    for(int column = 0; column < numOfCellsX; ++column, ++i){
+      SearcherModel::CellType& type = SearcherModel.types[i];
+      if(type == SearcherModel::CellType::searchedBySomeone){
+        type = SearcherModel::CellType::standard;
         continue;
       }
 
-      else if(matrix[i].type == SearcherModel::Cell::CellType::ballComponentSeenWeak)
-        matrix[i].type = SearcherModel::Cell::CellType::ballComponentSeenStrong;
-      
-      matrix[i].isShadow = false;
+      else if(type == SearcherModel::CellType::ballComponentSeenWeak)
+        type = SearcherModel::CellType::ballComponentSeenStrong;
 
       // STAGE 0: guard covered zone
 
-      if(penalizedTeammates < 2 &&
-        SearcherModel.flatToCoordinates(i).x()*SearcherModel.cellLengthX < guardCoveredX_Th){
-        matrix[i].searchWeight = 1;
+      if(penalizedTeammates < 2 && static_cast<float>(column) * SearcherModel.cellLengthX < guardCoveredX_Th){
+        SearcherModel.searchWeights[i] = 1;
         continue;
       }
 
       // STAGE 1: position based weights
-      
-      cellPosition = matrix[i].positionOnField;
-      cellDistance = Vector2f(abs(theRobotPose.translation.x() - cellPosition.x()), abs(theRobotPose.translation.y() - cellPosition.y())).norm();
 
-      distanceComponent = LocalPositionWeight*(1-cellDistance/maxDistance);
-      
+      const Vector2f cellPosition(SearcherModel.origin.x() + (static_cast<float>(column) + 0.5f) * SearcherModel.cellLengthX, cellY);
+      const float distanceComponent = LocalPositionWeight*(1-(theRobotPose.translation - cellPosition).norm()/maxDistance);
+
       // STAGE 2: last time seen based weight
-      
+
+      float timestampComponent = 1;
       if(cameraValid){
-        if(isInsideFieldOfView(matrix[i])){
+        if(visibility[i] == visible){
           timestampComponent = 0;
 
-          if(matrix[i].type == SearcherModel::Cell::CellType::standard)
-            matrix[i].type = SearcherModel::Cell::CellType::ballComponentSeenWeak;
-          
-          matrix[i].timestamp = theFrameInfo.time;
+          if(type == SearcherModel::CellType::standard)
+            type = SearcherModel::CellType::ballComponentSeenWeak;
+
+          SearcherModel.timestamps[i] = theFrameInfo.time;
         }
+        else if(visibility[i] == shadowed)
+          SearcherModel.timestamps[i] = 0; // the cell could not be seen, so it is treated as never seen
         else
-          timestampComponent = min(1.f, LastTimeSeenWeight*(theFrameInfo.time - matrix[i].timestamp));
-    
+          timestampComponent = min(1.f, LastTimeSeenWeight*(theFrameInfo.time - SearcherModel.timestamps[i]));
       }
-      else
-        timestampComponent = 1;
-      
+
       // STAGE 3: gaussian distribution representing the ball position
-      
-      if(matrix[i].type == SearcherModel::Cell::CellType::standard){
-        matrix[i].ballComponentValue = compute2dGaussianKernel(SearcherModel.grid[i]);
-      }
-      
-      assignWeight(matrix[i],timestampComponent,distanceComponent);
-    }
 
-    // Underlying cell workaround to fix searcher stuck 
-    int selfIdx = SearcherModel.getCellIndexFromPosition(theRobotPose.translation, theFieldDimensions);
-    matrix[selfIdx].searchWeight = 1;
-    matrix[selfIdx].type = SearcherModel::Cell::CellType::ballComponentSeenStrong;
-    matrix[selfIdx].timestamp = theFrameInfo.time;
-
-    // STAGE 4: shadow cones
-
-    int idx,
-        myIdx = SearcherModel.getCellIndexFromPosition(theRobotPose.translation, theFieldDimensions),
-        current_x,
-        current_y,
-        current_flat,
-        max_flat = matrix.size();
-    Vector2i shadowDirection, 
-             obsVec,
-             myVec = SearcherModel.flatToCoordinates(myIdx);
-    float rate;
-
-    for(Obstacle obs : theObstacleModel.obstacles){
-
-      idx = SearcherModel.getCellIndexFromPosition(obs.center, theFieldDimensions);
-
-      if(matrix[idx].searchWeight == 0){
-        obsVec = SearcherModel.flatToCoordinates(idx);
-        
-        shadowDirection = Vector2i(obsVec.x() - myVec.x(), obsVec.y() - myVec.y());
-        current_x = obsVec.x();
-        current_y = obsVec.y();
-        current_flat = idx;
-        if(shadowDirection.x() == 0)
-          rate = 1e5;
-        else 
-          rate = (float)(shadowDirection.y())/(float)(shadowDirection.x());
-
-        while(current_flat < max_flat && current_flat >= 0 &&
-              matrix[current_flat].type != SearcherModel::Cell::CellType::searchedBySomeone &&
-              matrix[current_flat].searchWeight == 0){
-
-          //restore cell weight
-          
-          if(matrix[current_flat].type == SearcherModel::Cell::CellType::ballComponentSeenWeak)
-            matrix[current_flat].type = SearcherModel::Cell::CellType::standard;
-          
-          cellPosition = matrix[current_flat].positionOnField;
-          cellDistance = Vector2f(abs(theRobotPose.translation.x() - cellPosition.x()), abs(theRobotPose.translation.y() - cellPosition.y())).norm();
-
-          distanceComponent = LocalPositionWeight*(1-cellDistance/maxDistance);
-
-          assignWeight(matrix[current_flat], 1, distanceComponent);
-          matrix[current_flat].timestamp = 0;
-          matrix[current_flat].isShadow = true;
-
-          if(abs(rate) <= 1){
-            current_x = shadowDirection.x() > 0 ? current_x+1 : current_x-1;
-            current_y = obsVec.y() + (int) ((current_x - obsVec.x())*rate);
-            current_flat = SearcherModel.coordinatesFlattening(current_x, current_y);
-          }
-          else{
-            current_y = shadowDirection.y() > 0 ? current_y+1 : current_y-1;
-            current_x = obsVec.x() + (int) ((current_y - obsVec.y())/rate);
-            current_flat = SearcherModel.coordinatesFlattening(current_x, current_y);
-          }
+      if(type == SearcherModel::CellType::standard)
+        SearcherModel.ballComponentValues[i] = gaussianMax * exp((cellPosition - bestBall).squaredNorm() * gaussianFactor);
 
-        }
-         
-      } 
-    } 
-  };
+      assignWeight(SearcherModel, i, timestampComponent, distanceComponent);
+    }
+  }
 
-  updateWeightMatrix(SearcherModel.grid);
+  // Underlying cell workaround to fix searcher stuck
+  const int selfIdx = SearcherModel.getCellIndexFromPosition(theRobotPose.translation, theFieldDimensions);
+  SearcherModel.searchWeights[selfIdx] = 1;
+  SearcherModel.types[selfIdx] = SearcherModel::CellType::ballComponentSeenStrong;
+  SearcherModel.timestamps[selfIdx] = theFrameInfo.time;
 }
 
 void SearcherModelProvider::init(SearcherModel& SearcherModel)
 {
   initDone = true;
 
-  SearcherModel.cellLengthX = theFieldDimensions.xPosOpponentGroundLine * 2 / SearcherModel.numOfCellsX;
-  SearcherModel.cellLengthY = theFieldDimensions.yPosLeftSideline * 2 / SearcherModel.numOfCellsY;
+  SearcherModel.cellLengthX = (theFieldDimensions.xPosOpponentGroundLine - theFieldDimensions.xPosOwnGroundLine) / SearcherModel.numOfCellsX;
+  SearcherModel.cellLengthY = (theFieldDimensions.yPosLeftSideline - theFieldDimensions.yPosRightSideline) / SearcherModel.numOfCellsY;
+  SearcherModel.origin = Vector2f(theFieldDimensions.xPosOwnGroundLine, theFieldDimensions.yPosRightSideline);
 
-  float positionOnFieldX = theFieldDimensions.xPosOwnGroundLine + SearcherModel.cellLengthX / 2.f;
-  float positionOnFieldY = theFieldDimensions.yPosRightSideline + SearcherModel.cellLengthY / 2.f;
+  const size_t numOfCells = SearcherModel.size();
   const unsigned time = max(10000u, theFrameInfo.time);
-  lastTimeUpdate = time;
-  SearcherModel.grid.reserve(SearcherModel.numOfCellsY * SearcherModel.numOfCellsX);
-  for(int y = 0; y < SearcherModel.numOfCellsY; ++y)
-  {
-    for(int x = 0; x < SearcherModel.numOfCellsX; ++x)
-    {
-      SearcherModel.grid.emplace_back(time, time, 
-                                            positionOnFieldX, positionOnFieldY,
-                                            SearcherModel.cellLengthX,
-                                            SearcherModel.cellLengthY, INFINITY);
-      positionOnFieldX += SearcherModel.cellLengthX;
-    }
-    positionOnFieldX = theFieldDimensions.xPosOwnGroundLine + SearcherModel.cellLengthX / 2.f;
-    positionOnFieldY += SearcherModel.cellLengthY;
-  }
-
+  SearcherModel.timestamps.assign(numOfCells, time);
+  SearcherModel.searchWeights.assign(numOfCells, INFINITY);
+  SearcherModel.ballComponentValues.assign(numOfCells, 1.f);
+  SearcherModel.types.assign(numOfCells, SearcherModel::CellType::standard);
+  visibility.assign(numOfCells, hidden);
 }
 
 MAKE_MODULE(SearcherModelProvider, modeling);
@@ -37,23 +37,51 @@ MODULE(SearcherModelProvider,
   {,
     (float) LocalPositionWeight,
     (float) LastTimeSeenWeight,
-    (float) updateTime,
     (float) sigmaNormalizationRate,
     (float) gaussianMax,
     (float) fieldOfViewFarTh,
     (int) guardCoveredX_Th,
-    (int) activeSearcherZone,
+    (float) activeSearcherZoneSize,
   }),
 });
 
 class SearcherModelProvider : public SearcherModelProviderBase
 {
   private:
-    unsigned int lastTimeUpdate;
-    float angleBetweenVectors(Vector2f v1, Vector2f v2);
-    float compute2dGaussianKernel(SearcherModel::Cell cell);
-    bool isInsideFieldOfView(SearcherModel::Cell cell);
-    bool isInsideShadowCone(SearcherModel::Cell cell);
+    ENUM(Visibility,
+    {,
+      hidden,   /* Outside of the field of view */
+      visible,  /* Inside of the field of view */
+      shadowed, /* Inside of the field of view, but behind an obstacle */
+    });
+
+    std::vector<Vector2f> fieldOfViewCorners; /* The corners computed by Projection */
+    std::vector<Vector2f> sector;             /* The circular sector the camera can see */
+    std::vector<Vector2f> fieldOfView;        /* The sector clipped to the area in front of the robot */
+    std::vector<Vector2f> shadowCone;         /* The area hidden by an obstacle */
+    std::vector<Visibility> visibility;       /* The visibility of each cell in the current frame */
+
+    /**
+     * Compute the polygon of the part of the field that is currently seen.
+     * It is the sector between the two outer rays of the camera up to the
+     * distance fieldOfViewFarTh, restricted to the area in front of the robot.
+     *
+     * @return Is the field of view valid?
+     */
+    bool computeFieldOfView();
+
+    /**
+     * Change the visibility of all cells whose centers are inside a convex polygon.
+     * The polygon is filled row by row, i.e. each row of cells is intersected
+     * with the polygon and the resulting interval is filled.
+     *
+     * @param searcherModel The grid
+     * @param polygon The corners of the polygon in field coordinates
+     * @param from Only cells that currently have this visibility are changed
+     * @param to The new visibility of these cells
+     */
+    void rasterize(const SearcherModel& searcherModel, const std::vector<Vector2f>& polygon, Visibility from, Visibility to);
+
   public:
     void update(SearcherModel& SearcherModel) override;
 
@@ -61,4 +89,3 @@ class SearcherModelProvider : public SearcherModelProviderBase
          justSwitched = false;
     void init(SearcherModel& SearcherModel);
 };
-
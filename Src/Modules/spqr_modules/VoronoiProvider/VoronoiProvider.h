@@ -12,16 +12,10 @@
 #include "Representations/Communication/RobotInfo.h"
 #include "Representations/BehaviorControl/Libraries/LibMisc.h"
 #include "Representations/BehaviorControl/Libraries/LibSpec.h"
+#include "Tools/Math/Delaunay.h"
 #include "Tools/Math/Geometry.h"
 #include <vector>
-#include <list>
-#include <tuple>
-#include <map>
-#include <set>
 #include "Tools/Debugging/DebugDrawings.h"
-#include "Tools/Module/Module.h"
-
-using Line2 = Eigen::Hyperplane<float,2>;
 
 
 MODULE(VoronoiProvider,
@@ -38,15 +32,22 @@ MODULE(VoronoiProvider,
 class VoronoiProvider : public VoronoiProviderBase
 {
     private:
-        std::vector<std::tuple<Vector2f, Vector2f, Vector2f>> BowyerWatson(std::vector<Vector2f> pointList);
-        void dualGraph(std::vector<Voronoi::Node>& graph, std::vector<std::tuple<Vector2f, Vector2f, Vector2f>> triangulation);
+        Delaunay triangulation;                 /**< The Delaunay triangulation of the opponents and some fixed points. It is kept between frames. */
+        std::vector<unsigned> opponentVertices; /**< The vertex of each opponent in the triangulation. */
+        bool movable = false;                   /**< Can the opponent vertices be moved to their new positions in the next frame? */
+
+        // Buffers reused by dualGraph.
+        std::vector<Vector2f> nodePositions;
+        std::vector<unsigned> nodeOfTriangle;
+        std::vector<std::vector<unsigned>> nodeEdges;
+        std::vector<unsigned> nodeOrder;
+        std::vector<unsigned> nodeIndex;
+
+        void updateTriangulation(const std::vector<Vector2f>& opponents);
+        void rebuildTriangulation(const std::vector<Vector2f>& opponents);
+        void dualGraph(std::vector<Voronoi::Node>& graph);
         bool isCorridorFree(Vector2f start, Vector2f end, float width);
 
-        
     public:
         void update(Voronoi& voronoi);
-        //void printGraph();
 };
-
-
-
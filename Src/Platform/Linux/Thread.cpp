@@ -1,6 +1,8 @@
 #include "Platform/BHAssert.h"
 #include "Platform/Thread.h"
 
+#include <pthread.h>
+
 void Thread::nameCurrentThread(const std::string& name)
 {
   char cname[16] = "";
@@ -8,3 +10,15 @@ void Thread::nameCurrentThread(const std::string& name)
   cname [15] = '\0';
   VERIFY(!pthread_setname_np(pthread_self(), cname));
 }
+
+void Thread::setAffinity(unsigned core)
+{
+  SYNC;
+  if(thread && running)
+  {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    VERIFY(!pthread_setaffinity_np(thread->native_handle(), sizeof(cpuSet), &cpuSet));
+  }
+}
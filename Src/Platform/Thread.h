@@ -81,6 +81,13 @@ public:
    */
   void setPriority(int prio) { priority = prio; changePriority(); }
 
+  /**
+   * The function pins the thread to a single core. It must be running.
+   * It has no effect on macOS.
+   * @param core The index of the core.
+   */
+  void setAffinity(unsigned core);
+
   /**
    * The function determines whether the thread should still be running.
    * @return Should it continue?
@@ -30,6 +30,12 @@ void Thread::changePriority()
     SetThreadPriority(thread->native_handle(), THREAD_PRIORITY_NORMAL + priority);
 }
 
+void Thread::setAffinity(unsigned core)
+{
+  if(thread && running)
+    SetThreadAffinityMask(thread->native_handle(), static_cast<DWORD_PTR>(1) << core);
+}
+
 void Thread::nameCurrentThread(const std::string& name)
 {
   // Convert string to PCWSTR
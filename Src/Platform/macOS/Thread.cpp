@@ -5,3 +5,8 @@ void Thread::nameCurrentThread(const std::string& name)
 {
   VERIFY(!pthread_setname_np(name.c_str()));
 }
+
+void Thread::setAffinity(unsigned)
+{
+  // macOS does not support pinning threads to cores.
+}
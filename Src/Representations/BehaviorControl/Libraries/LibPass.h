@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "Tools/BehaviorControl/PassingLanes.h"
 #include "Tools/Function.h"
 #include "Tools/Math/Eigen.h"
 #include "Tools/Streams/AutoStreamable.h"
@@ -20,6 +21,18 @@ STREAMABLE(LibPass,
    */
   FUNCTION(Vector2f(Vector2f target, std::vector<Vector2f> mates)) findPassingLine;
 
+  /**
+   * Checks whether a pass from the robot to the target does not get close to
+   * an opponent (ahead of the robot, see findPassingLine).
+   */
+  FUNCTION(bool(const Vector2f& target)) isPassingLineFree;
+
+  /**
+   * Returns the directions from the robot in which no opponent is close to
+   * the path of the ball, the widest lane first.
+   */
+  FUNCTION(std::vector<PassingLanes::Lane>()) getFreePassingLanes;
+
   /**
    * This function orderes the team mates according to their distance w.r.t. the opponents
    * and then, starting from the most free one, tries to find a passing line
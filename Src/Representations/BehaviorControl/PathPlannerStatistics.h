@@ -0,0 +1,23 @@
+/**
+ * @file PathPlannerStatistics.h
+ *
+ * This file defines a representation that summarizes how often the path planner
+ * could reuse its cached path during the last statistics window and how long
+ * answering the requests took.
+ */
+
+#pragma once
+
+#include "Tools/Streams/AutoStreamable.h"
+
+STREAMABLE(PathPlannerStatistics,
+{,
+  (unsigned)(0) timestamp, /**< When was the statistics window finished? */
+  (unsigned)(0) requests, /**< The number of paths requested in the window. */
+  (unsigned)(0) cacheHits, /**< The number of requests answered with the cached path. */
+  (unsigned)(0) invalidations, /**< The number of requests for which the cached path had become blocked or too long. */
+  (float)(0.f) hitRate, /**< The ratio of requests answered with the cached path. 0 if there were no requests. */
+  (float)(0.f) meanReplanningTime, /**< The average duration of a request that planned a new path [ms]. */
+  (float)(0.f) maxReplanningTime, /**< The longest duration of a request that planned a new path [ms]. */
+  (float)(0.f) meanReuseTime, /**< The average duration of a request answered with the cached path [ms]. */
+});
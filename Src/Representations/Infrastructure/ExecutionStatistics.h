@@ -0,0 +1,45 @@
+/**
+ * @file ExecutionStatistics.h
+ *
+ * This file defines a representation that summarizes how long the providers of
+ * a thread and the thread's frames took during the last statistics window. It is
+ * not provided by a module, but filled by the module graph runner of each thread.
+ */
+
+#pragma once
+
+#include "Tools/Streams/AutoStreamable.h"
+#include <string>
+#include <vector>
+
+STREAMABLE(ExecutionStatistics,
+{
+  STREAMABLE(Durations,
+  {,
+    (std::string) name, /**< The name of the representation provided or "Frame" for the whole frame. */
+    (float)(0.f) p50, /**< The median duration [ms]. */
+    (float)(0.f) p95, /**< The 95th percentile of the durations [ms]. */
+    (float)(0.f) p99, /**< The 99th percentile of the durations [ms]. */
+    (float)(0.f) max, /**< The longest duration [ms]. */
+  });
+
+  /**
+   * Returns the durations of a provider.
+   * @param name The name of the representation provided.
+   * @return The durations or nullptr if there are none for this provider.
+   */
+  const Durations* find(const std::string& name) const
+  {
+    for(const Durations& durations : providers)
+      if(durations.name == name)
+        return &durations;
+    return nullptr;
+  },
+
+  (unsigned)(0) timestamp, /**< When was the statistics window finished? */
+  (float)(0.f) budget, /**< The time available per frame according to the expected frequency of the thread [ms]. 0 if unknown. */
+  (unsigned)(0) frames, /**< The number of frames executed in the statistics window. */
+  (unsigned)(0) overruns, /**< The number of these frames that took longer than the budget. */
+  (Durations) frame, /**< The durations of all providers of a frame together. */
+  (std::vector<Durations>) providers, /**< The durations per provider in execution order. */
+});
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "Tools/Function.h"
 #include "Tools/Streams/AutoStreamable.h"
 #include "Tools/ImageProcessing/Image.h"
 #include "Tools/ImageProcessing/PixelTypes.h"
@@ -20,13 +21,27 @@
  * A representation containing both a color classified and a grayscale version of
  * the camera image.
  * It is advised to use this representation for all further image processing.
+ * The grayscaled image is always complete. The saturated and hued images might
+ * only be computed for the rows in which the field is expected. Other rows must
+ * be prepared before they are accessed.
  */
 STREAMABLE(ECImage,
 {
+  /**
+   * Ensures that the rows yMin ... yMax - 1 of the saturated and hued images are
+   * computed. Does nothing if the images are always complete. Can be called
+   * concurrently by different modules.
+   */
+  FUNCTION(void(int yMin, int yMax)) prepareRows;
+
   void draw() const
   {
     SEND_DEBUG_IMAGE("GrayscaledImage", grayscaled);
+    DEBUG_RESPONSE("debug images:SaturatedImage")
+      prepareRows(0, static_cast<int>(saturated.height));
     SEND_DEBUG_IMAGE("SaturatedImage", saturated);
+    DEBUG_RESPONSE("debug images:HuedImage")
+      prepareRows(0, static_cast<int>(hued.height));
     SEND_DEBUG_IMAGE("HuedImage", hued);
   },
 
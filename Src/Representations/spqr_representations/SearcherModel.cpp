@@ -8,23 +8,6 @@
 #include "Tools/Math/BHMath.h"
 #include <limits>
 
-SearcherModel::Cell::Cell(const int coverage, unsigned timestamp,
-                                const float positionOnFieldX, const float positionOnFieldY,
-                                const float cellLengthX, const float cellLengthY, 
-                                const float searchWeight)
-  : coverage(coverage), timestamp(timestamp), positionOnField(positionOnFieldX, positionOnFieldY), searchWeight(searchWeight)
-{
-  const float xMin = positionOnFieldX - cellLengthX / 2.f;
-  const float xMax = positionOnFieldX + cellLengthX / 2.f;
-  const float yMin = positionOnFieldY - cellLengthY / 2.f;
-  const float yMax = positionOnFieldY + cellLengthY / 2.f;
-
-  const_cast<Vector2f&>(polygon[0]) = Vector2f(xMin + 25.0f, yMin + 25.0f);
-  const_cast<Vector2f&>(polygon[1]) = Vector2f(xMin + 25.0f, yMax - 25.0f);
-  const_cast<Vector2f&>(polygon[2]) = Vector2f(xMax - 25.0f, yMax - 25.0f);
-  const_cast<Vector2f&>(polygon[3]) = Vector2f(xMax - 25.0f, yMin + 25.0f);
-}
-
 int SearcherModel::getCellIndexFromPosition(const Vector2f position, const FieldDimensions& theFieldDimensions) const{
   float clippedPositionX = clip(position.x(), theFieldDimensions.xPosOwnGroundLine, theFieldDimensions.xPosOpponentGroundLine);
   float clippedPositionY = clip(position.y(), theFieldDimensions.yPosRightSideline, theFieldDimensions.yPosLeftSideline);
@@ -44,6 +27,12 @@ Vector2i SearcherModel::flatToCoordinates(int n) const{
   return out;
 }
 
+Vector2f SearcherModel::getCellPosition(int n) const{
+  const Vector2i coordinates = flatToCoordinates(n);
+  return Vector2f(origin.x() + (static_cast<float>(coordinates.x()) + 0.5f) * cellLengthX,
+                  origin.y() + (static_cast<float>(coordinates.y()) + 0.5f) * cellLengthY);
+}
+
 unsigned SearcherModel::timeWhenLastSeen(const Vector2f& positionOnField, const FieldDimensions& theFieldDimensions) const
 {
   float clippedPositionX = clip(positionOnField.x(), theFieldDimensions.xPosOwnGroundLine, theFieldDimensions.xPosOpponentGroundLine);
@@ -52,7 +41,7 @@ unsigned SearcherModel::timeWhenLastSeen(const Vector2f& positionOnField, const
   const int x = std::min(static_cast<int>((clippedPositionX - theFieldDimensions.xPosOwnGroundLine) / cellLengthX), numOfCellsX - 1);
   const int y = std::min(static_cast<int>((clippedPositionY - theFieldDimensions.yPosRightSideline) / cellLengthY), numOfCellsY - 1);
 
-  return grid[y * numOfCellsY + x].timestamp;
+  return timestamps[coordinatesFlattening(x, y)];
 }
 
 ColorRGBA heatMapToRGB(float maximum, float value){
@@ -71,26 +60,30 @@ void SearcherModel::draw() const
   DEBUG_DRAWING("representation:SearcherModel:coverage", "drawingOnField")
   {
     float max = 0;
-    for(size_t i = 0; i < grid.size(); ++i)
+    for(float searchWeight : searchWeights)
     {
-      if(grid[i].searchWeight > max)
-        max = grid[i].searchWeight;
+      if(searchWeight > max)
+        max = searchWeight;
     }
 
-    for(size_t i = 0; i < grid.size(); ++i)
+    for(int i = 0; i < static_cast<int>(searchWeights.size()); ++i)
     {
-      const Cell& c = grid[i];
+      const Vector2f center = getCellPosition(i);
+      const float xMin = center.x() - cellLengthX / 2.f + 25.f;
+      const float xMax = center.x() + cellLengthX / 2.f - 25.f;
+      const float yMin = center.y() - cellLengthY / 2.f + 25.f;
+      const float yMax = center.y() + cellLengthY / 2.f - 25.f;
 
       ColorRGBA color;
 
-      color = heatMapToRGB(max, c.searchWeight);
+      color = heatMapToRGB(max, searchWeights[i]);
 
       FILLED_RECTANGLE("representation:SearcherModel:coverage",
-                 c.polygon[1].x(), c.polygon[1].y(),
-                 c.polygon[3].x(), c.polygon[3].y(),
+                 xMin, yMax,
+                 xMax, yMin,
                 20, Drawings::solidPen, color, Drawings::solidBrush, color);
 
-      DRAW_TEXT("representation:SearcherModel:searchWeight", c.polygon[0].x(), c.polygon[0].y(), 50, ColorRGBA(255, 255, 255, 255), c.searchWeight);
+      DRAW_TEXT("representation:SearcherModel:searchWeight", xMin, yMin, 50, ColorRGBA(255, 255, 255, 255), searchWeights[i]);
     }
   }
 }
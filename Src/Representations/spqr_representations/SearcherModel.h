@@ -10,8 +10,21 @@
 #include "Tools/Math/Eigen.h"
 #include <vector>
 
+/**
+ * The grid is stored as structure of arrays, i.e. every attribute of all cells
+ * is kept in its own contiguous array. Cells are indexed row by row
+ * (see coordinatesFlattening).
+ */
 STREAMABLE(SearcherModel,
 {
+  ENUM(CellType,
+  {,
+    standard,
+    ballComponentSeenWeak,
+    ballComponentSeenStrong,
+    searchedBySomeone,
+  });
+
   void draw() const;
 
   /**
@@ -24,38 +37,26 @@ STREAMABLE(SearcherModel,
   int coordinatesFlattening(int x, int y) const;
   Vector2i flatToCoordinates(int n)const;
 
-  STREAMABLE(Cell,
-  {
-    Cell() = default;
-    Cell(const int coverage, unsigned timestamp,
-         const float positionOnFieldX, const float positionOnFieldY,
-         const float cellLengthX, const float cellLengthY, 
-         const float searchWeight);
-
-    ENUM(CellType,
-    {,
-      standard,
-      ballComponentSeenWeak,
-      ballComponentSeenStrong,
-      searchedBySomeone,
-    });
-
-    const Vector2f polygon[4], /* Used for drawing */
-    (int)(0) coverage, /* Rating for the cell */
-    (unsigned)(0) timestamp, /* Timestamp when the cell was last seen */
-    (Vector2f) positionOnField, /* Position of the cell in field coordinates */
-    (float)(0.f) searchWeight, /* A weight used for compute the searching point */
-    (float) (1) ballComponentValue, /* for optimization purposes */
-    (CellType) (standard) type,
-    (bool) (false) isShadow,
-  }),
-
-  (int)(0) meanCoverage,
-  (std::vector<Cell>) grid,
+  /**
+   * Return the center of a cell.
+   *
+   * @param n The index of the cell
+   * @return The position of the cell in field coordinates
+   */
+  Vector2f getCellPosition(int n) const;
+
+  /** Return the number of cells in the grid. */
+  int size() const {return numOfCellsX * numOfCellsY;},
+
+  (std::vector<unsigned>) timestamps, /* Timestamp when each cell was last seen */
+  (std::vector<float>) searchWeights, /* A weight per cell used for compute the searching point */
+  (std::vector<float>) ballComponentValues, /* The ball component of the weight of each cell, for optimization purposes */
+  (std::vector<CellType>) types,
 
   // The cell rate should be 3/2 (x/y)
-  (int)(18) numOfCellsX, 
-  (int)(12) numOfCellsY,
+  (int)(36) numOfCellsX,
+  (int)(24) numOfCellsY,
   (float) cellLengthX, /* Length of a cell in x direction */
   (float) cellLengthY, /* Length of a cell in y direction */
+  (Vector2f) origin, /* Corner of the first cell (own ground line, right sideline) */
 });
@@ -21,10 +21,10 @@ STREAMABLE(Voronoi,
     STREAMABLE(Node,
     {
         Node() = default;
-        Node(Vector2f position, std::vector<Vector2f> edges),
+        Node(Vector2f position, std::vector<unsigned> edges),
 
         (Vector2f) position,
-        (std::vector<Vector2f>) edges,
+        (std::vector<unsigned>) edges, /**< The indices of the adjacent nodes in the graph. */
     }),
 
     (std::vector<Node>) graph,
@@ -40,11 +40,13 @@ bool Cognition::beforeFrame()
   // read from team comm udp socket
   theSPLMessageHandler.receive();
 
-  const FrameInfo* lowerFrameInfo = Blackboard::getInstance().exists("LowerFrameInfo")
-                                    ? static_cast<FrameInfo*>(const_cast<Streamable*>(&Blackboard::getInstance()["LowerFrameInfo"]))
+  static const std::size_t lowerFrameInfoIndex = Blackboard::getIndex("LowerFrameInfo");
+  static const std::size_t upperFrameInfoIndex = Blackboard::getIndex("UpperFrameInfo");
+  const FrameInfo* lowerFrameInfo = Blackboard::getInstance().exists(lowerFrameInfoIndex)
+                                    ? static_cast<FrameInfo*>(const_cast<Streamable*>(&Blackboard::getInstance()[lowerFrameInfoIndex]))
                                     : nullptr;
-  const FrameInfo* upperFrameInfo = Blackboard::getInstance().exists("UpperFrameInfo")
-                                    ? static_cast<FrameInfo*>(const_cast<Streamable*>(&Blackboard::getInstance()["UpperFrameInfo"]))
+  const FrameInfo* upperFrameInfo = Blackboard::getInstance().exists(upperFrameInfoIndex)
+                                    ? static_cast<FrameInfo*>(const_cast<Streamable*>(&Blackboard::getInstance()[upperFrameInfoIndex]))
                                     : nullptr;
   unsigned lowerFrameTime = lowerFrameInfo ? lowerFrameInfo->time : 0;
   unsigned upperFrameTime = upperFrameInfo ? upperFrameInfo->time : 0;
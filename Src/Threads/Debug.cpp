@@ -92,12 +92,12 @@ bool Debug::main()
       for(const ModuleBase::Info& j : m->getModuleInfo())
         if(j.update)
           ++providersSize;
-        else
+        else if(!j.used)
           ++requirementsSize;
 
       Global::getDebugOut().bin << requirementsSize;
       for(const ModuleBase::Info& j : m->getModuleInfo())
-        if(!j.update)
+        if(!j.update && !j.used)
           Global::getDebugOut().bin << j.representation;
 
       Global::getDebugOut().bin << providersSize;
@@ -29,7 +29,8 @@ void Motion::afterModules()
 
 bool Motion::afterFrame()
 {
-  if(Blackboard::getInstance().exists("JointSensorData"))
+  static const std::size_t jointSensorData = Blackboard::getIndex("JointSensorData");
+  if(Blackboard::getInstance().exists(jointSensorData))
   {
     BH_TRACE_MSG("before waitForFrameData");
     NaoProvider::waitForFrameData();
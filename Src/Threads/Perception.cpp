@@ -28,7 +28,8 @@ void Perception::beforeModules()
 
 bool Perception::afterFrame()
 {
-  if(Blackboard::getInstance().exists("CameraImage"))
+  static const std::size_t cameraImage = Blackboard::getIndex("CameraImage");
+  if(Blackboard::getInstance().exists(cameraImage))
   {
     if(SystemCall::getMode() == SystemCall::physicalRobot)
       Thread::getCurrentThread()->setPriority(10);
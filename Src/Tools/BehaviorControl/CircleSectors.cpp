@@ -0,0 +1,35 @@
+/**
+ * @file CircleSectors.cpp
+ *
+ * This file implements functions for sectors of circles around obstacles.
+ */
+
+#include "CircleSectors.h"
+#include "Tools/Math/Angle.h"
+#include "Tools/Math/BHMath.h"
+#include <algorithm>
+#include <cmath>
+
+bool CircleSectors::intersect(const Vector2f& center, float radius, const Vector2f& otherCenter, float otherRadius)
+{
+  const float d2 = (otherCenter - center).squaredNorm();
+  return d2 > sqr(radius - otherRadius) && d2 < sqr(radius + otherRadius);
+}
+
+Rangef CircleSectors::getOverlap(const Vector2f& center, float radius, const Vector2f& otherCenter, float otherRadius)
+{
+  // d1 is the distance from the center to the line through both intersections of the circles.
+  const Vector2f v = otherCenter - center;
+  const float d = v.norm();
+  const float d1 = 0.5f * (d + (sqr(radius) - sqr(otherRadius)) / d);
+  const float a = std::acos(std::clamp(d1 / radius, -1.f, 1.f));
+  const float dir = v.angle();
+  return Rangef(Angle::normalize(dir - a), Angle::normalize(dir + a));
+}
+
+bool CircleSectors::overlap(const Rangef& sector1, const Rangef& sector2)
+{
+  // If the sectors overlap, at least one limit of one of them must be inside the other one.
+  return sector1.isInside(sector2.min) || sector1.isInside(sector2.max)
+         || sector2.isInside(sector1.min) || sector2.isInside(sector1.max);
+}
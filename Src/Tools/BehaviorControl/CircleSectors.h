@@ -0,0 +1,45 @@
+/**
+ * @file CircleSectors.h
+ *
+ * This file declares functions for sectors of circles around obstacles, i.e. ranges
+ * of directions from the center of a circle. The path planner surrounds obstacles on
+ * such circles and must not pass the sectors that lie inside other obstacles.
+ */
+
+#pragma once
+
+#include "Tools/Math/Eigen.h"
+#include "Tools/Range.h"
+
+namespace CircleSectors
+{
+  /**
+   * Checks whether two circles intersect, i.e. they overlap, but none of them contains the other one.
+   * @param center The center of the first circle.
+   * @param radius The radius of the first circle.
+   * @param otherCenter The center of the second circle.
+   * @param otherRadius The radius of the second circle.
+   * @return Do the circles intersect?
+   */
+  bool intersect(const Vector2f& center, float radius, const Vector2f& otherCenter, float otherRadius);
+
+  /**
+   * Determines the sector of a circle that lies inside another circle. The circles should
+   * intersect. Otherwise, the sector degenerates to a single direction.
+   * @param center The center of the circle.
+   * @param radius The radius of the circle.
+   * @param otherCenter The center of the other circle.
+   * @param otherRadius The radius of the other circle.
+   * @return The sector covered by the other circle (-pi <= min, max <= pi).
+   *         min > max if it crosses the -pi/pi border.
+   */
+  Rangef getOverlap(const Vector2f& center, float radius, const Vector2f& otherCenter, float otherRadius);
+
+  /**
+   * Checks whether two sectors of the same circle overlap. Both can cross the -pi/pi border.
+   * @param sector1 The first sector.
+   * @param sector2 The second sector.
+   * @return Do the sectors share at least one direction?
+   */
+  bool overlap(const Rangef& sector1, const Rangef& sector2);
+}
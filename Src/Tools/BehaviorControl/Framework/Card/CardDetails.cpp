@@ -12,16 +12,25 @@ void CardCreatorBase::addToModuleInfo(CardCreatorBase* firstCreator, std::vector
 {
   for(CardCreatorBase* cardCreator = firstCreator; cardCreator != nullptr; cardCreator = cardCreator->next)
   {
-    auto requirements = cardCreator->getCardInfo().requires;
-    for(const char* requirement : requirements)
+    const auto details = cardCreator->getCardInfo();
+    for(const char* requirement : details.requires)
     {
       bool found = false;
       for(auto& i : info)
-        if(!i.update && (found = (std::string(requirement) == i.representation)))
+        if(!i.update && !i.used && (found = (std::string(requirement) == i.representation)))
           break;
       if(!found)
         info.emplace_back(requirement, nullptr);
     }
+    for(const char* use : details.uses)
+    {
+      bool found = false;
+      for(auto& i : info)
+        if((found = (std::string(use) == i.representation)))
+          break;
+      if(!found)
+        info.emplace_back(use, nullptr, true);
+    }
   }
 }
 
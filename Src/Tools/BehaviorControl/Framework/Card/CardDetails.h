@@ -53,6 +53,7 @@ public:
   struct Info
   {
     std::vector<const char*> requires; /**< The names of representations required by this card. */
+    std::vector<const char*> uses; /**< The names of representations used by this card. */
     std::vector<const char*> calls; /**< The names of skills called by this card. */
   };
 
@@ -67,9 +68,9 @@ public:
   {}
 
   /**
-   * Adds the requirements of all cards to the info of a module.
+   * Adds the requirements and the representations used of all cards to the info of a module.
    * @param firstCreator The anchor of the creator list.
-   * @param info The info to which the requirements are added.
+   * @param info The info to which the requirements and the representations used are added.
    */
   static void addToModuleInfo(CardCreatorBase* firstCreator, std::vector<ModuleBase::Info>& info);
 
@@ -159,15 +160,15 @@ private:
 #define _CARD_DECLARE__MODULE_LOADS_PARAMETERS(...)
 
 #define _CARD_FREE(x) _MODULE_JOIN(_CARD_FREE_, x)
-#define _CARD_FREE_REQUIRES(type) Blackboard::getInstance().free(#type);
-#define _CARD_FREE_USES(type) Blackboard::getInstance().free(#type);
+#define _CARD_FREE_REQUIRES(type) Blackboard::getInstance().free(Blackboard::getIndex<type>(#type));
+#define _CARD_FREE_USES(type) Blackboard::getInstance().free(Blackboard::getIndex<type>(#type));
 #define _CARD_FREE_CALLS(type)
 #define _CARD_FREE__MODULE_DEFINES_PARAMETERS(...)
 #define _CARD_FREE__MODULE_LOADS_PARAMETERS(...)
 
 #define _CARD_INFO(x) _MODULE_JOIN(_CARD_INFO_, x)
 #define _CARD_INFO_REQUIRES(type) _info.requires.push_back(#type);
-#define _CARD_INFO_USES(type)
+#define _CARD_INFO_USES(type) _info.uses.push_back(#type);
 #define _CARD_INFO_CALLS(type) _info.calls.push_back(#type);
 #define _CARD_INFO__MODULE_DEFINES_PARAMETERS(...)
 #define _CARD_INFO__MODULE_LOADS_PARAMETERS(...)
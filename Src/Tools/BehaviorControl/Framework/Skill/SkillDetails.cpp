@@ -12,15 +12,24 @@ void SkillImplementationCreatorBase::addToModuleInfo(SkillImplementationCreatorB
 {
   for(SkillImplementationCreatorBase* skill = firstCreator; skill != nullptr; skill = skill->next)
   {
-    auto requirements = skill->getSkillInfo().requires;
-    for(const char* requirement : requirements)
+    const auto details = skill->getSkillInfo();
+    for(const char* requirement : details.requires)
     {
       bool found = false;
       for(auto& i : info)
-        if(!i.update && (found = (std::string(requirement) == i.representation)))
+        if(!i.update && !i.used && (found = (std::string(requirement) == i.representation)))
           break;
       if(!found)
         info.emplace_back(requirement, nullptr);
     }
+    for(const char* use : details.uses)
+    {
+      bool found = false;
+      for(auto& i : info)
+        if((found = (std::string(use) == i.representation)))
+          break;
+      if(!found)
+        info.emplace_back(use, nullptr, true);
+    }
   }
 }
@@ -252,6 +252,7 @@ public:
   struct Info
   {
     std::vector<const char*> requires; /**< The names of representations required by this skill implementation. */
+    std::vector<const char*> uses; /**< The names of representations used by this skill implementation. */
     std::vector<SkillInterfaceCreator> implements; /**< Info about skills implemented by this skill implementation. */
     std::vector<const char*> calls; /**< The names of skills called by this skill implementation. */
   };
@@ -267,9 +268,9 @@ public:
   {}
 
   /**
-   * Adds the requirements of all skill implementations to the info of a module.
+   * Adds the requirements and the representations used of all skill implementations to the info of a module.
    * @param firstCreator The anchor of the creator list.
-   * @param info The info to which the requirements are added.
+   * @param info The info to which the requirements and the representations used are added.
    */
   static void addToModuleInfo(SkillImplementationCreatorBase* firstCreator, std::vector<ModuleBase::Info>& info);
 
@@ -363,8 +364,8 @@ private:
 
 #define _SKILL_IMPLEMENTATION_FREE(x) _MODULE_JOIN(_SKILL_IMPLEMENTATION_FREE_, x)
 #define _SKILL_IMPLEMENTATION_FREE_IMPLEMENTS(type)
-#define _SKILL_IMPLEMENTATION_FREE_REQUIRES(type) Blackboard::getInstance().free(#type);
-#define _SKILL_IMPLEMENTATION_FREE_USES(type) Blackboard::getInstance().free(#type);
+#define _SKILL_IMPLEMENTATION_FREE_REQUIRES(type) Blackboard::getInstance().free(Blackboard::getIndex<type>(#type));
+#define _SKILL_IMPLEMENTATION_FREE_USES(type) Blackboard::getInstance().free(Blackboard::getIndex<type>(#type));
 #define _SKILL_IMPLEMENTATION_FREE_MODIFIES(type)
 #define _SKILL_IMPLEMENTATION_FREE_CALLS(type)
 #define _SKILL_IMPLEMENTATION_FREE__MODULE_DEFINES_PARAMETERS(...)
@@ -373,7 +374,7 @@ private:
 #define _SKILL_IMPLEMENTATION_INFO(x) _MODULE_JOIN(_SKILL_IMPLEMENTATION_INFO_, x)
 #define _SKILL_IMPLEMENTATION_INFO_IMPLEMENTS(type) _info.implements.emplace_back(#type, _SKILLS_NAMESPACE::type##Skill::createNew);
 #define _SKILL_IMPLEMENTATION_INFO_REQUIRES(type) _info.requires.push_back(#type);
-#define _SKILL_IMPLEMENTATION_INFO_USES(type)
+#define _SKILL_IMPLEMENTATION_INFO_USES(type) _info.uses.push_back(#type);
 #define _SKILL_IMPLEMENTATION_INFO_MODIFIES(type)
 #define _SKILL_IMPLEMENTATION_INFO_CALLS(type) _info.calls.push_back(#type);
 #define _SKILL_IMPLEMENTATION_INFO__MODULE_DEFINES_PARAMETERS(...)
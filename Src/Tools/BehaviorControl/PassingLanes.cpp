@@ -0,0 +1,102 @@
+/**
+ * @file PassingLanes.cpp
+ *
+ * This file implements a class that determines the directions in which the ball
+ * can be passed from a position without getting close to an opponent.
+ */
+
+#include "PassingLanes.h"
+#include <algorithm>
+#include <cmath>
+
+PassingLanes::PassingLanes(std::size_t maxOpponents)
+{
+  // An opponent blocks one interval, two if it crosses the -pi/pi border.
+  blocked.reserve(2 * maxOpponents);
+  merged.reserve(2 * maxOpponents);
+  lanes.reserve(2 * maxOpponents + 1);
+}
+
+void PassingLanes::begin(const Vector2f& origin, float clearance)
+{
+  this->origin = origin;
+  this->clearance = clearance;
+  blocked.clear();
+  merged.clear();
+  lanes.clear();
+}
+
+void PassingLanes::addOpponent(const Vector2f& position)
+{
+  const Vector2f offset = position - origin;
+  const float distance = offset.norm();
+
+  // An opponent closer than the clearance is in the way of every pass.
+  if(distance <= clearance)
+  {
+    blocked.push_back({Rangea(-pi, pi), distance});
+    return;
+  }
+
+  // The ball passes the opponent at the clearance if it deviates by asin(clearance / distance).
+  const float direction = offset.angle();
+  const float halfWidth = std::asin(clearance / distance);
+  const float min = direction - halfWidth;
+  const float max = direction + halfWidth;
+  if(min < -pi)
+  {
+    blocked.push_back({Rangea(min + pi2, pi), distance});
+    blocked.push_back({Rangea(-pi, max), distance});
+  }
+  else if(max > pi)
+  {
+    blocked.push_back({Rangea(min, pi), distance});
+    blocked.push_back({Rangea(-pi, max - pi2), distance});
+  }
+  else
+    blocked.push_back({Rangea(min, max), distance});
+}
+
+void PassingLanes::finish()
+{
+  std::sort(blocked.begin(), blocked.end(), [](const Blocked& a, const Blocked& b) {return a.angleRange.min < b.angleRange.min;});
+
+  // Sweep over the sorted intervals and unite the overlapping ones.
+  for(const Blocked& b : blocked)
+    if(merged.empty() || merged.back().max < b.angleRange.min)
+      merged.push_back(b.angleRange);
+    else
+      merged.back().max = std::max(merged.back().max, b.angleRange.max);
+
+  // The lanes are the gaps between the united intervals.
+  if(merged.empty())
+    lanes.push_back({Rangea(-pi, pi)});
+  else
+  {
+    for(std::size_t i = 1; i < merged.size(); ++i)
+      lanes.push_back({Rangea(merged[i - 1].max, merged[i].min)});
+    if(merged.back().max < merged.front().min + pi2)
+      lanes.push_back({Rangea(merged.back().max, merged.front().min + pi2)});
+  }
+  std::sort(lanes.begin(), lanes.end(), [](const Lane& a, const Lane& b) {return a.width() > b.width();});
+}
+
+bool PassingLanes::isFree(const Vector2f& target) const
+{
+  const Vector2f offset = target - origin;
+  const float direction = offset.angle();
+
+  // Most directions are not blocked at all.
+  auto range = std::upper_bound(merged.begin(), merged.end(), direction, [](float direction, const Rangea& range) {return direction < range.min;});
+  if(range == merged.begin() || (--range)->max < direction)
+    return true;
+
+  // Otherwise, only opponents before the target (or close behind it) are in the way.
+  const float maxDistance = offset.norm() + clearance;
+  for(const Blocked& b : blocked)
+    if(b.angleRange.min > direction)
+      break;
+    else if(b.angleRange.max >= direction && b.distance < maxDistance)
+      return false;
+  return true;
+}
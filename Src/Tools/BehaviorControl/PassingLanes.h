@@ -0,0 +1,102 @@
+/**
+ * @file PassingLanes.h
+ *
+ * This file declares a class that determines the directions in which the ball
+ * can be passed from a position without getting close to an opponent. Each
+ * opponent blocks an interval of directions. The intervals are sorted and swept
+ * once, which results in the free lanes between them. Afterwards, checking
+ * whether a single pass is free is mostly a binary search.
+ */
+
+#pragma once
+
+#include "Tools/Math/Angle.h"
+#include "Tools/Math/Eigen.h"
+#include "Tools/Range.h"
+#include <vector>
+
+class PassingLanes
+{
+public:
+  /** The directions blocked by a single opponent. */
+  struct Blocked
+  {
+    Rangea angleRange; /**< The directions (-pi <= min <= max <= pi). */
+    float distance; /**< The distance of the opponent from the origin. */
+  };
+
+  /** A range of directions not blocked by any opponent. */
+  struct Lane
+  {
+    Rangea angleRange; /**< The directions. max exceeds pi if the lane crosses the -pi/pi border. */
+
+    /** The width of the lane. Wider lanes are better, because the pass can be less precise. */
+    Angle width() const {return angleRange.max - angleRange.min;}
+
+    /** The direction in the middle of the lane. */
+    Angle center() const {return Angle::normalize((angleRange.min + angleRange.max) / 2.f);}
+  };
+
+  /**
+   * Constructor.
+   * @param maxOpponents The number of opponents for which the buffers are allocated in advance.
+   */
+  PassingLanes(std::size_t maxOpponents = 20);
+
+  /**
+   * Starts collecting the opponents.
+   * @param origin The position the passes start at.
+   * @param clearance The minimum distance of opponents from the path of the ball.
+   */
+  void begin(const Vector2f& origin, float clearance);
+
+  /**
+   * Adds an opponent.
+   * @param position The position of the opponent (in the same coordinate system as the origin).
+   */
+  void addOpponent(const Vector2f& position);
+
+  /**
+   * Checks whether an opponent must be added for the passes of a player. Opponents
+   * ahead of the player are always considered. If the player is close to the
+   * opponent goal, the opponents behind it are considered as well, down to a
+   * minimum x coordinate.
+   * @param origin The position of the player.
+   * @param opponent The position of the opponent.
+   * @param xMinOriginWithBehind Beyond this x coordinate of the player, opponents behind it are considered.
+   * @param xMinBehind The minimum x coordinate of opponents behind the player that are considered.
+   * @return Is the opponent considered?
+   */
+  static bool isConsidered(const Vector2f& origin, const Vector2f& opponent, float xMinOriginWithBehind, float xMinBehind)
+  {
+    return opponent.x() > origin.x()
+           || (origin.x() > xMinOriginWithBehind && opponent.x() > xMinBehind);
+  }
+
+  /** Sorts the blocked intervals and determines the free lanes between them. */
+  void finish();
+
+  /**
+   * Checks whether a pass is not blocked. Only opponents that are not further
+   * away than the target plus the clearance are considered.
+   * @param target The target of the pass.
+   * @return Is the pass free?
+   */
+  bool isFree(const Vector2f& target) const;
+
+  /**
+   * Returns the lanes that are free of all opponents.
+   * @return The lanes ordered by their width, the widest first.
+   */
+  const std::vector<Lane>& getLanes() const {return lanes;}
+
+  /** Returns the intervals blocked by the opponents, sorted by their minimum. */
+  const std::vector<Blocked>& getBlocked() const {return blocked;}
+
+private:
+  Vector2f origin = Vector2f::Zero(); /**< The position the passes start at. */
+  float clearance = 0.f; /**< The minimum distance of opponents from the path of the ball. */
+  std::vector<Blocked> blocked; /**< The intervals blocked by each opponent. */
+  std::vector<Rangea> merged; /**< The union of the blocked intervals, i.e. disjoint ranges sorted by their minimum. */
+  std::vector<Lane> lanes; /**< The free lanes, the widest first. */
+};
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "Platform/Thread.h"
 #include "Tools/MessageQueue/MessageQueue.h"
 
 class AnnotationManager final
@@ -13,6 +14,8 @@ public:
   AnnotationManager();
   AnnotationManager(const AnnotationManager&) = delete;
 
+  DECLARE_SYNC; /**< Annotations can be added by the worker threads of a module graph runner. */
+
   void signalThreadStart();
   void clear();
 
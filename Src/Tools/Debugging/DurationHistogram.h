@@ -0,0 +1,109 @@
+/**
+ * @file DurationHistogram.h
+ *
+ * The file declares a histogram of durations with a fixed number of log-linear
+ * buckets. Each power of two is divided into the same number of equally sized
+ * buckets, so the relative error of a quantile is bounded independently of the
+ * magnitude of the durations. Adding a duration takes a few shifts and never
+ * allocates memory.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+class DurationHistogram
+{
+public:
+  static constexpr unsigned subBucketBits = 3; /**< Each power of two is divided into 2^subBucketBits buckets. */
+  static constexpr unsigned subBuckets = 1 << subBucketBits; /**< The number of buckets per power of two. */
+  static constexpr unsigned maxDuration = (1 << 24) - 1; /**< Longer durations are clamped to this one (in µs). */
+  static constexpr unsigned numOfBuckets = (25 - subBucketBits) * subBuckets; /**< The number of buckets required to cover all durations up to maxDuration. */
+
+private:
+  std::array<unsigned, numOfBuckets> counts; /**< The number of durations per bucket. */
+  unsigned total; /**< The number of durations added. */
+  unsigned maximum; /**< The longest duration added (in µs). */
+
+public:
+  DurationHistogram() {reset();}
+
+  /**
+   * Adds a duration.
+   * @param duration The duration in µs.
+   */
+  void add(unsigned duration)
+  {
+    duration = std::min(duration, maxDuration);
+    ++counts[getBucket(duration)];
+    ++total;
+    maximum = std::max(maximum, duration);
+  }
+
+  /** Removes all durations. */
+  void reset()
+  {
+    counts.fill(0);
+    total = 0;
+    maximum = 0;
+  }
+
+  /**
+   * Returns an upper bound for the duration below which a certain ratio of all
+   * durations lies. The bound is at most 1/subBuckets larger than the actual quantile.
+   * @param ratio The ratio in [0 .. 1], e.g. 0.95f for the 95th percentile.
+   * @return The quantile in µs. 0 if no durations were added.
+   */
+  unsigned getQuantile(float ratio) const
+  {
+    const unsigned rank = std::max(1u, static_cast<unsigned>(std::ceil(ratio * static_cast<float>(total))));
+    unsigned sum = 0;
+    for(unsigned i = 0; i < numOfBuckets; ++i)
+    {
+      sum += counts[i];
+      if(sum >= rank)
+        return std::min(getLowerBound(i + 1) - 1, maximum);
+    }
+    return maximum;
+  }
+
+  /** Returns the longest duration added (in µs). */
+  unsigned getMaximum() const {return maximum;}
+
+  /** Returns the number of durations added. */
+  unsigned getTotal() const {return total;}
+
+private:
+  /**
+   * Returns the bucket of a duration. Durations below 2 * subBuckets have a bucket
+   * of their own. Above that, the bucket is determined by the position of the highest
+   * bit set and the subBucketBits following it.
+   * @param duration The duration in µs. Must not exceed maxDuration.
+   * @return The index of the bucket.
+   */
+  static unsigned getBucket(unsigned duration)
+  {
+    unsigned shift = 0;
+    while(duration >= 2 * subBuckets)
+    {
+      duration >>= 1;
+      ++shift;
+    }
+    return shift * subBuckets + duration;
+  }
+
+  /**
+   * Returns the shortest duration that falls into a bucket.
+   * @param bucket The index of the bucket. numOfBuckets is allowed.
+   * @return The duration in µs.
+   */
+  static unsigned getLowerBound(unsigned bucket)
+  {
+    if(bucket < 2 * subBuckets)
+      return bucket;
+    else
+      return (subBuckets + bucket % subBuckets) << (bucket / subBuckets - 1);
+  }
+};
@@ -15,22 +15,24 @@
 class Stopwatch
 {
   const char* const name; /**< The name of the plot. */
+  const unsigned short id; /**< The id of the stopwatch in the timing manager. */
   bool running = true; /**< Should the stopwatch still be running? */
 
 public:
   /**
    * Start the stopwatch.
    * @param name The name of the plot.
+   * @param id The id of the stopwatch in the timing manager.
    */
-  Stopwatch(const char* name) : name(name) {Global::getTimingManager().startTiming(name + 15);}
+  Stopwatch(const char* name, unsigned short id) : name(name), id(id) {Global::getTimingManager().startTiming(id);}
 
   /** Stop the stopwatch.*/
   ~Stopwatch()
   {
-#ifndef TARGET_TOOL
-    const unsigned time = Global::getTimingManager().stopTiming(name + 15);
-#else
+    const unsigned time = Global::getTimingManager().stopTiming(id);
+#ifdef TARGET_TOOL
     static_cast<void>(name);
+    static_cast<void>(time);
 #endif
     DEBUG_RESPONSE(name)
       OUTPUT(idPlot, bin, (name + 5) << static_cast<float>(time) * 0.001f);
@@ -45,4 +47,5 @@ public:
  * @param name The name of the stopwatch.
  */
 #define STOPWATCH(name) \
-  for(Stopwatch _stopwatch("plot:stopwatch:" name); _stopwatch.isRunning();)
+  for(Stopwatch _stopwatch("plot:stopwatch:" name, [] {static const unsigned short id = TimingManager::getId(name); return id;}()); \
+      _stopwatch.isRunning();)
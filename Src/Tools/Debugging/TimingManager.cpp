@@ -6,8 +6,13 @@
  */
 
 #include "TimingManager.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <string>
 #include <unordered_map>
-#include <vector>
 #include "Platform/BHAssert.h"
 #include "Platform/Time.h"
 #include "Debugging.h"
@@ -15,27 +20,77 @@
 
 using namespace std;
 
-struct TimingManager::Pimpl
+/** The names of all stopwatches. They are shared by all threads. */
+class StopwatchRegistry
 {
+public:
+  std::mutex mutex; /**< Guards adding names, because threads might add them concurrently. */
+  unordered_map<string, unsigned short> ids; /**< The id for each name. */
+  array<const char*, TimingManager::maxStopwatches> names; /**< The name for each id. Entries are never changed once set. */
+  atomic<unsigned short> numOfNames{0}; /**< The number of ids assigned. */
+
   /**
-   * NOTE: the hash maps only work because the compiler uses a string table and
-   *       allocates only one address for all const string literals with the same value.
-   *       If this ever changes you have to replace the key with std::string
+   * Returns the only instance. It is created when it is used for the first time.
+   * @return The registry.
    */
+  static StopwatchRegistry& getInstance()
+  {
+    static StopwatchRegistry registry;
+    return registry;
+  }
+};
+
+/** The lane of the current thread. 0 is the thread owning the timing manager. */
+static thread_local unsigned char lane = 0;
+
+struct TimingManager::Pimpl
+{
+  struct Watch
+  {
+    /**
+     * If the stopwatch has been started but not stopped, yet: the start time minus
+     * the time already accumulated in this frame. Else: the time accumulated in this frame.
+     */
+    unsigned long long time = 0;
+    bool known = false; /**< Was the stopwatch ever used in this thread? */
+    bool usedInFrame = false; /**< Was the stopwatch used in the current frame? */
+    bool nameSent = false; /**< Was the name of the stopwatch sent together with the events of the previous frames? */
+  };
+
+  struct Event
+  {
+    unsigned long long timestamp; /**< The time of the event in ns (steady clock). */
+    unsigned short id; /**< The id of the stopwatch. */
+    unsigned char flags; /**< Bit 7: the stopwatch was started (otherwise stopped). Bits 0-6: the lane. */
+  };
 
   /**
-   * Key: name of the timer
-   * value: If timer has been started but not stopped, yet: the start time.
-   *        Else: the time between start and stop.
+   * The stopwatches indexed by their ids. Each entry is only written by the thread running
+   * the stopwatch. Worker threads synchronize with the owning thread before it reads them.
    */
-  unordered_map<const char*, unsigned long long> timing;
-  unordered_map<const char*, unsigned short> idTable; /**< Key: name of the stopwatch. Value: the id that is used when sending timing data over the network */
+  array<Watch, maxStopwatches> watches;
+  array<Event, maxEvents> events; /**< A ring buffer of the events of the current frame. */
+  atomic<unsigned> numOfEvents{0}; /**< The number of events recorded in this frame. The next is written to numOfEvents % maxEvents. */
+  unsigned long long frameStart = 0; /**< The time when the current frame started in ns (steady clock). */
   unsigned currentThreadStartTime = 0; /**< Timestamp of the current thread iteration */
   unsigned frameNo = 0; /**<  Number of the current frame*/
-  vector<const char*> watchNames; /**< Contains the names of the stopwatches */
   MessageQueue data; /**< Contains the timing data in streamable format inbetween frames */
-  bool dataPrepared = false; /**< True if data hs already been prepared this frame */
-  int watchNameIndex = 0; /**< Every frame a few watch names are transmitted. This is the index of the watchname that is to be transmitted next */
+  unsigned eventsPrepared = numeric_limits<unsigned>::max(); /**< The number of events when data was prepared. Data is outdated if more events were recorded. */
+  bool eventsRequested = false; /**< Shall the events of the current frame be sent? */
+  unsigned short watchNameIndex = 0; /**< Every frame a few watch names are transmitted. This is the id of the watchname that is to be transmitted next */
+
+  /**
+   * Records an event.
+   * @param id The id of the stopwatch.
+   * @param begin Was the stopwatch started (or stopped)?
+   */
+  void record(unsigned short id, bool begin)
+  {
+    Event& event = events[numOfEvents++ % maxEvents];
+    event.timestamp = static_cast<unsigned long long>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+    event.id = id;
+    event.flags = static_cast<unsigned char>((begin ? 0x80 : 0) | lane);
+  }
 };
 
 TimingManager::TimingManager() : prvt(new TimingManager::Pimpl)
@@ -48,45 +103,81 @@ TimingManager::~TimingManager()
   delete prvt;
 }
 
-void TimingManager::startTiming(const char* identifier)
+unsigned short TimingManager::getId(const char* name)
 {
-  auto timing = prvt->timing.find(identifier);
-  if(timing == prvt->timing.end())
-  {
-    //create new entry
-    prvt->watchNames.push_back(identifier);
-    prvt->idTable[identifier] = static_cast<unsigned short>(prvt->idTable.size()); //NOTE: this assumes that an unsigned short will always be big big enough to count the timers...
-    timing = prvt->timing.insert(std::pair<const char*, unsigned long long>(identifier, 0)).first;
-  }
-  prvt->dataPrepared = false;
-  timing->second = Time::getCurrentThreadTime() - timing->second; // accumulate measurements
+  StopwatchRegistry& registry = StopwatchRegistry::getInstance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto i = registry.ids.find(name);
+  if(i != registry.ids.end())
+    return i->second;
+  const unsigned short id = registry.numOfNames;
+  ASSERT(id < maxStopwatches);
+  registry.names[id] = name;
+  registry.numOfNames = static_cast<unsigned short>(id + 1);
+  return registry.ids[name] = id;
+}
+
+void TimingManager::setLane(unsigned char lane)
+{
+  ASSERT(lane < 0x80);
+  ::lane = lane;
+}
+
+void TimingManager::startTiming(unsigned short id)
+{
+  Pimpl::Watch& watch = prvt->watches[id];
+  watch.known = true;
+  watch.usedInFrame = true;
+  prvt->record(id, true);
+  watch.time = Time::getCurrentThreadTime() - watch.time; // accumulate measurements
 }
 
-unsigned TimingManager::stopTiming(const char* identifier)
+unsigned TimingManager::stopTiming(unsigned short id)
 {
   const unsigned long long stopTime = Time::getCurrentThreadTime();
-  auto timing = prvt->timing.find(identifier);
-  const unsigned diff = unsigned(stopTime - timing->second);
-  timing->second = diff;
+  prvt->record(id, false);
+  Pimpl::Watch& watch = prvt->watches[id];
+  const unsigned diff = unsigned(stopTime - watch.time);
+  watch.time = diff;
   return diff;
 }
 
 void TimingManager::signalThreadStart()
 {
   prvt->currentThreadStartTime = Time::getCurrentSystemTime();
+  prvt->frameStart = static_cast<unsigned long long>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
   prvt->frameNo++;
   prvt->data.clear();
-  prvt->dataPrepared = false;
-  for(const pair<const char* const, unsigned long long>& it : prvt->timing)
-    prvt->timing[it.first] = 0;
+  prvt->numOfEvents = 0;
+  prvt->eventsPrepared = numeric_limits<unsigned>::max();
+  const unsigned short numOfNames = StopwatchRegistry::getInstance().numOfNames;
+  for(unsigned short id = 0; id < numOfNames; ++id)
+  {
+    Pimpl::Watch& watch = prvt->watches[id];
+    watch.time = 0;
+    // If no events were sent, a receiver of future events might have missed all names.
+    watch.nameSent = prvt->eventsRequested && (watch.nameSent || watch.usedInFrame);
+    watch.usedInFrame = false;
+  }
+  prvt->eventsRequested = false;
+}
+
+void TimingManager::requestEvents()
+{
+  if(!prvt->eventsRequested)
+  {
+    prvt->eventsRequested = true;
+    prvt->eventsPrepared = numeric_limits<unsigned>::max();
+  }
 }
 
 MessageQueue& TimingManager::getData()
 {
-  if(!prvt->dataPrepared)
+  if(prvt->eventsPrepared != prvt->numOfEvents)
   {
+    prvt->data.clear();
     prepareData();
-    prvt->dataPrepared = true;
+    prvt->eventsPrepared = prvt->numOfEvents;
   }
   return prvt->data;
 }
@@ -107,25 +198,86 @@ void TimingManager::prepareData()
    * unsigned : timestamp at which the last iteration started.
    * unsigned : frame number of the current frame
    */
+  const StopwatchRegistry& registry = StopwatchRegistry::getInstance();
+  const unsigned short numOfNames = registry.numOfNames;
   OutBinaryMessage& out = prvt->data.out.bin;
 
+  unsigned short numOfKnownWatches = 0;
+  for(unsigned short id = 0; id < numOfNames; ++id)
+    if(prvt->watches[id].known)
+      ++numOfKnownWatches;
+
   // every frame we send 3 watch names
-  out << static_cast<unsigned short>(3); //number of names to follow
-  for(int i = 0; i < 3; ++i, prvt->watchNameIndex = (prvt->watchNameIndex + 1) % prvt->watchNames.size())
+  const unsigned short namesToSend = std::min(numOfKnownWatches, static_cast<unsigned short>(3));
+  out << namesToSend; //number of names to follow
+  for(unsigned short i = 0; i < namesToSend; ++prvt->watchNameIndex)
   {
-    const char* watchName = prvt->watchNames[prvt->watchNameIndex];
-    out << prvt->idTable[watchName] << watchName;
+    if(prvt->watchNameIndex >= numOfNames)
+      prvt->watchNameIndex = 0;
+    if(prvt->watches[prvt->watchNameIndex].known)
+    {
+      out << prvt->watchNameIndex << registry.names[prvt->watchNameIndex];
+      ++i;
+    }
   }
 
   // now write the data of all watches
-  out << static_cast<unsigned short>(prvt->timing.size());
-  for(const pair<const char* const, unsigned long long>& it : prvt->timing)
-  {
-    out << prvt->idTable[it.first];
-    out << static_cast<unsigned>(it.second); // the cast is ok because the time between start and stop will never be bigger than an int...
-  }
+  out << numOfKnownWatches;
+  for(unsigned short id = 0; id < numOfNames; ++id)
+    if(prvt->watches[id].known)
+    {
+      out << id;
+      out << static_cast<unsigned>(prvt->watches[id].time); // the cast is ok because the time between start and stop will never be bigger than an int...
+    }
   out << prvt->currentThreadStartTime;
   out << prvt->frameNo;
   if(!prvt->data.out.finishMessage(idStopwatch))
     OUTPUT_WARNING("TimingManager: queue is full!!!");
+
+  if(prvt->eventsRequested)
+    prepareEvents();
+}
+
+void TimingManager::prepareEvents()
+{
+  /** Protocol of the events:
+   * unsigned short : number of stopwatch names
+   * for each stopwatch used in this frame whose name was not sent before:
+   *  unsigned short : id of the stopwatch
+   *  string         : name of the stopwatch
+   *
+   * unsigned : upper 32 bits of the time when the frame started in ns
+   * unsigned : lower 32 bits of the time when the frame started in ns
+   * unsigned : number of events
+   * for each event:
+   *  unsigned short : id of the stopwatch
+   *  unsigned char  : bit 7: stopwatch started (otherwise stopped), bits 0-6: lane of the thread
+   *  unsigned       : time since the frame started in ns
+   */
+  const StopwatchRegistry& registry = StopwatchRegistry::getInstance();
+  const unsigned short numOfNames = registry.numOfNames;
+  OutBinaryMessage& out = prvt->data.out.bin;
+
+  unsigned short numOfNewNames = 0;
+  for(unsigned short id = 0; id < numOfNames; ++id)
+    if(prvt->watches[id].usedInFrame && !prvt->watches[id].nameSent)
+      ++numOfNewNames;
+  out << numOfNewNames;
+  for(unsigned short id = 0; id < numOfNames; ++id)
+    if(prvt->watches[id].usedInFrame && !prvt->watches[id].nameSent)
+      out << id << registry.names[id];
+
+  out << static_cast<unsigned>(prvt->frameStart >> 32) << static_cast<unsigned>(prvt->frameStart);
+  const unsigned numOfEvents = prvt->numOfEvents;
+  const unsigned first = numOfEvents > maxEvents ? numOfEvents - maxEvents : 0;
+  out << numOfEvents - first;
+  for(unsigned i = first; i < numOfEvents; ++i)
+  {
+    const Pimpl::Event& event = prvt->events[i % maxEvents];
+    out << event.id << event.flags
+        << static_cast<unsigned>(std::min(event.timestamp - std::min(event.timestamp, prvt->frameStart),
+                                          static_cast<unsigned long long>(numeric_limits<unsigned>::max())));
+  }
+  if(!prvt->data.out.finishMessage(idTraceEvents))
+    OUTPUT_WARNING("TimingManager: queue is full!!!");
 }
@@ -11,21 +11,49 @@ class MessageQueue;
 
 /**
  * A class that keeps track of several stopwatches.
+ * Stopwatches are identified by ids that are shared by all threads. Starting
+ * and stopping a stopwatch does not lock, so stopwatches can also run in the
+ * worker threads of a module graph runner, as long as the same stopwatch is not
+ * running in two threads at the same time. In addition to the accumulated time
+ * of each stopwatch per frame, every start and stop is recorded as an event
+ * with a nanosecond timestamp. If requested, these events are part of the
+ * timing data, which allows to export the timeline of all threads as a trace
+ * (see TraceWriter).
  */
 class TimingManager final
 {
 public:
+  static constexpr unsigned maxStopwatches = 1024; /**< The maximum number of different stopwatch names. */
+  static constexpr unsigned maxEvents = 4096; /**< The number of events a thread can record per frame. Older events are overwritten. */
+
   /** Constructor. */
   TimingManager();
 
   /** Destructor. */
   ~TimingManager();
 
-  /** Start the stopwatch for the specified identifier. */
-  void startTiming(const char* identifier);
+  /**
+   * Returns the id of a stopwatch name. The STOPWATCH macro calls this function
+   * only once per call site.
+   * @param name The name of the stopwatch. Only the pointer is stored, i.e. it must
+   *             be a string literal.
+   * @return The id that is used for this name in all threads.
+   */
+  static unsigned short getId(const char* name);
+
+  /**
+   * Sets the lane of the calling thread. Events are recorded together with the lane
+   * to distinguish between the thread owning a timing manager (lane 0) and threads
+   * that help executing its modules.
+   * @param lane The lane of the calling thread (< 128).
+   */
+  static void setLane(unsigned char lane);
 
-  /** Stops the stopwatch for the specified identifier and returns the time in us. */
-  unsigned stopTiming(const char* identifier);
+  /** Start the stopwatch for the specified id. */
+  void startTiming(unsigned short id);
+
+  /** Stops the stopwatch for the specified id and returns the time in us. */
+  unsigned stopTiming(unsigned short id);
 
   /**
    * The TimingManager has a special stopwatch that is used to keep track
@@ -35,6 +63,14 @@ public:
    */
   void signalThreadStart();
 
+  /**
+   * Requests that the data of the current frame also contain the stopwatch events.
+   * The request must be repeated in each frame. The name of a stopwatch is only
+   * sent with the events of the first frame it is used in since the requests
+   * started, i.e. a receiver must get the events of all these frames.
+   */
+  void requestEvents();
+
   /**
    * Returns a message queue that contains all timing data from this frame.
    * Call this method in between signalThreadStop() and signalThreadStart.
@@ -45,6 +81,9 @@ private:
   /** Prepares timing data for streaming. */
   void prepareData();
 
+  /** Prepares the events for streaming. */
+  void prepareEvents();
+
   struct Pimpl;
   Pimpl* prvt;
 };
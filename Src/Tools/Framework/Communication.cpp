@@ -12,14 +12,18 @@
 
 bool DebugSenderBase::terminating = false;
 
-void ReceiverBase::setPacket(void* p)
+void ReceiverBase::reserve()
 {
-  int writing = 0;
+  writing = 0;
   if(writing == actual)
     ++writing;
   if(writing == reading)
     if(++writing == actual)
       ++writing;
+}
+
+void ReceiverBase::setPacket(void* p)
+{
   ASSERT(writing != actual);
   ASSERT(writing != reading);
   if(packet[writing])
@@ -41,6 +41,7 @@ protected:
   void* packet[3];           /**< A triple buffer for received packets. */
   volatile int reading = 0;   /**< Index of packet reserved for reading. */
   volatile int actual = 0;    /**< Index of packet that is the most actual. */
+  int writing = 0;            /**< Index of packet reserved for writing. Only used by the sender. */
 
 public:
   /**
@@ -63,12 +64,33 @@ public:
   }
 
   /**
-   * The function sets the packet.
+   * The function reserves the index of the next packet to be written.
+   * It is neither the index of the packet being read nor the most actual one.
+   */
+  void reserve();
+
+  /**
+   * The function sets the packet at the index reserved before.
    *
    * @param p The packet.
    */
   void setPacket(void* p);
 
+  /**
+   * The function returns the index of the packet reserved for writing.
+   * Data that is associated with a packet can be stored under this index.
+   *
+   * @return The index (0..2).
+   */
+  int getWritingIndex() const { return writing; }
+
+  /**
+   * The function returns the index of the packet reserved for reading.
+   *
+   * @return The index (0..2).
+   */
+  int getReadingIndex() const { return reading; }
+
   /**
    * The function determines whether the receiver has a pending packet.
    *
@@ -171,6 +193,7 @@ public:
     if(receiverThreadName == Communication::dummy)
       return;
     const PacketType& data = *static_cast<const PacketType*>(this);
+    receiver.reserve();
     OutBinaryMemory stream(16384);
     stream << data;
     receiver.setPacket(stream.obtainData());
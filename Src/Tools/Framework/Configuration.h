@@ -54,6 +54,10 @@ STREAMABLE(Configuration,
     (unsigned)(0) debugSenderSize, /**< The maximum size of the queue in Bytes. */
     (unsigned)(0) debugSenderInfrastructureSize,
     (std::string) executionUnit,
+    (bool)(false) exchangeDirectly, /**< Receive representations by swapping pre-allocated instances instead of streaming them (if their types allow it). */
+    (unsigned)(0) workerThreads, /**< The number of additional threads that execute independent providers concurrently. Ignored if debugging is compiled in. */
+    (std::vector<unsigned>) stripeCores, /**< The cores of additional threads that help executing image kernels in horizontal stripes, one thread per entry. Only used on the robot. */
+    (float)(0.f) frequency, /**< The expected frequency of this thread in Hz. Longer frames are counted as budget overruns. 0 if unknown. */
     (std::vector<RepresentationProvider>) representationProviders,
   });
 
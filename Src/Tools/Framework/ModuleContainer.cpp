@@ -11,6 +11,7 @@
 #include "Platform/Time.h"
 #include "Threads/Debug.h"
 #include "Tools/Framework/FrameExecutionUnit.h"
+#include "Tools/ImageProcessing/ParallelRows.h"
 #include "Tools/Logging/Logger.h"
 #include "Tools/Math/Constants.h"
 
@@ -22,7 +23,9 @@ ModuleContainer::ModuleContainer(const Settings& settings, const std::string& ro
   ThreadFrame(settings, robotName),
   name(config()[index].name),
   priority(config()[index].priority),
-  moduleGraphRunner(config().size()),
+  moduleGraphRunner(config().size(), config()[index].workerThreads,
+                    SystemCall::getMode() == SystemCall::physicalRobot ? config()[index].priority : 0,
+                    [this] { setGlobals(); }, config()[index].frequency),
   logger(logger)
 {
   for(ExecutionUnitCreatorBase* i = ExecutionUnitCreatorBase::first; i; i = i->next)
@@ -34,6 +37,14 @@ ModuleContainer::ModuleContainer(const Settings& settings, const std::string& ro
     }
   }
   ASSERT(executionUnit);
+
+#ifdef TARGET_ROBOT
+  // The cores of the robot are known, so the threads are pinned to them.
+  // In the simulator, all robots would compete for the same cores.
+  if(!config()[index].stripeCores.empty())
+    parallelRows = new ParallelRows(name + "Rows", static_cast<unsigned>(config()[index].stripeCores.size()),
+                                    config()[index].priority, config()[index].stripeCores);
+#endif
 }
 
 ModuleContainer::~ModuleContainer()
@@ -58,6 +69,12 @@ void ModuleContainer::connectWithSender(ModuleContainer* sender, const Configura
     if(getName() == config()[i].name)
     {
       sender->senders.back().index = i;
+      if(config()[i].exchangeDirectly)
+      {
+        receivers.back().sharedInstances = std::make_shared<ModulePacketInstances>();
+        receivers.back().sharedInstances->receiver = &receivers.back();
+        sender->senders.back().sharedInstances = receivers.back().sharedInstances;
+      }
       break;
     }
 }
@@ -109,6 +126,7 @@ bool ModuleContainer::main()
     if(logger)
       logger->execute(getName());
 
+    DEBUG_RESPONSE("timing:events") Global::getTimingManager().requestEvents();
     DEBUG_RESPONSE("timing") Global::getTimingManager().getData().copyAllMessages(*debugSender);
 
     DEBUG_RESPONSE("annotation") Global::getAnnotationManager().getOut().copyAllMessages(*debugSender);
@@ -10,6 +10,7 @@
 #include "ThreadFrame.h"
 #include "Tools/Debugging/Debugging.h"
 #include "Tools/Global.h"
+#include "Tools/ImageProcessing/ParallelRows.h"
 #include <asmjit/asmjit.h>
 
 ThreadFrame::ThreadFrame(const Settings& settings, const std::string& robotName) :
@@ -47,6 +48,7 @@ ThreadFrame::~ThreadFrame()
   delete debugReceiver;
   delete debugSender;
   delete asmjitRuntime;
+  delete parallelRows;
 }
 
 void ThreadFrame::setGlobals()
@@ -62,6 +64,7 @@ void ThreadFrame::setGlobals()
   Global::theAsmjitRuntime = asmjitRuntime;
 
   Blackboard::setInstance(blackboard); // blackboard is NOT globally accessible
+  ParallelRows::setInstance(parallelRows);
 }
 
 void ThreadFrame::threadMain()
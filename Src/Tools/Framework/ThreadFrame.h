@@ -31,6 +31,7 @@ namespace asmjit
 {
   class JitRuntime;
 }
+class ParallelRows;
 
 /**
  * @class ThreadFrame
@@ -62,6 +63,7 @@ private:
 
 protected:
   const std::string robotName; /**< The name of the robot this thread belongs to. */
+  ParallelRows* parallelRows = nullptr; /**< The threads that help executing image kernels in this thread. nullptr if there are none. */
 
 public:
   /**
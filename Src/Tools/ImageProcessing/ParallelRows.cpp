@@ -0,0 +1,137 @@
+/**
+ * @file ParallelRows.cpp
+ *
+ * This file implements a pool of threads that help executing image kernels
+ * in horizontal stripes.
+ */
+
+#include "ParallelRows.h"
+#include "Platform/BHAssert.h"
+#include "Platform/Thread.h"
+#include <algorithm>
+
+/** The pool of the current thread. */
+static thread_local ParallelRows* theInstance = nullptr;
+
+class ParallelRows::Worker : public Thread
+{
+private:
+  ParallelRows& pool; /**< The pool this thread belongs to. */
+  const std::string name; /**< The name of this thread. */
+
+public:
+  Semaphore go; /**< Signals that a kernel should be executed. */
+
+  /**
+   * Constructor.
+   * @param pool The pool this thread belongs to.
+   * @param name The name of this thread.
+   * @param priority The priority of this thread.
+   */
+  Worker(ParallelRows& pool, const std::string& name, int priority) :
+    Thread(priority), pool(pool), name(name)
+  {
+    start(this, &Worker::main);
+  }
+
+  /** Destructor. Stops the thread. */
+  ~Worker()
+  {
+    announceStop();
+    go.post();
+    stop();
+  }
+
+private:
+  /** The main function of this thread. */
+  void main()
+  {
+    Thread::nameCurrentThread(name);
+    while(go.wait() && isRunning())
+      pool.help();
+  }
+};
+
+ParallelRows::ParallelRows(const std::string& name, unsigned numOfThreads, int priority, const std::vector<unsigned>& cores) :
+  busy(false), open(false), inside(0), next(0)
+{
+  for(unsigned i = 0; i < numOfThreads; ++i)
+  {
+    workers.emplace_back(new Worker(*this, name + std::to_string(i + 1), priority));
+    if(i < cores.size())
+      workers.back()->setAffinity(cores[i]);
+  }
+}
+
+ParallelRows::~ParallelRows()
+{
+  ASSERT(!busy);
+  workers.clear();
+}
+
+bool ParallelRows::forRows(int yMin, int yMax, int stripeHeight, const Kernel& kernel)
+{
+  ASSERT(stripeHeight > 0);
+  if(yMin >= yMax)
+    return false;
+  const int numOfStripes = (yMax - yMin + stripeHeight - 1) / stripeHeight;
+  if(workers.empty() || numOfStripes < 2 || busy.exchange(true, std::memory_order_acquire))
+  {
+    kernel(yMin, yMax);
+    return false;
+  }
+
+  this->kernel = &kernel;
+  this->yMin = yMin;
+  this->yMax = yMax;
+  this->stripeHeight = stripeHeight;
+  this->numOfStripes = numOfStripes;
+  next = 0;
+  open = true;
+  for(std::size_t i = 0; i < std::min(workers.size(), static_cast<std::size_t>(numOfStripes - 1)); ++i)
+    workers[i]->go.post();
+
+  executeStripes();
+
+  // All stripes are taken. Workers that wake up now leave immediately, so
+  // only those that are still executing a stripe must be waited for.
+  open = false;
+  while(inside)
+    Thread::yield();
+  busy.store(false, std::memory_order_release);
+  return true;
+}
+
+void ParallelRows::executeStripes()
+{
+  for(int i = next++; i < numOfStripes; i = next++)
+  {
+    const int y = yMin + i * stripeHeight;
+    (*kernel)(y, std::min(y + stripeHeight, yMax));
+  }
+}
+
+void ParallelRows::help()
+{
+  ++inside;
+  if(open)
+    executeStripes();
+  --inside;
+}
+
+bool ParallelRows::parallelForRows(int yMin, int yMax, int stripeHeight, const Kernel& kernel)
+{
+  if(theInstance)
+    return theInstance->forRows(yMin, yMax, stripeHeight, kernel);
+  else
+  {
+    if(yMin < yMax)
+      kernel(yMin, yMax);
+    return false;
+  }
+}
+
+void ParallelRows::setInstance(ParallelRows* instance)
+{
+  theInstance = instance;
+}
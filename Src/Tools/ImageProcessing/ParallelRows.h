@@ -0,0 +1,93 @@
+/**
+ * @file ParallelRows.h
+ *
+ * This file declares a pool of threads that help executing image kernels
+ * in horizontal stripes. Each thread that executes modules can have its
+ * own pool.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ParallelRows
+{
+public:
+  using Kernel = std::function<void(int yMin, int yMax)>; /**< Processes the rows [yMin, yMax[. */
+
+  /**
+   * Constructor. Starts the threads.
+   * @param name The name of the threads. It is followed by their indices.
+   * @param numOfThreads The number of additional threads. The thread calling
+   *                     forRows always processes stripes as well.
+   * @param priority The priority of the threads.
+   * @param cores The cores the threads are pinned to, i.e. the i-th thread is
+   *              pinned to cores[i]. Threads without an entry are not pinned.
+   */
+  ParallelRows(const std::string& name, unsigned numOfThreads, int priority = 0, const std::vector<unsigned>& cores = std::vector<unsigned>());
+
+  /** Destructor. Stops the threads. */
+  ~ParallelRows();
+
+  /**
+   * Executes a kernel for horizontal stripes of rows. The stripes are taken
+   * one after another by the calling thread and the threads of this pool,
+   * i.e. a thread that does not get a core, e.g. because the Motion thread
+   * needs it, does not delay the others. A thread only waits for stripes
+   * that were already started. If the pool is used by another thread at the
+   * same time, the kernel is executed sequentially instead.
+   * @param yMin The first row.
+   * @param yMax The row after the last one.
+   * @param stripeHeight The number of rows per stripe. Stripes start at yMin
+   *                     plus multiples of this value. The last one can be shorter.
+   * @param kernel The kernel. It must only write the rows it was called for.
+   * @return Whether the kernel was called for each stripe. Otherwise, it was
+   *         called once for all rows.
+   */
+  bool forRows(int yMin, int yMax, int stripeHeight, const Kernel& kernel);
+
+  /**
+   * Executes a kernel for horizontal stripes of rows with the pool of the
+   * current thread (see forRows). Without a pool, the kernel is called once
+   * for all rows.
+   * @param yMin The first row.
+   * @param yMax The row after the last one.
+   * @param stripeHeight The number of rows per stripe.
+   * @param kernel The kernel.
+   * @return Whether the kernel was called for each stripe.
+   */
+  static bool parallelForRows(int yMin, int yMax, int stripeHeight, const Kernel& kernel);
+
+  /**
+   * Sets the pool of the current thread.
+   * @param instance The pool or nullptr if kernels are executed sequentially.
+   */
+  static void setInstance(ParallelRows* instance);
+
+private:
+  class Worker; /**< A thread that helps executing the stripes. */
+
+  std::vector<std::unique_ptr<Worker>> workers; /**< The threads of this pool. */
+  std::atomic<bool> busy; /**< Is a thread currently using this pool? */
+  std::atomic<bool> open; /**< Can the workers take stripes of the current kernel? */
+  std::atomic<unsigned> inside; /**< The number of workers currently taking or executing stripes. */
+  std::atomic<int> next; /**< The index of the next stripe that is executed. */
+  const Kernel* kernel = nullptr; /**< The current kernel. */
+  int yMin = 0; /**< The first row of the current kernel. */
+  int yMax = 0; /**< The row after the last one of the current kernel. */
+  int stripeHeight = 1; /**< The number of rows per stripe of the current kernel. */
+  int numOfStripes = 0; /**< The number of stripes of the current kernel. */
+
+  /** Executes stripes of the current kernel until none are left. */
+  void executeStripes();
+
+  /**
+   * Executes stripes of the current kernel if it is still open.
+   * It is called by the workers.
+   */
+  void help();
+};
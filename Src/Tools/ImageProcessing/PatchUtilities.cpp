@@ -7,6 +7,8 @@
 #include "PatchUtilities.h"
 #include "Tools/ImageProcessing/ImageTransform.h"
 #include <iostream>
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 Matrix3f PatchUtilities::calcInverseTransformation(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize)
@@ -45,7 +47,7 @@ void PatchUtilities::getInterpolatedImageSection(const Vector2i& center, const V
 }
 
 template<typename OutType, bool interpolate>
-void PatchUtilities::getImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output)
+void PatchUtilities::getImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output, ColumnTable& columns)
 {
   const Vector2i upperLeft = (center.array() - inSize.array() / 2).matrix();
   const Vector2f stepSize = (inSize.cast<float>().array() / outSize.cast<float>().array()).matrix();
@@ -87,94 +89,57 @@ void PatchUtilities::getImageSection(const Vector2i& center, const Vector2i& inS
     std::fill_n(output, outSize.x() * outSize.y(), static_cast<OutType>(fillColor));
   }
 
+  // The sampled columns are the same in all rows, so they are only computed once.
+  columns.indices.resize(std::max(xSteps, 0));
+  if(interpolate)
+    columns.weights.resize(std::max(xSteps, 0));
+  float xImage = xImageOffset;
+  for(int n = 0; n < xSteps; xImage += stepSize.x(), ++n)
+  {
+    const size_t xIndex = static_cast<size_t>(xImage);
+    columns.indices[n] = static_cast<int>(xIndex);
+    if(interpolate)
+      columns.weights[n] = xImage - static_cast<float>(xIndex);
+  }
+  const int* xIndices = columns.indices.data();
+  const float* xWeights1 = columns.weights.data();
+
   // Copy the patch
   OutType* dest = output + yPatchOffset * outSize.x(); //Check x or y
-  if(xSteps < outSize.x())
+  const size_t xPatchSkip = outSize.x() - xSteps - xPatchOffset;
+  for(; ySteps; yImage += stepSize.y(), --ySteps)
   {
-    const size_t xPatchSkip = outSize.x() - xSteps - xPatchOffset;
-    if(!interpolate)
+    dest += xPatchOffset;
+    if constexpr(!interpolate)
     {
-      for(; ySteps; yImage += stepSize.y(), --ySteps)
-      {
-        const PixelTypes::GrayscaledPixel* row = src[static_cast<size_t>(yImage)];
-
-        dest += xPatchOffset;
-        float xImage = xImageOffset;
-        for(size_t n = xSteps; n; xImage += stepSize.x(), --n)
-          * dest++ = static_cast<OutType>(row[static_cast<size_t>(xImage)]);
-        dest += xPatchSkip;
-      }
+      const PixelTypes::GrayscaledPixel* row = src[static_cast<size_t>(yImage)];
+      for(int n = 0; n < xSteps; ++n)
+        dest[n] = static_cast<OutType>(row[xIndices[n]]);
     }
     else
     {
-      for(; ySteps; yImage += stepSize.y(), --ySteps)
-      {
-        const size_t yIndex = static_cast<size_t>(yImage);
-        const float yWeight1 = yImage - static_cast<float>(yIndex);
-        const float yWeight0 = 1 - yWeight1;
-        const PixelTypes::GrayscaledPixel* row0 = src[yIndex];
-        const PixelTypes::GrayscaledPixel* row1 = src[yIndex + 1];
-
-        dest += xPatchOffset;
-        float xImage = xImageOffset;
-        for(size_t n = xSteps; n; xImage += stepSize.x(), --n)
-        {
-          const size_t xIndex = static_cast<size_t>(xImage);
-          const float xWeight1 = xImage - static_cast<float>(xIndex);
-          const float xWeight0 = 1 - xWeight1;
-
-          *dest++ = static_cast<OutType>(
-                      std::min(
-                        255.f,
-                        yWeight0 * (static_cast<float>(row0[xIndex]) * xWeight0 + static_cast<float>(row0[xIndex + 1]) * xWeight1)
-                        + yWeight1 * (static_cast<float>(row1[xIndex]) * xWeight0 + static_cast<float>(row1[xIndex + 1]) * xWeight1)
-                      )
-                    );
-        }
-        dest += xPatchSkip;
-      }
-    }
-  }
-  else
-  {
-    if(!interpolate)
-    {
-      for(; ySteps; yImage += stepSize.y(), --ySteps)
-      {
-        const PixelTypes::GrayscaledPixel* row = src[static_cast<size_t>(yImage)];
+      const size_t yIndex = static_cast<size_t>(yImage);
+      const float yWeight1 = yImage - static_cast<float>(yIndex);
+      const float yWeight0 = 1 - yWeight1;
+      const PixelTypes::GrayscaledPixel* row0 = src[yIndex];
+      const PixelTypes::GrayscaledPixel* row1 = src[yIndex + 1];
 
-        float xImage = xImageOffset;
-        for(size_t n = xSteps; n; xImage += stepSize.x(), --n)
-          * dest++ = static_cast<OutType>(row[static_cast<size_t>(xImage)]);
-      }
-    }
-    else
-    {
-      for(; ySteps; yImage += stepSize.y(), --ySteps)
+      for(int n = 0; n < xSteps; ++n)
       {
-        const size_t yIndex = static_cast<size_t>(yImage);
-        const float yWeight1 = yImage - static_cast<float>(yIndex);
-        const float yWeight0 = 1 - yWeight1;
-        const PixelTypes::GrayscaledPixel* row0 = src[yIndex];
-        const PixelTypes::GrayscaledPixel* row1 = src[yIndex + 1];
-
-        float xImage = xImageOffset;
-        for(size_t n = xSteps; n; xImage += stepSize.x(), --n)
-        {
-          const size_t xIndex = static_cast<size_t>(xImage);
-          const float xWeight1 = xImage - static_cast<float>(xIndex);
-          const float xWeight0 = 1 - xWeight1;
-
-          *dest++ = static_cast<OutType>(
-                      std::min(
-                        255.f,
-                        yWeight0 * (static_cast<float>(row0[xIndex]) * xWeight0 + static_cast<float>(row0[xIndex + 1]) * xWeight1)
-                        + yWeight1 * (static_cast<float>(row1[xIndex]) * xWeight0 + static_cast<float>(row1[xIndex + 1]) * xWeight1)
-                      )
-                    );
-        }
+        const int xIndex = xIndices[n];
+        const float xWeight1 = xWeights1[n];
+        const float xWeight0 = 1 - xWeight1;
+
+        dest[n] = static_cast<OutType>(
+                    std::min(
+                      255.f,
+                      yWeight0 * (static_cast<float>(row0[xIndex]) * xWeight0 + static_cast<float>(row0[xIndex + 1]) * xWeight1)
+                      + yWeight1 * (static_cast<float>(row1[xIndex]) * xWeight0 + static_cast<float>(row1[xIndex + 1]) * xWeight1)
+                    )
+                  );
       }
     }
+    dest += xSteps + xPatchSkip;
   }
 }
 
@@ -186,16 +151,58 @@ void PatchUtilities::normalizeContrast(GrayscaledImage& output, const float perc
 template<typename OutType>
 void PatchUtilities::normalizeContrast(OutType* output, const Vector2i& size, const float percent)
 {
-  Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, Eigen::Dynamic>> patch(output, size.x(), size.y());
-  Eigen::Matrix<OutType, Eigen::Dynamic, 1> sorted = Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, 1>>(patch.data(), size.x() * size.y());
-  std::sort(sorted.data(), sorted.data() + sorted.size());
+  if constexpr(std::is_same<OutType, unsigned char>::value)
+    normalizeContrastWithHistogram(output, size, percent);
+  else
+  {
+    Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, Eigen::Dynamic>> patch(output, size.x(), size.y());
+    Eigen::Matrix<OutType, Eigen::Dynamic, 1> sorted = Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, 1>>(patch.data(), size.x() * size.y());
+
+    // Only the two quantiles are needed, so the values are not sorted completely.
+    const int minIndex = static_cast<int>((sorted.size() - 1) * percent);
+    const int maxIndex = static_cast<int>((sorted.size() - 1) * (1.f - percent));
+    std::nth_element(sorted.data(), sorted.data() + minIndex, sorted.data() + sorted.size());
+    OutType min = sorted(minIndex);
+    std::nth_element(sorted.data() + minIndex, sorted.data() + maxIndex, sorted.data() + sorted.size());
+    OutType max = sorted(maxIndex);
+    if(max == 0)
+      patch.setConstant(0);
+    else
+      patch.array() = ((patch.array().max(min).min(max) - min).template cast<float>() * 255.f / (static_cast<float>(max - min))).template cast<OutType>();
+  }
+}
+
+template<typename OutType>
+void PatchUtilities::normalizeContrastWithHistogram(OutType* output, const Vector2i& size, const float percent)
+{
+  const int count = size.x() * size.y();
+  std::array<int, 256> histogram;
+  histogram.fill(0);
+  for(int i = 0; i < count; ++i)
+    ++histogram[static_cast<unsigned char>(output[i])];
+
+  // The same quantiles as when sorting, i.e. the values at these indices of the sorted patch.
+  const int minIndex = static_cast<int>((count - 1) * percent);
+  const int maxIndex = static_cast<int>((count - 1) * (1.f - percent));
+  int min = 0;
+  int sum = histogram[0];
+  while(sum <= minIndex)
+    sum += histogram[++min];
+  int max = min;
+  while(sum <= maxIndex)
+    sum += histogram[++max];
 
-  OutType min = sorted(static_cast<int>((sorted.size() - 1) * percent));
-  OutType max = sorted(static_cast<int>((sorted.size() - 1) * (1.f - percent)));
   if(max == 0)
-    patch.setConstant(0);
+    std::fill_n(output, count, static_cast<OutType>(0));
   else
-    patch.array() = ((patch.array().max(min).min(max) - min).template cast<float>() * 255.f / (static_cast<float>(max - min))).template cast<OutType>();
+  {
+    // There are only 256 different values, so their results are looked up.
+    std::array<OutType, 256> normalized;
+    for(int value = 0; value < 256; ++value)
+      normalized[value] = static_cast<OutType>(static_cast<float>(std::max(min, std::min(max, value)) - min) * 255.f / static_cast<float>(max - min));
+    for(int i = 0; i < count; ++i)
+      output[i] = normalized[static_cast<unsigned char>(output[i])];
+  }
 }
 
 template void PatchUtilities::normalizeContrast<float>(float* output, const Vector2i& size, const float percent);
@@ -210,14 +217,21 @@ void PatchUtilities::extractPatch(const Vector2i& center, const Vector2i& inSize
 
 template<typename OutType>
 void PatchUtilities::extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode)
+{
+  ColumnTable columns;
+  extractPatch(center, inSize, outSize, src, dest, mode, columns);
+}
+
+template<typename OutType>
+void PatchUtilities::extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode, ColumnTable& columns)
 {
   switch (mode)
   {
     case fast:
-      getImageSection<OutType,false>(center, inSize, outSize, src, dest);
+      getImageSection<OutType,false>(center, inSize, outSize, src, dest, columns);
       break;
     case fastInterpolated:
-      getImageSection<OutType, true>(center, inSize, outSize, src, dest);
+      getImageSection<OutType, true>(center, inSize, outSize, src, dest, columns);
       break;
     case interpolated:
       getInterpolatedImageSection<OutType>(center, inSize, outSize, src, dest);
@@ -225,8 +239,32 @@ void PatchUtilities::extractPatch(const Vector2i& center, const Vector2i& inSize
   }
 }
 
+template<typename OutType>
+void PatchUtilities::extractPatches(const std::vector<Vector2i>& centers, const std::vector<Vector2i>& inSizes, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode, const float percent)
+{
+  ASSERT(centers.size() == inSizes.size());
+  const int patchSize = outSize.x() * outSize.y();
+  // The columns depend on the position and size of each patch, so they are recomputed
+  // for every patch. Only their storage is reused.
+  ColumnTable columns;
+  for(std::size_t i = 0; i < centers.size(); ++i, dest += patchSize)
+  {
+    extractPatch(centers[i], inSizes[i], outSize, src, dest, mode, columns);
+    if(percent > 0.f)
+    {
+      // Without interpolation, the patch only contains pixel values.
+      if(mode == fast)
+        normalizeContrastWithHistogram(dest, outSize, percent);
+      else
+        normalizeContrast(dest, outSize, percent);
+    }
+  }
+}
+
 template void PatchUtilities::extractPatch<float>(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, float* dest, const ExtractionMode mode);
 template void PatchUtilities::extractPatch<unsigned char>(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, unsigned char* dest, const ExtractionMode mode);
+template void PatchUtilities::extractPatches<float>(const std::vector<Vector2i>& centers, const std::vector<Vector2i>& inSizes, const Vector2i& outSize, const GrayscaledImage& src, float* dest, const ExtractionMode mode, const float percent);
+template void PatchUtilities::extractPatches<unsigned char>(const std::vector<Vector2i>& centers, const std::vector<Vector2i>& inSizes, const Vector2i& outSize, const GrayscaledImage& src, unsigned char* dest, const ExtractionMode mode, const float percent);
 
 template<typename OutType, bool grayscale>
 void PatchUtilities::extractInput(const CameraImage& cameraImage, const Vector2i& patchSize, OutType* input)
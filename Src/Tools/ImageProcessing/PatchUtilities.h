@@ -10,6 +10,7 @@
 #include "Tools/ImageProcessing/Image.h"
 #include "Tools/Math/Eigen.h"
 #include "Tools/Streams/Enum.h"
+#include <vector>
 
 class PatchUtilities
 {
@@ -29,17 +30,50 @@ public:
   static void extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode = fast);
   static void extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, GrayscaledImage& dest, const ExtractionMode mode = fast);
 
+  /**
+   * Extracts several patches into one buffer, e.g. the input of a neural network
+   * that processes them in a single batch. The patches are stored one after another.
+   * @param centers The centers of the patches in the image.
+   * @param inSizes The sizes of the patches in the image (one per center).
+   * @param outSize The size of each patch in the buffer.
+   * @param src The image.
+   * @param dest The buffer. It must provide space for centers.size() * outSize.x() * outSize.y() values.
+   * @param mode How the image is sampled.
+   * @param percent If positive, the contrast of each patch is normalized (see normalizeContrast).
+   */
+  template<typename OutType>
+  static void extractPatches(const std::vector<Vector2i>& centers, const std::vector<Vector2i>& inSizes, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode = fast, const float percent = 0.f);
+
   // This methods only work correctly if the image dimensions are multiples of the patch size.
   template<typename OutType, bool grayscale>
   static void extractInput(const CameraImage& cameraImage, const Vector2i& patchSize, OutType* input);
   static void extractInput(const CameraImage& cameraImage, const Vector2i& patchSize, std::uint8_t* input);
 
 private:
+  /** The sampled columns of a patch. They are the same in all of its rows. */
+  struct ColumnTable
+  {
+    std::vector<int> indices; /**< The column in the image for each column sampled. */
+    std::vector<float> weights; /**< The weight of the column right of the index (only used for interpolation). */
+  };
+
+  template<typename OutType>
+  static void extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode, ColumnTable& columns);
+
   template<typename OutType, bool interpolate = false>
-  static void getImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output);
+  static void getImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output, ColumnTable& columns);
 
   template<typename OutType>
   static void getInterpolatedImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output);
 
+  /**
+   * Normalizes the contrast of a patch based on a histogram instead of sorting.
+   * @param output The patch. All values must be integers between 0 and 255.
+   * @param size The size of the patch.
+   * @param percent The ratio of the darkest and the brightest pixels that are saturated.
+   */
+  template<typename OutType>
+  static void normalizeContrastWithHistogram(OutType* output, const Vector2i& size, const float percent);
+
   static Matrix3f calcInverseTransformation(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize);
 };
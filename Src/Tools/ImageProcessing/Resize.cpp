@@ -7,15 +7,27 @@
  */
 
 #include "Tools/ImageProcessing/Resize.h"
+#include "Tools/ImageProcessing/ColorModelConversions.h"
+#include "Tools/ImageProcessing/ParallelRows.h"
 #include "Tools/ImageProcessing/SIMD.h"
+#include "Platform/BHAssert.h"
+#include <algorithm>
 #include <array>
+#include <cstring>
 
-void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::GrayscaledPixel>& src, PixelTypes::GrayscaledPixel* dest)
+/**
+ * Shrinks consecutive rows of a grayscale image. The buffer for the result is
+ * also used for intermediate results.
+ * @param downScales How often the size is halved.
+ * @param src The first row.
+ * @param srcWidth The width of the rows.
+ * @param srcHeight The number of rows.
+ * @param dest The buffer. It must have the size of the source rows.
+ */
+static void shrinkYRows(const unsigned int downScales, const PixelTypes::GrayscaledPixel* src, size_t srcWidth, size_t srcHeight,
+                        PixelTypes::GrayscaledPixel* dest)
 {
-  const __m128i* pSrc = reinterpret_cast<const __m128i*>(src[0]);
-
-  size_t srcWidth = src.width;
-  size_t srcHeight = src.height;
+  const __m128i* pSrc = reinterpret_cast<const __m128i*>(src);
 
   // Shrink horizontally
   size_t downScalesLeft = downScales;
@@ -206,15 +218,23 @@ void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::Gray
   }
 }
 
-void Resize::shrinkUV(const unsigned int downScales, const Image<PixelTypes::YUYVPixel>& src, unsigned short* dest)
+/**
+ * Shrinks consecutive rows of the chroma channels of a YUYV image. The buffer
+ * for the result is also used for intermediate results.
+ * @param downScales How often the width is halved. The height is halved once more.
+ * @param src The first row.
+ * @param srcWidth The width of the rows.
+ * @param srcHeight The number of rows.
+ * @param dest The buffer. It must have one element per source pixel.
+ */
+static void shrinkUVRows(const unsigned int downScales, const PixelTypes::YUYVPixel* src, size_t srcWidth, size_t srcHeight,
+                         unsigned short* dest)
 {
-  const size_t srcSize = src.width * src.height * 2;
-  size_t srcWidth = src.width;
-  size_t srcHeight = src.height;
+  const size_t srcSize = srcWidth * srcHeight * 2;
   unsigned int downScalesLeft = downScales;
 
   // Convert YUV422 to UV and shrink horizontally if needed
-  const __m128i* pSrc = reinterpret_cast<const __m128i*>(src[0]);
+  const __m128i* pSrc = reinterpret_cast<const __m128i*>(src);
   __m128i* pDest = reinterpret_cast<__m128i*>(dest);
   static const __m128i shuffleMask = _mm_setr_epi8(0, -1, 1, -1, 4, -1, 5, -1, 8, -1, 9, -1, 12, -1, 13, -1);
   if(downScalesLeft > 2)
@@ -560,3 +580,154 @@ void Resize::shrinkUV(const unsigned int downScales, const Image<PixelTypes::YUY
     }
   }
 }
+
+void Resize::shrinkY(const unsigned int downScales, const Image<PixelTypes::GrayscaledPixel>& src, PixelTypes::GrayscaledPixel* dest)
+{
+  const int destWidth = src.width >> downScales;
+  const int destHeight = src.height >> downScales;
+  if(destWidth % 16) // The rows of the result overlap while shrinking vertically.
+  {
+    shrinkYRows(downScales, src[0], src.width, src.height, dest);
+    return;
+  }
+
+  // Stripes are shrunk independently, each in the part of the buffer that belongs
+  // to its source rows. Afterwards, they are moved to their final places.
+  const int stripeHeight = std::max(1, 64 >> downScales);
+  if(ParallelRows::parallelForRows(0, destHeight, stripeHeight, [&](int yMin, int yMax)
+  {
+    shrinkYRows(downScales, src[yMin << downScales], src.width, (yMax - yMin) << downScales, dest + (yMin << downScales) * src.width);
+  }))
+    for(int y = stripeHeight; y < destHeight; y += stripeHeight)
+      std::memmove(dest + y * destWidth, dest + (y << downScales) * src.width, std::min(stripeHeight, destHeight - y) * destWidth);
+}
+
+void Resize::shrinkUV(const unsigned int downScales, const Image<PixelTypes::YUYVPixel>& src, unsigned short* dest)
+{
+  const int destWidth = src.width >> downScales;
+  const int destHeight = src.height >> (downScales + 1);
+  if(destWidth % 8) // The rows of the result overlap while shrinking vertically.
+  {
+    shrinkUVRows(downScales, src[0], src.width, src.height, dest);
+    return;
+  }
+
+  // Stripes are shrunk independently, each in the part of the buffer that belongs
+  // to its source rows. Afterwards, they are moved to their final places.
+  const int stripeHeight = std::max(1, 64 >> (downScales + 1));
+  if(ParallelRows::parallelForRows(0, destHeight, stripeHeight, [&](int yMin, int yMax)
+  {
+    shrinkUVRows(downScales, src[yMin << (downScales + 1)], src.width, (yMax - yMin) << (downScales + 1),
+                 dest + (yMin << (downScales + 1)) * src.width);
+  }))
+    for(int y = stripeHeight; y < destHeight; y += stripeHeight)
+      std::memmove(dest + y * destWidth, dest + (y << (downScales + 1)) * src.width,
+                   std::min(stripeHeight, destHeight - y) * destWidth * sizeof(unsigned short));
+}
+
+void Resize::letterboxRGB(const Image<PixelTypes::YUYVPixel>& src, int x, int y, int width, int height, int size, int* dest)
+{
+  constexpr int maxSize = 512;
+  constexpr int maxRowBytes = 4096;
+  ASSERT(x >= 0 && y >= 0 && width > 0 && height > 0);
+  ASSERT(x + width <= static_cast<int>(src.width) * 2 && y + height <= static_cast<int>(src.height));
+  ASSERT(size > 0 && size <= maxSize);
+
+  const int resizedWidth = width > height ? size : std::max(1, size * width / height);
+  const int resizedHeight = width > height ? std::max(1, size * height / width) : size;
+  const int left = (size - resizedWidth + 1) / 2;
+  const int top = (size - resizedHeight) / 2;
+  std::fill(dest, dest + size * size * 3, 0);
+
+  // The YUYV pixels covering the region are interpolated vertically into a row first.
+  const int firstPair = x / 2;
+  const int rowBytes = ((x + width + 1) / 2 - firstPair) * 4;
+  ASSERT(rowBytes <= maxRowBytes);
+  alignas(16) std::array<unsigned char, maxRowBytes> row;
+
+  // The horizontal interpolation is the same for all rows. Pixel centers are mapped onto each other.
+  std::array<int, maxSize> yLeft, yRight, uvLeft, uvRight;
+  alignas(16) std::array<float, maxSize + 3> weights;
+  const float scaleX = static_cast<float>(width) / static_cast<float>(resizedWidth);
+  for(int i = 0; i < resizedWidth; ++i)
+  {
+    const float sx = std::min(std::max((static_cast<float>(i) + 0.5f) * scaleX - 0.5f, 0.f), static_cast<float>(width - 1));
+    const int pixel = static_cast<int>(sx) + x - firstPair * 2;
+    const int next = std::min(pixel + 1, x + width - 1 - firstPair * 2);
+    yLeft[i] = pixel * 2;
+    yRight[i] = next * 2;
+    uvLeft[i] = (pixel >> 1) * 4 + 1;
+    uvRight[i] = (next >> 1) * 4 + 1;
+    weights[i] = sx - static_cast<float>(static_cast<int>(sx));
+  }
+  weights[resizedWidth] = weights[resizedWidth + 1] = weights[resizedWidth + 2] = 0.f;
+
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 maxValue = _mm_set1_ps(255.f);
+  const __m128 offset = _mm_set1_ps(128.f);
+  const float scale = 1.f / static_cast<float>(1 << ColorModelConversions::scaleExponent);
+  const __m128 invUCoeff = _mm_set1_ps(static_cast<float>(ColorModelConversions::scaledInvUCoeff) * scale);
+  const __m128 invVCoeff = _mm_set1_ps(static_cast<float>(ColorModelConversions::scaledInvVCoeff) * scale);
+  const __m128 gCoeffU = _mm_set1_ps(static_cast<float>(ColorModelConversions::scaledGCoeffU) * scale);
+  const __m128 gCoeffV = _mm_set1_ps(static_cast<float>(ColorModelConversions::scaledGCoeffV) * scale);
+
+  const float scaleY = static_cast<float>(height) / static_cast<float>(resizedHeight);
+  for(int j = 0; j < resizedHeight; ++j)
+  {
+    const float sy = std::min(std::max((static_cast<float>(j) + 0.5f) * scaleY - 0.5f, 0.f), static_cast<float>(height - 1));
+    const int upper = static_cast<int>(sy);
+    const int lower = std::min(upper + 1, height - 1);
+    const short weight = static_cast<short>((sy - static_cast<float>(upper)) * 256.f);
+    const unsigned char* pUpper = reinterpret_cast<const unsigned char*>(src[y + upper] + firstPair);
+    const unsigned char* pLower = reinterpret_cast<const unsigned char*>(src[y + lower] + firstPair);
+
+    // Interpolate vertically. This works on the interleaved channels, because all of them are interpolated the same way.
+    const __m128i upperWeight = _mm_set1_epi16(static_cast<short>(256 - weight));
+    const __m128i lowerWeight = _mm_set1_epi16(weight);
+    int byte = 0;
+    for(; byte + 16 <= rowBytes; byte += 16)
+    {
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pUpper + byte));
+      const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLower + byte));
+      const __m128i low = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, _mm_setzero_si128()), upperWeight),
+                                                       _mm_mullo_epi16(_mm_unpacklo_epi8(b, _mm_setzero_si128()), lowerWeight)), 8);
+      const __m128i high = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, _mm_setzero_si128()), upperWeight),
+                                                        _mm_mullo_epi16(_mm_unpackhi_epi8(b, _mm_setzero_si128()), lowerWeight)), 8);
+      _mm_store_si128(reinterpret_cast<__m128i*>(row.data() + byte), _mm_packus_epi16(low, high));
+    }
+    for(; byte < rowBytes; ++byte)
+      row[byte] = static_cast<unsigned char>((pUpper[byte] * (256 - weight) + pLower[byte] * weight) >> 8);
+
+    // Interpolate horizontally and convert four pixels at once.
+    int* pDest = dest + ((top + j) * size + left) * 3;
+    for(int i = 0; i < resizedWidth; i += 4)
+    {
+      alignas(16) std::array<float, 4> y0, y1, u0, u1, v0, v1;
+      for(int k = 0; k < 4; ++k)
+      {
+        const int n = std::min(i + k, resizedWidth - 1);
+        y0[k] = row[yLeft[n]];
+        y1[k] = row[yRight[n]];
+        u0[k] = row[uvLeft[n]];
+        u1[k] = row[uvRight[n]];
+        v0[k] = row[uvLeft[n] + 2];
+        v1[k] = row[uvRight[n] + 2];
+      }
+      const __m128 w = _mm_loadu_ps(weights.data() + i);
+      const __m128 yValue = _mm_add_ps(_mm_load_ps(y0.data()), _mm_mul_ps(_mm_sub_ps(_mm_load_ps(y1.data()), _mm_load_ps(y0.data())), w));
+      const __m128 uValue = _mm_sub_ps(_mm_add_ps(_mm_load_ps(u0.data()), _mm_mul_ps(_mm_sub_ps(_mm_load_ps(u1.data()), _mm_load_ps(u0.data())), w)), offset);
+      const __m128 vValue = _mm_sub_ps(_mm_add_ps(_mm_load_ps(v0.data()), _mm_mul_ps(_mm_sub_ps(_mm_load_ps(v1.data()), _mm_load_ps(v0.data())), w)), offset);
+
+      alignas(16) std::array<int, 4> r, g, b;
+      _mm_store_si128(reinterpret_cast<__m128i*>(r.data()), _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(yValue, _mm_mul_ps(vValue, invVCoeff)), zero), maxValue)));
+      _mm_store_si128(reinterpret_cast<__m128i*>(g.data()), _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_sub_ps(yValue, _mm_add_ps(_mm_mul_ps(uValue, gCoeffU), _mm_mul_ps(vValue, gCoeffV))), zero), maxValue)));
+      _mm_store_si128(reinterpret_cast<__m128i*>(b.data()), _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(yValue, _mm_mul_ps(uValue, invUCoeff)), zero), maxValue)));
+      for(int k = 0; k < 4 && i + k < resizedWidth; ++k, pDest += 3)
+      {
+        pDest[0] = r[k];
+        pDest[1] = g[k];
+        pDest[2] = b[k];
+      }
+    }
+  }
+}
@@ -30,4 +30,18 @@ namespace Resize
     dest.setResolution(src.width >> downScales, src.height >> (downScales + 1));
     shrinkUV(downScales, src, dest[0]);
   }
+
+  /**
+   * Converts a region of a YUYV image into a square RGB tensor in a single pass. The region is
+   * scaled bilinearly to fit into the tensor while keeping its aspect ratio and is centered in it.
+   * The remaining border is filled with zeros. Only the pixels of the region are read.
+   * @param src The image. Each of its pixels contains two horizontally adjacent image pixels.
+   * @param x The left edge of the region in image pixels.
+   * @param y The upper edge of the region.
+   * @param width The width of the region in image pixels.
+   * @param height The height of the region.
+   * @param size The edge length of the tensor. Must not be larger than 512.
+   * @param dest The tensor in row-major order with interleaved RGB channels (size * size * 3 values).
+   */
+  void letterboxRGB(const Image<PixelTypes::YUYVPixel>& src, int x, int y, int width, int height, int size, int* dest);
 }
@@ -0,0 +1,66 @@
+/**
+ * @file ScanLineColumns.cpp
+ *
+ * This file implements a class that copies the image columns along vertical
+ * scan lines into contiguous memory.
+ */
+
+#include "ScanLineColumns.h"
+#include <algorithm>
+#include <limits>
+
+void ScanLineColumns::update(const Image<PixelTypes::GrayscaledPixel>& grayscaled, const Image<PixelTypes::GrayscaledPixel>& saturated,
+                             const Image<PixelTypes::HuePixel>& hued, const std::vector<Column>& columns)
+{
+  ASSERT(saturated.width == grayscaled.width && saturated.height == grayscaled.height);
+  ASSERT(hued.width == grayscaled.width && hued.height == grayscaled.height);
+
+  height = grayscaled.height;
+  const std::size_t size = columns.size() * height;
+  if(gauss3Values.size() < size)
+  {
+    gauss3Values.resize(size);
+    gauss5Values.resize(size);
+    grayscaledValues.resize(size);
+    saturatedValues.resize(size);
+    huedValues.resize(size);
+  }
+
+  int yMin = std::numeric_limits<int>::max();
+  int yMax = 0;
+  for(const Column& column : columns)
+  {
+    ASSERT(column.yMin >= 0 && column.yMax <= static_cast<int>(height));
+    yMin = std::min(yMin, column.yMin);
+    yMax = std::max(yMax, column.yMax);
+  }
+
+  // The image is traversed row by row. Each row is touched once for all columns.
+  // The stores go through local pointers, because the compiler would otherwise
+  // reload the buffer addresses after each write of a single byte.
+  short* const gauss3 = gauss3Values.data();
+  short* const gauss5 = gauss5Values.data();
+  PixelTypes::GrayscaledPixel* const gray = grayscaledValues.data();
+  PixelTypes::GrayscaledPixel* const saturation = saturatedValues.data();
+  PixelTypes::HuePixel* const hue = huedValues.data();
+  for(int y = yMin; y < yMax; ++y)
+  {
+    const PixelTypes::GrayscaledPixel* const grayscaledRow = grayscaled[y];
+    const PixelTypes::GrayscaledPixel* const saturatedRow = saturated[y];
+    const PixelTypes::HuePixel* const huedRow = hued[y];
+    std::size_t index = y;
+    for(const Column& column : columns)
+    {
+      if(y >= column.yMin && y < column.yMax)
+      {
+        const PixelTypes::GrayscaledPixel* const p = grayscaledRow + column.x;
+        gauss3[index] = static_cast<short>(p[-1] + 2 * p[0] + p[1]);
+        gauss5[index] = static_cast<short>(p[-2] + 2 * p[-1] + 4 * p[0] + 2 * p[1] + p[2]);
+        gray[index] = p[0];
+        saturation[index] = saturatedRow[column.x];
+        hue[index] = huedRow[column.x];
+      }
+      index += height;
+    }
+  }
+}
@@ -0,0 +1,82 @@
+/**
+ * @file ScanLineColumns.h
+ *
+ * This file declares a class that copies the image columns along vertical
+ * scan lines into contiguous memory. The columns are filled in a single pass
+ * over the image rows, so the image is read sequentially instead of with a
+ * full row stride per pixel. In addition to the luminance, saturation, and hue,
+ * the luminance smoothed horizontally with binomial filters of the sizes 3 and
+ * 5 is stored.
+ */
+
+#pragma once
+
+#include "Tools/ImageProcessing/Image.h"
+#include "Tools/ImageProcessing/PixelTypes.h"
+#include <vector>
+
+class ScanLineColumns
+{
+public:
+  /** The description of a column that should be copied. */
+  struct Column
+  {
+    int x; /**< The x coordinate of the column. The smoothing also reads the two pixels on each side. */
+    int yMin; /**< The first row copied. */
+    int yMax; /**< The row after the last one copied. */
+  };
+
+  /**
+   * Copies the columns from the images. All images must have the same resolution.
+   * @param grayscaled The luminance image.
+   * @param saturated The saturation image.
+   * @param hued The hue image.
+   * @param columns The columns to copy. The values of the rows outside of their
+   *                ranges are undefined.
+   */
+  void update(const Image<PixelTypes::GrayscaledPixel>& grayscaled, const Image<PixelTypes::GrayscaledPixel>& saturated,
+              const Image<PixelTypes::HuePixel>& hued, const std::vector<Column>& columns);
+
+  /**
+   * The luminance smoothed horizontally with the filter 1 2 1.
+   * @param index The index of the column.
+   * @return The values of the column indexed by the y coordinate.
+   */
+  const short* gauss3(std::size_t index) const {return gauss3Values.data() + index * height;}
+
+  /**
+   * The luminance smoothed horizontally with the filter 1 2 4 2 1.
+   * @param index The index of the column.
+   * @return The values of the column indexed by the y coordinate.
+   */
+  const short* gauss5(std::size_t index) const {return gauss5Values.data() + index * height;}
+
+  /**
+   * The luminance.
+   * @param index The index of the column.
+   * @return The values of the column indexed by the y coordinate.
+   */
+  const PixelTypes::GrayscaledPixel* grayscaled(std::size_t index) const {return grayscaledValues.data() + index * height;}
+
+  /**
+   * The saturation.
+   * @param index The index of the column.
+   * @return The values of the column indexed by the y coordinate.
+   */
+  const PixelTypes::GrayscaledPixel* saturated(std::size_t index) const {return saturatedValues.data() + index * height;}
+
+  /**
+   * The hue.
+   * @param index The index of the column.
+   * @return The values of the column indexed by the y coordinate.
+   */
+  const PixelTypes::HuePixel* hued(std::size_t index) const {return huedValues.data() + index * height;}
+
+private:
+  std::size_t height = 0; /**< The number of rows of each column. */
+  std::vector<short> gauss3Values; /**< The horizontally smoothed luminance of all columns (filter 1 2 1). */
+  std::vector<short> gauss5Values; /**< The horizontally smoothed luminance of all columns (filter 1 2 4 2 1). */
+  std::vector<PixelTypes::GrayscaledPixel> grayscaledValues; /**< The luminance of all columns. */
+  std::vector<PixelTypes::GrayscaledPixel> saturatedValues; /**< The saturation of all columns. */
+  std::vector<PixelTypes::HuePixel> huedValues; /**< The hue of all columns. */
+};
@@ -9,15 +9,19 @@
 #include "Tools/ImageProcessing/SIMD.h"
 #include "Platform/BHAssert.h"
 #include "Platform/Memory.h"
+#include "Tools/ImageProcessing/ParallelRows.h"
 #include "Sobel.h"
 
-void Sobel::sobelSSE(const Image1D& srcImage, SobelImage& destImage)
+/**
+ * Computes the inner rows [yMin, yMax[ of a Sobel image. Their left and right
+ * borders are set to zero.
+ * @param srcImage The source image.
+ * @param destImage The destination image. It already has the resolution of the source image.
+ * @param yMin The first row. Must be at least 1.
+ * @param yMax The row after the last one. Must be at most the height - 1.
+ */
+static void sobelRows(const Sobel::Image1D& srcImage, Sobel::SobelImage& destImage, int yMin, int yMax)
 {
-  ASSERT(srcImage.width % 16 == 0);
-  ASSERT(srcImage.height >= 3);
-
-  destImage.setResolution(srcImage.width, srcImage.height);
-
   // a b c    0 1 2
   // d e f    3 4 5
   // g h i    6 7 8
@@ -29,22 +33,13 @@ void Sobel::sobelSSE(const Image1D& srcImage, SobelImage& destImage)
   __m128i zeros = _mm_setzero_si128();
 
   __m128i* pDestImg;
-  __m128i* pDestImgLineEnd;
-
-  // Fill top line
-  for(pDestImg = reinterpret_cast<__m128i*>(destImage[0]), pDestImgLineEnd = reinterpret_cast<__m128i*>(destImage[1]);
-      pDestImg < pDestImgLineEnd; ++pDestImg)
-  {
-    *pDestImg = zeros;
-  }
 
-  int lastRow = destImage.height - 1;
-  const Image1D::PixelType* p0 = srcImage[0];
-  const Image1D::PixelType* p1 = srcImage[1];
-  const Image1D::PixelType* p2 = srcImage[2];
-  const Image1D::PixelType* p0LineEnd;
+  const Sobel::Image1D::PixelType* p0 = srcImage[yMin - 1];
+  const Sobel::Image1D::PixelType* p1 = srcImage[yMin];
+  const Sobel::Image1D::PixelType* p2 = srcImage[yMin + 1];
+  const Sobel::Image1D::PixelType* p0LineEnd;
 
-  for(int y = 1; y < lastRow; ++y)
+  for(int y = yMin; y < yMax; ++y)
   {
     for(p0LineEnd = srcImage[y], pDestImg = reinterpret_cast<__m128i*>(destImage[y]); p0 < p0LineEnd;
         p0 += 16, p1 += 16, p2 += 16, pDestImg += 2)
@@ -80,19 +75,41 @@ void Sobel::sobelSSE(const Image1D& srcImage, SobelImage& destImage)
       *pDestImg = _mm_unpacklo_epi8(sumX, sumY);
       *(pDestImg + 1) = _mm_unpackhi_epi8(sumX, sumY);
     }
+
+    // Fill right and left border
+    destImage[y]->index = 0;
+    (destImage[y + 1] - 1)->index = 0;
   }
+}
 
-  // Fill bottom line
-  for(pDestImg = reinterpret_cast<__m128i*>(destImage[destImage.height - 1]), pDestImgLineEnd = reinterpret_cast<__m128i*>(destImage[destImage.height]);
+void Sobel::sobelSSE(const Image1D& srcImage, SobelImage& destImage)
+{
+  ASSERT(srcImage.width % 16 == 0);
+  ASSERT(srcImage.height >= 3);
+
+  destImage.setResolution(srcImage.width, srcImage.height);
+
+  __m128i zeros = _mm_setzero_si128();
+
+  __m128i* pDestImg;
+  __m128i* pDestImgLineEnd;
+
+  // Fill top line
+  for(pDestImg = reinterpret_cast<__m128i*>(destImage[0]), pDestImgLineEnd = reinterpret_cast<__m128i*>(destImage[1]);
       pDestImg < pDestImgLineEnd; ++pDestImg)
   {
     *pDestImg = zeros;
   }
 
-  // Fill right and left border
-  for(unsigned int y = 0; y < destImage.height - 1; y++)
+  ParallelRows::parallelForRows(1, destImage.height - 1, 32, [&](int yMin, int yMax)
   {
-    destImage[y]->index = 0;
-    (destImage[y + 1] - 1)->index = 0;
+    sobelRows(srcImage, destImage, yMin, yMax);
+  });
+
+  // Fill bottom line
+  for(pDestImg = reinterpret_cast<__m128i*>(destImage[destImage.height - 1]), pDestImgLineEnd = reinterpret_cast<__m128i*>(destImage[destImage.height]);
+      pDestImg < pDestImgLineEnd; ++pDestImg)
+  {
+    *pDestImg = zeros;
   }
 }
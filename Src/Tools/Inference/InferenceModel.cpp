@@ -0,0 +1,217 @@
+/**
+ * @file InferenceModel.cpp
+ *
+ * This file implements the backends of the common interface for neural networks.
+ */
+
+#include "InferenceModel.h"
+#include "InferenceRuntime.h"
+#include "Platform/BHAssert.h"
+#include "Tools/Debugging/Debugging.h"
+#include "Tools/Global.h"
+#include <CompiledNN/CompiledNN.h>
+#include <CompiledNN/Model.h>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+
+/** A model that is run by the ONNX Runtime. Only the first input and output are used. */
+class OnnxModel : public InferenceModel
+{
+private:
+  Ort::Session session{nullptr};
+  std::vector<unsigned char> inputBuffer; /**< The inputs of the largest batch. */
+  std::vector<unsigned char> outputBuffer; /**< The outputs of the largest batch. */
+  std::vector<unsigned char> byteInputBuffer; /**< If bytes are given for a float input: The inputs of the largest batch. */
+  std::vector<Ort::Value> tensors; /**< The input and output tensors for each batch size. They are views of the buffers. */
+  std::vector<Ort::IoBinding> bindings; /**< The bindings of the tensors for each batch size. */
+
+  /**
+   * Returns the size of the elements of a tensor type.
+   * @param type The type of the elements.
+   * @return The size in bytes.
+   */
+  static std::size_t getElementSize(ONNXTensorElementDataType type)
+  {
+    switch(type)
+    {
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+        return 1;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+        return 4;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+        return 8;
+      default:
+        FAIL("Unsupported tensor element type " << static_cast<int>(type) << ".");
+        return 0;
+    }
+  }
+
+  /**
+   * Returns the dimensions of a single sample of a tensor.
+   * @param shape The shape of the tensor including the batch dimension.
+   * @return The dimensions without the batch dimension.
+   */
+  static std::vector<unsigned> getDimensions(const std::vector<int64_t>& shape)
+  {
+    ASSERT(!shape.empty() && (shape[0] == -1 || shape[0] == 1));
+    std::vector<unsigned> dimensions;
+    for(std::size_t i = 1; i < shape.size(); ++i)
+    {
+      ASSERT(shape[i] > 0);
+      dimensions.push_back(static_cast<unsigned>(shape[i]));
+    }
+    return dimensions;
+  }
+
+public:
+  OnnxModel(const std::string& path, const Settings& settings) :
+    session(InferenceRuntime::getInstance().createSession(path))
+  {
+    Ort::AllocatorWithDefaultOptions allocator;
+    const std::string inputName = session.GetInputNameAllocated(0, allocator).get();
+    const std::string outputName = session.GetOutputNameAllocated(0, allocator).get();
+    const Ort::TypeInfo inputTypeInfo = session.GetInputTypeInfo(0);
+    const Ort::TypeInfo outputTypeInfo = session.GetOutputTypeInfo(0);
+    const auto inputInfo = inputTypeInfo.GetTensorTypeAndShapeInfo();
+    const auto outputInfo = outputTypeInfo.GetTensorTypeAndShapeInfo();
+    const std::vector<int64_t> inputShape = inputInfo.GetShape();
+    const std::vector<int64_t> outputShape = outputInfo.GetShape();
+
+    setDimensions(getDimensions(inputShape), getDimensions(outputShape));
+    maxBatchSize = inputShape[0] == -1 ? std::max(settings.maxBatchSize, 1u) : 1;
+
+    const ONNXTensorElementDataType inputType = inputInfo.GetElementType();
+    const ONNXTensorElementDataType outputType = outputInfo.GetElementType();
+    const std::size_t inputBytes = inputSize * getElementSize(inputType);
+    const std::size_t outputBytes = outputSize * getElementSize(outputType);
+    inputBuffer.resize(inputBytes * maxBatchSize);
+    outputBuffer.resize(outputBytes * maxBatchSize);
+    if(settings.uint8Input && inputType != ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8)
+    {
+      if(inputType != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
+        throw std::runtime_error("Bytes can only be given for an input of type uint8 or float");
+      byteInputBuffer.resize(inputSize * maxBatchSize);
+    }
+
+    // Bind views of the buffers for every batch size once, so that running the model does not create any tensors.
+    const Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
+    std::vector<int64_t> batchedInputShape = inputShape;
+    std::vector<int64_t> batchedOutputShape = outputShape;
+    tensors.reserve(2 * maxBatchSize);
+    for(unsigned batchSize = 1; batchSize <= maxBatchSize; ++batchSize)
+    {
+      batchedInputShape[0] = batchedOutputShape[0] = batchSize;
+      tensors.emplace_back(Ort::Value::CreateTensor(memoryInfo, inputBuffer.data(), inputBytes * batchSize,
+                                                    batchedInputShape.data(), batchedInputShape.size(), inputType));
+      tensors.emplace_back(Ort::Value::CreateTensor(memoryInfo, outputBuffer.data(), outputBytes * batchSize,
+                                                    batchedOutputShape.data(), batchedOutputShape.size(), outputType));
+      bindings.emplace_back(session);
+      bindings.back().BindInput(inputName.c_str(), tensors[tensors.size() - 2]);
+      bindings.back().BindOutput(outputName.c_str(), tensors.back());
+    }
+  }
+
+  void infer(unsigned batchSize) override
+  {
+    ASSERT(batchSize >= 1 && batchSize <= maxBatchSize);
+    if(!byteInputBuffer.empty())
+    {
+      float* input = reinterpret_cast<float*>(inputBuffer.data());
+      const unsigned char* bytes = byteInputBuffer.data();
+      for(const unsigned char* end = bytes + inputSize * batchSize; bytes < end;)
+        *input++ = static_cast<float>(*bytes++);
+    }
+    session.Run(Ort::RunOptions{nullptr}, bindings[batchSize - 1]);
+  }
+
+protected:
+  void* getInput() override {return byteInputBuffer.empty() ? static_cast<void*>(inputBuffer.data()) : byteInputBuffer.data();}
+  void* getOutput() override {return outputBuffer.data();}
+};
+
+/**
+ * A model that is compiled with CompiledNN. The network only processes a single
+ * sample. Batches are run sample by sample through separate buffers.
+ */
+class CompiledNNModel : public InferenceModel
+{
+private:
+  NeuralNetwork::CompiledNN network;
+  std::size_t inputBytes; /**< The size of a single input sample in bytes. */
+  std::vector<unsigned char> inputBuffer; /**< The inputs of the largest batch (if batches are supported). */
+  std::vector<float> outputBuffer; /**< The outputs of the largest batch (if batches are supported). */
+
+public:
+  CompiledNNModel(const std::string& path, const Settings& settings) :
+    network(&Global::getAsmjitRuntime())
+  {
+    NeuralNetwork::Model model(path);
+    if(settings.uint8Input)
+      model.setInputUInt8(0);
+    NeuralNetwork::CompilationSettings compilationSettings;
+    compilationSettings.useExpApproxInSigmoid = settings.approximateExp;
+    compilationSettings.useExpApproxInTanh = settings.approximateExp;
+    network.compile(model, compilationSettings);
+    ASSERT(network.valid());
+    ASSERT(network.numOfInputs() == 1);
+    ASSERT(network.numOfOutputs() == 1);
+
+    setDimensions(network.input(0).dims(), network.output(0).dims());
+    maxBatchSize = std::max(settings.maxBatchSize, 1u);
+    inputBytes = inputSize * (settings.uint8Input ? 1 : sizeof(float));
+    if(maxBatchSize > 1)
+    {
+      inputBuffer.resize(inputBytes * maxBatchSize);
+      outputBuffer.resize(outputSize * maxBatchSize);
+    }
+  }
+
+  void infer(unsigned batchSize) override
+  {
+    ASSERT(batchSize >= 1 && batchSize <= maxBatchSize);
+    if(maxBatchSize == 1)
+      network.apply();
+    else
+      for(unsigned i = 0; i < batchSize; ++i)
+      {
+        std::memcpy(network.input(0).data(), inputBuffer.data() + i * inputBytes, inputBytes);
+        network.apply();
+        std::memcpy(outputBuffer.data() + i * outputSize, network.output(0).data(), outputSize * sizeof(float));
+      }
+  }
+
+protected:
+  void* getInput() override {return maxBatchSize == 1 ? static_cast<void*>(network.input(0).data()) : inputBuffer.data();}
+  void* getOutput() override {return maxBatchSize == 1 ? network.output(0).data() : outputBuffer.data();}
+};
+
+std::unique_ptr<InferenceModel> InferenceModel::load(const std::string& path, const Settings& settings)
+{
+  try
+  {
+    if(path.size() >= 3 && path.compare(path.size() - 3, 3, ".h5") == 0)
+      return std::make_unique<CompiledNNModel>(path, settings);
+    else
+      return std::make_unique<OnnxModel>(path, settings);
+  }
+  catch(const std::exception& e)
+  {
+    OUTPUT_ERROR("InferenceModel: Could not load " << path << ": " << e.what());
+    return nullptr;
+  }
+}
+
+void InferenceModel::setDimensions(const std::vector<unsigned>& inputDimensions, const std::vector<unsigned>& outputDimensions)
+{
+  this->inputDimensions = inputDimensions;
+  this->outputDimensions = outputDimensions;
+  inputSize = 1;
+  for(unsigned dimension : inputDimensions)
+    inputSize *= dimension;
+  outputSize = 1;
+  for(unsigned dimension : outputDimensions)
+    outputSize *= dimension;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file InferenceModel.h
+ *
+ * This file declares a common interface for neural networks that are either run by
+ * the ONNX Runtime or compiled with CompiledNN. The backend is chosen by the file
+ * extension of the model, i.e. it is picked per model by the configuration.
+ * A model owns its input and output buffers. They are allocated when the model is
+ * loaded, so running it does not allocate memory. The buffers contain the samples
+ * of a batch contiguously. The input must be filled again before each run, because
+ * CompiledNN might reuse its memory for the output.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class InferenceModel
+{
+public:
+  /** How a model is loaded. */
+  struct Settings
+  {
+    unsigned maxBatchSize = 1; /**< The maximum number of samples per run. Models with a fixed batch size only support 1. */
+    bool uint8Input = false; /**< The input is given as bytes. ONNX models with a float input convert it before each run. */
+    bool approximateExp = true; /**< CompiledNN: Approximate the exponential function in sigmoid and tanh activations. */
+  };
+
+  virtual ~InferenceModel() = default;
+
+  /**
+   * Loads a model. ".h5" files are compiled with CompiledNN, all other files are
+   * loaded by the shared ONNX Runtime environment.
+   * @param path The path of the model file.
+   * @param settings How the model is loaded.
+   * @return The model or nullptr if it could not be loaded.
+   */
+  static std::unique_ptr<InferenceModel> load(const std::string& path, const Settings& settings);
+
+  /**
+   * Loads a model with the default settings.
+   * @param path The path of the model file.
+   * @return The model or nullptr if it could not be loaded.
+   */
+  static std::unique_ptr<InferenceModel> load(const std::string& path) {return load(path, Settings());}
+
+  /**
+   * Runs the model on the samples in the input buffer.
+   * @param batchSize The number of samples in the input buffer.
+   */
+  virtual void infer(unsigned batchSize = 1) = 0;
+
+  /**
+   * Returns the input buffer.
+   * @tparam T The element type of the input of the model.
+   * @return The first element of the first sample.
+   */
+  template<typename T> T* input() {return static_cast<T*>(getInput());}
+
+  /**
+   * Returns the output buffer. It can be modified, e.g. to post-process the output in place.
+   * @tparam T The element type of the output of the model.
+   * @return The first element of the first sample.
+   */
+  template<typename T = float> T* output() {return static_cast<T*>(getOutput());}
+
+  /** The dimensions of a single input sample, i.e. without the batch dimension. */
+  const std::vector<unsigned>& getInputDimensions() const {return inputDimensions;}
+
+  /** The dimensions of a single output sample, i.e. without the batch dimension. */
+  const std::vector<unsigned>& getOutputDimensions() const {return outputDimensions;}
+
+  /** The number of elements of a single input sample. */
+  unsigned getInputSize() const {return inputSize;}
+
+  /** The number of elements of a single output sample. */
+  unsigned getOutputSize() const {return outputSize;}
+
+  /** The maximum number of samples per run. */
+  unsigned getMaxBatchSize() const {return maxBatchSize;}
+
+protected:
+  std::vector<unsigned> inputDimensions; /**< The dimensions of a single input sample. */
+  std::vector<unsigned> outputDimensions; /**< The dimensions of a single output sample. */
+  unsigned inputSize = 0; /**< The number of elements of a single input sample. */
+  unsigned outputSize = 0; /**< The number of elements of a single output sample. */
+  unsigned maxBatchSize = 1; /**< The maximum number of samples per run. */
+
+  /**
+   * Sets the dimensions of the input and output samples and the resulting sizes.
+   * @param inputDimensions The dimensions of a single input sample.
+   * @param outputDimensions The dimensions of a single output sample.
+   */
+  void setDimensions(const std::vector<unsigned>& inputDimensions, const std::vector<unsigned>& outputDimensions);
+
+  /** Returns the untyped input buffer. */
+  virtual void* getInput() = 0;
+
+  /** Returns the untyped output buffer. */
+  virtual void* getOutput() = 0;
+};
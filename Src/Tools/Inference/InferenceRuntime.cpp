@@ -0,0 +1,46 @@
+/**
+ * @file InferenceRuntime.cpp
+ *
+ * This file implements the ONNX Runtime environment that is shared by all neural
+ * networks of the process.
+ */
+
+#include "InferenceRuntime.h"
+#include "Platform/BHAssert.h"
+#include "Tools/Streams/InStreams.h"
+
+InferenceRuntime::InferenceRuntime()
+{
+  InMapFile stream("inference.cfg");
+  if(stream.exists())
+    stream >> *this;
+
+  Ort::ThreadingOptions threadingOptions;
+  threadingOptions.SetGlobalIntraOpNumThreads(intraOpThreads);
+  threadingOptions.SetGlobalInterOpNumThreads(1);
+  threadingOptions.SetGlobalSpinControl(allowSpinning ? 1 : 0);
+#ifdef TARGET_ROBOT
+  // Keep the pool threads off the processors the real-time threads need.
+  if(!intraOpAffinity.empty())
+    Ort::ThrowOnError(Ort::GetApi().SetGlobalIntraOpThreadAffinity(threadingOptions, intraOpAffinity.c_str()));
+#endif
+  env = Ort::Env(threadingOptions, ORT_LOGGING_LEVEL_ERROR, "InferenceRuntime");
+}
+
+InferenceRuntime& InferenceRuntime::getInstance()
+{
+  static InferenceRuntime runtime;
+  return runtime;
+}
+
+Ort::Session InferenceRuntime::createSession(const std::string& path) const
+{
+  Ort::SessionOptions options;
+  options.DisablePerSessionThreads();
+  options.SetGraphOptimizationLevel(optimizeGraph ? GraphOptimizationLevel::ORT_ENABLE_ALL : GraphOptimizationLevel::ORT_DISABLE_ALL);
+  if(useMemoryArena)
+    options.EnableCpuMemArena();
+  else
+    options.DisableCpuMemArena();
+  return Ort::Session(env, path.c_str(), options);
+}
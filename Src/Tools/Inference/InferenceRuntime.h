@@ -0,0 +1,43 @@
+/**
+ * @file InferenceRuntime.h
+ *
+ * This file declares the ONNX Runtime environment that is shared by all neural
+ * networks of the process. All sessions use the same intra-op thread pool instead
+ * of each spawning its own threads, and they are created with the same tuned options.
+ */
+
+#pragma once
+
+#include "Tools/Streams/AutoStreamable.h"
+#include <onnxruntime_cxx_api.h>
+#include <string>
+
+STREAMABLE(InferenceRuntime,
+{
+private:
+  Ort::Env env{nullptr}; /**< The environment owning the global thread pools. */
+
+  /** The constructor reads the configuration file and creates the environment. */
+  InferenceRuntime();
+
+public:
+  /**
+   * Returns the only instance. It is created when it is used for the first time.
+   * @return The runtime.
+   */
+  static InferenceRuntime& getInstance();
+
+  /**
+   * Creates a session that runs in the shared thread pool.
+   * @param path The path of the .onnx file.
+   * @return The session.
+   */
+  Ort::Session createSession(const std::string& path) const;
+
+private:,
+  (int)(2) intraOpThreads, /**< The number of threads of the shared pool, including the thread calling the session. */
+  (std::string)("") intraOpAffinity, /**< The processors (1-based) of the additional pool threads on the robot, separated by ';'. Empty: not pinned. */
+  (bool)(false) allowSpinning, /**< Do pool threads busy-wait for work? This burns processor time other threads could use. */
+  (bool)(true) useMemoryArena, /**< Reuse the memory of intermediate tensors between runs. */
+  (bool)(true) optimizeGraph, /**< Apply all graph optimizations when a session is created. */
+});
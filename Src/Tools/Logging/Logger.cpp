@@ -20,10 +20,14 @@
 #include "Tools/Debugging/Stopwatch.h"
 #include "Tools/Global.h"
 #include "Tools/Logging/LoggingTools.h"
+#include "Tools/Logging/SnappyEncoder.h"
+#include "Tools/Logging/TraceWriter.h"
 #include "Tools/Module/Blackboard.h"
 #include "Tools/Settings.h"
 #include "Tools/Streams/TypeInfo.h"
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
 #undef PRINT
 #ifndef TARGET_ROBOT
@@ -62,6 +66,9 @@ Logger::Logger(const Configuration& config)
         {
           for(const std::string& loggerRepresentation : rpt.representations)
           {
+            if(loggerRepresentation == "ExecutionStatistics") // Filled by the module graph runner of every thread.
+              goto representationFound;
+
             for(const std::string& defaultRepresentation : config.defaultRepresentations)
               if(loggerRepresentation == defaultRepresentation)
               {
@@ -188,6 +195,8 @@ void Logger::execute(const std::string& threadName)
 
           Global::getAnnotationManager().getOut().copyAllMessages(*buffer);
         }
+        if(writeTrace)
+          Global::getTimingManager().requestEvents();
         Global::getTimingManager().getData().copyAllMessages(*buffer);
         buffer->out.bin << threadName;
         buffer->out.finishMessage(idFrameFinished);
@@ -215,7 +224,10 @@ void Logger::writer()
   BH_TRACE_INIT("Logger");
 
   OutBinaryFile* file = nullptr;
+  TraceWriter* trace = nullptr;
   std::string completeFilename;
+  OutBinaryMemory chunk(framesPerChunk ? sizeOfBuffer : 0); // Grows to the size of a chunk and is reused for all chunks
+  unsigned framesInChunk = 0;
 
   while(true)
   {
@@ -250,11 +262,37 @@ void Logger::writer()
       buffer->writeMessageIDs(*file);
       *file << LoggingTools::logFileTypeInfo;
       file->write(typeInfo.data(), typeInfo.size());
-      *file << LoggingTools::logFileUncompressed;
-      buffer->writeAppendableHeader(*file);
+      if(framesPerChunk)
+        *file << LoggingTools::logFileChunked;
+      else
+      {
+        *file << LoggingTools::logFileUncompressed;
+        buffer->writeAppendableHeader(*file);
+      }
+
+      if(writeTrace)
+        trace = new TraceWriter(completeFilename.substr(0, completeFilename.size() - 4) + ".json");
     }
 
-    buffer->append(*file);
+    if(trace)
+      buffer->handleAllMessages(*trace);
+    if(framesPerChunk)
+    {
+      if(!framesInChunk)
+      {
+        chunk.clear();
+        buffer->writeAppendableHeader(chunk);
+      }
+      buffer->append(chunk);
+      addToIndex(*buffer);
+      if(++framesInChunk == framesPerChunk)
+      {
+        writeChunk(*file, chunk, framesInChunk);
+        framesInChunk = 0;
+      }
+    }
+    else
+      buffer->append(*file);
     buffer->clear();
 
     {
@@ -264,5 +302,64 @@ void Logger::writer()
     }
   }
 
+  if(file && file->exists() && framesPerChunk)
+  {
+    if(framesInChunk)
+      writeChunk(*file, chunk, framesInChunk);
+    *file << 0u; // End marker
+    LoggingTools::writeChunkIndex(*file, chunkIndex);
+  }
+
+  delete trace;
   delete file;
 }
+
+void Logger::writeChunk(OutBinaryFile& file, const OutBinaryMemory& chunk, unsigned frames)
+{
+  compressedChunk.resize(SnappyEncoder::maxCompressedLength(chunk.size()));
+  const size_t compressedSize = SnappyEncoder::compress(chunk.data(), chunk.size(), compressedChunk.data());
+  if(compressedSize < chunk.size())
+  {
+    file << static_cast<unsigned>(compressedSize) << static_cast<unsigned>(chunk.size()) << frames;
+    file.write(compressedChunk.data(), compressedSize);
+  }
+  else
+  {
+    file << static_cast<unsigned>(chunk.size()) << static_cast<unsigned>(chunk.size()) << frames;
+    file.write(chunk.data(), chunk.size());
+  }
+  chunkIndex.chunks.push_back({static_cast<unsigned>(std::min(compressedSize, chunk.size())), static_cast<unsigned>(chunk.size()), frames});
+}
+
+void Logger::addToIndex(MessageQueue& frame)
+{
+  class FrameIndexer : public MessageHandler
+  {
+  public:
+    LoggingTools::ChunkIndex& index;
+
+    FrameIndexer(LoggingTools::ChunkIndex& index) : index(index) {}
+
+    bool handleMessage(InMessage& message) override
+    {
+      if(message.getMessageID() == idFrameBegin)
+      {
+        const std::string thread = message.readThreadIdentifier();
+        const auto i = std::find(index.threads.begin(), index.threads.end(), thread);
+        index.frames.push_back({static_cast<unsigned char>(i - index.threads.begin()), -1});
+        if(i == index.threads.end())
+          index.threads.push_back(thread);
+      }
+      else if(message.getMessageID() == idGameInfo)
+      {
+        GameInfo gameInfo;
+        message.bin >> gameInfo;
+        if(gameInfo.secsRemaining >= 0 && gameInfo.secsRemaining <= std::numeric_limits<short>::max())
+          index.frames.back().gcTime = static_cast<short>(gameInfo.secsRemaining);
+      }
+      return true;
+    }
+  } frameIndexer(chunkIndex);
+
+  frame.handleAllMessages(frameIndexer);
+}
@@ -15,9 +15,11 @@
 #include "Platform/Semaphore.h"
 #include "Platform/Thread.h"
 #include "Tools/Framework/Configuration.h"
+#include "Tools/Logging/LoggingTools.h"
 #include "Tools/MessageQueue/MessageQueue.h"
 #include "Tools/Streams/AutoStreamable.h"
 #include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
 #include <deque>
 #include <stack>
 
@@ -56,10 +58,29 @@ private:
   std::string filename; /**< The base name of the log file. */
   Thread writerThread; /**< The thread that is writing the logged data to a file. */
   Semaphore framesToWrite; /**< How many frames the writer thread should write? */
+  std::vector<char> compressedChunk; /**< The buffer the writer thread compresses chunks into. */
+  LoggingTools::ChunkIndex chunkIndex; /**< The index of the chunks and frames written, which is appended to the log file. */
 
   /** The method runs in a separate thread and writes the logged data to a file. */
   void writer();
 
+  /**
+   * Adds a frame to the index, i.e. the thread that logged it and the GameController time it contains.
+   * @param frame The frame.
+   */
+  void addToIndex(MessageQueue& frame);
+
+  /**
+   * Writes a chunk of frames to the log file. The chunk is compressed if that makes it smaller.
+   * Each chunk is preceded by its size in the file, its uncompressed size, and the number of
+   * frames it contains. A chunk is compressed if the two sizes differ. The header is also added
+   * to the index.
+   * @param file The log file.
+   * @param chunk The uncompressed chunk, starting with an appendable message queue header.
+   * @param frames The number of frames in the chunk.
+   */
+  void writeChunk(OutBinaryFile& file, const OutBinaryMemory& chunk, unsigned frames);
+
 public:
   /**
    * The constructor reads the configuration file and checks it against the module configuration.
@@ -83,5 +104,7 @@ private:,
   (unsigned) sizeOfBuffer, /**< The size of each buffer in bytes. */
   (int) writePriority, /**< The scheduling priority of the writer thread. */
   (unsigned) minFreeDriveSpace, /**< Logging will stop if less MB are available to the target device. */
+  (bool) writeTrace, /**< Also write the stopwatch events to a trace file (Chrome Trace Event format) next to the log file. */
+  (unsigned) framesPerChunk, /**< The number of frames compressed together. 0 writes an uncompressed log file. */
   (std::vector<RepresentationsPerThread>) representationsPerThread, /**< Representations to log per thread. */
 });
@@ -8,6 +8,8 @@
 
 #include "LoggingTools.h"
 #include "Platform/BHAssert.h"
+#include "Tools/Streams/InOut.h"
+#include <cstring>
 #include <regex>
 
 std::string LoggingTools::createName(const std::string& prefix, const std::string& headName, const std::string& bodyName,
@@ -75,3 +77,95 @@ void LoggingTools::parseName(const std::string& logfileName, std::string* prefix
       *suffix = match[3].matched ? match[3].str().substr(1) : "";
   }
 }
+
+void LoggingTools::writeChunkIndex(Out& stream, const ChunkIndex& index)
+{
+  unsigned size = 2 * sizeof(unsigned) + sizeof(unsigned char)
+                  + static_cast<unsigned>(index.chunks.size() * chunkHeaderSize + index.frames.size() * (sizeof(unsigned char) + sizeof(short)));
+
+  stream << static_cast<unsigned>(index.chunks.size());
+  for(const ChunkIndex::Chunk& chunk : index.chunks)
+    stream << chunk.size << chunk.uncompressedSize << chunk.frames;
+  stream << static_cast<unsigned char>(index.threads.size());
+  for(const std::string& thread : index.threads)
+  {
+    stream << static_cast<unsigned>(thread.size());
+    stream.write(thread.data(), thread.size());
+    size += static_cast<unsigned>(sizeof(unsigned) + thread.size());
+  }
+  stream << static_cast<unsigned>(index.frames.size());
+  for(const ChunkIndex::Frame& frame : index.frames)
+    stream << frame.thread << frame.gcTime;
+  stream << size;
+}
+
+bool LoggingTools::readChunkIndex(const char* data, size_t size, size_t firstChunk, ChunkIndex& index)
+{
+  if(size < firstChunk + 2 * sizeof(unsigned))
+    return false;
+  unsigned indexSize;
+  std::memcpy(&indexSize, data + size - sizeof(unsigned), sizeof(unsigned));
+  if(indexSize > size - firstChunk - 2 * sizeof(unsigned))
+    return false;
+  const char* p = data + size - sizeof(unsigned) - indexSize;
+  const char* const end = p + indexSize;
+  const size_t endMarker = static_cast<size_t>(p - data) - sizeof(unsigned);
+
+  // All reads are checked against the size of the index, because it might be garbage.
+  auto read = [&p, end](auto& value)
+  {
+    if(static_cast<size_t>(end - p) < sizeof(value))
+      return false;
+    std::memcpy(&value, p, sizeof(value));
+    p += sizeof(value);
+    return true;
+  };
+
+  unsigned count;
+  if(!read(count) || count > static_cast<size_t>(end - p) / chunkHeaderSize)
+    return false;
+  index.chunks.resize(count);
+  size_t offset = firstChunk;
+  size_t frames = 0;
+  for(ChunkIndex::Chunk& chunk : index.chunks)
+  {
+    read(chunk.size);
+    read(chunk.uncompressedSize);
+    read(chunk.frames);
+    if(!chunk.size || chunk.size > chunk.uncompressedSize || !chunk.frames)
+      return false;
+    offset += chunkHeaderSize + chunk.size;
+    frames += chunk.frames;
+  }
+
+  // The chunks must end exactly at the end marker.
+  unsigned marker;
+  std::memcpy(&marker, data + endMarker, sizeof(unsigned));
+  if(offset != endMarker || marker)
+    return false;
+
+  unsigned char threads;
+  if(!read(threads))
+    return false;
+  index.threads.resize(threads);
+  for(std::string& thread : index.threads)
+  {
+    unsigned length;
+    if(!read(length) || length > static_cast<size_t>(end - p))
+      return false;
+    thread.assign(p, length);
+    p += length;
+  }
+
+  if(!read(count) || count != frames || count > static_cast<size_t>(end - p) / (sizeof(unsigned char) + sizeof(short)))
+    return false;
+  index.frames.resize(count);
+  for(ChunkIndex::Frame& frame : index.frames)
+  {
+    read(frame.thread);
+    read(frame.gcTime);
+    if(frame.thread >= threads)
+      return false;
+  }
+  return p == end;
+}
@@ -11,6 +11,9 @@
 
 #include "Tools/Streams/Enum.h"
 #include <string>
+#include <vector>
+
+class Out;
 
 namespace LoggingTools
 {
@@ -20,8 +23,58 @@ namespace LoggingTools
     logFileCompressed,
     logFileMessageIDs,
     logFileTypeInfo,
+    logFileChunked,
   });
 
+  /** The size of the header that precedes each chunk of a log file in the format logFileChunked. */
+  constexpr size_t chunkHeaderSize = 3 * sizeof(unsigned);
+
+  /**
+   * The index of a log file in the format logFileChunked. It follows the end marker
+   * behind the last chunk and allows to seek in the file without decompressing it.
+   */
+  struct ChunkIndex
+  {
+    /** The header of a chunk. */
+    struct Chunk
+    {
+      unsigned size; /**< The size of the chunk in the file (without its header). */
+      unsigned uncompressedSize; /**< The size of the chunk after decompressing it. */
+      unsigned frames; /**< The number of frames in the chunk. */
+    };
+
+    /** A frame of the log file. */
+    struct Frame
+    {
+      unsigned char thread; /**< The index of the thread that logged the frame in threads. */
+      short gcTime; /**< The remaining time in seconds the GameController reported in this frame or -1. */
+    };
+
+    std::vector<Chunk> chunks; /**< All chunks of the log file in their order. */
+    std::vector<std::string> threads; /**< The names of the threads that logged frames. */
+    std::vector<Frame> frames; /**< All frames of the log file in their order. */
+  };
+
+  /**
+   * Writes the index of a log file in the format logFileChunked. It is followed by its
+   * size, so that it can be found from the end of the file.
+   * @param stream The log file after its end marker.
+   * @param index The index.
+   */
+  void writeChunkIndex(Out& stream, const ChunkIndex& index);
+
+  /**
+   * Reads the index from the end of a log file in the format logFileChunked. The index is
+   * only accepted if it is consistent with the size of the file, i.e. it is rejected if the
+   * file was not closed properly.
+   * @param data The log file.
+   * @param size The size of the log file in bytes.
+   * @param firstChunk The offset of the header of the first chunk in the log file.
+   * @param index The index that is read.
+   * @return Was a valid index found?
+   */
+  bool readChunkIndex(const char* data, size_t size, size_t firstChunk, ChunkIndex& index);
+
   /**
    * Creates a log file name from lots of components.
    * @param prefix A prefix at the beginning of the log file name (e.g. the name of the logged process).
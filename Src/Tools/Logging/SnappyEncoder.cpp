@@ -0,0 +1,139 @@
+/**
+ * @file SnappyEncoder.cpp
+ *
+ * This file implements a compressor that produces data in the snappy block
+ * format. It is a greedy LZ77 compressor with a hash table of the last
+ * occurrences of 4-byte sequences, which works on independent blocks of 64 KB.
+ */
+
+#include "SnappyEncoder.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace SnappyEncoder
+{
+  static constexpr size_t blockSize = 1 << 16; /**< Matches are only searched within blocks of this size. */
+  static constexpr int hashBits = 14; /**< The number of bits of the hash of a 4-byte sequence. */
+
+  static uint32_t load(const char* p)
+  {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+
+  static uint32_t hash(uint32_t value)
+  {
+    return (value * 0x1e35a7bd) >> (32 - hashBits);
+  }
+
+  static char* emitLiteral(char* output, const char* literal, size_t length)
+  {
+    const size_t n = length - 1;
+    if(n < 60)
+      *output++ = static_cast<char>(n << 2);
+    else
+    {
+      char* tag = output++;
+      int bytes = 0;
+      for(size_t rest = n; rest; rest >>= 8, ++bytes)
+        *output++ = static_cast<char>(rest & 0xff);
+      *tag = static_cast<char>((59 + bytes) << 2);
+    }
+    std::memcpy(output, literal, length);
+    return output + length;
+  }
+
+  static char* emitCopy(char* output, size_t offset, size_t length)
+  {
+    // Copies with a 2-byte offset are limited to 64 bytes. Split longer ones so that at least 4 bytes remain.
+    while(length >= 68)
+    {
+      *output++ = static_cast<char>(2 | (63 << 2));
+      *output++ = static_cast<char>(offset & 0xff);
+      *output++ = static_cast<char>(offset >> 8);
+      length -= 64;
+    }
+    if(length > 64)
+    {
+      *output++ = static_cast<char>(2 | (59 << 2));
+      *output++ = static_cast<char>(offset & 0xff);
+      *output++ = static_cast<char>(offset >> 8);
+      length -= 60;
+    }
+
+    if(length < 12 && offset < 2048)
+    {
+      *output++ = static_cast<char>(1 | ((length - 4) << 2) | ((offset >> 8) << 5));
+      *output++ = static_cast<char>(offset & 0xff);
+    }
+    else
+    {
+      *output++ = static_cast<char>(2 | ((length - 1) << 2));
+      *output++ = static_cast<char>(offset & 0xff);
+      *output++ = static_cast<char>(offset >> 8);
+    }
+    return output;
+  }
+
+  static char* compressBlock(const char* block, size_t size, char* output, uint16_t* table)
+  {
+    size_t literalStart = 0;
+    if(size >= 15)
+    {
+      std::fill(table, table + (1 << hashBits), 0);
+      const size_t last = size - 4; // The last position at which 4 bytes can be read.
+      size_t i = 1;
+      table[hash(load(block))] = 0;
+      while(i <= last)
+      {
+        const uint32_t value = load(block + i);
+        uint16_t& entry = table[hash(value)];
+        const size_t candidate = entry;
+        entry = static_cast<uint16_t>(i);
+        if(load(block + candidate) != value)
+        {
+          // Skip faster through data that does not compress.
+          i += 1 + ((i - literalStart) >> 5);
+          continue;
+        }
+
+        if(literalStart < i)
+          output = emitLiteral(output, block + literalStart, i - literalStart);
+
+        size_t length = 4;
+        while(i + length < size && block[candidate + length] == block[i + length])
+          ++length;
+        output = emitCopy(output, i - candidate, length);
+        i += length;
+        literalStart = i;
+      }
+    }
+
+    if(literalStart < size)
+      output = emitLiteral(output, block + literalStart, size - literalStart);
+    return output;
+  }
+
+  size_t compress(const char* input, size_t size, char* output)
+  {
+    char* const start = output;
+
+    // The preamble is the uncompressed size as varint.
+    for(size_t rest = size; ; rest >>= 7)
+    {
+      if(rest < 0x80)
+      {
+        *output++ = static_cast<char>(rest);
+        break;
+      }
+      *output++ = static_cast<char>((rest & 0x7f) | 0x80);
+    }
+
+    uint16_t table[1 << hashBits];
+    for(size_t offset = 0; offset < size; offset += blockSize)
+      output = compressBlock(input + offset, std::min(blockSize, size - offset), output, table);
+    return output - start;
+  }
+}
@@ -0,0 +1,32 @@
+/**
+ * @file SnappyEncoder.h
+ *
+ * This file declares a namespace with a compressor that produces data in the
+ * snappy block format. The snappy library is only available on the desktop,
+ * but the log files are written on the robot. The output can be uncompressed
+ * with snappy_uncompress.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace SnappyEncoder
+{
+  /**
+   * Returns the maximum number of bytes the compression of some data can result in.
+   * @param size The number of bytes to compress.
+   * @return The size the output buffer must at least have.
+   */
+  inline size_t maxCompressedLength(size_t size) {return 32 + size + size / 6;}
+
+  /**
+   * Compresses a block of data.
+   * @param input The data to compress.
+   * @param size The number of bytes to compress. Must be less than 2^32.
+   * @param output The buffer that receives the compressed data. It must have at least
+   *               the size returned by maxCompressedLength.
+   * @return The number of bytes written to the output buffer.
+   */
+  size_t compress(const char* input, size_t size, char* output);
+}
@@ -0,0 +1,114 @@
+/**
+ * @file TraceWriter.cpp
+ *
+ * This file implements a class that converts the stopwatch events recorded by the
+ * timing managers of all threads into a file in the Chrome Trace Event format.
+ */
+
+#include "TraceWriter.h"
+#include <cstdio>
+
+TraceWriter::TraceWriter(const std::string& fileName) :
+  file(fileName)
+{
+  if(file.exists())
+    file << "{\"traceEvents\":[";
+}
+
+TraceWriter::~TraceWriter()
+{
+  if(file.exists())
+    file << "\n]}" << endl;
+}
+
+bool TraceWriter::handleMessage(InMessage& message)
+{
+  if(message.getMessageID() == idFrameBegin)
+  {
+    thread = message.readThreadIdentifier();
+    return true;
+  }
+  else if(message.getMessageID() == idStopwatch)
+  {
+    // The stopwatch data contains a few names per frame. They fill in names the events missed.
+    unsigned short numOfNames;
+    message.bin >> numOfNames;
+    for(unsigned short i = 0; i < numOfNames; ++i)
+    {
+      unsigned short id;
+      message.bin >> id;
+      message.bin >> names[id];
+    }
+    return true;
+  }
+  else if(message.getMessageID() == idTraceEvents)
+  {
+    unsigned short numOfNames;
+    message.bin >> numOfNames;
+    for(unsigned short i = 0; i < numOfNames; ++i)
+    {
+      unsigned short id;
+      message.bin >> id;
+      message.bin >> names[id];
+    }
+
+    unsigned high, low, numOfEvents;
+    message.bin >> high >> low >> numOfEvents;
+    const unsigned long long frameStart = static_cast<unsigned long long>(high) << 32 | low;
+    for(unsigned i = 0; i < numOfEvents; ++i)
+    {
+      unsigned short id;
+      unsigned char flags;
+      unsigned offset;
+      message.bin >> id >> flags >> offset;
+
+      // If the events of a frame did not fit into the buffer, the begins of the first ends are missing.
+      const int tid = getTid(flags & 0x7f);
+      unsigned& depth = depths[tid];
+      if(flags & 0x80)
+        ++depth;
+      else if(depth)
+        --depth;
+      else
+        continue;
+
+      const unsigned long long timestamp = frameStart + offset;
+      if(!started)
+      {
+        start = timestamp;
+        started = true;
+      }
+
+      // The trace expects timestamps in µs. Frames of other threads might have started a little earlier.
+      const unsigned long long delta = timestamp >= start ? timestamp - start : start - timestamp;
+      char ts[32];
+      std::snprintf(ts, sizeof(ts), "%s%llu.%03u", timestamp >= start ? "" : "-", delta / 1000, static_cast<unsigned>(delta % 1000));
+      const auto name = names.find(id);
+      write(std::string("{\"name\":\"") + (name == names.end() ? std::to_string(id) : name->second)
+            + "\",\"ph\":\"" + (flags & 0x80 ? "B" : "E") + "\",\"ts\":" + ts
+            + ",\"pid\":0,\"tid\":" + std::to_string(tid) + "}");
+    }
+    return true;
+  }
+  else
+    return false;
+}
+
+int TraceWriter::getTid(unsigned char lane)
+{
+  const std::string name = lane ? thread + std::to_string(lane) : thread;
+  const auto i = tids.find(name);
+  if(i != tids.end())
+    return i->second;
+  const int tid = static_cast<int>(tids.size()) + 1;
+  tids[name] = tid;
+  write("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + std::to_string(tid)
+        + ",\"args\":{\"name\":\"" + name + "\"}}");
+  return tid;
+}
+
+void TraceWriter::write(const std::string& text)
+{
+  file << (first ? "\n" : ",\n") << text;
+  first = false;
+}
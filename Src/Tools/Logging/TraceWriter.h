@@ -0,0 +1,67 @@
+/**
+ * @file TraceWriter.h
+ *
+ * This file declares a class that converts the stopwatch events recorded by the
+ * timing managers of all threads into a file in the Chrome Trace Event format.
+ * Such files can be inspected with chrome://tracing or https://ui.perfetto.dev.
+ * The writer is fed with the messages of a log, i.e. it can be used both while
+ * logging and when extracting data from a log file.
+ */
+
+#pragma once
+
+#include "Tools/MessageQueue/InMessage.h"
+#include "Tools/Streams/OutStreams.h"
+#include <string>
+#include <unordered_map>
+
+class TraceWriter : public MessageHandler
+{
+private:
+  OutTextRawFile file; /**< The file the trace is written to. */
+  std::string thread; /**< The thread the current frame stems from. */
+  std::unordered_map<unsigned short, std::string> names; /**< The names of all stopwatches seen so far. */
+  std::unordered_map<std::string, int> tids; /**< The trace thread ids of all threads and their lanes seen so far. */
+  std::unordered_map<int, unsigned> depths; /**< The number of stopwatches running per trace thread id. */
+  unsigned long long start = 0; /**< The timestamp of the first event in ns. All timestamps are written relative to it. */
+  bool started = false; /**< Was the start timestamp determined? */
+  bool first = true; /**< Was nothing written to the trace yet? */
+
+public:
+  /**
+   * Constructor. Opens the file and starts the trace.
+   * @param fileName The name of the file.
+   */
+  TraceWriter(const std::string& fileName);
+
+  /** Destructor. Finishes the trace. */
+  ~TraceWriter();
+
+  /**
+   * Was the file created?
+   * @return Can the trace be written?
+   */
+  bool exists() const {return file.exists();}
+
+  /**
+   * Handles a message of a log. Only frame begin, stopwatch, and trace event messages are used.
+   * @param message The message.
+   * @return Was the message used?
+   */
+  bool handleMessage(InMessage& message) override;
+
+private:
+  /**
+   * Returns the trace thread id of a thread and lane. If it was not used before,
+   * its name is written to the trace.
+   * @param lane The lane of the current thread.
+   * @return The trace thread id.
+   */
+  int getTid(unsigned char lane);
+
+  /**
+   * Writes a single event.
+   * @param text The event as a JSON object.
+   */
+  void write(const std::string& text);
+};
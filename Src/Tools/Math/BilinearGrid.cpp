@@ -0,0 +1,55 @@
+/**
+ * @file BilinearGrid.cpp
+ *
+ * This file implements a regular grid over a rectangle that samples a scalar
+ * function together with a direction at its nodes.
+ */
+
+#include "BilinearGrid.h"
+#include <algorithm>
+#include <cmath>
+
+void BilinearGrid::init(const Vector2f& min, const Vector2f& max, float cellSize)
+{
+  this->min = min;
+  this->cellSize = cellSize;
+  width = std::max(2, static_cast<int>(std::ceil((max.x() - min.x()) / cellSize)) + 1);
+  height = std::max(2, static_cast<int>(std::ceil((max.y() - min.y()) / cellSize)) + 1);
+  this->max = min + Vector2f(static_cast<float>(width - 1), static_cast<float>(height - 1)) * cellSize;
+  values.assign(width * height, 0.f);
+  directionsX.assign(width * height, 0.f);
+  directionsY.assign(width * height, 0.f);
+}
+
+void BilinearGrid::getCell(const Vector2f& point, std::size_t& index, float weights[4]) const
+{
+  const float fx = (point.x() - min.x()) / cellSize;
+  const float fy = (point.y() - min.y()) / cellSize;
+  const int x = std::min(static_cast<int>(fx), width - 2);
+  const int y = std::min(static_cast<int>(fy), height - 2);
+  const float dx = fx - static_cast<float>(x);
+  const float dy = fy - static_cast<float>(y);
+  index = y * width + x;
+  weights[0] = (1.f - dx) * (1.f - dy);
+  weights[1] = dx * (1.f - dy);
+  weights[2] = (1.f - dx) * dy;
+  weights[3] = dx * dy;
+}
+
+float BilinearGrid::value(const Vector2f& point) const
+{
+  std::size_t i;
+  float w[4];
+  getCell(point, i, w);
+  return w[0] * values[i] + w[1] * values[i + 1] + w[2] * values[i + width] + w[3] * values[i + width + 1];
+}
+
+float BilinearGrid::value(const Vector2f& point, Vector2f& direction) const
+{
+  std::size_t i;
+  float w[4];
+  getCell(point, i, w);
+  direction.x() = w[0] * directionsX[i] + w[1] * directionsX[i + 1] + w[2] * directionsX[i + width] + w[3] * directionsX[i + width + 1];
+  direction.y() = w[0] * directionsY[i] + w[1] * directionsY[i + 1] + w[2] * directionsY[i + width] + w[3] * directionsY[i + width + 1];
+  return w[0] * values[i] + w[1] * values[i + 1] + w[2] * values[i + width] + w[3] * values[i + width + 1];
+}
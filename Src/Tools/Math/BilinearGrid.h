@@ -0,0 +1,90 @@
+/**
+ * @file BilinearGrid.h
+ *
+ * This file declares a regular grid over a rectangle that samples a scalar
+ * function together with a direction at its nodes. In between, both are
+ * interpolated bilinearly, which replaces the evaluation of functions that
+ * are expensive to compute, but are queried very often.
+ */
+
+#pragma once
+
+#include "Tools/Math/Eigen.h"
+#include <vector>
+
+class BilinearGrid
+{
+public:
+  /**
+   * Sets the area covered by the grid. The previous samples are discarded.
+   * @param min The corner of the rectangle with the smallest coordinates.
+   * @param max The corner of the rectangle with the largest coordinates.
+   *            It is moved outwards to the next node if necessary.
+   * @param cellSize The distance between neighboring nodes.
+   */
+  void init(const Vector2f& min, const Vector2f& max, float cellSize);
+
+  /**
+   * Samples a function at all nodes.
+   * @param function The function. It is called as function(point, value, direction)
+   *                 and must set the value and the direction at the point.
+   */
+  template<typename F> void fill(F&& function)
+  {
+    std::size_t i = 0;
+    for(int y = 0; y < height; ++y)
+      for(int x = 0; x < width; ++x, ++i)
+      {
+        Vector2f direction = Vector2f::Zero();
+        function(Vector2f(min.x() + static_cast<float>(x) * cellSize, min.y() + static_cast<float>(y) * cellSize), values[i], direction);
+        directionsX[i] = direction.x();
+        directionsY[i] = direction.y();
+      }
+  }
+
+  /** Was the grid initialized? */
+  bool isValid() const {return !values.empty();}
+
+  /**
+   * Checks whether a point can be interpolated.
+   * @param point The point.
+   * @return Is it inside the area covered by the grid?
+   */
+  bool isInside(const Vector2f& point) const
+  {
+    return point.x() >= min.x() && point.y() >= min.y() && point.x() <= max.x() && point.y() <= max.y();
+  }
+
+  /**
+   * Interpolates the value at a point.
+   * @param point The point. It must be inside the grid.
+   * @return The value.
+   */
+  float value(const Vector2f& point) const;
+
+  /**
+   * Interpolates the value and the direction at a point.
+   * @param point The point. It must be inside the grid.
+   * @param direction The direction is returned here.
+   * @return The value.
+   */
+  float value(const Vector2f& point, Vector2f& direction) const;
+
+private:
+  Vector2f min = Vector2f::Zero(); /**< The position of the first node. */
+  Vector2f max = Vector2f::Zero(); /**< The position of the last node. */
+  float cellSize = 1.f; /**< The distance between neighboring nodes. */
+  int width = 0; /**< The number of nodes per row. */
+  int height = 0; /**< The number of rows. */
+  std::vector<float> values; /**< The values at the nodes, row by row. */
+  std::vector<float> directionsX; /**< The x components of the directions at the nodes. */
+  std::vector<float> directionsY; /**< The y components of the directions at the nodes. */
+
+  /**
+   * Determines the cell that contains a point and the weights of its corners.
+   * @param point The point.
+   * @param index The index of the node at the smaller corner of the cell is returned here.
+   * @param weights The weights of the nodes index, index + 1, index + width, and index + width + 1.
+   */
+  void getCell(const Vector2f& point, std::size_t& index, float weights[4]) const;
+};
@@ -0,0 +1,291 @@
+/**
+ * @file Delaunay.cpp
+ *
+ * This file implements an incremental Delaunay triangulation of points inside
+ * a rectangle.
+ */
+
+#include "Delaunay.h"
+#include <cmath>
+
+/** Points closer than this (in the units of the coordinates) are considered to be at the same place. */
+static constexpr double epsilon = 0.01;
+
+/**
+ * Returns the signed distance of a point to the line through two others.
+ * @param a The start of the line.
+ * @param b The end of the line.
+ * @param p The point.
+ * @return The distance, which is positive if p is on the left side of a->b.
+ */
+static double side(const Vector2f& a, const Vector2f& b, const Vector2f& p)
+{
+  const double dx = b.x() - a.x();
+  const double dy = b.y() - a.y();
+  const double length = std::sqrt(dx * dx + dy * dy);
+  return length == 0.0 ? 0.0 : (dx * (p.y() - a.y()) - dy * (p.x() - a.x())) / length;
+}
+
+/**
+ * Checks whether a point is inside the circumcircle of a triangle.
+ * Almost cocircular points are not regarded as being inside, so that flipping
+ * an edge can never be undone by flipping it back.
+ * @param a, b, c The corners of the triangle in counterclockwise order.
+ * @param d The point.
+ * @return Is d clearly inside the circumcircle?
+ */
+static bool inCircle(const Vector2f& a, const Vector2f& b, const Vector2f& c, const Vector2f& d)
+{
+  const double adx = a.x() - d.x(), ady = a.y() - d.y();
+  const double bdx = b.x() - d.x(), bdy = b.y() - d.y();
+  const double cdx = c.x() - d.x(), cdy = c.y() - d.y();
+  const double ad = adx * adx + ady * ady;
+  const double bd = bdx * bdx + bdy * bdy;
+  const double cd = cdx * cdx + cdy * cdy;
+  const double det = ad * (bdx * cdy - cdx * bdy) + bd * (cdx * ady - adx * cdy) + cd * (adx * bdy - bdx * ady);
+  const double permanent = ad * (std::abs(bdx * cdy) + std::abs(cdx * bdy))
+                           + bd * (std::abs(cdx * ady) + std::abs(adx * cdy))
+                           + cd * (std::abs(adx * bdy) + std::abs(bdx * ady));
+  return det > 1e-12 * permanent;
+}
+
+void Delaunay::reset(const Vector2f& min, const Vector2f& max)
+{
+  this->min = min;
+  this->max = max;
+  vertices = {min, Vector2f(max.x(), min.y()), max, Vector2f(min.x(), max.y())};
+  outgoing.assign(4, none);
+  halfEdges.resize(6);
+  setTriangle(0, 0, 1, 2, none, none, 3);
+  setTriangle(1, 0, 2, 3, 2, none, none);
+  lastTriangle = 0;
+}
+
+unsigned Delaunay::insert(const Vector2f& position)
+{
+  if(position.x() < min.x() || position.y() < min.y() || position.x() > max.x() || position.y() > max.y())
+    return none;
+
+  // Points very close to the border are put on it, because the border cannot be bent.
+  Vector2f point = position;
+  for(int i = 0; i < 2; ++i)
+    if(point[i] - min[i] < epsilon)
+      point[i] = min[i];
+    else if(max[i] - point[i] < epsilon)
+      point[i] = max[i];
+
+  const unsigned triangle = locate(point);
+  if(triangle == none)
+    return none;
+  lastTriangle = triangle;
+
+  unsigned closestEdge = none;
+  double closestDistance = epsilon;
+  for(unsigned i = 0; i < 3; ++i)
+  {
+    const unsigned edge = triangle * 3 + i;
+    const Vector2f& a = vertices[halfEdges[edge].origin];
+    if((a - point).norm() < epsilon)
+      return halfEdges[edge].origin;
+    const double distance = std::abs(side(a, vertices[halfEdges[next(edge)].origin], point));
+    if(distance < closestDistance)
+    {
+      closestEdge = edge;
+      closestDistance = distance;
+    }
+  }
+
+  const unsigned vertex = numOfVertices();
+  vertices.push_back(point);
+  outgoing.push_back(none);
+  if(closestEdge != none)
+    splitEdge(closestEdge, vertex);
+  else
+    splitTriangle(triangle, vertex);
+  legalize();
+  return vertex;
+}
+
+bool Delaunay::move(unsigned vertex, const Vector2f& point)
+{
+  if(vertex < 4 || vertex >= numOfVertices()
+     || point.x() <= min.x() || point.y() <= min.y() || point.x() >= max.x() || point.y() >= max.y())
+    return false;
+
+  // Walk around the vertex and collect the edges that might become illegal.
+  // Vertices on the border are never moved.
+  const unsigned start = outgoing[vertex];
+  unsigned edge = start;
+  do
+  {
+    // At its new position, the vertex must still be left of the opposite edge of each triangle.
+    const unsigned opposite = next(edge);
+    const unsigned twin = halfEdges[prev(edge)].twin;
+    if(twin == none || toLegalize.size() > halfEdges.size()
+       || side(vertices[halfEdges[opposite].origin], vertices[halfEdges[prev(edge)].origin], point) <= epsilon)
+    {
+      toLegalize.clear();
+      return false;
+    }
+    toLegalize.push_back(edge);
+    toLegalize.push_back(opposite);
+    edge = twin;
+  }
+  while(edge != start);
+
+  vertices[vertex] = point;
+  legalize();
+  return true;
+}
+
+unsigned Delaunay::locate(const Vector2f& point) const
+{
+  unsigned triangle = lastTriangle < numOfTriangles() ? lastTriangle : 0;
+
+  // In a Delaunay triangulation, the walk never runs in circles. The limit only guards against rounding errors.
+  for(unsigned steps = numOfTriangles(); steps; --steps)
+  {
+    unsigned i = 0;
+    while(i < 3)
+    {
+      const unsigned edge = triangle * 3 + i;
+      if(side(vertices[halfEdges[edge].origin], vertices[halfEdges[next(edge)].origin], point) < -epsilon)
+      {
+        if(halfEdges[edge].twin == none)
+          return none;
+        triangle = halfEdges[edge].twin / 3;
+        break;
+      }
+      ++i;
+    }
+    if(i == 3)
+      return triangle;
+  }
+
+  for(triangle = 0; triangle < numOfTriangles(); ++triangle)
+  {
+    unsigned i = 0;
+    while(i < 3 && side(vertices[halfEdges[triangle * 3 + i].origin],
+                        vertices[halfEdges[next(triangle * 3 + i)].origin], point) >= -epsilon)
+      ++i;
+    if(i == 3)
+      return triangle;
+  }
+  return none;
+}
+
+void Delaunay::setTriangle(unsigned triangle, unsigned a, unsigned b, unsigned c, unsigned ab, unsigned bc, unsigned ca)
+{
+  const unsigned edge = triangle * 3;
+  halfEdges[edge] = {a, ab};
+  halfEdges[edge + 1] = {b, bc};
+  halfEdges[edge + 2] = {c, ca};
+  if(ab != none)
+    halfEdges[ab].twin = edge;
+  if(bc != none)
+    halfEdges[bc].twin = edge + 1;
+  if(ca != none)
+    halfEdges[ca].twin = edge + 2;
+  outgoing[a] = edge;
+  outgoing[b] = edge + 1;
+  outgoing[c] = edge + 2;
+}
+
+void Delaunay::splitTriangle(unsigned triangle, unsigned vertex)
+{
+  const unsigned edge = triangle * 3;
+  const unsigned a = halfEdges[edge].origin;
+  const unsigned b = halfEdges[edge + 1].origin;
+  const unsigned c = halfEdges[edge + 2].origin;
+  const unsigned ab = halfEdges[edge].twin;
+  const unsigned bc = halfEdges[edge + 1].twin;
+  const unsigned ca = halfEdges[edge + 2].twin;
+
+  const unsigned t1 = numOfTriangles();
+  const unsigned t2 = t1 + 1;
+  halfEdges.resize(halfEdges.size() + 6);
+  setTriangle(triangle, a, b, vertex, ab, t1 * 3 + 2, t2 * 3 + 1);
+  setTriangle(t1, b, c, vertex, bc, t2 * 3 + 2, edge + 1);
+  setTriangle(t2, c, a, vertex, ca, edge + 2, t1 * 3 + 1);
+
+  toLegalize.push_back(edge);
+  toLegalize.push_back(t1 * 3);
+  toLegalize.push_back(t2 * 3);
+}
+
+void Delaunay::splitEdge(unsigned edge, unsigned vertex)
+{
+  const unsigned t = edge / 3;
+  const unsigned a = halfEdges[edge].origin;
+  const unsigned b = halfEdges[next(edge)].origin;
+  const unsigned c = halfEdges[prev(edge)].origin;
+  const unsigned bc = halfEdges[next(edge)].twin;
+  const unsigned ca = halfEdges[prev(edge)].twin;
+  const unsigned twin = halfEdges[edge].twin;
+  const unsigned t1 = numOfTriangles();
+
+  if(twin == none)
+  {
+    // The edge is on the border: (a, b, c) -> (a, v, c), (v, b, c).
+    halfEdges.resize(halfEdges.size() + 3);
+    setTriangle(t, a, vertex, c, none, t1 * 3 + 2, ca);
+    setTriangle(t1, vertex, b, c, none, bc, t * 3 + 1);
+    toLegalize.push_back(t * 3 + 2);
+    toLegalize.push_back(t1 * 3 + 1);
+  }
+  else
+  {
+    // Additionally (b, a, d) -> (b, v, d), (v, a, d).
+    const unsigned u = twin / 3;
+    const unsigned u1 = t1 + 1;
+    const unsigned d = halfEdges[prev(twin)].origin;
+    const unsigned ad = halfEdges[next(twin)].twin;
+    const unsigned db = halfEdges[prev(twin)].twin;
+    halfEdges.resize(halfEdges.size() + 6);
+    setTriangle(t, a, vertex, c, u1 * 3, t1 * 3 + 2, ca);
+    setTriangle(t1, vertex, b, c, u * 3, bc, t * 3 + 1);
+    setTriangle(u, b, vertex, d, t1 * 3, u1 * 3 + 2, db);
+    setTriangle(u1, vertex, a, d, t * 3, ad, u * 3 + 1);
+    toLegalize.push_back(t * 3 + 2);
+    toLegalize.push_back(t1 * 3 + 1);
+    toLegalize.push_back(u * 3 + 2);
+    toLegalize.push_back(u1 * 3 + 1);
+  }
+}
+
+void Delaunay::legalize()
+{
+  // Every flip makes the triangulation "more Delaunay", so this limit is only reached because of rounding errors.
+  for(std::size_t flips = 0; !toLegalize.empty() && flips < halfEdges.size(); )
+  {
+    const unsigned edge = toLegalize.back();
+    toLegalize.pop_back();
+    const unsigned twin = halfEdges[edge].twin;
+    if(twin == none)
+      continue;
+
+    const unsigned a = halfEdges[edge].origin;
+    const unsigned b = halfEdges[next(edge)].origin;
+    const unsigned c = halfEdges[prev(edge)].origin;
+    const unsigned d = halfEdges[prev(twin)].origin;
+    if(!inCircle(vertices[a], vertices[b], vertices[c], vertices[d]))
+      continue;
+
+    // Replace the edge a-b by c-d: (a, b, c), (b, a, d) -> (a, d, c), (d, b, c).
+    const unsigned t = edge / 3;
+    const unsigned u = twin / 3;
+    const unsigned bc = halfEdges[next(edge)].twin;
+    const unsigned ca = halfEdges[prev(edge)].twin;
+    const unsigned ad = halfEdges[next(twin)].twin;
+    const unsigned db = halfEdges[prev(twin)].twin;
+    setTriangle(t, a, d, c, ad, u * 3 + 2, ca);
+    setTriangle(u, d, b, c, db, bc, t * 3 + 1);
+    ++flips;
+
+    toLegalize.push_back(t * 3);
+    toLegalize.push_back(t * 3 + 2);
+    toLegalize.push_back(u * 3);
+    toLegalize.push_back(u * 3 + 1);
+  }
+  toLegalize.clear();
+}
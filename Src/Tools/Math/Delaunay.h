@@ -0,0 +1,135 @@
+/**
+ * @file Delaunay.h
+ *
+ * This file declares an incremental Delaunay triangulation of points inside
+ * a rectangle. The triangulation is stored as half-edges: the half-edges of
+ * triangle t are 3 * t, 3 * t + 1, and 3 * t + 2 in counterclockwise order,
+ * and each half-edge knows its twin in the adjacent triangle. New points are
+ * located by walking through the triangulation and inserted by splitting the
+ * triangle (or edge) that contains them, followed by edge flips that restore
+ * the Delaunay property. Vertices can also be moved, which only repairs the
+ * triangulation around them instead of rebuilding it.
+ */
+
+#pragma once
+
+#include "Tools/Math/Eigen.h"
+#include <vector>
+
+class Delaunay
+{
+public:
+  static constexpr unsigned none = ~0u; /**< Marks a missing twin or vertex. */
+
+  /**
+   * Starts a new triangulation that consists of the two triangles covering a
+   * rectangle. The corners become the vertices 0 to 3 in counterclockwise
+   * order, starting at the minimum.
+   * @param min The corner of the rectangle with the smallest coordinates.
+   * @param max The corner of the rectangle with the largest coordinates.
+   */
+  void reset(const Vector2f& min, const Vector2f& max);
+
+  /**
+   * Inserts a point into the triangulation.
+   * @param point The point. It must be inside the rectangle (or on its border).
+   * @return The index of the vertex at the point. If there already was a vertex
+   *         at that position, its index is returned. If the point is outside,
+   *         none is returned.
+   */
+  unsigned insert(const Vector2f& point);
+
+  /**
+   * Moves a vertex to a new position and restores the Delaunay property.
+   * This is only possible if the vertex does not leave the polygon formed by
+   * its neighbors and is not on the border.
+   * @param vertex The index of the vertex.
+   * @param point The new position of the vertex.
+   * @return Was the vertex moved? If not, the triangulation was not changed and
+   *         must be rebuilt to reflect the new position.
+   */
+  bool move(unsigned vertex, const Vector2f& point);
+
+  /** Returns the number of vertices including the four corners. */
+  unsigned numOfVertices() const {return static_cast<unsigned>(vertices.size());}
+
+  /** Returns the number of triangles. */
+  unsigned numOfTriangles() const {return static_cast<unsigned>(halfEdges.size() / 3);}
+
+  /**
+   * Returns the position of a vertex.
+   * @param vertex The index of the vertex.
+   * @return Its position.
+   */
+  const Vector2f& getVertex(unsigned vertex) const {return vertices[vertex];}
+
+  /**
+   * Returns a corner of a triangle.
+   * @param triangle The index of the triangle.
+   * @param corner The corner (0 ... 2, counterclockwise).
+   * @return The index of the vertex at that corner.
+   */
+  unsigned getCorner(unsigned triangle, unsigned corner) const {return halfEdges[triangle * 3 + corner].origin;}
+
+  /**
+   * Returns the triangle adjacent to an edge of a triangle.
+   * @param triangle The index of the triangle.
+   * @param edge The edge (0 ... 2), i.e. the edge from corner edge to the next one.
+   * @return The index of the adjacent triangle or none if the edge is on the border.
+   */
+  unsigned getNeighbor(unsigned triangle, unsigned edge) const
+  {
+    const unsigned twin = halfEdges[triangle * 3 + edge].twin;
+    return twin == none ? none : twin / 3;
+  }
+
+private:
+  struct HalfEdge
+  {
+    unsigned origin; /**< The vertex this half-edge starts at. It ends at the origin of the next one. */
+    unsigned twin; /**< The opposite half-edge in the adjacent triangle or none. */
+  };
+
+  std::vector<Vector2f> vertices; /**< The positions of all vertices. */
+  std::vector<HalfEdge> halfEdges; /**< Three half-edges per triangle. */
+  std::vector<unsigned> outgoing; /**< A half-edge starting at each vertex. */
+  std::vector<unsigned> toLegalize; /**< The stack of half-edges that still have to be checked. */
+  Vector2f min = Vector2f::Zero(); /**< The smallest coordinates of the rectangle. */
+  Vector2f max = Vector2f::Zero(); /**< The largest coordinates of the rectangle. */
+  unsigned lastTriangle = 0; /**< The triangle the last point was found in. The next walk starts here. */
+
+  static unsigned next(unsigned edge) {return edge % 3 == 2 ? edge - 2 : edge + 1;}
+  static unsigned prev(unsigned edge) {return edge % 3 == 0 ? edge + 2 : edge - 1;}
+
+  /**
+   * Finds the triangle that contains a point by walking towards it.
+   * @param point The point.
+   * @return The index of the triangle or none if the walk left the triangulation.
+   */
+  unsigned locate(const Vector2f& point) const;
+
+  /**
+   * (Re)defines a triangle and links it to its neighbors.
+   * @param triangle The index of the triangle.
+   * @param a, b, c The vertices in counterclockwise order.
+   * @param ab, bc, ca The twins of the three half-edges.
+   */
+  void setTriangle(unsigned triangle, unsigned a, unsigned b, unsigned c, unsigned ab, unsigned bc, unsigned ca);
+
+  /**
+   * Splits a triangle into three triangles around a new vertex inside.
+   * @param triangle The triangle.
+   * @param vertex The new vertex.
+   */
+  void splitTriangle(unsigned triangle, unsigned vertex);
+
+  /**
+   * Splits the one or two triangles adjacent to an edge at a new vertex on that edge.
+   * @param edge The half-edge.
+   * @param vertex The new vertex.
+   */
+  void splitEdge(unsigned edge, unsigned vertex);
+
+  /** Flips edges until none of the half-edges on the stack violates the Delaunay property. */
+  void legalize();
+};
@@ -0,0 +1,93 @@
+/**
+ * @file SpatialGrid.cpp
+ *
+ * This file implements a uniform grid that indexes a static set of items by
+ * the axis-aligned rectangles in which they are relevant.
+ */
+
+#include "SpatialGrid.h"
+#include "Platform/BHAssert.h"
+#include <cmath>
+
+void SpatialGrid::clear(float cellSize)
+{
+  ASSERT(cellSize > 0.f);
+  this->cellSize = cellSize;
+  invCellSize = 1.f / cellSize;
+  entries.clear();
+  cellStarts.clear();
+  items.clear();
+  width = height = 0;
+  min = max = Vector2f::Zero();
+}
+
+void SpatialGrid::add(int item, const Vector2f& min, const Vector2f& max)
+{
+  ASSERT(min.x() <= max.x() && min.y() <= max.y());
+  entries.push_back({item, min, max});
+}
+
+void SpatialGrid::build()
+{
+  if(entries.empty())
+  {
+    width = height = 0;
+    min = max = Vector2f::Zero();
+    cellStarts.assign(1, 0);
+    items.clear();
+    return;
+  }
+
+  // The grid covers the union of all rectangles.
+  min = entries.front().min;
+  max = entries.front().max;
+  for(const Entry& entry : entries)
+  {
+    min = min.cwiseMin(entry.min);
+    max = max.cwiseMax(entry.max);
+  }
+  width = std::max(1, static_cast<int>(std::ceil((max.x() - min.x()) * invCellSize)));
+  height = std::max(1, static_cast<int>(std::ceil((max.y() - min.y()) * invCellSize)));
+
+  // Determines the range of cells covered by a rectangle.
+  const auto cells = [this](const Entry& entry, int& x1, int& y1, int& x2, int& y2)
+  {
+    x1 = std::min(static_cast<int>((entry.min.x() - min.x()) * invCellSize), width - 1);
+    y1 = std::min(static_cast<int>((entry.min.y() - min.y()) * invCellSize), height - 1);
+    x2 = std::min(static_cast<int>((entry.max.x() - min.x()) * invCellSize), width - 1);
+    y2 = std::min(static_cast<int>((entry.max.y() - min.y()) * invCellSize), height - 1);
+  };
+
+  // Count the items per cell, ...
+  cellStarts.assign(width * height + 1, 0);
+  for(const Entry& entry : entries)
+  {
+    int x1, y1, x2, y2;
+    cells(entry, x1, y1, x2, y2);
+    for(int y = y1; y <= y2; ++y)
+      for(int x = x1; x <= x2; ++x)
+        ++cellStarts[y * width + x + 1];
+  }
+
+  // ... determine where each cell begins, ...
+  for(std::size_t i = 1; i < cellStarts.size(); ++i)
+    cellStarts[i] += cellStarts[i - 1];
+
+  // ... and fill them in the order in which the items were added.
+  items.resize(cellStarts.back());
+  std::vector<int> next(cellStarts.begin(), cellStarts.end() - 1);
+  for(const Entry& entry : entries)
+  {
+    int x1, y1, x2, y2;
+    cells(entry, x1, y1, x2, y2);
+    for(int y = y1; y <= y2; ++y)
+      for(int x = x1; x <= x2; ++x)
+        items[next[y * width + x]++] = entry.item;
+  }
+
+  // Sort each cell, in case the items were not added in ascending order.
+  for(int i = 0; i < width * height; ++i)
+    std::sort(items.begin() + cellStarts[i], items.begin() + cellStarts[i + 1]);
+
+  entries.clear();
+}
@@ -0,0 +1,83 @@
+/**
+ * @file SpatialGrid.h
+ *
+ * This file declares a uniform grid that indexes a static set of items by
+ * the axis-aligned rectangles in which they are relevant, e.g. the area in
+ * which a field line can be associated with a perceived line. A query
+ * returns the items whose rectangles might contain a point, which replaces
+ * a linear scan over all items by a scan over the few items near the point.
+ */
+
+#pragma once
+
+#include "Tools/Math/Eigen.h"
+#include <algorithm>
+#include <vector>
+
+class SpatialGrid
+{
+public:
+  /** The items returned by a query in ascending order. */
+  struct Items
+  {
+    const int* first; /**< The first item. */
+    const int* last; /**< The end of the items. */
+
+    const int* begin() const {return first;}
+    const int* end() const {return last;}
+    bool empty() const {return first == last;}
+  };
+
+  /**
+   * Removes all items.
+   * @param cellSize The edge length of the cells that will be used by build.
+   */
+  void clear(float cellSize);
+
+  /**
+   * Adds an item.
+   * @param item The number of the item, e.g. its index in an external list.
+   * @param min The corner of the rectangle with the smallest coordinates in which the item is relevant.
+   * @param max The corner of the rectangle with the largest coordinates in which the item is relevant.
+   */
+  void add(int item, const Vector2f& min, const Vector2f& max);
+
+  /** Builds the grid from the items added since the last call of clear. */
+  void build();
+
+  /**
+   * Returns the items whose rectangles might contain a point. All items whose
+   * rectangles contain the point are returned, but the rectangles of some others
+   * might just touch the grid cell of the point.
+   * @param point The point.
+   * @return The items in ascending order. It is empty if the point is outside of all rectangles.
+   */
+  Items query(const Vector2f& point) const
+  {
+    if(width == 0 || !(point.x() >= min.x() && point.y() >= min.y() && point.x() <= max.x() && point.y() <= max.y()))
+      return {nullptr, nullptr};
+    const int x = std::min(static_cast<int>((point.x() - min.x()) * invCellSize), width - 1);
+    const int y = std::min(static_cast<int>((point.y() - min.y()) * invCellSize), height - 1);
+    const int cell = y * width + x;
+    return {items.data() + cellStarts[cell], items.data() + cellStarts[cell + 1]};
+  }
+
+private:
+  /** An item and its rectangle before the grid was built. */
+  struct Entry
+  {
+    int item;
+    Vector2f min;
+    Vector2f max;
+  };
+
+  float cellSize = 1.f; /**< The edge length of the cells. */
+  float invCellSize = 1.f; /**< 1 / cellSize. */
+  Vector2f min = Vector2f::Zero(); /**< The corner of the grid with the smallest coordinates. */
+  Vector2f max = Vector2f::Zero(); /**< The corner of the grid with the largest coordinates. */
+  int width = 0; /**< The number of cells in x direction. */
+  int height = 0; /**< The number of cells in y direction. */
+  std::vector<Entry> entries; /**< The items added since the last call of clear. */
+  std::vector<int> cellStarts; /**< The index of the first item of each cell in items, plus the end of the last cell. */
+  std::vector<int> items; /**< The items of all cells, one cell after another. */
+};
@@ -0,0 +1,20 @@
+/**
+ * @file MemoizedFunction.cpp
+ *
+ * This file implements the part of memoized functions that does not depend on their type.
+ */
+
+#include "MemoizedFunction.h"
+#include "Tools/Debugging/Debugging.h"
+
+void MemoizedFunctionBase::printStatistics(const char* provided, std::initializer_list<const MemoizedFunctionBase*> functions)
+{
+#if defined TARGET_TOOL || (defined TARGET_ROBOT && defined NDEBUG) // OUTPUT_TEXT is compiled out
+  static_cast<void>(provided);
+  static_cast<void>(functions);
+#else
+  for(const MemoizedFunctionBase* function : functions)
+    OUTPUT_TEXT(provided << "." << function->getName() << ": " << function->statistics.hits << " hits, "
+                << function->statistics.misses << " misses, " << static_cast<float>(function->statistics.time) * 0.001f << " ms");
+#endif
+}
@@ -0,0 +1,124 @@
+/**
+ * @file MemoizedFunction.h
+ *
+ * This file declares a cache for the results of functions that are provided
+ * through FUNCTION members. A provider keeps an instance per function and
+ * binds the actual implementation to it in each of its updates. All calls with
+ * the same arguments are then only computed once until the timestamp passed
+ * to bind changes, i.e. usually until the next frame. Only functions that do
+ * not have side effects and that do not return results through reference
+ * parameters can be memoized.
+ */
+
+#pragma once
+
+#include "Platform/Time.h"
+#include "Tools/Function.h"
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/** The part of memoized functions that does not depend on their type. */
+class MemoizedFunctionBase
+{
+public:
+  /** How often the cache was used. */
+  struct Statistics
+  {
+    unsigned hits = 0; /**< The number of calls answered from the cache. */
+    unsigned misses = 0; /**< The number of calls that were computed. */
+    unsigned long long time = 0; /**< The thread time spent in computing (in µs). */
+  };
+
+  /** Returns the name of the function. */
+  const char* getName() const {return name;}
+
+  /** Returns how often the cache was used since it was constructed. */
+  const Statistics& getStatistics() const {return statistics;}
+
+  /**
+   * Prints the statistics of memoized functions to the console.
+   * @param provided The name of what provides the functions. It prefixes their names.
+   * @param functions The memoized functions.
+   */
+  static void printStatistics(const char* provided, std::initializer_list<const MemoizedFunctionBase*> functions);
+
+protected:
+  const char* name; /**< The name of the function. */
+  Statistics statistics; /**< How often the cache was used. */
+
+  MemoizedFunctionBase(const char* name) : name(name) {}
+};
+
+template<typename S> class MemoizedFunction;
+
+template<typename R, typename... A> class MemoizedFunction<R(A...)> : public MemoizedFunctionBase
+{
+  static_assert(!std::is_void<R>::value, "Functions without a result cannot be memoized.");
+  static_assert(!std::disjunction<std::conjunction<std::is_lvalue_reference<A>, std::negation<std::is_const<std::remove_reference_t<A>>>>...>::value,
+                "Functions with output parameters cannot be memoized.");
+
+public:
+  /**
+   * Constructor.
+   * @param name The name of the function, e.g. for printing the statistics.
+   * @param maxEntries The maximum number of different arguments cached per frame.
+   *                   Calls beyond that are computed every time.
+   */
+  MemoizedFunction(const char* name, std::size_t maxEntries = 16)
+    : MemoizedFunctionBase(name), maxEntries(maxEntries)
+  {
+    entries.reserve(maxEntries);
+  }
+
+  /**
+   * Sets the function to be cached and returns a function that accesses the
+   * cache. The cache is emptied if the timestamp differs from the last one.
+   * The result must not be called after this object was destroyed.
+   * @param timestamp The time that identifies the current frame.
+   * @param function The function that actually computes the result.
+   * @return The function that should be assigned to the FUNCTION member.
+   */
+  template<typename F> FunctionImpl::Function<R(A...)> bind(unsigned timestamp, F&& function)
+  {
+    if(timestamp != this->timestamp)
+    {
+      entries.clear();
+      this->timestamp = timestamp;
+    }
+    this->function = std::forward<F>(function);
+    return [this](A... args) -> R {return (*this)(std::forward<A>(args)...);};
+  }
+
+  /**
+   * Returns the cached result for the arguments or computes it.
+   * @param args The arguments.
+   * @return The result of the function.
+   */
+  R operator()(A... args)
+  {
+    for(const Entry& entry : entries)
+      if(entry.first == std::tie(args...))
+      {
+        ++statistics.hits;
+        return entry.second;
+      }
+
+    ++statistics.misses;
+    const unsigned long long start = Time::getCurrentThreadTime();
+    R result = function(args...);
+    statistics.time += Time::getCurrentThreadTime() - start;
+    if(entries.size() < maxEntries)
+      entries.emplace_back(std::make_tuple(args...), result);
+    return result;
+  }
+
+private:
+  using Entry = std::pair<std::tuple<std::decay_t<A>...>, R>; /**< The arguments and the result of a call. */
+
+  std::size_t maxEntries; /**< The maximum number of entries. */
+  std::function<R(A...)> function; /**< The function that computes the results. */
+  std::vector<Entry> entries; /**< The results computed in the current frame. */
+  unsigned timestamp = 0; /**< The timestamp of the current frame. */
+};
@@ -36,6 +36,7 @@ ENUM(MessageID,
   idCameraInfo,
   idCameraMatrix,
   idCirclePercept,
+  idExecutionStatistics,
   idFallDownState,
   idFieldBoundary,
   idFootOffset,
@@ -71,6 +72,7 @@ ENUM(MessageID,
   idOdometryData,
   idOpponentTeamInfo,
   idOwnTeamInfo,
+  idPathPlannerStatistics,
   idPenaltyMarkPercept,
   idRawGameInfo,
   idRefereeEstimator,
@@ -89,6 +91,7 @@ ENUM(MessageID,
   idTeamPlayersModel,
   idTeamTalk,
   idThumbnail,
+  idTraceEvents,
   idWalkGenerator,
   idWalkStepData,
   idWalkingEngineOutput,
@@ -276,6 +276,7 @@ void MessageQueueBase::removeRepetitions()
 
       // data only from latest frame
       case idStopwatch:
+      case idTraceEvents:
       case idDebugImage:
       case idDebugDrawing:
       case idDebugDrawing3D:
@@ -0,0 +1,170 @@
+/**
+ * @file UKFPose2DBatch.cpp
+ *
+ * This file implements a set of Unscented Kalman Filters for 2D poses that
+ * are stored as a structure of arrays.
+ */
+
+#include "UKFPose2DBatch.h"
+#include "Platform/BHAssert.h"
+#include "Tools/Math/BHMath.h"
+#include <algorithm>
+#include <cmath>
+
+void UKFPose2DBatch::resize(int size)
+{
+  ASSERT(size > 0);
+  for(std::vector<float>* component : {&x, &y, &r, &xx, &xy, &xr, &yy, &yr, &rr,
+                                       &l11, &l21, &l31, &l22, &l32, &l33,
+                                       &sinR, &cosR, &sin1, &cos1, &sin2, &cos2, &sin3, &cos3, &sinO, &cosO})
+    component->resize(size);
+}
+
+void UKFPose2DBatch::init(int i, const Pose2f& pose, const Pose2f& poseDeviation)
+{
+  x[i] = pose.translation.x();
+  y[i] = pose.translation.y();
+  r[i] = pose.rotation;
+  xx[i] = sqr(poseDeviation.translation.x());
+  yy[i] = sqr(poseDeviation.translation.y());
+  rr[i] = sqr(poseDeviation.rotation);
+  xy[i] = xr[i] = yr[i] = 0.f;
+}
+
+void UKFPose2DBatch::get(int i, UKFPose2D& filter) const
+{
+  filter.mean << x[i], y[i], r[i];
+  filter.cov = getCov(i);
+}
+
+void UKFPose2DBatch::set(int i, const UKFPose2D& filter)
+{
+  x[i] = filter.mean.x();
+  y[i] = filter.mean.y();
+  r[i] = filter.mean.z();
+  xx[i] = filter.cov(0, 0);
+  xy[i] = (filter.cov(0, 1) + filter.cov(1, 0)) * 0.5f;
+  xr[i] = (filter.cov(0, 2) + filter.cov(2, 0)) * 0.5f;
+  yy[i] = filter.cov(1, 1);
+  yr[i] = (filter.cov(1, 2) + filter.cov(2, 1)) * 0.5f;
+  rr[i] = filter.cov(2, 2);
+}
+
+void UKFPose2DBatch::copy(int to, const UKFPose2DBatch& other, int from)
+{
+  x[to] = other.x[from];
+  y[to] = other.y[from];
+  r[to] = other.r[from];
+  xx[to] = other.xx[from];
+  xy[to] = other.xy[from];
+  xr[to] = other.xr[from];
+  yy[to] = other.yy[from];
+  yr[to] = other.yr[from];
+  rr[to] = other.rr[from];
+}
+
+void UKFPose2DBatch::motionUpdate(const std::vector<Pose2f>& odometryOffsets, const Pose2f& filterProcessDeviation,
+                                  const Pose2f& odometryDeviation, const Vector2f& odometryRotationDeviation)
+{
+  ASSERT(static_cast<int>(odometryOffsets.size()) == size());
+  const int n = size();
+
+  // Cholesky decompositions as in UKFPose2D::generateSigmaPoints.
+  for(int i = 0; i < n; ++i)
+  {
+    float l11 = std::sqrt(std::max(xx[i], 0.f));
+    if(l11 == 0.f) l11 = 0.0000000001f;
+    const float l21 = xy[i] / l11;
+    const float l31 = xr[i] / l11;
+    float l22 = std::sqrt(std::max(yy[i] - l21 * l21, 0.f));
+    if(l22 == 0.f) l22 = 0.0000000001f;
+    const float l32 = (yr[i] - l31 * l21) / l22;
+    this->l11[i] = l11;
+    this->l21[i] = l21;
+    this->l31[i] = l31;
+    this->l22[i] = l22;
+    this->l32[i] = l32;
+    l33[i] = std::sqrt(std::max(rr[i] - l31 * l31 - l32 * l32, 0.f));
+  }
+
+  // The rotations of the sigma points are r and r +/- l31, l32, and l33. Their sines
+  // and cosines are derived from those of the summands, which needs 4 instead of 7 pairs.
+  // The mean rotation after the update is r plus the odometry rotation, because the
+  // other summands cancel out. Its sine and cosine are derived in the same way.
+  for(int i = 0; i < n; ++i)
+  {
+    sinO[i] = std::sin(odometryOffsets[i].rotation);
+    cosO[i] = std::cos(odometryOffsets[i].rotation);
+    sinR[i] = std::sin(r[i]);
+    cosR[i] = std::cos(r[i]);
+    sin1[i] = std::sin(l31[i]);
+    cos1[i] = std::cos(l31[i]);
+    sin2[i] = std::sin(l32[i]);
+    cos2[i] = std::cos(l32[i]);
+    sin3[i] = std::sin(l33[i]);
+    cos3[i] = std::cos(l33[i]);
+  }
+
+  for(int i = 0; i < n; ++i)
+  {
+    const float odoX = odometryOffsets[i].translation.x();
+    const float odoY = odometryOffsets[i].translation.y();
+    const float odoR = odometryOffsets[i].rotation;
+
+    // Adds the odometry rotated by (sin, cos) to a sigma point and accumulates it.
+    float sumX = 0.f, sumY = 0.f, sumR = 0.f;
+    float pX[7], pY[7], pR[7];
+    auto addPoint = [&](int j, float dX, float dY, float dR, float s, float c)
+    {
+      pX[j] = x[i] + dX + odoX * c - odoY * s;
+      pY[j] = y[i] + dY + odoX * s + odoY * c;
+      pR[j] = r[i] + dR + odoR;
+      sumX += pX[j];
+      sumY += pY[j];
+      sumR += pR[j];
+    };
+    const float s = sinR[i], c = cosR[i];
+    addPoint(0, 0.f, 0.f, 0.f, s, c);
+    addPoint(1, l11[i], l21[i], l31[i], s * cos1[i] + c * sin1[i], c * cos1[i] - s * sin1[i]);
+    addPoint(2, -l11[i], -l21[i], -l31[i], s * cos1[i] - c * sin1[i], c * cos1[i] + s * sin1[i]);
+    addPoint(3, 0.f, l22[i], l32[i], s * cos2[i] + c * sin2[i], c * cos2[i] - s * sin2[i]);
+    addPoint(4, 0.f, -l22[i], -l32[i], s * cos2[i] - c * sin2[i], c * cos2[i] + s * sin2[i]);
+    addPoint(5, 0.f, 0.f, l33[i], s * cos3[i] + c * sin3[i], c * cos3[i] - s * sin3[i]);
+    addPoint(6, 0.f, 0.f, -l33[i], s * cos3[i] - c * sin3[i], c * cos3[i] + s * sin3[i]);
+
+    const float meanX = sumX * (1.f / 7.f);
+    const float meanY = sumY * (1.f / 7.f);
+    const float meanR = sumR * (1.f / 7.f);
+    float covXX = 0.f, covXY = 0.f, covXR = 0.f, covYY = 0.f, covYR = 0.f, covRR = 0.f;
+    for(int j = 0; j < 7; ++j)
+    {
+      const float dX = pX[j] - meanX;
+      const float dY = pY[j] - meanY;
+      const float dR = pR[j] - meanR;
+      covXX += dX * dX;
+      covXY += dX * dY;
+      covXR += dX * dR;
+      covYY += dY * dY;
+      covYR += dY * dR;
+      covRR += dR * dR;
+    }
+
+    const float sO = sinO[i], cO = cosO[i];
+    const float rotatedOdoX = odoX * (c * cO - s * sO) - odoY * (s * cO + c * sO);
+    const float rotatedOdoY = odoX * (s * cO + c * sO) + odoY * (c * cO - s * sO);
+
+    x[i] = meanX;
+    y[i] = meanY;
+    r[i] = meanR;
+    xx[i] = covXX * 0.5f + sqr(filterProcessDeviation.translation.x()) + sqr(rotatedOdoX * odometryDeviation.translation.x());
+    xy[i] = covXY * 0.5f;
+    xr[i] = covXR * 0.5f;
+    yy[i] = covYY * 0.5f + sqr(filterProcessDeviation.translation.y()) + sqr(rotatedOdoY * odometryDeviation.translation.y());
+    yr[i] = covYR * 0.5f;
+    rr[i] = covRR * 0.5f + sqr(filterProcessDeviation.rotation) + sqr(odoR * odometryDeviation.rotation)
+            + sqr(rotatedOdoX * odometryRotationDeviation.x()) + sqr(rotatedOdoY * odometryRotationDeviation.y());
+  }
+
+  for(int i = 0; i < n; ++i)
+    r[i] = Angle::normalize(r[i]);
+}
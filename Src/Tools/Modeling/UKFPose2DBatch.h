@@ -0,0 +1,100 @@
+/**
+ * @file UKFPose2DBatch.h
+ *
+ * This file declares a set of Unscented Kalman Filters for 2D poses that are
+ * stored as a structure of arrays, i.e. each component of the means and the
+ * covariances of all filters is kept in an array of its own. This allows
+ * the compiler to vectorize the motion update over all filters. Single
+ * filters can be copied to and from a UKFPose2D, e.g. for sensor updates.
+ */
+
+#pragma once
+
+#include "Tools/Modeling/UKFPose2D.h"
+#include <vector>
+
+class UKFPose2DBatch
+{
+public:
+  /**
+   * Sets the number of filters. The states of new filters are undefined.
+   * @param size The number of filters.
+   */
+  void resize(int size);
+
+  /** Returns the number of filters. */
+  int size() const {return static_cast<int>(x.size());}
+
+  /**
+   * Sets the state of a filter.
+   * @param i The index of the filter.
+   * @param pose The mean of the state.
+   * @param poseDeviation The standard deviations of the dimensions, which are assumed to be independent.
+   */
+  void init(int i, const Pose2f& pose, const Pose2f& poseDeviation);
+
+  /**
+   * Returns the mean of a filter.
+   * @param i The index of the filter.
+   * @return The mean as pose.
+   */
+  Pose2f getPose(int i) const {return Pose2f(r[i], x[i], y[i]);}
+
+  /**
+   * Returns the covariance of a filter.
+   * @param i The index of the filter.
+   * @return The covariance matrix.
+   */
+  Matrix3f getCov(int i) const
+  {
+    return (Matrix3f() << xx[i], xy[i], xr[i], xy[i], yy[i], yr[i], xr[i], yr[i], rr[i]).finished();
+  }
+
+  /**
+   * Copies the state of a filter to a single filter.
+   * @param i The index of the filter.
+   * @param filter The filter that receives the state.
+   */
+  void get(int i, UKFPose2D& filter) const;
+
+  /**
+   * Copies the state of a single filter to a filter of this set.
+   * @param i The index of the filter.
+   * @param filter The filter the state is taken from.
+   */
+  void set(int i, const UKFPose2D& filter);
+
+  /**
+   * Copies the state of a filter of another set.
+   * @param to The index of the filter in this set that is replaced.
+   * @param other The other set. It must not be this set.
+   * @param from The index of the filter in the other set.
+   */
+  void copy(int to, const UKFPose2DBatch& other, int from);
+
+  /**
+   * Pose update of all filters based on the assumed robot motion. It is equivalent
+   * to calling UKFPose2D::motionUpdate for each filter (up to rounding).
+   * @param odometryOffsets The positional changes regarding translation and rotation for each filter.
+   * @param filterProcessDeviation Process noise for Kalman filter update
+   * @param odometryDeviation The assumed uncertainty in odometry information
+   * @param odometryRotationDeviation Additional odometry uncertainty of rotation that affects translation
+   */
+  void motionUpdate(const std::vector<Pose2f>& odometryOffsets, const Pose2f& filterProcessDeviation,
+                    const Pose2f& odometryDeviation, const Vector2f& odometryRotationDeviation);
+
+protected:
+  std::vector<float> x; /**< The x components of the means. */
+  std::vector<float> y; /**< The y components of the means. */
+  std::vector<float> r; /**< The rotational components of the means. */
+  std::vector<float> xx; /**< The variances of x. */
+  std::vector<float> xy; /**< The covariances of x and y. */
+  std::vector<float> xr; /**< The covariances of x and the rotation. */
+  std::vector<float> yy; /**< The variances of y. */
+  std::vector<float> yr; /**< The covariances of y and the rotation. */
+  std::vector<float> rr; /**< The variances of the rotation. */
+
+private:
+  std::vector<float> l11, l21, l31, l22, l32, l33; /**< The Cholesky decompositions during the motion update. */
+  std::vector<float> sinR, cosR, sin1, cos1, sin2, cos2, sin3, cos3, sinO, cosO; /**< Sines and cosines of rotations during the motion update. */
+};
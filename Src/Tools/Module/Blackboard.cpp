@@ -8,70 +8,173 @@
 #include "Tools/Streams/Streamable.h"
 #include "Platform/BHAssert.h"
 #include "Platform/SystemCall.h"
+#include <deque>
+#include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 /** The instance of the blackboard of the current thread. */
 static thread_local Blackboard* theInstance = nullptr;
 
-/** The actual type of the map for all entries. */
-class Blackboard::Entries : public std::unordered_map<std::string, Blackboard::Entry> {};
+/** The actual type of the array of all entries. */
+class Blackboard::Entries : public std::vector<Blackboard::Entry> {};
+
+/**
+ * The indices of all representations. They are shared by all threads.
+ * Names are only added, so indices and names stay valid.
+ */
+class Registry
+{
+public:
+  std::mutex mutex; /**< Guards the registry, because threads might add names concurrently. */
+  std::unordered_map<std::string, std::size_t> indices; /**< The index for each name. */
+  std::deque<std::string> names; /**< The name for each index. A deque does not move its elements. */
+
+  /**
+   * Returns the only instance. It is created when it is used for the first time,
+   * which might happen during static initialization.
+   * @return The registry.
+   */
+  static Registry& getInstance()
+  {
+    static Registry registry;
+    return registry;
+  }
+};
 
 Blackboard::Blackboard() :
   entries(new Entries)
 {
   theInstance = this;
+  Registry& registry = Registry::getInstance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  entries->resize(registry.names.size());
 }
 
 Blackboard::~Blackboard()
 {
   ASSERT(theInstance == this);
   theInstance = nullptr;
-  ASSERT(entries->size() == 0);
+#ifndef NDEBUG
+  for(const Entry& entry : *entries)
+    ASSERT(entry.counter == 0);
+#endif
 }
 
-Blackboard::Entry& Blackboard::get(const char* representation)
+std::size_t Blackboard::getIndex(const char* representation)
 {
-  return (*entries)[representation];
+  Registry& registry = Registry::getInstance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto i = registry.indices.find(representation);
+  if(i != registry.indices.end())
+    return i->second;
+  registry.names.emplace_back(representation);
+  return registry.indices[representation] = registry.names.size() - 1;
 }
 
-const Blackboard::Entry& Blackboard::get(const char* representation) const
+std::size_t Blackboard::findIndex(const char* representation)
 {
-  return entries->find(representation)->second;
+  Registry& registry = Registry::getInstance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto i = registry.indices.find(representation);
+  return i == registry.indices.end() ? npos : i->second;
+}
+
+const char* Blackboard::getName(std::size_t index)
+{
+  Registry& registry = Registry::getInstance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  ASSERT(index < registry.names.size());
+  return registry.names[index].c_str();
+}
+
+Blackboard::Entry& Blackboard::get(std::size_t index)
+{
+  ASSERT(index != npos);
+
+  // Representations might have been registered after this blackboard was created.
+  if(index >= entries->size())
+    entries->resize(index + 1);
+  return (*entries)[index];
+}
+
+const Blackboard::Entry& Blackboard::get(std::size_t index) const
+{
+  ASSERT(index < entries->size());
+  return (*entries)[index];
 }
 
 bool Blackboard::exists(const char* representation) const
 {
-  return entries->find(representation) != entries->end();
+  return exists(findIndex(representation));
+}
+
+bool Blackboard::exists(std::size_t index) const
+{
+  return index < entries->size() && (*entries)[index].data;
 }
 
 Streamable& Blackboard::operator[](const char* representation)
 {
-  Entry& entry = get(representation);
+  return (*this)[findIndex(representation)];
+}
+
+const Streamable& Blackboard::operator[](const char* representation) const
+{
+  return (*this)[findIndex(representation)];
+}
+
+Streamable& Blackboard::operator[](std::size_t index)
+{
+  Entry& entry = get(index);
   ASSERT(entry.data);
   return *entry.data;
 }
 
-const Streamable& Blackboard::operator[](const char* representation) const
+const Streamable& Blackboard::operator[](std::size_t index) const
 {
-  const Entry& entry = get(representation);
+  const Entry& entry = get(index);
   ASSERT(entry.data);
   return *entry.data;
 }
 
+const Blackboard::Exchange& Blackboard::getExchange(const char* representation) const
+{
+  return getExchange(findIndex(representation));
+}
+
+const Blackboard::Exchange& Blackboard::getExchange(std::size_t index) const
+{
+  const Entry& entry = get(index);
+  ASSERT(entry.data);
+  return entry.exchange;
+}
+
 void Blackboard::free(const char* representation)
 {
-  Entry& entry = get(representation);
+  free(findIndex(representation));
+}
+
+void Blackboard::free(std::size_t index)
+{
+  Entry& entry = get(index);
   ASSERT(entry.counter > 0);
   if(--entry.counter == 0)
   {
-    entries->erase(representation);
+    entry = Entry();
     ++version;
   }
 }
 
 void Blackboard::reset(const char* representation)
 {
-  Entry& entry = get(representation);
+  reset(findIndex(representation));
+}
+
+void Blackboard::reset(std::size_t index)
+{
+  Entry& entry = get(index);
   entry.reset(&*entry.data);
 }
 
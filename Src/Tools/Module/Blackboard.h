@@ -3,13 +3,22 @@
  * representations used in a thread.
  * The file will be included by all modules and therefore avoids including
  * headers by itself.
+ * Each representation has a dense index that is the same in all blackboards.
+ * The indices of all representations required or provided by modules are
+ * assigned during static initialization. The entries of a blackboard are
+ * stored in a flat array under these indices, i.e. accessing representations
+ * by index never looks up their names.
  * @author Thomas Röfer
  */
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 class Streamable;
 class In;
@@ -25,6 +34,19 @@ struct HasReadWrite
 
 class Blackboard
 {
+public:
+  /**
+   * Functions to exchange a representation between threads without streaming it.
+   * They are only set if the representation can be copied and swapped and does not
+   * contain functions, which must stay bound to the modules of their own thread.
+   */
+  struct Exchange
+  {
+    Streamable* (*create)() = nullptr; /**< Creates a new instance of the representation. */
+    void (*copy)(const Streamable& source, Streamable& target) = nullptr; /**< Copies the representation into another instance. */
+    void (*swap)(Streamable& a, Streamable& b) = nullptr; /**< Swaps the contents of two instances. */
+  };
+
 private:
   /** A single entry of the blackboard. */
   struct Entry
@@ -32,10 +54,11 @@ private:
     std::unique_ptr<Streamable> data; /**< The representation. */
     int counter = 0; /**< How many modules requested its existence? */
     std::function<void(Streamable*)> reset;
+    Exchange exchange; /**< Functions to exchange the representation directly between threads. */
   };
 
-  class Entries; /**< Type of the map for all entries. */
-  std::unique_ptr<Entries> entries; /**< All entries of the blackboard. */
+  class Entries; /**< Type of the array of all entries. */
+  std::unique_ptr<Entries> entries; /**< All entries of the blackboard, indexed by the indices of the representations. */
   int version = 0; /**< A version that is increased with each configuration change. */
 
   /**
@@ -47,15 +70,17 @@ private:
   friend class ThreadFrame; /**< A thread is allowed to set the instance. */
 
   /**
-   * Retrieve the blackboard entry for the name of a representation.
-   * @param representation The name of the representation.
+   * Retrieve the blackboard entry for the index of a representation.
+   * @param index The index of the representation.
    * @return The blackboard entry. If it does not exist, it will
    * be created, but not the representation.
    */
-  Entry& get(const char* representation);
-  const Entry& get(const char* representation) const;
+  Entry& get(std::size_t index);
+  const Entry& get(std::size_t index) const;
 
 public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1); /**< The index of representations that do not exist. */
+
   /**
    * The default constructor creates the blackboard and sets it as
    * the instance of this thread.
@@ -74,6 +99,44 @@ public:
    * @return Does it exist in this blackboard?
    */
   bool exists(const char* representation) const;
+  bool exists(std::size_t index) const;
+
+  /**
+   * Returns the index of a representation. A new index is assigned if the
+   * name was not used before. The indices are shared by all blackboards.
+   * This method looks up the name and should not be used per frame.
+   * @param representation The name of the representation.
+   * @return The index of the representation.
+   */
+  static std::size_t getIndex(const char* representation);
+
+  /**
+   * Returns the index of a representation without assigning a new one.
+   * @param representation The name of the representation.
+   * @return The index or npos if the name is unknown.
+   */
+  static std::size_t findIndex(const char* representation);
+
+  /**
+   * Returns the index of a representation of a certain type. The index is
+   * only looked up once per type.
+   * @param T The type of the representation. Its name must be the name
+   *          of the representation.
+   * @param representation The name of the representation.
+   * @return The index of the representation.
+   */
+  template<typename T> static std::size_t getIndex(const char* representation)
+  {
+    static const std::size_t index = getIndex(representation);
+    return index;
+  }
+
+  /**
+   * Returns the name of a representation.
+   * @param index The index of the representation.
+   * @return The name of the representation.
+   */
+  static const char* getName(std::size_t index);
 
   /**
    * Allocate a new blackboard entry for a representation of a
@@ -85,7 +148,20 @@ public:
    */
   template<typename T> T& alloc(const char* representation)
   {
-    Entry& entry = get(representation);
+    return alloc<T>(getIndex<T>(representation));
+  }
+
+  /**
+   * Allocate a new blackboard entry for a representation of a
+   * certain type and index. The representation is only created
+   * if this is its first allocation.
+   * @param T The type of the representation.
+   * @param index The index of the representation.
+   * @return The representation.
+   */
+  template<typename T> T& alloc(std::size_t index)
+  {
+    Entry& entry = get(index);
     if(entry.counter++ == 0)
     {
       entry.data = std::make_unique<T>();
@@ -97,6 +173,24 @@ public:
       };
       else
         entry.reset = [](Streamable*) {};
+      // Copying is implemented by copy construction, because the copy assignment of
+      // containers may not compile although std::is_copy_assignable claims it would.
+      if constexpr(std::is_default_constructible<T>::value && std::is_copy_constructible<T>::value &&
+                   std::is_move_constructible<T>::value && std::is_move_assignable<T>::value)
+        if(!HasReadWrite::test(dynamic_cast<T*>(&*entry.data)))
+        {
+          entry.exchange.create = []() -> Streamable* {return new T;};
+          entry.exchange.copy = [](const Streamable& source, Streamable& target)
+          {
+            T* t = dynamic_cast<T*>(&target);
+            t->~T();
+            new(t) T(dynamic_cast<const T&>(source));
+          };
+          entry.exchange.swap = [](Streamable& a, Streamable& b)
+          {
+            std::swap(dynamic_cast<T&>(a), dynamic_cast<T&>(b));
+          };
+        }
       ++version;
     }
     return dynamic_cast<T&>(*entry.data);
@@ -109,6 +203,7 @@ public:
    * @param representation The name of the representation.
    */
   void free(const char* representation);
+  void free(std::size_t index);
 
   /**
    * Reset the blackboard entry for a representation of a certain
@@ -116,6 +211,7 @@ public:
    * @param representation The name of the representation.
    */
   void reset(const char* representation);
+  void reset(std::size_t index);
 
   /**
    * Access a representation of a certain name. The representation
@@ -125,6 +221,17 @@ public:
    */
   Streamable& operator[](const char* representation);
   const Streamable& operator[](const char* representation) const;
+  Streamable& operator[](std::size_t index);
+  const Streamable& operator[](std::size_t index) const;
+
+  /**
+   * Returns the functions to exchange a representation between threads
+   * without streaming. The representation must already exist.
+   * @param representation The name of the representation.
+   * @return The functions. They are not set if the representation must be streamed.
+   */
+  const Exchange& getExchange(const char* representation) const;
+  const Exchange& getExchange(std::size_t index) const;
 
   /**
    * Return the current version.
@@ -71,9 +71,10 @@ public:
   public:
     const char* representation;
     void (*update)(Streamable&);
+    bool used; /**< The representation is only used, i.e. it does not need to be updated before. */
 
-    Info(const char* representation, void (*update)(Streamable&)) :
-      representation(representation), update(update)
+    Info(const char* representation, void (*update)(Streamable&), bool used = false) :
+      representation(representation), update(update), used(used)
     {}
   };
 
@@ -139,6 +140,10 @@ public:
     next(first), name(name), category(category), getModuleInfo(getModuleInfo)
   {
     first = this;
+
+    // Assign the blackboard indices of all representations required or provided during static initialization.
+    for(const Info& info : getModuleInfo())
+      Blackboard::getIndex(info.representation);
   }
 
   friend class ModuleGraphCreator; /**< The ModuleGraphCreator gathers all private data. */
@@ -478,23 +483,23 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
  * @param x The type name of a representation or the set of all parameters.
  */
 #define _MODULE_FREE(x) _MODULE_JOIN(_MODULE_FREE_, x)
-#define _MODULE_FREE_PROVIDES(type) if(_the##type) Blackboard::getInstance().free(#type);
-#define _MODULE_FREE_PROVIDES_WITHOUT_MODIFY(type) if(_the##type) Blackboard::getInstance().free(#type);
-#define _MODULE_FREE_REQUIRES(type) Blackboard::getInstance().free(#type);
-#define _MODULE_FREE_USES(type) Blackboard::getInstance().free(#type);
+#define _MODULE_FREE_PROVIDES(type) if(_the##type) Blackboard::getInstance().free(Blackboard::getIndex<type>(#type));
+#define _MODULE_FREE_PROVIDES_WITHOUT_MODIFY(type) if(_the##type) Blackboard::getInstance().free(Blackboard::getIndex<type>(#type));
+#define _MODULE_FREE_REQUIRES(type) Blackboard::getInstance().free(Blackboard::getIndex<type>(#type));
+#define _MODULE_FREE_USES(type) Blackboard::getInstance().free(Blackboard::getIndex<type>(#type));
 #define _MODULE_FREE__MODULE_DEFINES_PARAMETERS(...)
 #define _MODULE_FREE__MODULE_LOADS_PARAMETERS(...)
 
 /**
- * The following macros generate the code that provides information about all requirements
- * and providers. They filter out the *_PARAMETERS and USES macros.
+ * The following macros generate the code that provides information about all requirements,
+ * representations used, and providers. They filter out the *_PARAMETERS macros.
  * @param x The type name of a representation or the set of all parameters.
  */
 #define _MODULE_INFO(x) _MODULE_JOIN(_MODULE_INFO_, x)
 #define _MODULE_INFO_PROVIDES(type) infos.emplace_back(#type, &BaseType::update##type);
 #define _MODULE_INFO_PROVIDES_WITHOUT_MODIFY(type) infos.emplace_back(#type, &BaseType::update##type);
 #define _MODULE_INFO_REQUIRES(type) infos.emplace_back(#type, nullptr);
-#define _MODULE_INFO_USES(type)
+#define _MODULE_INFO_USES(type) infos.emplace_back(#type, nullptr, true);
 #define _MODULE_INFO__MODULE_DEFINES_PARAMETERS(...)
 #define _MODULE_INFO__MODULE_LOADS_PARAMETERS(...)
 
@@ -36,7 +36,7 @@ ModuleGraphCreator::ModuleGraphCreator(const Configuration& config)
 std::vector<ModuleBase::Info>::const_iterator ModuleGraphCreator::find(const std::vector<ModuleBase::Info>& info, const std::string& representation, bool required)
 {
   for(auto i = info.cbegin(); i != info.cend(); ++i)
-    if((!i->update == required) && representation == i->representation)
+    if((!i->update == required) && !i->used && representation == i->representation)
       return i;
   return info.cend();
 }
@@ -170,7 +170,7 @@ bool ModuleGraphCreator::calcShared(const Configuration& config, std::size_t ind
   // Check if all requirements are provided by this or another thread
   for(const ModuleBase::Info& requirement : module->getModuleInfo())
   {
-    if(!requirement.update)
+    if(!requirement.update && !requirement.used)
     {
       bool provided = false;
 
@@ -406,7 +406,7 @@ bool ModuleGraphCreator::sortProviders(const std::vector<std::string>& providedB
     for(const auto& info : target.provider.moduleBase->getModuleInfo())
     {
       // Skip if this is not a requirement or if it is already provided.
-      if(info.update || alreadyProvided.find(info.representation) != alreadyProvided.end())
+      if(info.update || info.used || alreadyProvided.find(info.representation) != alreadyProvided.end())
         continue;
 
       // Who provides this representation?
@@ -431,6 +431,7 @@ bool ModuleGraphCreator::sortProviders(const std::vector<std::string>& providedB
       return false;
 
   // Use new list.
+  calcLevels(providers);
   this->providers[index] = providers;
   return true;
 }
@@ -466,10 +467,46 @@ bool ModuleGraphCreator::topologicalSort(const char* threadName, Node* node, std
   return true;
 }
 
+void ModuleGraphCreator::calcLevels(std::list<Provider>& providers)
+{
+  std::unordered_map<std::string, std::size_t> positions;
+  std::vector<Provider*> sequence;
+  for(Provider& provider : providers)
+  {
+    positions[provider.representation] = sequence.size();
+    sequence.push_back(&provider);
+  }
+
+  std::unordered_map<const ModuleBase*, const Provider*> previous;
+  for(std::size_t i = 0; i < sequence.size(); ++i)
+  {
+    Provider& provider = *sequence[i];
+
+    // Providers of the same module share the module's state.
+    auto p = previous.find(provider.moduleBase);
+    if(p != previous.end())
+      provider.level = std::max(provider.level, p->second->level + 1);
+    previous[provider.moduleBase] = &provider;
+
+    for(const ModuleBase::Info& info : provider.moduleBase->getModuleInfo())
+    {
+      if(info.update)
+        continue;
+      auto position = positions.find(info.representation);
+      if(position == positions.end() || position->second == i)
+        continue; // Provided by another thread, by default, or by this provider itself.
+      else if(position->second < i)
+        provider.level = std::max(provider.level, sequence[position->second]->level + 1);
+      else // The value of the previous frame is used, so it must not be updated concurrently.
+        sequence[position->second]->level = std::max(sequence[position->second]->level, provider.level + 1);
+    }
+  }
+}
+
 ModuleGraphCreator::ExecutionValues::ExecutionValues(std::vector<std::vector<const char*>>& received, std::vector<std::vector<const char*>>& sent,
                                                      std::vector<std::string>& representationsToReset, std::vector<ModuleRequired>& modules,
-                                                     std::vector<Configuration::RepresentationProvider>& providers) :
-  representationsToReset(representationsToReset), modules(modules), providers(providers)
+                                                     std::vector<Configuration::RepresentationProvider>& providers, std::vector<unsigned>& levels) :
+  representationsToReset(representationsToReset), modules(modules), providers(providers), levels(levels)
 {
   ASSERT(received.size() == sent.size());
   for(std::size_t i = 0; i < received.size(); i++)
@@ -490,8 +527,12 @@ const ModuleGraphCreator::ExecutionValues ModuleGraphCreator::getExecutionValues
   for(size_t i = 0; i < modules.size(); i++)
     modulesRequired.emplace_back(it++->second->name, required[index][i]);
   std::vector<Configuration::RepresentationProvider> providerList;
+  std::vector<unsigned> levels;
   for(const Provider& provider : providers[index])
+  {
     providerList.emplace_back(provider.representation, provider.moduleBase->name);
+    levels.emplace_back(provider.level);
+  }
 
-  return ExecutionValues(received[index], sent[index], representationsToReset, modulesRequired, providerList);
+  return ExecutionValues(received[index], sent[index], representationsToReset, modulesRequired, providerList, levels);
 }
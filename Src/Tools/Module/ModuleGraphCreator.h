@@ -34,6 +34,7 @@ private:
   public:
     const char* representation; /**< The representation that will be provided. */
     ModuleBase* moduleBase; /**< The module base that will give access to the module that provides the information. */
+    unsigned level = 0; /**< The dependency level. Providers on the same level are independent of each other. */
 
     /**
      * Constructor.
@@ -143,6 +144,16 @@ private:
    */
   bool topologicalSort(const char* threadName, Node* node, std::list<Provider>& providers);
 
+  /**
+   * Assigns dependency levels to sorted providers. A provider is on a higher level than
+   * all providers of representations its module requires or uses, all providers of
+   * representations it uses that are executed later, and all other providers of the same
+   * module that are executed before it. Therefore, executing the providers level by level
+   * keeps all dependencies of the sequential order.
+   * @param providers The providers in the sequence they must be called.
+   */
+  static void calcLevels(std::list<Provider>& providers);
+
 public: // Passing data to the public:
   /** Contains all the parameters a thread needs to run its modules. */
   STREAMABLE(ExecutionValues,
@@ -164,13 +175,14 @@ public: // Passing data to the public:
     ExecutionValues() = default;
     ExecutionValues(std::vector<std::vector<const char*>>& received,  std::vector<std::vector<const char*>>& sent,
                     std::vector<std::string>& representationsToReset, std::vector<ModuleRequired>& modules,
-                    std::vector<Configuration::RepresentationProvider>& providers),
+                    std::vector<Configuration::RepresentationProvider>& providers, std::vector<unsigned>& levels),
 
     (std::vector<StringVector>) received, /**< Which data is received from which thread. */
     (std::vector<StringVector>) sent, /**< Which data is sent to which thread. */
     (std::vector<std::string>) representationsToReset, /**< All representations that must be reset. */
     (std::vector<ModuleRequired>) modules, /**< All available modules and whether they need to be executed. */
     (std::vector<Configuration::RepresentationProvider>) providers, /**< All active modules and the order in which they must be executed. */
+    (std::vector<unsigned>) levels, /**< The dependency level of each provider. Providers on the same level can be executed concurrently. */
   });
 
   /**
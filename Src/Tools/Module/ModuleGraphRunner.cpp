@@ -8,9 +8,106 @@
  */
 
 #include "ModuleGraphRunner.h"
-#ifdef TARGET_ROBOT
+#include "Platform/Thread.h"
 #include "Platform/Time.h"
+#include "Tools/Debugging/TimingManager.h"
+#include <chrono>
+
+/** The duration of a statistics window in ms. */
+static constexpr int statisticsWindow = 5000;
+
+/**
+ * Returns the number of µs passed since a point in time.
+ * @param start The point in time.
+ * @return The duration in µs.
+ */
+static unsigned getMicrosecondsSince(const std::chrono::steady_clock::time_point& start)
+{
+  return static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+/**
+ * Summarizes the durations in a histogram.
+ * @param name The name of the durations.
+ * @param histogram The histogram.
+ * @param durations The summary in ms.
+ */
+static void summarize(const char* name, const DurationHistogram& histogram, ExecutionStatistics::Durations& durations)
+{
+  durations.name = name;
+  durations.p50 = static_cast<float>(histogram.getQuantile(0.5f)) * 0.001f;
+  durations.p95 = static_cast<float>(histogram.getQuantile(0.95f)) * 0.001f;
+  durations.p99 = static_cast<float>(histogram.getQuantile(0.99f)) * 0.001f;
+  durations.max = static_cast<float>(histogram.getMaximum()) * 0.001f;
+}
+
+class ModuleGraphRunner::Worker : public Thread
+{
+private:
+  ModuleGraphRunner& runner; /**< The runner this thread helps. */
+  const std::string name; /**< The name of this thread. */
+  const unsigned char lane; /**< The lane of this thread in the timing manager. */
+
+public:
+  Semaphore go; /**< Signals that the providers of the current level should be executed. */
+  Semaphore done; /**< Signals that no providers of the current level are left for this thread. */
+
+  /**
+   * Constructor.
+   * @param runner The runner this thread helps.
+   * @param name The name of this thread.
+   * @param lane The lane of this thread in the timing manager.
+   */
+  Worker(ModuleGraphRunner& runner, const std::string& name, unsigned char lane) :
+    Thread(runner.priority), runner(runner), name(name), lane(lane)
+  {
+    start(this, &Worker::main);
+  }
+
+  /** Destructor. Stops the thread. */
+  ~Worker()
+  {
+    announceStop();
+    go.post();
+    stop();
+  }
+
+private:
+  /** The main function of this thread. */
+  void main()
+  {
+    Thread::nameCurrentThread(name);
+    runner.setGlobals();
+    TimingManager::setLane(lane);
+    while(go.wait() && isRunning())
+    {
+      runner.executeCurrentLevel();
+      done.post();
+    }
+  }
+};
+
+ModuleGraphRunner::ModuleGraphRunner(size_t numberOfThreads, unsigned workerThreads, int priority, const std::function<void()>& setGlobals,
+                                     float frequency) :
+  toReceive(numberOfThreads), toSend(numberOfThreads),
+#if defined TARGET_ROBOT && defined NDEBUG
+  numOfWorkers(setGlobals ? workerThreads : 0),
+#else
+  numOfWorkers(0), // The debugging infrastructure is not thread-safe.
 #endif
+  priority(priority), setGlobals(setGlobals),
+  frameBudget(frequency > 0.f ? static_cast<unsigned>(1000000.f / frequency) : 0)
+{
+  static_cast<void>(workerThreads);
+  for(ModuleBase* i = ModuleBase::first; i; i = i->next)
+    allModules.emplace(i->name, i);
+}
+
+ModuleGraphRunner::~ModuleGraphRunner()
+{
+  workers.clear();
+  destroy();
+}
 
 void ModuleGraphRunner::destroy()
 {
@@ -22,18 +119,40 @@ void ModuleGraphRunner::destroy()
       m.moduleState->instance = 0;
     }
   providers.clear();
+  levels.clear();
   sent.clear();
   received.clear();
+  if(statistics)
+  {
+    Blackboard::getInstance().free("ExecutionStatistics");
+    statistics = nullptr;
+  }
 }
 
 void ModuleGraphRunner::update(In& stream)
 {
   providers.clear();
+  levels.clear();
 
   ModuleGraphCreator::ExecutionValues values;
   stream >> values;
-  received = values.received;
-  sent = values.sent;
+  ASSERT(values.levels.size() == values.providers.size());
+
+  // Resolve the names of the representations exchanged with other threads once
+  received.resize(values.received.size());
+  for(std::size_t i = 0; i < values.received.size(); ++i)
+  {
+    received[i].clear();
+    for(const std::string& r : values.received[i].vector)
+      received[i].emplace_back(Blackboard::getIndex(r.c_str()));
+  }
+  sent.resize(values.sent.size());
+  for(std::size_t i = 0; i < values.sent.size(); ++i)
+  {
+    sent[i].clear();
+    for(const std::string& s : values.sent[i].vector)
+      sent[i].emplace_back(Blackboard::getIndex(s.c_str()));
+  }
 
   // Adds available modules and updates if they are needed
   for(const auto& module : values.modules)
@@ -49,18 +168,27 @@ void ModuleGraphRunner::update(In& stream)
   }
 
   // Creating the provider list
-  for(const auto& rp : values.providers)
+  for(std::size_t j = 0; j < values.providers.size(); ++j)
   {
+    const Configuration::RepresentationProvider& rp = values.providers[j];
     const auto m = modules.find(rp.provider);
     ASSERT(m != modules.end());
     for(const ModuleBase::Info& i : m->second.module->getModuleInfo())
       if(i.update && rp.representation == i.representation)
       {
-        providers.emplace_back(i.representation, &m->second, i.update);
+        providers.emplace_back(i.representation, &m->second, i.update, values.levels[j]);
         break;
       }
   }
 
+  // Group the providers by their levels
+  for(Provider& p : providers)
+  {
+    if(p.level >= levels.size())
+      levels.resize(p.level + 1);
+    levels[p.level].emplace_back(&p);
+  }
+
   // Reset all blackboard entries that are now provided by a different module or no module anymore
   // Note: Needed to prevent function pointers from becoming invalid.
   for(const std::string& representation : values.representationsToReset)
@@ -84,30 +212,54 @@ void ModuleGraphRunner::update(In& stream)
 
 void ModuleGraphRunner::execute()
 {
-  // Execute all providers in the given sequence
-  for(Provider& p : providers)
-  {
-    ASSERT(p.moduleState->required);
-    if(!p.moduleState->instance)
-      p.moduleState->instance = p.moduleState->module->createNew();
-#ifdef TARGET_ROBOT
-    unsigned timestamp = Time::getCurrentSystemTime();
-#endif
-    if(p.moduleState->instance)
-      p.update(*p.moduleState->instance);
 #ifdef TARGET_ROBOT
-    int duration = Time::getTimeSince(timestamp);
-    if(timestamp > 110000 &&
-       ((duration > 100 &&
-         !Global::getDebugRequestTable().isActive("representation:JPEGImage") &&
-         !Global::getDebugRequestTable().isActive("representation:CameraImage")) ||
-        duration > 500))
-      OUTPUT_ERROR("TIMING: providing " << p.representation << " took " << duration
-                   << " ms at " << timestamp / 1000 - 100 << " s after start");
+  imageRequested = Global::getDebugRequestTable().isActive("representation:JPEGImage") ||
+                   Global::getDebugRequestTable().isActive("representation:CameraImage");
 #endif
+
+  if(!statistics)
+  {
+    statistics = &Blackboard::getInstance().alloc<ExecutionStatistics>("ExecutionStatistics");
+    windowStart = Time::getRealSystemTime();
+  }
+  const auto start = std::chrono::steady_clock::now();
+
+  // Modules are created and representations are allocated in the blackboard when
+  // providers are executed for the first time. Therefore, the first execution after
+  // a configuration change is always sequential.
+  if(numOfWorkers && timestamp)
+  {
+    if(workers.empty())
+    {
+      const std::string name = Thread::getCurrentThreadName();
+      for(unsigned i = 0; i < numOfWorkers; ++i)
+        workers.emplace_back(new Worker(*this, name + std::to_string(i + 1), static_cast<unsigned char>(i + 1)));
+    }
+
+    // Execute the providers level by level
+    for(const std::vector<Provider*>& level : levels)
+      execute(level);
+  }
+  else
+  {
+    // Execute all providers in the given sequence
+    for(Provider& p : providers)
+      execute(p);
   }
   BH_TRACE;
 
+  if(timestamp) // The first frame after a configuration change also constructs modules.
+  {
+    const unsigned duration = getMicrosecondsSince(start);
+    frameDurations.add(duration);
+    if(frameBudget && duration > frameBudget)
+      ++overruns;
+  }
+  if(Time::getRealTimeSince(windowStart) >= statisticsWindow)
+    updateStatistics();
+  DEBUG_RESPONSE("representation:ExecutionStatistics")
+    OUTPUT(idExecutionStatistics, bin, *statistics);
+
   if(!timestamp) // Configuration changed recently?
   {
     // all representations must be constructed now, so we can receive data
@@ -115,32 +267,120 @@ void ModuleGraphRunner::execute()
     for(auto& s : toSend)
       s.clear();
     for(std::size_t i = 0; i < sent.size(); i++)
-      for(const std::string& s : sent[i].vector)
-        toSend[i].emplace_back(&Blackboard::getInstance()[s.c_str()]);
+      for(std::size_t s : sent[i])
+        toSend[i].emplace_back(&Blackboard::getInstance()[s], Blackboard::getInstance().getExchange(s));
 
     for(auto& r : toReceive)
       r.clear();
     for(std::size_t i = 0; i < received.size(); i++)
-      for(const std::string& r : received[i].vector)
-        toReceive[i].emplace_back(&Blackboard::getInstance()[r.c_str()]);
+      for(std::size_t r : received[i])
+        toReceive[i].emplace_back(&Blackboard::getInstance()[r], Blackboard::getInstance().getExchange(r));
+  }
+}
+
+void ModuleGraphRunner::execute(Provider& provider)
+{
+  ASSERT(provider.moduleState->required);
+  if(!provider.moduleState->instance)
+    provider.moduleState->instance = provider.moduleState->module->createNew();
+  const auto start = std::chrono::steady_clock::now();
+  if(provider.moduleState->instance)
+    provider.update(*provider.moduleState->instance);
+  const unsigned duration = getMicrosecondsSince(start);
+  provider.durations.add(duration);
+#ifdef TARGET_ROBOT
+  const unsigned timestamp = Time::getCurrentSystemTime();
+  if(timestamp > 110000 && ((duration > 100000 && !imageRequested) || duration > 500000))
+    OUTPUT_ERROR("TIMING: providing " << provider.representation << " took " << duration / 1000
+                 << " ms at " << timestamp / 1000 - 100 << " s after start");
+#endif
+}
+
+void ModuleGraphRunner::execute(const std::vector<Provider*>& level)
+{
+  if(level.size() == 1)
+    execute(*level.front());
+  else
+  {
+    currentLevel = &level;
+    next = 0;
+    const std::size_t helpers = std::min(workers.size(), level.size() - 1);
+    for(std::size_t i = 0; i < helpers; ++i)
+      workers[i]->go.post();
+    executeCurrentLevel();
+    for(std::size_t i = 0; i < helpers; ++i)
+      workers[i]->done.wait();
+  }
+}
+
+void ModuleGraphRunner::executeCurrentLevel()
+{
+  // Each thread takes the next provider that was not taken yet.
+  for(std::size_t i = next++; i < currentLevel->size(); i = next++)
+    execute(*(*currentLevel)[i]);
+}
+
+void ModuleGraphRunner::updateStatistics()
+{
+  statistics->timestamp = Time::getCurrentSystemTime();
+  statistics->budget = static_cast<float>(frameBudget) * 0.001f;
+  statistics->frames = frameDurations.getTotal();
+  statistics->overruns = overruns;
+  summarize("Frame", frameDurations, statistics->frame);
+  statistics->providers.resize(providers.size());
+  auto durations = statistics->providers.begin();
+  for(Provider& p : providers)
+  {
+    summarize(p.representation, p.durations, *durations++);
+    p.durations.reset();
   }
+
+  frameDurations.reset();
+  overruns = 0;
+  windowStart = Time::getRealSystemTime();
 }
 
-void ModuleGraphRunner::readPacket(In& stream, const std::size_t index)
+void ModuleGraphRunner::readPacket(In& stream, const std::size_t index, SharedInstances* instances)
 {
   unsigned timestamp;
   stream >> timestamp;
   // Communication is only possible if both sides are based on the same module request.
   if(timestamp == this->timestamp)
-    for(Streamable* s : toReceive[index])
-      stream >> *s;
+  {
+    ASSERT(!instances || instances->size() == toReceive[index].size());
+    for(std::size_t i = 0; i < toReceive[index].size(); ++i)
+    {
+      const Transfer& transfer = toReceive[index][i];
+      if(instances && transfer.exchange.swap)
+        transfer.exchange.swap(*(*instances)[i].representation, *transfer.representation);
+      else
+        stream >> *transfer.representation;
+    }
+  }
   else
     stream.skip(10000000); // skip everything
 }
 
-void ModuleGraphRunner::writePacket(Out& stream, const std::size_t index) const
+void ModuleGraphRunner::writePacket(Out& stream, const std::size_t index, SharedInstances* instances) const
 {
   stream << timestamp;
-  for(const Streamable* s : toSend[index])
-    stream << *s;
+  if(instances)
+    instances->resize(toSend[index].size());
+  for(std::size_t i = 0; i < toSend[index].size(); ++i)
+  {
+    const Transfer& transfer = toSend[index][i];
+    if(instances && transfer.exchange.copy)
+    {
+      // The instance is reused unless the module request changed the representation at this position.
+      SharedInstance& instance = (*instances)[i];
+      if(instance.create != transfer.exchange.create)
+      {
+        instance.representation.reset(transfer.exchange.create());
+        instance.create = transfer.exchange.create;
+      }
+      transfer.exchange.copy(*transfer.representation, *instance.representation);
+    }
+    else
+      stream << *transfer.representation;
+  }
 }
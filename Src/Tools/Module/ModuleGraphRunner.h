@@ -9,9 +9,13 @@
 
 #pragma once
 
+#include "Representations/Infrastructure/ExecutionStatistics.h"
+#include "Tools/Debugging/DurationHistogram.h"
 #include "Tools/Framework/Configuration.h"
 #include "Tools/Module/ModuleGraphCreator.h"
 
+#include <atomic>
+#include <functional>
 #include <vector>
 
 class In;
@@ -24,6 +28,20 @@ class Out;
  */
 class ModuleGraphRunner
 {
+public:
+  /**
+   * A pre-allocated instance of a representation that is exchanged between
+   * threads without streaming it.
+   */
+  class SharedInstance
+  {
+  public:
+    std::unique_ptr<Streamable> representation; /**< The instance. */
+    Streamable* (*create)() = nullptr; /**< The function that created the instance. */
+  };
+
+  using SharedInstances = std::vector<SharedInstance>; /**< One instance per representation sent in a packet. */
+
 private:
   /**
    * The class represents the current state of a module.
@@ -51,48 +69,95 @@ private:
     const char* representation; /**< The representation that will be provided. */
     ModuleState* moduleState; /**< The moduleState that will give access to the module that provides the information. */
     void (*update)(Streamable&); /**< The update handler within the module. */
+    unsigned level; /**< The dependency level. Providers on the same level are independent of each other. */
+    DurationHistogram durations; /**< The durations of the updates in the current statistics window. */
 
     /**
      * Constructor.
      * @param representation The name of the representation provided.
      * @param moduleState The moduleState that will give access to the module that provides the information.
      * @param update The update handler within the module.
+     * @param level The dependency level.
+     */
+    Provider(const char* representation, ModuleState* moduleState, void (*update)(Streamable&), unsigned level) :
+      representation(representation), moduleState(moduleState), update(update), level(level)
+    {}
+  };
+
+  /**
+   * A representation that is sent to or received from another thread.
+   */
+  class Transfer
+  {
+  public:
+    Streamable* representation; /**< The representation in the blackboard of this thread. */
+    Blackboard::Exchange exchange; /**< The functions to exchange it directly. Not set if it must be streamed. */
+
+    /**
+     * Constructor.
+     * @param representation The representation in the blackboard of this thread.
+     * @param exchange The functions to exchange it directly.
      */
-    Provider(const char* representation, ModuleState* moduleState, void (*update)(Streamable&)) :
-      representation(representation), moduleState(moduleState), update(update)
+    Transfer(Streamable* representation, const Blackboard::Exchange& exchange) :
+      representation(representation), exchange(exchange)
     {}
   };
 
+  class Worker; /**< A thread that helps executing the providers of a level. */
+
   std::unordered_map<std::string, ModuleBase*> allModules; /**< A map of all modules for quick access via name. */
   bool validConfiguration = false;
 
   std::unordered_map<std::string, ModuleState> modules; /**< The current state of all available modules. Must not be changed after adding to the providers list. */
-  std::vector<ModuleGraphCreator::ExecutionValues::StringVector> received; /**< The list of all names of representations received from other threads. */
-  std::vector<ModuleGraphCreator::ExecutionValues::StringVector> sent; /**< The list of all names of representations sent to other threads */
+  std::vector<std::vector<std::size_t>> received; /**< The list of all blackboard indices of representations received from other threads. */
+  std::vector<std::vector<std::size_t>> sent; /**< The list of all blackboard indices of representations sent to other threads */
 
   std::list<Provider> providers; /**< The list of providers that will be executed. */
-  std::vector<std::vector<Streamable*>> toReceive; /**< The list of all representations received from other threads. */
-  std::vector<std::vector<Streamable*>> toSend; /**< The list of all representations sent to other threads. */
+  std::vector<std::vector<Provider*>> levels; /**< The providers grouped by their dependency levels. */
+  std::vector<std::vector<Transfer>> toReceive; /**< The list of all representations received from other threads. */
+  std::vector<std::vector<Transfer>> toSend; /**< The list of all representations sent to other threads. */
 
   unsigned timestamp = 0; /**< The timestamp of the last module request. Communication is only possible if both sides use the same timestamp. */
   unsigned nextTimestamp = 0; /**< The next timestamp used to verify communication. */
 
+  const unsigned numOfWorkers; /**< The number of worker threads. 0 if the providers are executed sequentially. */
+  const int priority; /**< The priority of the worker threads. */
+  const std::function<void()> setGlobals; /**< Makes the globals of the thread executing this runner available in a worker thread. */
+  std::vector<std::unique_ptr<Worker>> workers; /**< The worker threads. They are started when they are needed for the first time. */
+  const std::vector<Provider*>* currentLevel = nullptr; /**< The level the providers of which are currently executed. */
+  std::atomic<std::size_t> next; /**< The index of the next provider of the current level that is executed. */
+  bool imageRequested = false; /**< Is an image requested for debugging? Execution takes longer then. */
+
+  const unsigned frameBudget; /**< The duration available per frame in µs. 0 if unknown. */
+  DurationHistogram frameDurations; /**< The durations of the frames in the current statistics window. */
+  unsigned overruns = 0; /**< The number of frames in the current statistics window that exceeded the budget. */
+  unsigned windowStart = 0; /**< The real time when the current statistics window was started. */
+  ExecutionStatistics* statistics = nullptr; /**< The statistics of the last window. They are stored in the blackboard. */
+
 public:
   /**
    * The constructor.
+   * Concurrent execution requires that debugging is compiled out, i.e. it is only
+   * supported in Release builds for the robot. Otherwise, and in particular during
+   * log replay, the providers are always executed in their sequential order.
    * @param numberOfThreads The number of threads.
+   * @param workerThreads The number of additional threads that execute independent
+   *                      providers concurrently. 0 executes all providers sequentially.
+   * @param priority The priority of the worker threads.
+   * @param setGlobals Makes the globals of the thread executing this runner available
+   *                   in a worker thread.
+   * @param frequency The expected frequency of the thread in Hz. Frames that take
+   *                  longer than its period are counted as overruns. 0 if unknown.
    */
-  ModuleGraphRunner(size_t numberOfThreads) : toReceive(numberOfThreads), toSend(numberOfThreads)
-  {
-    for(ModuleBase* i = ModuleBase::first; i; i = i->next)
-      allModules.emplace(i->name, i);
-  }
+  ModuleGraphRunner(size_t numberOfThreads, unsigned workerThreads = 0, int priority = 0,
+                    const std::function<void()>& setGlobals = std::function<void()>(),
+                    float frequency = 0.f);
 
   /**
    * Destructor.
-   * Destructs all modules currently constructed.
+   * Destructs all modules currently constructed and stops the worker threads.
    */
-  ~ModuleGraphRunner() { destroy(); };
+  ~ModuleGraphRunner();
 
   /**
    * Returns whether a valid module configuration is present.
@@ -120,7 +185,9 @@ public:
   void update(In& stream);
 
   /**
-   * The function executes all selected modules.
+   * The function executes all selected modules. The durations of the frame and of
+   * each provider are recorded. Their statistics are summarized in the representation
+   * ExecutionStatistics in regular intervals.
    */
   void execute();
 
@@ -128,16 +195,20 @@ public:
    * The function reads a packet from a stream.
    * @param stream A stream containing representations received from another thread.
    * @param index The index of the thread this packet is from.
+   * @param instances If set, representations that support it are swapped with
+   *                  these instances instead of being read from the stream.
    */
-  void readPacket(In& stream, const std::size_t index);
+  void readPacket(In& stream, const std::size_t index, SharedInstances* instances = nullptr);
 
   /**
    * The function writes a packet to a stream.
    * @param stream A stream that will be filled with representations that are sent
    *               to another thread.
    * @param index The index of the thread this packet is for.
+   * @param instances If set, representations that support it are copied into
+   *                  these instances instead of being written to the stream.
    */
-  void writePacket(Out& stream, const std::size_t index) const;
+  void writePacket(Out& stream, const std::size_t index, SharedInstances* instances = nullptr) const;
 
   /**
    * The function checks whether no data would be received in a packet from a
@@ -158,4 +229,30 @@ public:
   {
     return toSend[index].empty();
   }
+
+private:
+  /**
+   * The function executes a single provider.
+   * @param provider The provider.
+   */
+  void execute(Provider& provider);
+
+  /**
+   * The function executes all providers of a level. If there are several,
+   * the worker threads help executing them.
+   * @param level The providers of the level.
+   */
+  void execute(const std::vector<Provider*>& level);
+
+  /**
+   * The function executes providers of the current level until none are left.
+   * It is called by the thread executing this runner and by the worker threads.
+   */
+  void executeCurrentLevel();
+
+  /**
+   * The function summarizes the durations recorded in the current statistics
+   * window in the representation ExecutionStatistics and starts a new window.
+   */
+  void updateStatistics();
 };
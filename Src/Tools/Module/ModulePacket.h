@@ -7,6 +7,22 @@
 #pragma once
 
 #include "ModuleGraphRunner.h"
+#include "Tools/Framework/Communication.h"
+
+#include <memory>
+
+/**
+ * @struct ModulePacketInstances
+ * The pre-allocated representations that are exchanged between two threads
+ * without streaming them. They are triple-buffered together with the packets
+ * of the receiver, i.e. the sender fills the set at the index reserved for
+ * writing and the receiver swaps with the set at the index it is reading.
+ */
+struct ModulePacketInstances
+{
+  const ReceiverBase* receiver = nullptr; /**< The receiver whose packet indices select the set of instances. */
+  ModuleGraphRunner::SharedInstances instances[3]; /**< A set of instances per packet. */
+};
 
 /**
  * @struct ModulePacket
@@ -16,6 +32,7 @@ struct ModulePacket
 {
   ModuleGraphRunner* moduleGraphRunner = nullptr; /**< A pointer to the module graph runner. It knows the actual data to be streamed. */
   size_t index = -1; /**< The index of the thread of the packet. */
+  std::shared_ptr<ModulePacketInstances> sharedInstances; /**< If set, the instances that are exchanged directly. Shared by sender and receiver. */
 };
 
 /**
@@ -27,7 +44,8 @@ struct ModulePacket
  */
 inline Out& operator<<(Out& stream, const ModulePacket& modulePacket)
 {
-  modulePacket.moduleGraphRunner->writePacket(stream, modulePacket.index);
+  ModulePacketInstances* shared = modulePacket.sharedInstances.get();
+  modulePacket.moduleGraphRunner->writePacket(stream, modulePacket.index, shared ? &shared->instances[shared->receiver->getWritingIndex()] : nullptr);
   return stream;
 }
 
@@ -40,6 +58,7 @@ inline Out& operator<<(Out& stream, const ModulePacket& modulePacket)
  */
 inline In& operator>>(In& stream, ModulePacket& modulePacket)
 {
-  modulePacket.moduleGraphRunner->readPacket(stream, modulePacket.index);
+  ModulePacketInstances* shared = modulePacket.sharedInstances.get();
+  modulePacket.moduleGraphRunner->readPacket(stream, modulePacket.index, shared ? &shared->instances[shared->receiver->getReadingIndex()] : nullptr);
   return stream;
 }
@@ -260,6 +260,21 @@
 /** Generate type registration code from declaration. */
 #define _STREAM_REG(seq) TypeRegistry::addAttribute(_type, typeid(decltype(Streaming::TypeWrapper<_STREAM_DECL_I seq))>::type)).name(), #seq);
 
+/** Generate the type of the attribute from the declaration. */
+#define _STREAM_TYPE(seq) decltype(Streaming::TypeWrapper<_STREAM_DECL_I seq))>::type)
+
+/** Generate the checks whether all attributes have a binary representation of a fixed size. */
+#define _STREAM_FIXED(seq) && Streaming::BinaryCodec<_STREAM_TYPE(seq)>::fixed
+
+/** Generate the sum of the sizes of the binary representations of all attributes. */
+#define _STREAM_SIZE(seq) + Streaming::BinaryCodec<_STREAM_TYPE(seq)>::size
+
+/** Generate the code that encodes an attribute into a buffer. */
+#define _STREAM_ENC(seq) _p = Streaming::BinaryCodec<_STREAM_TYPE(seq)>::encode(_p, _STREAM_VAR(seq));
+
+/** Generate the code that decodes an attribute from a buffer. */
+#define _STREAM_DEC(seq) _p = Streaming::BinaryCodec<_STREAM_TYPE(seq)>::decode(_p, _STREAM_VAR(seq));
+
 /** Generate the initialization code from the declaration if required. */
 #define _STREAM_INIT(seq) _STREAM_JOIN(_STREAM_INIT_I_, _STREAM_SEQ_SIZE(seq))(seq)
 #define _STREAM_INIT_I_1(...)
@@ -273,24 +288,60 @@
   struct name : public base \
   _STREAM_UNWRAP header; \
   _STREAM_STREAMABLE_I(_STREAM_TUPLE_SIZE(__VA_ARGS__), name, base, readBase, writeBase, __VA_ARGS__)
-#define _STREAM_STREAMABLE_I(n, name, base, readBase, writeBase, ...) _STREAM_STREAMABLE_II(n, name, base, readBase, writeBase, (_STREAM_SER, __VA_ARGS__), (_STREAM_DECL, __VA_ARGS__), (_STREAM_REG, __VA_ARGS__))
-#define _STREAM_STREAMABLE_II(n, theName, base, readBase, writeBase, params1, params2, params3) \
+#define _STREAM_STREAMABLE_I(n, name, base, readBase, writeBase, ...) _STREAM_STREAMABLE_II(n, name, base, readBase, writeBase, (_STREAM_SER, __VA_ARGS__), (_STREAM_DECL, __VA_ARGS__), (_STREAM_REG, __VA_ARGS__), (_STREAM_FIXED, __VA_ARGS__), (_STREAM_SIZE, __VA_ARGS__), (_STREAM_ENC, __VA_ARGS__), (_STREAM_DEC, __VA_ARGS__))
+#define _STREAM_STREAMABLE_II(n, theName, base, readBase, writeBase, params1, params2, params3, params4, params5, params6, params7) \
     _STREAM_ATTR_##n params2 \
+  public: \
+    using _BinaryCodecType = theName; \
   protected: \
     friend struct Streaming::OnRead<theName, true>; \
+    friend struct Streaming::BinaryCodec<theName>; \
+    static constexpr bool _binaryFixed() {return Streaming::BinaryCodec<base>::fixed _STREAM_ATTR_##n params4;} \
+    static constexpr size_t _binarySize() {return Streaming::BinaryCodec<base>::size _STREAM_ATTR_##n params5;} \
+    static constexpr bool _binaryBuffered() {return _binaryFixed() && _binarySize() <= Streaming::maxFixedBinarySize;} \
+    char* _binaryEncode(char* _p) const \
+    { \
+      _p = Streaming::BinaryCodec<base>::encode(_p, *this); \
+      _STREAM_ATTR_##n params6 \
+      return _p; \
+    } \
+    const char* _binaryDecode(const char* _p) \
+    { \
+      _p = Streaming::BinaryCodec<base>::decode(_p, *this); \
+      _STREAM_ATTR_##n params7 \
+      return _p; \
+    } \
     void read(In& stream) override \
     { \
       static_cast<void>(stream); \
       PUBLISH(_reg); \
-      readBase; \
-      _STREAM_ATTR_##n params1 \
+      if(_binaryBuffered() && stream.isBinary()) \
+      { \
+        char _buffer[_binaryBuffered() && _binarySize() ? _binarySize() : 1]; \
+        stream.read(_buffer, _binarySize()); \
+        _binaryDecode(_buffer); \
+      } \
+      else \
+      { \
+        readBase; \
+        _STREAM_ATTR_##n params1 \
+      } \
       Streaming::onRead(*this); \
     } \
     void write(Out& stream) const override \
     { \
       static_cast<void>(stream); \
-      writeBase; \
-      _STREAM_ATTR_##n params1 \
+      if(_binaryBuffered() && stream.isBinary()) \
+      { \
+        char _buffer[_binaryBuffered() && _binarySize() ? _binarySize() : 1]; \
+        _binaryEncode(_buffer); \
+        stream.write(_buffer, _binarySize()); \
+      } \
+      else \
+      { \
+        writeBase; \
+        _STREAM_ATTR_##n params1 \
+      } \
     } \
   private: \
     static void _reg() \
@@ -377,4 +428,19 @@ namespace Streaming
   {
     OnRead<T, HasOnReadMethod<T>::value>::onRead(t);
   }
+
+  /**
+   * Classes generated by the macros above have a binary representation of a
+   * fixed size if their base class and all their attributes have one. They
+   * are then encoded and decoded in a single pass over a buffer instead of
+   * streaming each attribute on its own.
+   * @tparam T The type of the generated class.
+   */
+  template<typename T> struct BinaryCodec<T, std::enable_if_t<std::is_same<typename T::_BinaryCodecType, T>::value>>
+  {
+    static constexpr bool fixed = T::_binaryFixed();
+    static constexpr size_t size = T::_binarySize();
+    static char* encode(char* p, const T& t) {return t._binaryEncode(p);}
+    static const char* decode(const char* p, T& t) {p = t._binaryDecode(p); onRead(t); return p;}
+  };
 }
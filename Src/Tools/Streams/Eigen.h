@@ -619,3 +619,20 @@ Out& operator<<(Out& stream, const Eigen::AngleAxis<T>& angleAxis)
 
   return stream;
 }
+
+namespace Streaming
+{
+  /**
+   * Fixed-sized Eigen matrices are streamed in their storage order in all
+   * variants above, so their elements can be copied as a block.
+   */
+  template<typename T, int ROWS, int COLS, int OPTIONS>
+  struct BinaryCodec<Eigen::Matrix<T, ROWS, COLS, OPTIONS, ROWS, COLS>, std::enable_if_t<ROWS != Eigen::Dynamic && COLS != Eigen::Dynamic && BinaryCodec<T>::fixed>>
+  {
+    using Matrix = Eigen::Matrix<T, ROWS, COLS, OPTIONS, ROWS, COLS>;
+    static constexpr bool fixed = true;
+    static constexpr size_t size = ROWS * COLS * BinaryCodec<T>::size;
+    static char* encode(char* p, const Matrix& t) {return BinaryArrayCodec<T>::encode(p, t.data(), ROWS * COLS);}
+    static const char* decode(const char* p, Matrix& t) {return BinaryArrayCodec<T>::decode(p, t.data(), ROWS * COLS);}
+  };
+}
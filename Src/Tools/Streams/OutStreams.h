@@ -761,6 +761,11 @@ public:
    */
   const char* data() const { return buffer; }
 
+  /**
+   * Discards all bytes written, but keeps the memory reserved for reusing it.
+   */
+  void clear() { bytes = 0; }
+
   /**
    * Obtain ownership of the memory. The caller must free the memory.
    * This stream looses access to the memory.
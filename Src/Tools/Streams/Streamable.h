@@ -11,8 +11,10 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <list>
 #include <optional>
+#include <type_traits>
 #include <vector>
 #include "InOut.h"
 #include "TypeRegistry.h"
@@ -134,10 +136,134 @@ public:
 
 namespace Streaming
 {
+  /** Objects with a fixed binary size up to this number of bytes are streamed through a buffer on the stack. */
+  constexpr size_t maxFixedBinarySize = 4096;
+
+  /**
+   * Encodes values of a type into a raw byte buffer and decodes them from it
+   * without calling the stream for each primitive. This is only possible if the
+   * binary representation has a fixed size. The encoding is the same as the one
+   * of the binary streams, so the type information of logs remains valid. This
+   * is the version for types that do not qualify. Its methods do nothing and must
+   * not be called.
+   * @tparam T The type of the values.
+   */
+  template<typename T, typename = void> struct BinaryCodec
+  {
+    static constexpr bool fixed = false; /**< Has the binary representation a fixed size? */
+    static constexpr size_t size = 0; /**< The size of the binary representation in bytes. */
+    static char* encode(char* p, const T&) {return p;}
+    static const char* decode(const char* p, T&) {return p;}
+  };
+
+  /** Numbers are copied as they are in memory. */
+  template<typename T> struct BinaryCodec<T, std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>>
+  {
+    static constexpr bool fixed = true;
+    static constexpr size_t size = sizeof(T);
+    static char* encode(char* p, const T& t) {std::memcpy(p, &t, sizeof(T)); return p + sizeof(T);}
+    static const char* decode(const char* p, T& t) {std::memcpy(&t, p, sizeof(T)); return p + sizeof(T);}
+  };
+
+  /** Booleans are streamed as a single character. */
+  template<> struct BinaryCodec<bool>
+  {
+    static constexpr bool fixed = true;
+    static constexpr size_t size = 1;
+    static char* encode(char* p, const bool& t) {*p = static_cast<char>(t); return p + 1;}
+    static const char* decode(const char* p, bool& t) {t = *p != 0; return p + 1;}
+  };
+
+  /** Enumerations are streamed as unsigned char if they fit into it, otherwise as int. */
+  template<typename T> struct BinaryCodec<T, std::enable_if_t<std::is_enum<T>::value>>
+  {
+    using Type = std::conditional_t<sizeof(T) == 1, unsigned char, int>;
+    static constexpr bool fixed = true;
+    static constexpr size_t size = sizeof(Type);
+    static char* encode(char* p, const T& t) {const Type value = static_cast<Type>(t); return BinaryCodec<Type>::encode(p, value);}
+    static const char* decode(const char* p, T& t) {Type value; p = BinaryCodec<Type>::decode(p, value); t = static_cast<T>(value); return p;}
+  };
+
+  /** Angles are streamed as float. */
+  template<typename T> struct BinaryCodec<T, std::enable_if_t<std::is_same<T, Angle>::value>>
+  {
+    static constexpr bool fixed = true;
+    static constexpr size_t size = sizeof(float);
+    static char* encode(char* p, const T& t) {const float value = t; return BinaryCodec<float>::encode(p, value);}
+    static const char* decode(const char* p, T& t) {float value; p = BinaryCodec<float>::decode(p, value); t = value; return p;}
+  };
+
+  /** Encodes and decodes sequences of elements with a fixed size. */
+  template<typename E> struct BinaryArrayCodec
+  {
+    static char* encode(char* p, const E* elements, size_t numberOfElements)
+    {
+      if constexpr(std::is_arithmetic<E>::value && !std::is_same<E, bool>::value)
+      {
+        std::memcpy(p, elements, numberOfElements * sizeof(E));
+        return p + numberOfElements * sizeof(E);
+      }
+      else
+      {
+        for(size_t i = 0; i < numberOfElements; ++i)
+          p = BinaryCodec<E>::encode(p, elements[i]);
+        return p;
+      }
+    }
+
+    static const char* decode(const char* p, E* elements, size_t numberOfElements)
+    {
+      if constexpr(std::is_arithmetic<E>::value && !std::is_same<E, bool>::value)
+      {
+        std::memcpy(elements, p, numberOfElements * sizeof(E));
+        return p + numberOfElements * sizeof(E);
+      }
+      else
+      {
+        for(size_t i = 0; i < numberOfElements; ++i)
+          p = BinaryCodec<E>::decode(p, elements[i]);
+        return p;
+      }
+    }
+  };
+
+  template<typename E, size_t N> struct BinaryCodec<E[N], std::enable_if_t<BinaryCodec<E>::fixed>>
+  {
+    static constexpr bool fixed = true;
+    static constexpr size_t size = N * BinaryCodec<E>::size;
+    static char* encode(char* p, const E (&t)[N]) {return BinaryArrayCodec<E>::encode(p, t, N);}
+    static const char* decode(const char* p, E (&t)[N]) {return BinaryArrayCodec<E>::decode(p, t, N);}
+  };
+
+  template<typename E, size_t N> struct BinaryCodec<std::array<E, N>, std::enable_if_t<BinaryCodec<E>::fixed>>
+  {
+    static constexpr bool fixed = true;
+    static constexpr size_t size = N * BinaryCodec<E>::size;
+    static char* encode(char* p, const std::array<E, N>& t) {return BinaryArrayCodec<E>::encode(p, t.data(), N);}
+    static const char* decode(const char* p, std::array<E, N>& t) {return BinaryArrayCodec<E>::decode(p, t.data(), N);}
+  };
+
+  /** The base class of all streamable classes adds nothing. */
+  template<> struct BinaryCodec<Streamable>
+  {
+    static constexpr bool fixed = true;
+    static constexpr size_t size = 0;
+    static char* encode(char* p, const Streamable&) {return p;}
+    static const char* decode(const char* p, Streamable&) {return p;}
+  };
+
   template<typename T>
   In& streamComplexStaticArray(In& in, T inArray[], size_t size, const char* enumType)
   {
     int numberOfEntries = int(size / sizeof(T));
+    if constexpr(BinaryCodec<T>::fixed)
+      if(in.isBinary())
+      {
+        std::vector<char> buffer(numberOfEntries * BinaryCodec<T>::size);
+        in.read(buffer.data(), buffer.size());
+        BinaryArrayCodec<T>::decode(buffer.data(), inArray, numberOfEntries);
+        return in;
+      }
     for(int i = 0; i < numberOfEntries; ++i)
     {
       in.select(0, i, enumType);
@@ -150,7 +276,16 @@ namespace Streaming
   template<typename T>
   Out& streamComplexStaticArray(Out& out, T outArray[], size_t size, const char* enumType)
   {
+    using E = std::remove_const_t<T>;
     int numberOfEntries = int(size / sizeof(T));
+    if constexpr(BinaryCodec<E>::fixed)
+      if(out.isBinary())
+      {
+        std::vector<char> buffer(numberOfEntries * BinaryCodec<E>::size);
+        BinaryArrayCodec<E>::encode(buffer.data(), outArray, numberOfEntries);
+        out.write(buffer.data(), buffer.size());
+        return out;
+      }
     for(int i = 0; i < numberOfEntries; ++i)
     {
       out.select(0, i, enumType);
@@ -0,0 +1,75 @@
+#include "Tools/BehaviorControl/CircleSectors.h"
+#include "Tools/Math/Angle.h"
+
+#include "gtest/gtest.h"
+
+/** Checks that both limits of the sector covered by the other circle are the intersections of the circles. */
+static void checkOverlap(const Vector2f& center, float radius, const Vector2f& otherCenter, float otherRadius)
+{
+  ASSERT_TRUE(CircleSectors::intersect(center, radius, otherCenter, otherRadius));
+  ASSERT_TRUE(CircleSectors::intersect(otherCenter, otherRadius, center, radius));
+  const Rangef sector = CircleSectors::getOverlap(center, radius, otherCenter, otherRadius);
+  for(const float angle : {sector.min, sector.max})
+  {
+    const Vector2f intersection = center + Vector2f(radius, 0.f).rotated(angle);
+    EXPECT_NEAR(otherRadius, (intersection - otherCenter).norm(), 0.5f);
+  }
+  EXPECT_TRUE(sector.isInside((otherCenter - center).angle()));
+}
+
+GTEST_TEST(CircleSectors, Overlap)
+{
+  checkOverlap(Vector2f::Zero(), 500.f, Vector2f(600.f, 0.f), 300.f);
+  checkOverlap(Vector2f(1000.f, -200.f), 500.f, Vector2f(1000.f, 500.f), 400.f);
+
+  // The sector crosses the -pi/pi border.
+  checkOverlap(Vector2f::Zero(), 500.f, Vector2f(-600.f, 10.f), 300.f);
+  const Rangef sector = CircleSectors::getOverlap(Vector2f::Zero(), 500.f, Vector2f(-600.f, 10.f), 300.f);
+  EXPECT_GT(sector.min, sector.max);
+}
+
+GTEST_TEST(CircleSectors, NoOverlap)
+{
+  // Separate
+  EXPECT_FALSE(CircleSectors::intersect(Vector2f::Zero(), 500.f, Vector2f(900.f, 0.f), 300.f));
+
+  // Touching
+  EXPECT_FALSE(CircleSectors::intersect(Vector2f::Zero(), 500.f, Vector2f(800.f, 0.f), 300.f));
+
+  // One contains the other one
+  EXPECT_FALSE(CircleSectors::intersect(Vector2f::Zero(), 500.f, Vector2f(100.f, 0.f), 300.f));
+  EXPECT_FALSE(CircleSectors::intersect(Vector2f::Zero(), 300.f, Vector2f(100.f, 0.f), 500.f));
+
+  // A point is never intersected
+  EXPECT_FALSE(CircleSectors::intersect(Vector2f::Zero(), 0.f, Vector2f(100.f, 0.f), 300.f));
+}
+
+GTEST_TEST(CircleSectors, ObstacleMovesOntoArc)
+{
+  // A path surrounds an obstacle counterclockwise from its right to its left side, i.e.
+  // it passes the front of the obstacle. Another obstacle moves from behind the first one
+  // to its front. Only then, it blocks the arc.
+  const Vector2f center(2000.f, 0.f);
+  const float radius = 500.f;
+  const Rangef arc(-pi_2, pi_2);
+  Rangef sector;
+
+  sector = CircleSectors::getOverlap(center, radius, center + Vector2f(-600.f, 100.f), 300.f);
+  EXPECT_FALSE(CircleSectors::overlap(arc, sector));
+  EXPECT_FALSE(CircleSectors::overlap(sector, arc));
+
+  sector = CircleSectors::getOverlap(center, radius, center + Vector2f(600.f, 100.f), 300.f);
+  EXPECT_TRUE(CircleSectors::overlap(arc, sector));
+  EXPECT_TRUE(CircleSectors::overlap(sector, arc));
+
+  // The same clockwise from the left to the right side, i.e. around the back, which crosses the -pi/pi border.
+  const Rangef backArc(pi_2, -pi_2);
+  sector = CircleSectors::getOverlap(center, radius, center + Vector2f(600.f, 100.f), 300.f);
+  EXPECT_FALSE(CircleSectors::overlap(backArc, sector));
+  sector = CircleSectors::getOverlap(center, radius, center + Vector2f(-600.f, 100.f), 300.f);
+  EXPECT_TRUE(CircleSectors::overlap(backArc, sector));
+
+  // A small obstacle inside the arc that does not cover any of its limits.
+  sector = CircleSectors::getOverlap(center, radius, center + Vector2f(520.f, 0.f), 50.f);
+  EXPECT_TRUE(CircleSectors::overlap(arc, sector));
+}
@@ -0,0 +1,214 @@
+#include "Tools/BehaviorControl/PassingLanes.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <iostream>
+
+/** The original check: every opponent is farther than the clearance from the line through the origin and the target. */
+static bool isLineFree(const Vector2f& origin, const std::vector<Vector2f>& opponents, const Vector2f& target, float clearance)
+{
+  const Eigen::ParametrizedLine<float, 2> line = Eigen::ParametrizedLine<float, 2>::Through(origin, target);
+  for(const Vector2f& opponent : opponents)
+    if(line.distance(opponent) <= clearance)
+      return false;
+  return true;
+}
+
+/** The recursive search that was used before, which tries all orders in which the opponents can be removed. */
+static bool findPassingLineRecursively(const Vector2f& origin, std::vector<Vector2f> opponents, const Vector2f& target, float clearance)
+{
+  if(opponents.empty())
+    return true;
+  const Eigen::ParametrizedLine<float, 2> line = Eigen::ParametrizedLine<float, 2>::Through(origin, target);
+  const std::vector<Vector2f> originalVector = opponents;
+  for(auto it = opponents.begin(); it != opponents.end(); ++it)
+  {
+    if(line.distance(*it) > clearance)
+    {
+      opponents.erase(it);
+      if(findPassingLineRecursively(origin, opponents, target, clearance))
+        return true;
+    }
+    opponents = originalVector;
+  }
+  return false;
+}
+
+GTEST_TEST(PassingLanes, Empty)
+{
+  PassingLanes passingLanes;
+  passingLanes.begin(Vector2f::Zero(), 400.f);
+  passingLanes.finish();
+  ASSERT_EQ(1u, passingLanes.getLanes().size());
+  EXPECT_FLOAT_EQ(pi2, passingLanes.getLanes().front().width());
+  EXPECT_TRUE(passingLanes.isFree(Vector2f(1000.f, 0.f)));
+}
+
+GTEST_TEST(PassingLanes, Blocked)
+{
+  PassingLanes passingLanes;
+  passingLanes.begin(Vector2f(1000.f, 0.f), 400.f);
+  passingLanes.addOpponent(Vector2f(3000.f, 0.f));
+  passingLanes.addOpponent(Vector2f(1000.f, 2000.f));
+  passingLanes.addOpponent(Vector2f(-1000.f, 10.f)); // Crosses the -pi/pi border
+  passingLanes.finish();
+
+  EXPECT_FALSE(passingLanes.isFree(Vector2f(4000.f, 0.f)));
+  EXPECT_FALSE(passingLanes.isFree(Vector2f(2800.f, 100.f)));
+  EXPECT_TRUE(passingLanes.isFree(Vector2f(2000.f, 0.f))); // Far enough before the opponent
+  EXPECT_TRUE(passingLanes.isFree(Vector2f(4000.f, 1000.f)));
+  EXPECT_FALSE(passingLanes.isFree(Vector2f(-2000.f, 0.f)));
+  EXPECT_FALSE(passingLanes.isFree(Vector2f(-2000.f, -10.f)));
+
+  ASSERT_EQ(3u, passingLanes.getLanes().size());
+  Angle sum = 0.f;
+  for(std::size_t i = 0; i < passingLanes.getLanes().size(); ++i)
+  {
+    const PassingLanes::Lane& lane = passingLanes.getLanes()[i];
+    EXPECT_GT(lane.width(), 0.f);
+    if(i > 0)
+      EXPECT_LE(lane.width(), passingLanes.getLanes()[i - 1].width());
+    EXPECT_TRUE(passingLanes.isFree(Vector2f(1000.f, 0.f) + Vector2f::polar(5000.f, lane.center())));
+    sum += lane.width();
+  }
+  EXPECT_NEAR(pi2 - 2.f * (std::asin(0.2f) * 2.f + std::asin(0.2f)), sum, 1e-4f);
+
+  // An opponent next to the origin blocks everything.
+  passingLanes.begin(Vector2f::Zero(), 400.f);
+  passingLanes.addOpponent(Vector2f(100.f, 100.f));
+  passingLanes.finish();
+  EXPECT_TRUE(passingLanes.getLanes().empty());
+  EXPECT_FALSE(passingLanes.isFree(Vector2f(-3000.f, 0.f)));
+}
+
+GTEST_TEST(PassingLanes, ConsideredOpponents)
+{
+  constexpr float xPosOpponentPenaltyMark = 3200.f;
+  constexpr float xMinBehind = 2000.f;
+
+  // Before the penalty mark, only opponents ahead are considered.
+  const Vector2f midfield(1000.f, 0.f);
+  EXPECT_TRUE(PassingLanes::isConsidered(midfield, Vector2f(2500.f, 500.f), xPosOpponentPenaltyMark, xMinBehind));
+  EXPECT_FALSE(PassingLanes::isConsidered(midfield, Vector2f(500.f, 500.f), xPosOpponentPenaltyMark, xMinBehind));
+
+  // Beyond the penalty mark, opponents ahead are still considered, e.g. the goalie.
+  const Vector2f origin(3800.f, 1000.f);
+  const Vector2f goalie(4300.f, 0.f);
+  EXPECT_TRUE(PassingLanes::isConsidered(origin, goalie, xPosOpponentPenaltyMark, xMinBehind));
+  EXPECT_TRUE(PassingLanes::isConsidered(origin, Vector2f(2500.f, 0.f), xPosOpponentPenaltyMark, xMinBehind));
+  EXPECT_FALSE(PassingLanes::isConsidered(origin, Vector2f(1500.f, 0.f), xPosOpponentPenaltyMark, xMinBehind));
+
+  PassingLanes passingLanes;
+  passingLanes.begin(origin, 400.f);
+  passingLanes.addOpponent(goalie);
+  passingLanes.finish();
+  EXPECT_FALSE(passingLanes.isFree(Vector2f(4800.f, -1000.f)));
+  EXPECT_TRUE(passingLanes.isFree(Vector2f(3000.f, -1000.f)));
+}
+
+/** Opponents ahead of the origin and targets further away must give the same results as the line check. */
+GTEST_TEST(PassingLanes, MatchesLineCheck)
+{
+  PassingLanes passingLanes;
+  std::vector<Vector2f> opponents;
+  for(int run = 0; run < 100; ++run)
+  {
+    const Vector2f origin(Random::uniform(-4500.f, 0.f), Random::uniform(-3000.f, 3000.f));
+    passingLanes.begin(origin, 400.f);
+    opponents.clear();
+    for(int i = 0; i < 5; ++i)
+    {
+      opponents.emplace_back(Random::uniform(origin.x() + 500.f, 2000.f), Random::uniform(-3000.f, 3000.f));
+      passingLanes.addOpponent(opponents.back());
+    }
+    passingLanes.finish();
+    for(int i = 0; i < 100; ++i)
+    {
+      const Vector2f target(Random::uniform(2500.f, 4500.f), Random::uniform(-3000.f, 3000.f));
+      EXPECT_EQ(isLineFree(origin, opponents, target, 400.f), passingLanes.isFree(target));
+    }
+  }
+}
+
+/**
+ * Checks that the lanes find every pass the recursive search found. Disabled, because the
+ * recursive search is slow. Run it with --gtest_also_run_disabled_tests.
+ */
+GTEST_TEST(PassingLanes, DISABLED_MatchesRecursiveSearch)
+{
+  PassingLanes passingLanes;
+  for(int i = 0; i < 100; ++i)
+  {
+    const Vector2f origin(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f));
+    std::vector<Vector2f> opponents;
+    for(int j = Random::uniformInt(0, 6); j > 0; --j)
+      opponents.emplace_back(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f));
+    passingLanes.begin(origin, 400.f);
+    for(const Vector2f& opponent : opponents)
+      passingLanes.addOpponent(opponent);
+    passingLanes.finish();
+
+    for(int j = 0; j < 50; ++j)
+    {
+      const Vector2f target(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f));
+      const bool recursive = findPassingLineRecursively(origin, opponents, target, 400.f);
+      EXPECT_EQ(isLineFree(origin, opponents, target, 400.f), recursive);
+
+      // Lanes ignore opponents behind the target and behind the origin, so they can find more free passes.
+      if(recursive)
+        EXPECT_TRUE(passingLanes.isFree(target));
+    }
+  }
+}
+
+/**
+ * Compares the recursive search for each target with checking it against the lanes for
+ * 5 to 10 opponents. It only prints timings and is therefore disabled. Run it with
+ * --gtest_also_run_disabled_tests.
+ */
+GTEST_TEST(PassingLanes, DISABLED_Benchmark)
+{
+  constexpr int frames = 10;
+  constexpr int numOfTargets = 10;
+
+  std::vector<Vector2f> targets;
+  for(int i = 0; i < numOfTargets; ++i)
+    targets.emplace_back(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f));
+
+  for(int numOfOpponents = 5; numOfOpponents <= 10; ++numOfOpponents)
+  {
+    std::vector<std::vector<Vector2f>> opponents(frames);
+    for(std::vector<Vector2f>& frame : opponents)
+      for(int i = 0; i < numOfOpponents; ++i)
+        frame.emplace_back(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f));
+
+    unsigned freeLines = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(const std::vector<Vector2f>& frame : opponents)
+      for(const Vector2f& target : targets)
+        freeLines += findPassingLineRecursively(Vector2f::Zero(), frame, target, 400.f);
+    const auto lineTime = std::chrono::steady_clock::now() - start;
+
+    unsigned freeLanes = 0;
+    PassingLanes passingLanes;
+    start = std::chrono::steady_clock::now();
+    for(const std::vector<Vector2f>& frame : opponents)
+    {
+      passingLanes.begin(Vector2f::Zero(), 400.f);
+      for(const Vector2f& opponent : frame)
+        passingLanes.addOpponent(opponent);
+      passingLanes.finish();
+      for(const Vector2f& target : targets)
+        freeLanes += passingLanes.isFree(target);
+    }
+    const auto laneTime = std::chrono::steady_clock::now() - start;
+
+    // Lanes ignore opponents behind the target and behind the origin, so they find more free passes.
+    EXPECT_GE(freeLanes, freeLines);
+
+    std::cout << "[ BENCHMARK] " << numOfOpponents << " opponents, " << numOfTargets << " targets: recursive "
+              << std::chrono::duration<double, std::micro>(lineTime).count() / frames << " us/frame, lanes "
+              << std::chrono::duration<double, std::micro>(laneTime).count() / frames << " us/frame" << std::endl;
+  }
+}
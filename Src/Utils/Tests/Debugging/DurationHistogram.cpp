@@ -0,0 +1,60 @@
+#include "Tools/Debugging/DurationHistogram.h"
+
+#include "gtest/gtest.h"
+
+GTEST_TEST(DurationHistogram, Empty)
+{
+  DurationHistogram histogram;
+  EXPECT_EQ(0u, histogram.getTotal());
+  EXPECT_EQ(0u, histogram.getMaximum());
+  EXPECT_EQ(0u, histogram.getQuantile(0.5f));
+}
+
+GTEST_TEST(DurationHistogram, SmallDurationsAreExact)
+{
+  DurationHistogram histogram;
+  for(unsigned i = 1; i <= 10; ++i)
+    histogram.add(i);
+  EXPECT_EQ(10u, histogram.getTotal());
+  EXPECT_EQ(5u, histogram.getQuantile(0.5f));
+  EXPECT_EQ(10u, histogram.getQuantile(1.f));
+  EXPECT_EQ(10u, histogram.getMaximum());
+}
+
+GTEST_TEST(DurationHistogram, RelativeErrorIsBounded)
+{
+  DurationHistogram histogram;
+  for(unsigned i = 1; i <= 100000; ++i)
+    histogram.add(i);
+  for(float ratio : {0.5f, 0.95f, 0.99f})
+  {
+    const unsigned exact = static_cast<unsigned>(ratio * 100000.f);
+    const unsigned quantile = histogram.getQuantile(ratio);
+    EXPECT_GE(quantile, exact);
+    EXPECT_LE(quantile, exact + exact / DurationHistogram::subBuckets);
+  }
+  EXPECT_EQ(100000u, histogram.getMaximum());
+}
+
+GTEST_TEST(DurationHistogram, OutliersOnlyAffectHighQuantiles)
+{
+  DurationHistogram histogram;
+  for(int i = 0; i < 990; ++i)
+    histogram.add(1000);
+  for(int i = 0; i < 10; ++i)
+    histogram.add(50000);
+  EXPECT_LE(histogram.getQuantile(0.5f), 1000u + 1000u / DurationHistogram::subBuckets);
+  EXPECT_LE(histogram.getQuantile(0.99f), 1000u + 1000u / DurationHistogram::subBuckets);
+  EXPECT_GE(histogram.getQuantile(0.995f), 50000u);
+  EXPECT_EQ(50000u, histogram.getMaximum());
+}
+
+GTEST_TEST(DurationHistogram, LongDurationsAreClamped)
+{
+  DurationHistogram histogram;
+  histogram.add(0xffffffff);
+  EXPECT_EQ(DurationHistogram::maxDuration, histogram.getMaximum());
+  EXPECT_EQ(DurationHistogram::maxDuration, histogram.getQuantile(1.f));
+  histogram.reset();
+  EXPECT_EQ(0u, histogram.getTotal());
+}
@@ -0,0 +1,124 @@
+#include "Tools/Debugging/TimingManager.h"
+#include "Tools/MessageQueue/MessageQueue.h"
+
+#include "gtest/gtest.h"
+
+GTEST_TEST(TimingManager, IdsAreSharedByName)
+{
+  const unsigned short a = TimingManager::getId("TimingManagerTestA");
+  const unsigned short b = TimingManager::getId("TimingManagerTestB");
+  EXPECT_NE(a, b);
+  static const char name[] = "TimingManagerTestA"; // Same contents, different address, lives as long as the registry
+  EXPECT_EQ(a, TimingManager::getId(name));
+}
+
+namespace
+{
+  class Handler : public MessageHandler
+  {
+  public:
+    unsigned stopwatchMessages = 0;
+    unsigned traceMessages = 0;
+    unsigned short numOfNames = 0;
+    std::vector<std::pair<unsigned short, unsigned char>> events;
+    std::vector<unsigned> offsets;
+
+    bool handleMessage(InMessage& message) override
+    {
+      if(message.getMessageID() == idStopwatch)
+        ++stopwatchMessages;
+      else if(message.getMessageID() == idTraceEvents)
+      {
+        ++traceMessages;
+        message.bin >> numOfNames;
+        for(unsigned short i = 0; i < numOfNames; ++i)
+        {
+          unsigned short id;
+          std::string name;
+          message.bin >> id >> name;
+        }
+        unsigned high, low, numOfEvents;
+        message.bin >> high >> low >> numOfEvents;
+        for(unsigned i = 0; i < numOfEvents; ++i)
+        {
+          unsigned short id;
+          unsigned char flags;
+          unsigned offset;
+          message.bin >> id >> flags >> offset;
+          events.emplace_back(id, flags);
+          offsets.push_back(offset);
+        }
+      }
+      return true;
+    }
+  };
+}
+
+GTEST_TEST(TimingManager, EventsAreRecorded)
+{
+  const unsigned short outer = TimingManager::getId("TimingManagerTestOuter");
+  const unsigned short inner = TimingManager::getId("TimingManagerTestInner");
+
+  TimingManager timingManager;
+  timingManager.signalThreadStart();
+  timingManager.startTiming(outer);
+  timingManager.startTiming(inner);
+  timingManager.stopTiming(inner);
+  timingManager.stopTiming(outer);
+
+  Handler handler;
+  timingManager.requestEvents();
+  timingManager.getData().handleAllMessages(handler);
+  EXPECT_EQ(1u, handler.stopwatchMessages);
+  EXPECT_EQ(1u, handler.traceMessages);
+  EXPECT_EQ(2, handler.numOfNames);
+  ASSERT_EQ(4u, handler.events.size());
+  EXPECT_EQ(std::make_pair(outer, static_cast<unsigned char>(0x80)), handler.events[0]);
+  EXPECT_EQ(std::make_pair(inner, static_cast<unsigned char>(0x80)), handler.events[1]);
+  EXPECT_EQ(std::make_pair(inner, static_cast<unsigned char>(0)), handler.events[2]);
+  EXPECT_EQ(std::make_pair(outer, static_cast<unsigned char>(0)), handler.events[3]);
+  for(std::size_t i = 1; i < handler.offsets.size(); ++i)
+    EXPECT_LE(handler.offsets[i - 1], handler.offsets[i]);
+
+  // A new frame starts without events.
+  timingManager.signalThreadStart();
+  Handler next;
+  timingManager.requestEvents();
+  timingManager.getData().handleAllMessages(next);
+  EXPECT_EQ(0, next.numOfNames);
+  EXPECT_TRUE(next.events.empty());
+}
+
+GTEST_TEST(TimingManager, EventsAreOnlySentOnRequest)
+{
+  const unsigned short id = TimingManager::getId("TimingManagerTestRequest");
+  TimingManager timingManager;
+  auto frame = [&](bool request)
+  {
+    timingManager.signalThreadStart();
+    timingManager.startTiming(id);
+    timingManager.stopTiming(id);
+    Handler handler;
+    if(request)
+      timingManager.requestEvents();
+    timingManager.getData().handleAllMessages(handler);
+    EXPECT_EQ(1u, handler.stopwatchMessages);
+    return handler;
+  };
+
+  EXPECT_EQ(0u, frame(false).traceMessages);
+
+  // The name is only sent in the first frame with events.
+  Handler handler = frame(true);
+  EXPECT_EQ(1u, handler.traceMessages);
+  EXPECT_EQ(1, handler.numOfNames);
+  EXPECT_EQ(2u, handler.events.size());
+  handler = frame(true);
+  EXPECT_EQ(1u, handler.traceMessages);
+  EXPECT_EQ(0, handler.numOfNames);
+  EXPECT_EQ(2u, handler.events.size());
+
+  // After a frame without events, the name is sent again.
+  EXPECT_EQ(0u, frame(false).traceMessages);
+  EXPECT_EQ(1, frame(true).numOfNames);
+}
@@ -0,0 +1,176 @@
+#include "Tools/ImageProcessing/ParallelRows.h"
+#include "Tools/ImageProcessing/Resize.h"
+#include "Tools/ImageProcessing/Sobel.h"
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace ParallelRowsTest
+{
+  constexpr unsigned width = 640;
+  constexpr unsigned height = 480;
+
+  /** Sets the pool of the current thread while it exists. */
+  struct Pool : ParallelRows
+  {
+    Pool(unsigned numOfThreads) : ParallelRows("Rows", numOfThreads) {setInstance(this);}
+    ~Pool() {setInstance(nullptr);}
+  };
+
+  /** The images processed by the kernels. */
+  struct Images
+  {
+    Sobel::Image1D gray = Sobel::Image1D(width, height, 16);
+    Image<PixelTypes::YUYVPixel> yuyv = Image<PixelTypes::YUYVPixel>(width / 2, height);
+
+    Images()
+    {
+      std::mt19937 random(42);
+      for(unsigned y = 0; y < height; ++y)
+      {
+        for(unsigned x = 0; x < width; ++x)
+          gray[y][x] = static_cast<unsigned char>(random());
+        unsigned char* p = reinterpret_cast<unsigned char*>(yuyv[y]);
+        for(unsigned x = 0; x < width * 2; ++x)
+          p[x] = static_cast<unsigned char>(random());
+      }
+    }
+  };
+
+  /** The kernels with their names. */
+  const std::vector<std::pair<const char*, std::function<void(const Images&, std::vector<unsigned char>&)>>> kernels =
+  {
+    {
+      "sobelSSE", [](const Images& images, std::vector<unsigned char>& result)
+      {
+        Sobel::SobelImage sobel;
+        Sobel::sobelSSE(images.gray, sobel);
+        result.assign(reinterpret_cast<const unsigned char*>(sobel[0]), reinterpret_cast<const unsigned char*>(sobel[sobel.height]));
+      }
+    },
+    {
+      "shrinkY(3)", [](const Images& images, std::vector<unsigned char>& result)
+      {
+        Image<PixelTypes::GrayscaledPixel> shrunk;
+        Resize::shrinkY(3, images.gray, shrunk);
+        result.assign(shrunk[0], shrunk[shrunk.height]);
+      }
+    },
+    {
+      "shrinkY(1)", [](const Images& images, std::vector<unsigned char>& result)
+      {
+        Image<PixelTypes::GrayscaledPixel> shrunk;
+        Resize::shrinkY(1, images.gray, shrunk);
+        result.assign(shrunk[0], shrunk[shrunk.height]);
+      }
+    },
+    {
+      "shrinkUV(2)", [](const Images& images, std::vector<unsigned char>& result)
+      {
+        Image<unsigned short> shrunk;
+        Resize::shrinkUV(2, images.yuyv, shrunk);
+        result.assign(reinterpret_cast<const unsigned char*>(shrunk[0]), reinterpret_cast<const unsigned char*>(shrunk[shrunk.height]));
+      }
+    },
+    {
+      "shrinkUV(0)", [](const Images& images, std::vector<unsigned char>& result)
+      {
+        Image<unsigned short> shrunk;
+        Resize::shrinkUV(0, images.yuyv, shrunk);
+        result.assign(reinterpret_cast<const unsigned char*>(shrunk[0]), reinterpret_cast<const unsigned char*>(shrunk[shrunk.height]));
+      }
+    }
+  };
+
+  GTEST_TEST(ParallelRows, stripes)
+  {
+    ParallelRows pool("Rows", 3);
+    std::vector<std::atomic<int>> counts(100);
+    EXPECT_TRUE(pool.forRows(3, 100, 7, [&](int yMin, int yMax)
+    {
+      EXPECT_EQ(0, (yMin - 3) % 7);
+      EXPECT_LE(yMax - yMin, 7);
+      for(int y = yMin; y < yMax; ++y)
+        ++counts[y];
+    }));
+    for(int y = 0; y < 100; ++y)
+      EXPECT_EQ(y < 3 ? 0 : 1, counts[y]);
+
+    int calls = 0;
+    EXPECT_FALSE(pool.forRows(0, 7, 7, [&](int yMin, int yMax)
+    {
+      EXPECT_EQ(0, yMin);
+      EXPECT_EQ(7, yMax);
+      ++calls;
+    }));
+    EXPECT_EQ(1, calls);
+  }
+
+  GTEST_TEST(ParallelRows, concurrentCallers)
+  {
+    ParallelRows pool("Rows", 2);
+    std::vector<std::atomic<int>> counts(2 * 1000);
+    auto run = [&](int offset)
+    {
+      for(int i = 0; i < 50; ++i)
+        pool.forRows(offset, offset + 1000, 10, [&](int yMin, int yMax)
+        {
+          for(int y = yMin; y < yMax; ++y)
+            ++counts[y];
+        });
+    };
+    std::thread other(run, 1000);
+    run(0);
+    other.join();
+    for(const std::atomic<int>& count : counts)
+      EXPECT_EQ(50, count);
+  }
+
+  GTEST_TEST(ParallelRows, kernels)
+  {
+    const Images images;
+    for(const auto& [name, kernel] : kernels)
+    {
+      std::vector<unsigned char> sequential, striped;
+      kernel(images, sequential);
+      {
+        Pool pool(3);
+        kernel(images, striped);
+      }
+      EXPECT_TRUE(sequential == striped) << name;
+    }
+  }
+
+  /**
+   * Measures how each kernel scales with 1 to 4 threads. It only prints timings and is
+   * therefore disabled. Run it with --gtest_also_run_disabled_tests.
+   */
+  GTEST_TEST(ParallelRows, DISABLED_Benchmark)
+  {
+    constexpr int runs = 50;
+    const Images images;
+    std::vector<unsigned char> result;
+    for(const auto& [name, kernel] : kernels)
+    {
+      std::cout << "[ BENCHMARK] " << name << ":";
+      for(unsigned threads = 0; threads < 4; ++threads)
+      {
+        Pool pool(threads);
+        kernel(images, result);
+        const auto start = std::chrono::high_resolution_clock::now();
+        for(int i = 0; i < runs; ++i)
+          kernel(images, result);
+        const auto end = std::chrono::high_resolution_clock::now();
+        std::cout << " " << threads + 1 << (threads ? " threads " : " thread ")
+                  << std::chrono::duration<double, std::micro>(end - start).count() / runs << " us"
+                  << (threads < 3 ? "," : "");
+      }
+      std::cout << std::endl;
+    }
+  }
+}
@@ -0,0 +1,107 @@
+#include "Tools/ImageProcessing/PatchUtilities.h"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace PatchUtilitiesTest
+{
+  constexpr unsigned width = 160;
+  constexpr unsigned height = 120;
+  const Vector2i outSize(32, 32);
+
+  /** Patches inside the image, partly outside of each of its borders, larger and smaller than outSize. */
+  const std::vector<Vector2i> centers = {{80, 60}, {5, 8}, {150, 115}, {80, 2}, {3, 60}, {157, 40}};
+  const std::vector<Vector2i> inSizes = {{40, 40}, {32, 24}, {48, 32}, {17, 29}, {64, 64}, {20, 20}};
+
+  struct Images
+  {
+    GrayscaledImage grayscaled = GrayscaledImage(width, height);
+
+    Images()
+    {
+      std::mt19937 random(42);
+      for(unsigned y = 0; y < height; ++y)
+        for(unsigned x = 0; x < width; ++x)
+          grayscaled[y][x] = static_cast<PixelTypes::GrayscaledPixel>(random());
+    }
+  };
+
+  /** The former implementation of PatchUtilities::normalizeContrast that sorts all values. */
+  template<typename OutType>
+  void normalizeContrastSorted(OutType* output, const Vector2i& size, const float percent)
+  {
+    Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, Eigen::Dynamic>> patch(output, size.x(), size.y());
+    Eigen::Matrix<OutType, Eigen::Dynamic, 1> sorted = Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, 1>>(patch.data(), size.x() * size.y());
+    std::sort(sorted.data(), sorted.data() + sorted.size());
+
+    OutType min = sorted(static_cast<int>((sorted.size() - 1) * percent));
+    OutType max = sorted(static_cast<int>((sorted.size() - 1) * (1.f - percent)));
+    if(max == 0)
+      patch.setConstant(0);
+    else
+      patch.array() = ((patch.array().max(min).min(max) - min).template cast<float>() * 255.f / (static_cast<float>(max - min))).template cast<OutType>();
+  }
+
+  /** Checks that extracting a batch yields the same patches as extracting (and normalizing) them one by one. */
+  template<typename OutType>
+  void checkBatch(const GrayscaledImage& image, const PatchUtilities::ExtractionMode mode, const float percent)
+  {
+    const int patchSize = outSize.x() * outSize.y();
+    std::vector<OutType> batch(centers.size() * patchSize);
+    PatchUtilities::extractPatches(centers, inSizes, outSize, image, batch.data(), mode, percent);
+
+    std::vector<OutType> patch(patchSize);
+    for(std::size_t i = 0; i < centers.size(); ++i)
+    {
+      PatchUtilities::extractPatch(centers[i], inSizes[i], outSize, image, patch.data(), mode);
+      if(percent > 0.f)
+        normalizeContrastSorted(patch.data(), outSize, percent);
+      EXPECT_TRUE(std::equal(patch.begin(), patch.end(), batch.begin() + i * patchSize))
+          << "mode " << static_cast<int>(mode) << ", patch " << i << ", percent " << percent;
+    }
+  }
+
+  /** Checks that PatchUtilities::normalizeContrast yields the same results as sorting. */
+  template<typename OutType, typename Distribution>
+  void checkNormalizeContrast(Distribution distribution)
+  {
+    std::mt19937 random(42);
+    for(const Vector2i& size : {Vector2i(32, 32), Vector2i(7, 13)})
+      for(const float percent : {0.f, 0.02f, 0.1f})
+      {
+        std::vector<OutType> values(size.x() * size.y());
+        for(OutType& value : values)
+          value = static_cast<OutType>(distribution(random));
+        std::vector<OutType> expected = values;
+        normalizeContrastSorted(expected.data(), size, percent);
+        PatchUtilities::normalizeContrast(values.data(), size, percent);
+        EXPECT_EQ(expected, values) << "size " << size.x() << "x" << size.y() << ", percent " << percent;
+
+        // A black patch stays black.
+        std::fill(values.begin(), values.end(), static_cast<OutType>(0));
+        PatchUtilities::normalizeContrast(values.data(), size, percent);
+        EXPECT_TRUE(std::all_of(values.begin(), values.end(), [](OutType value) {return value == 0;}));
+      }
+  }
+
+  GTEST_TEST(PatchUtilities, extractPatches)
+  {
+    const Images images;
+    for(const PatchUtilities::ExtractionMode mode : {PatchUtilities::fast, PatchUtilities::fastInterpolated})
+      for(const float percent : {0.f, 0.02f})
+      {
+        checkBatch<unsigned char>(images.grayscaled, mode, percent);
+        checkBatch<float>(images.grayscaled, mode, percent);
+      }
+  }
+
+  GTEST_TEST(PatchUtilities, normalizeContrast)
+  {
+    checkNormalizeContrast<unsigned char>(std::uniform_int_distribution<int>(0, 255));
+    checkNormalizeContrast<unsigned char>(std::uniform_int_distribution<int>(40, 90));
+    checkNormalizeContrast<float>(std::uniform_real_distribution<float>(0.f, 255.f));
+    checkNormalizeContrast<float>(std::uniform_real_distribution<float>(40.f, 90.f));
+  }
+}
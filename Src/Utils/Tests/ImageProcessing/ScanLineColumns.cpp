@@ -0,0 +1,111 @@
+#include "Tools/ImageProcessing/ScanLineColumns.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace ScanLineColumnsTest
+{
+  constexpr unsigned width = 640;
+  constexpr unsigned height = 480;
+
+  struct Images
+  {
+    Image<PixelTypes::GrayscaledPixel> grayscaled = Image<PixelTypes::GrayscaledPixel>(width, height);
+    Image<PixelTypes::GrayscaledPixel> saturated = Image<PixelTypes::GrayscaledPixel>(width, height);
+    Image<PixelTypes::HuePixel> hued = Image<PixelTypes::HuePixel>(width, height);
+
+    Images()
+    {
+      std::mt19937 random(42);
+      for(unsigned y = 0; y < height; ++y)
+        for(unsigned x = 0; x < width; ++x)
+        {
+          grayscaled[y][x] = static_cast<PixelTypes::GrayscaledPixel>(random());
+          saturated[y][x] = static_cast<PixelTypes::GrayscaledPixel>(random());
+          hued[y][x] = static_cast<PixelTypes::HuePixel>(random());
+        }
+    }
+  };
+
+  /** Columns similar to the vertical scan lines of the upper camera. */
+  std::vector<ScanLineColumns::Column> getColumns()
+  {
+    std::vector<ScanLineColumns::Column> columns;
+    for(int x = 2, i = 0; x < static_cast<int>(width) - 2; x += 14, ++i)
+      columns.push_back({x, 60 + (i * 37) % 80, i % 4 ? 300 + (i * 53) % 180 : static_cast<int>(height)});
+    return columns;
+  }
+
+  GTEST_TEST(ScanLineColumns, copy)
+  {
+    const Images images;
+    const std::vector<ScanLineColumns::Column> columns = getColumns();
+    ScanLineColumns scanLineColumns;
+    scanLineColumns.update(images.grayscaled, images.saturated, images.hued, columns);
+
+    for(std::size_t i = 0; i < columns.size(); ++i)
+    {
+      const ScanLineColumns::Column& column = columns[i];
+      for(int y = column.yMin; y < column.yMax; ++y)
+      {
+        const PixelTypes::GrayscaledPixel* p = &images.grayscaled[y][column.x];
+        ASSERT_EQ(p[-1] + 2 * p[0] + p[1], scanLineColumns.gauss3(i)[y]);
+        ASSERT_EQ(p[-2] + 2 * p[-1] + 4 * p[0] + 2 * p[1] + p[2], scanLineColumns.gauss5(i)[y]);
+        ASSERT_EQ(p[0], scanLineColumns.grayscaled(i)[y]);
+        ASSERT_EQ(images.saturated[y][column.x], scanLineColumns.saturated(i)[y]);
+        ASSERT_EQ(images.hued[y][column.x], scanLineColumns.hued(i)[y]);
+      }
+    }
+  }
+
+  /**
+   * Compares reading the columns of the scan lines from the images with reading them from
+   * their contiguous copies. It only prints timings and is therefore disabled. Run it with
+   * --gtest_also_run_disabled_tests.
+   */
+  GTEST_TEST(ScanLineColumns, DISABLED_Benchmark)
+  {
+    constexpr int runs = 100;
+    const Images images;
+    const std::vector<ScanLineColumns::Column> columns = getColumns();
+    ScanLineColumns scanLineColumns;
+
+    // Both variants read the values as the vertical scan does: the smoothed
+    // luminance for the edges and the three channels for the regions.
+    int stridedSum = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(int run = 0; run < runs; ++run)
+      for(const ScanLineColumns::Column& column : columns)
+        for(int y = column.yMin; y < column.yMax; ++y)
+        {
+          const PixelTypes::GrayscaledPixel* p = &images.grayscaled[y][column.x];
+          stridedSum += p[-2] + 2 * p[-1] + 4 * p[0] + 2 * p[1] + p[2];
+          stridedSum += p[-1] + 2 * p[0] + p[1];
+          stridedSum += p[0] + images.saturated[y][column.x] + images.hued[y][column.x];
+        }
+    const auto middle = std::chrono::high_resolution_clock::now();
+    int transposedSum = 0;
+    for(int run = 0; run < runs; ++run)
+    {
+      scanLineColumns.update(images.grayscaled, images.saturated, images.hued, columns);
+      for(std::size_t i = 0; i < columns.size(); ++i)
+      {
+        const short* gauss3 = scanLineColumns.gauss3(i);
+        const short* gauss5 = scanLineColumns.gauss5(i);
+        const PixelTypes::GrayscaledPixel* grayscaled = scanLineColumns.grayscaled(i);
+        const PixelTypes::GrayscaledPixel* saturated = scanLineColumns.saturated(i);
+        const PixelTypes::HuePixel* hued = scanLineColumns.hued(i);
+        for(int y = columns[i].yMin; y < columns[i].yMax; ++y)
+          transposedSum += gauss5[y] + gauss3[y] + grayscaled[y] + saturated[y] + hued[y];
+      }
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(stridedSum, transposedSum);
+    std::cout << "[ BENCHMARK] " << columns.size() << " columns: strided "
+              << std::chrono::duration<double, std::micro>(middle - start).count() / runs << " us, transposed "
+              << std::chrono::duration<double, std::micro>(end - middle).count() / runs << " us" << std::endl;
+  }
+}
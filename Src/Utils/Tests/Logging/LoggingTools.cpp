@@ -0,0 +1,109 @@
+#include "Tools/Logging/LoggingTools.h"
+#include "Tools/Streams/OutStreams.h"
+
+#include "gtest/gtest.h"
+#include <vector>
+
+/** Creates the index of a log file with two chunks of three and two frames logged by two threads. */
+static LoggingTools::ChunkIndex createIndex()
+{
+  LoggingTools::ChunkIndex index;
+  index.chunks = {{10, 20, 3}, {7, 7, 2}};
+  index.threads = {"Upper", "Motion"};
+  index.frames = {{0, -1}, {1, -1}, {0, 600}, {1, 599}, {0, 599}};
+  return index;
+}
+
+/** Writes a log file in the format logFileChunked with the chunks and the index. Returns the offset of the first chunk. */
+static size_t writeLog(OutBinaryMemory& log, const LoggingTools::ChunkIndex& index)
+{
+  log << static_cast<unsigned char>(LoggingTools::logFileChunked);
+  const size_t firstChunk = log.size();
+  for(const LoggingTools::ChunkIndex::Chunk& chunk : index.chunks)
+  {
+    log << chunk.size << chunk.uncompressedSize << chunk.frames;
+    const std::vector<char> data(chunk.size, 'x');
+    log.write(data.data(), data.size());
+  }
+  log << 0u;
+  LoggingTools::writeChunkIndex(log, index);
+  return firstChunk;
+}
+
+GTEST_TEST(LoggingTools, ChunkIndexRoundTrip)
+{
+  const LoggingTools::ChunkIndex index = createIndex();
+  OutBinaryMemory log(256);
+  const size_t firstChunk = writeLog(log, index);
+
+  LoggingTools::ChunkIndex read;
+  ASSERT_TRUE(LoggingTools::readChunkIndex(log.data(), log.size(), firstChunk, read));
+  ASSERT_EQ(index.chunks.size(), read.chunks.size());
+  for(size_t i = 0; i < index.chunks.size(); ++i)
+  {
+    EXPECT_EQ(index.chunks[i].size, read.chunks[i].size);
+    EXPECT_EQ(index.chunks[i].uncompressedSize, read.chunks[i].uncompressedSize);
+    EXPECT_EQ(index.chunks[i].frames, read.chunks[i].frames);
+  }
+  EXPECT_EQ(index.threads, read.threads);
+  ASSERT_EQ(index.frames.size(), read.frames.size());
+  for(size_t i = 0; i < index.frames.size(); ++i)
+  {
+    EXPECT_EQ(index.frames[i].thread, read.frames[i].thread);
+    EXPECT_EQ(index.frames[i].gcTime, read.frames[i].gcTime);
+  }
+}
+
+GTEST_TEST(LoggingTools, ChunkIndexEmpty)
+{
+  OutBinaryMemory log(64);
+  const size_t firstChunk = writeLog(log, LoggingTools::ChunkIndex());
+
+  LoggingTools::ChunkIndex read;
+  ASSERT_TRUE(LoggingTools::readChunkIndex(log.data(), log.size(), firstChunk, read));
+  EXPECT_TRUE(read.chunks.empty());
+  EXPECT_TRUE(read.threads.empty());
+  EXPECT_TRUE(read.frames.empty());
+}
+
+GTEST_TEST(LoggingTools, ChunkIndexTruncated)
+{
+  // A log file that was not closed properly ends anywhere in front of the trailing size of its index.
+  OutBinaryMemory log(256);
+  const size_t firstChunk = writeLog(log, createIndex());
+  for(size_t size = firstChunk; size < log.size(); ++size)
+  {
+    LoggingTools::ChunkIndex read;
+    EXPECT_FALSE(LoggingTools::readChunkIndex(log.data(), size, firstChunk, read)) << "size " << size;
+  }
+}
+
+GTEST_TEST(LoggingTools, ChunkIndexInconsistent)
+{
+  LoggingTools::ChunkIndex read;
+
+  // The chunks do not end at the end marker.
+  LoggingTools::ChunkIndex index = createIndex();
+  OutBinaryMemory log(256);
+  log << static_cast<unsigned char>(LoggingTools::logFileChunked);
+  log << index.chunks[0].size << index.chunks[0].uncompressedSize << index.chunks[0].frames;
+  const std::vector<char> data(index.chunks[0].size, 'x');
+  log.write(data.data(), data.size());
+  log << 0u;
+  LoggingTools::writeChunkIndex(log, index);
+  EXPECT_FALSE(LoggingTools::readChunkIndex(log.data(), log.size(), 1, read));
+
+  // The number of frames does not match the chunks.
+  index = createIndex();
+  index.frames.pop_back();
+  OutBinaryMemory log2(256);
+  writeLog(log2, index);
+  EXPECT_FALSE(LoggingTools::readChunkIndex(log2.data(), log2.size(), 1, read));
+
+  // A frame refers to a thread that does not exist.
+  index = createIndex();
+  index.frames[2].thread = 2;
+  OutBinaryMemory log3(256);
+  writeLog(log3, index);
+  EXPECT_FALSE(LoggingTools::readChunkIndex(log3.data(), log3.size(), 1, read));
+}
@@ -0,0 +1,64 @@
+#include "Tools/Logging/SnappyEncoder.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+#include <snappy-c.h>
+#include <functional>
+#include <vector>
+
+/** Compresses data, checks that the snappy library can uncompress it, and returns the compressed size. */
+static size_t checkRoundTrip(const std::vector<char>& data)
+{
+  std::vector<char> compressed(SnappyEncoder::maxCompressedLength(data.size()));
+  const size_t compressedSize = SnappyEncoder::compress(data.data(), data.size(), compressed.data());
+  EXPECT_LE(compressedSize, compressed.size());
+
+  size_t uncompressedSize = 0;
+  EXPECT_EQ(SNAPPY_OK, snappy_uncompressed_length(compressed.data(), compressedSize, &uncompressedSize));
+  EXPECT_EQ(data.size(), uncompressedSize);
+
+  std::vector<char> uncompressed(uncompressedSize + 1);
+  EXPECT_EQ(SNAPPY_OK, snappy_uncompress(compressed.data(), compressedSize, uncompressed.data(), &uncompressedSize));
+  EXPECT_EQ(data.size(), uncompressedSize);
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), uncompressed.begin()));
+  return compressedSize;
+}
+
+static std::vector<char> generate(size_t size, const std::function<char(const std::vector<char>&)>& next)
+{
+  std::vector<char> data;
+  data.reserve(size);
+  while(data.size() < size)
+    data.push_back(next(data));
+  return data;
+}
+
+GTEST_TEST(SnappyEncoder, Small)
+{
+  for(size_t size = 0; size < 40; ++size)
+    checkRoundTrip(generate(size, [](const std::vector<char>&) {return static_cast<char>(Random::uniformInt(0, 3));}));
+}
+
+GTEST_TEST(SnappyEncoder, Random)
+{
+  // Does not compress, but must not grow much.
+  const std::vector<char> data = generate(300000, [](const std::vector<char>&) {return static_cast<char>(Random::uniformInt(0, 255));});
+  EXPECT_LE(checkRoundTrip(data), data.size() + data.size() / 100);
+}
+
+GTEST_TEST(SnappyEncoder, Repetitions)
+{
+  // Long runs and repetitions across the 64 KB blocks.
+  const std::vector<char> runs = generate(200000, [](const std::vector<char>& data) {return static_cast<char>(data.size() / 1000);});
+  EXPECT_LT(checkRoundTrip(runs), runs.size() / 10);
+
+  std::vector<char> copies = generate(3000, [](const std::vector<char>&) {return static_cast<char>(Random::uniformInt(0, 255));});
+  while(copies.size() < 200000)
+  {
+    copies.push_back(static_cast<char>(Random::uniformInt(0, 255)));
+    const size_t from = copies.size() - Random::uniformInt(1, 3000);
+    for(size_t i = 0, length = Random::uniformInt(4, 100); i < length; ++i)
+      copies.push_back(copies[from + i]);
+  }
+  EXPECT_LT(checkRoundTrip(copies), copies.size() / 2);
+}
@@ -0,0 +1,45 @@
+#include "Tools/Math/BilinearGrid.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+
+GTEST_TEST(BilinearGrid, Init)
+{
+  BilinearGrid grid;
+  EXPECT_FALSE(grid.isValid());
+  grid.init(Vector2f(-5200.f, -3700.f), Vector2f(5200.f, 3700.f), 300.f);
+  EXPECT_TRUE(grid.isValid());
+  EXPECT_TRUE(grid.isInside(Vector2f(5200.f, 3700.f)));
+  EXPECT_TRUE(grid.isInside(Vector2f(5300.f, 3700.f))); // The grid is extended to the next node.
+  EXPECT_FALSE(grid.isInside(Vector2f(-5201.f, 0.f)));
+}
+
+GTEST_TEST(BilinearGrid, Interpolate)
+{
+  BilinearGrid grid;
+  grid.init(Vector2f(-4500.f, -3000.f), Vector2f(4500.f, 3000.f), 200.f);
+
+  // Bilinear functions are reproduced exactly.
+  const auto function = [](const Vector2f& point) {return 0.001f * point.x() - 0.002f * point.y() + 1e-6f * point.x() * point.y();};
+  grid.fill([&](const Vector2f& point, float& value, Vector2f& direction)
+  {
+    value = function(point);
+    direction = Vector2f(point.y(), 2.f);
+  });
+
+  for(int i = 0; i < 1000; ++i)
+  {
+    const Vector2f point(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f));
+    Vector2f direction;
+    EXPECT_NEAR(function(point), grid.value(point), 1e-3f);
+    EXPECT_NEAR(function(point), grid.value(point, direction), 1e-3f);
+    EXPECT_NEAR(point.y(), direction.x(), 1e-2f);
+    EXPECT_NEAR(2.f, direction.y(), 1e-5f);
+  }
+
+  // The nodes are hit exactly, including the last ones.
+  Vector2f direction;
+  EXPECT_FLOAT_EQ(function(Vector2f(4500.f, 3000.f)), grid.value(Vector2f(4500.f, 3000.f), direction));
+  EXPECT_FLOAT_EQ(3000.f, direction.x());
+  EXPECT_FLOAT_EQ(function(Vector2f(-4500.f, -3000.f)), grid.value(Vector2f(-4500.f, -3000.f)));
+}
@@ -0,0 +1,173 @@
+#include "Tools/Math/Delaunay.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+#include <chrono>
+#include <iostream>
+
+static const Vector2f fieldMin(-4500.f, -3000.f);
+static const Vector2f fieldMax(4500.f, 3000.f);
+
+/** Checks that the triangles are linked correctly, cover the rectangle, and satisfy the Delaunay property. */
+static void checkTriangulation(const Delaunay& delaunay)
+{
+  double area = 0.0;
+  for(unsigned t = 0; t < delaunay.numOfTriangles(); ++t)
+  {
+    const Vector2f& a = delaunay.getVertex(delaunay.getCorner(t, 0));
+    const Vector2f& b = delaunay.getVertex(delaunay.getCorner(t, 1));
+    const Vector2f& c = delaunay.getVertex(delaunay.getCorner(t, 2));
+    const double triangleArea = 0.5 * ((static_cast<double>(b.x()) - a.x()) * (static_cast<double>(c.y()) - a.y())
+                                       - (static_cast<double>(b.y()) - a.y()) * (static_cast<double>(c.x()) - a.x()));
+    EXPECT_GT(triangleArea, 0.0);
+    area += triangleArea;
+
+    for(unsigned i = 0; i < 3; ++i)
+    {
+      const unsigned u = delaunay.getNeighbor(t, i);
+      if(u == Delaunay::none)
+        continue;
+
+      // The neighbor must share the edge in the opposite direction.
+      const unsigned from = delaunay.getCorner(t, i);
+      const unsigned to = delaunay.getCorner(t, (i + 1) % 3);
+      unsigned j = 0;
+      while(j < 3 && (delaunay.getCorner(u, j) != to || delaunay.getCorner(u, (j + 1) % 3) != from))
+        ++j;
+      ASSERT_LT(j, 3u);
+      EXPECT_EQ(t, delaunay.getNeighbor(u, j));
+
+      // The opposite vertex of the neighbor must not be inside the circumcircle.
+      const Vector2f& d = delaunay.getVertex(delaunay.getCorner(u, (j + 2) % 3));
+      const Vector2f center = (Eigen::Matrix2f() << b - a, c - a).finished().transpose()
+                              .colPivHouseholderQr().solve(Eigen::Vector2f(0.5f * (b.squaredNorm() - a.squaredNorm()),
+                                                                           0.5f * (c.squaredNorm() - a.squaredNorm())));
+      EXPECT_GE((d - center).norm(), (a - center).norm() * 0.999f);
+    }
+  }
+  EXPECT_NEAR((fieldMax - fieldMin).prod(), area, 1.f);
+}
+
+GTEST_TEST(Delaunay, Rectangle)
+{
+  Delaunay delaunay;
+  delaunay.reset(fieldMin, fieldMax);
+  EXPECT_EQ(4u, delaunay.numOfVertices());
+  EXPECT_EQ(2u, delaunay.numOfTriangles());
+  checkTriangulation(delaunay);
+}
+
+GTEST_TEST(Delaunay, Insert)
+{
+  Delaunay delaunay;
+  delaunay.reset(fieldMin, fieldMax);
+
+  // Points on the border and duplicates.
+  const unsigned halfWayLine = delaunay.insert(Vector2f(0.f, fieldMax.y()));
+  EXPECT_EQ(4u, halfWayLine);
+  EXPECT_EQ(halfWayLine, delaunay.insert(Vector2f(0.f, fieldMax.y())));
+  EXPECT_EQ(0u, delaunay.insert(fieldMin));
+  EXPECT_EQ(Delaunay::none, delaunay.insert(Vector2f(fieldMax.x() + 1.f, 0.f)));
+  delaunay.insert(Vector2f(0.f, fieldMin.y()));
+  delaunay.insert(Vector2f(fieldMax.x(), 800.f));
+  delaunay.insert(Vector2f(fieldMax.x(), -800.f));
+  checkTriangulation(delaunay);
+
+  // A point on the diagonal of the rectangle.
+  delaunay.insert(Vector2f::Zero());
+  checkTriangulation(delaunay);
+
+  for(int i = 0; i < 100; ++i)
+    delaunay.insert(Vector2f(Random::uniform(fieldMin.x(), fieldMax.x()), Random::uniform(fieldMin.y(), fieldMax.y())));
+  checkTriangulation(delaunay);
+  EXPECT_EQ(109u, delaunay.numOfVertices());
+  EXPECT_EQ(2 * delaunay.numOfVertices() - 8 - 2, delaunay.numOfTriangles()); // 8 vertices are on the border
+}
+
+GTEST_TEST(Delaunay, Move)
+{
+  Delaunay delaunay;
+  delaunay.reset(fieldMin, fieldMax);
+  std::vector<unsigned> vertices;
+  for(int i = 0; i < 20; ++i)
+    vertices.push_back(delaunay.insert(Vector2f(Random::uniform(fieldMin.x(), fieldMax.x()), Random::uniform(fieldMin.y(), fieldMax.y()))));
+
+  EXPECT_FALSE(delaunay.move(0, Vector2f::Zero()));
+  EXPECT_FALSE(delaunay.move(vertices[0], Vector2f(fieldMax.x() + 1.f, 0.f)));
+
+  unsigned moved = 0;
+  for(int frame = 0; frame < 100; ++frame)
+    for(unsigned vertex : vertices)
+    {
+      const Vector2f target = delaunay.getVertex(vertex) + Vector2f(Random::normal(20.f), Random::normal(20.f));
+      const unsigned numOfTriangles = delaunay.numOfTriangles();
+      if(delaunay.move(vertex, target))
+      {
+        EXPECT_EQ(target, delaunay.getVertex(vertex));
+        ++moved;
+      }
+      EXPECT_EQ(numOfTriangles, delaunay.numOfTriangles());
+    }
+  EXPECT_GT(moved, 0u);
+  checkTriangulation(delaunay);
+}
+
+/**
+ * Compares rebuilding the triangulation of typical obstacles every frame with moving them.
+ * It only prints timings and is therefore disabled. Run it with --gtest_also_run_disabled_tests.
+ */
+GTEST_TEST(Delaunay, DISABLED_Benchmark)
+{
+  constexpr int frames = 1000;
+  constexpr int obstacles = 20;
+
+  std::vector<Vector2f> positions;
+  for(int i = 0; i < obstacles; ++i)
+    positions.emplace_back(Random::uniform(-4000.f, 4000.f), Random::uniform(-2500.f, 2500.f));
+  std::vector<std::vector<Vector2f>> trajectory;
+  for(int frame = 0; frame < frames; ++frame)
+  {
+    for(Vector2f& position : positions)
+      position = (position + Vector2f(Random::normal(5.f), Random::normal(5.f))).cwiseMax(-fieldMax).cwiseMin(fieldMax);
+    trajectory.push_back(positions);
+  }
+
+  Delaunay delaunay;
+  const auto rebuild = [&](const std::vector<Vector2f>& positions, std::vector<unsigned>& vertices)
+  {
+    delaunay.reset(fieldMin, fieldMax);
+    delaunay.insert(Vector2f(0.f, fieldMin.y()));
+    delaunay.insert(Vector2f(0.f, fieldMax.y()));
+    delaunay.insert(Vector2f(fieldMax.x(), -800.f));
+    delaunay.insert(Vector2f(fieldMax.x(), 800.f));
+    vertices.clear();
+    for(const Vector2f& position : positions)
+      vertices.push_back(delaunay.insert(position));
+  };
+
+  std::vector<unsigned> vertices;
+  auto start = std::chrono::steady_clock::now();
+  for(const std::vector<Vector2f>& positions : trajectory)
+    rebuild(positions, vertices);
+  const auto rebuildTime = std::chrono::steady_clock::now() - start;
+  checkTriangulation(delaunay);
+
+  unsigned rebuilds = 0;
+  rebuild(trajectory.front(), vertices);
+  start = std::chrono::steady_clock::now();
+  for(const std::vector<Vector2f>& positions : trajectory)
+    for(std::size_t i = 0; i < positions.size(); ++i)
+      if(!delaunay.move(vertices[i], positions[i]))
+      {
+        rebuild(positions, vertices);
+        ++rebuilds;
+        break;
+      }
+  const auto moveTime = std::chrono::steady_clock::now() - start;
+  checkTriangulation(delaunay);
+
+  std::cout << "[ BENCHMARK] " << obstacles << " obstacles: rebuild "
+            << std::chrono::duration<double, std::micro>(rebuildTime).count() / frames << " us/frame, move "
+            << std::chrono::duration<double, std::micro>(moveTime).count() / frames << " us/frame ("
+            << rebuilds << " rebuilds)" << std::endl;
+}
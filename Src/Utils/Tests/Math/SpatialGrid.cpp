@@ -0,0 +1,66 @@
+#include "Tools/Math/SpatialGrid.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+
+GTEST_TEST(SpatialGrid, Empty)
+{
+  SpatialGrid grid;
+  grid.clear(100.f);
+  EXPECT_TRUE(grid.query(Vector2f::Zero()).empty());
+  grid.build();
+  EXPECT_TRUE(grid.query(Vector2f::Zero()).empty());
+}
+
+GTEST_TEST(SpatialGrid, ContainsAllRectangles)
+{
+  struct Rectangle
+  {
+    Vector2f min;
+    Vector2f max;
+  };
+  std::vector<Rectangle> rectangles;
+  for(int i = 0; i < 50; ++i)
+  {
+    const Vector2f center(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f));
+    const Vector2f size(Random::uniform(0.f, 3000.f), Random::uniform(0.f, 1000.f));
+    rectangles.push_back({center - size, center + size});
+  }
+
+  SpatialGrid grid;
+  grid.clear(250.f);
+  // Add in reverse order to check that the results are sorted nevertheless.
+  for(int i = static_cast<int>(rectangles.size()) - 1; i >= 0; --i)
+    grid.add(i, rectangles[i].min, rectangles[i].max);
+  grid.build();
+
+  const auto check = [&](const Vector2f& point)
+  {
+    const SpatialGrid::Items items = grid.query(point);
+    EXPECT_TRUE(std::is_sorted(items.begin(), items.end()));
+    for(int i = 0; i < static_cast<int>(rectangles.size()); ++i)
+    {
+      if(point.x() >= rectangles[i].min.x() && point.y() >= rectangles[i].min.y() &&
+         point.x() <= rectangles[i].max.x() && point.y() <= rectangles[i].max.y())
+      {
+        EXPECT_NE(items.end(), std::find(items.begin(), items.end(), i)) << "Missing rectangle " << i;
+      }
+    }
+  };
+
+  for(int i = 0; i < 10000; ++i)
+    check(Vector2f(Random::uniform(-8000.f, 8000.f), Random::uniform(-5000.f, 5000.f)));
+
+  // The corners of the rectangles are inside.
+  for(const Rectangle& rectangle : rectangles)
+  {
+    check(rectangle.min);
+    check(rectangle.max);
+    check(Vector2f(rectangle.min.x(), rectangle.max.y()));
+    check(Vector2f(rectangle.max.x(), rectangle.min.y()));
+  }
+
+  // Far away, there is nothing.
+  EXPECT_TRUE(grid.query(Vector2f(20000.f, 0.f)).empty());
+  EXPECT_TRUE(grid.query(Vector2f(0.f, -20000.f)).empty());
+}
@@ -0,0 +1,48 @@
+#include "Tools/MemoizedFunction.h"
+#include "Tools/Math/Eigen.h"
+
+#include "gtest/gtest.h"
+
+GTEST_TEST(MemoizedFunction, CachesPerFrame)
+{
+  int calls = 0;
+  MemoizedFunction<float(const Vector2f&, bool)> memoized("distance");
+  FunctionImpl::Function<float(const Vector2f&, bool)> function = memoized.bind(100, [&calls](const Vector2f& point, bool squared)
+  {
+    ++calls;
+    return squared ? point.squaredNorm() : point.norm();
+  });
+
+  EXPECT_EQ(5.f, function(Vector2f(3.f, 4.f), false));
+  EXPECT_EQ(25.f, function(Vector2f(3.f, 4.f), true));
+  EXPECT_EQ(5.f, function(Vector2f(3.f, 4.f), false));
+  EXPECT_EQ(2, calls);
+
+  // The same frame keeps the results, even if the function is bound again.
+  function = memoized.bind(100, [&calls](const Vector2f&, bool) {++calls; return 0.f;});
+  EXPECT_EQ(5.f, function(Vector2f(3.f, 4.f), false));
+  EXPECT_EQ(2, calls);
+
+  // A new frame computes them again.
+  function = memoized.bind(120, [&calls](const Vector2f&, bool) {++calls; return 0.f;});
+  EXPECT_EQ(0.f, function(Vector2f(3.f, 4.f), false));
+  EXPECT_EQ(3, calls);
+
+  EXPECT_STREQ("distance", memoized.getName());
+  EXPECT_EQ(2u, memoized.getStatistics().hits);
+  EXPECT_EQ(3u, memoized.getStatistics().misses);
+}
+
+GTEST_TEST(MemoizedFunction, MaxEntries)
+{
+  int calls = 0;
+  MemoizedFunction<int(int)> memoized("square", 2);
+  const FunctionImpl::Function<int(int)> function = memoized.bind(0, [&calls](int x) {++calls; return x * x;});
+  for(int i = 0; i < 2; ++i)
+    for(int x = 1; x <= 3; ++x)
+      EXPECT_EQ(x * x, function(x));
+
+  // Only the first two arguments were cached.
+  EXPECT_EQ(4, calls);
+  EXPECT_EQ(2u, memoized.getStatistics().hits);
+}
@@ -0,0 +1,74 @@
+#include "Tools/Modeling/UKFPose2DBatch.h"
+#include "Tools/Math/Random.h"
+
+#include "gtest/gtest.h"
+
+/** Fills a batch with random states that have correlated covariances and returns a random odometry for each. */
+static std::vector<Pose2f> initRandomly(UKFPose2DBatch& batch, int size)
+{
+  batch.resize(size);
+  std::vector<Pose2f> odometryOffsets(size);
+  for(int i = 0; i < size; ++i)
+  {
+    batch.init(i, Pose2f(Random::uniform(-pi, pi), Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f)),
+               Pose2f(Random::uniform(0.f, 0.5f), Random::uniform(0.f, 500.f), Random::uniform(0.f, 500.f)));
+    odometryOffsets[i] = Pose2f(Random::uniform(-0.1f, 0.1f), Random::uniform(-20.f, 40.f), Random::uniform(-20.f, 20.f));
+  }
+
+  // Correlate the dimensions by a few updates.
+  for(int i = 0; i < 3; ++i)
+    batch.motionUpdate(odometryOffsets, Pose2f(0.002f, 2.f, 2.f), Pose2f(0.3f, 0.2f, 0.2f), Vector2f(0.002f, 0.002f));
+  return odometryOffsets;
+}
+
+GTEST_TEST(UKFPose2DBatch, MotionUpdateMatchesSingleFilters)
+{
+  UKFPose2DBatch batch;
+  const std::vector<Pose2f> odometryOffsets = initRandomly(batch, 50);
+  const Pose2f filterProcessDeviation(0.002f, 2.f, 2.f);
+  const Pose2f odometryDeviation(0.3f, 0.2f, 0.2f);
+  const Vector2f odometryRotationDeviation(0.002f, 0.002f);
+
+  std::vector<UKFPose2D> filters(batch.size());
+  for(int i = 0; i < batch.size(); ++i)
+  {
+    batch.get(i, filters[i]);
+    EXPECT_TRUE(filters[i].getPose().translation.isApprox(batch.getPose(i).translation));
+    EXPECT_TRUE(filters[i].getCov().isApprox(batch.getCov(i)));
+  }
+
+  for(int frame = 0; frame < 10; ++frame)
+  {
+    batch.motionUpdate(odometryOffsets, filterProcessDeviation, odometryDeviation, odometryRotationDeviation);
+    for(int i = 0; i < batch.size(); ++i)
+      filters[i].motionUpdate(odometryOffsets[i], filterProcessDeviation, odometryDeviation, odometryRotationDeviation);
+  }
+
+  for(int i = 0; i < batch.size(); ++i)
+  {
+    const Pose2f pose = batch.getPose(i);
+    EXPECT_NEAR(filters[i].getPose().translation.x(), pose.translation.x(), 0.1f);
+    EXPECT_NEAR(filters[i].getPose().translation.y(), pose.translation.y(), 0.1f);
+    EXPECT_NEAR(0.f, Angle::normalize(filters[i].getPose().rotation - pose.rotation), 1e-4f);
+    const Matrix3f cov = batch.getCov(i);
+    for(int row = 0; row < 3; ++row)
+      for(int column = 0; column < 3; ++column)
+        EXPECT_NEAR(filters[i].getCov()(row, column), cov(row, column), 1e-3f * std::sqrt(cov(row, row) * cov(column, column)));
+  }
+}
+
+GTEST_TEST(UKFPose2DBatch, CopyAndSet)
+{
+  UKFPose2DBatch batch, other;
+  initRandomly(batch, 4);
+  initRandomly(other, 4);
+  batch.copy(0, other, 3);
+  EXPECT_EQ(other.getCov(3), batch.getCov(0));
+  EXPECT_EQ(other.getPose(3).translation, batch.getPose(0).translation);
+
+  UKFPose2D filter;
+  batch.get(1, filter);
+  other.set(2, filter);
+  EXPECT_EQ(batch.getCov(1), other.getCov(2));
+  EXPECT_EQ(batch.getPose(1).rotation, other.getPose(2).rotation);
+}
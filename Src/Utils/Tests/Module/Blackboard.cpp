@@ -0,0 +1,53 @@
+#include "Tools/Module/Blackboard.h"
+#include "Utils/Tests/TestModules.h"
+
+#include "gtest/gtest.h"
+
+GTEST_TEST(Blackboard, IndicesAssignedDuringStaticInitialization)
+{
+  // The test modules require and provide A, B, C, and D.
+  const std::size_t a = Blackboard::findIndex("A");
+  const std::size_t b = Blackboard::findIndex("B");
+  EXPECT_NE(Blackboard::npos, a);
+  EXPECT_NE(Blackboard::npos, b);
+  EXPECT_NE(a, b);
+  EXPECT_STREQ("A", Blackboard::getName(a));
+  EXPECT_EQ(a, Blackboard::getIndex("A"));
+  EXPECT_EQ(a, Blackboard::getIndex<A>("A"));
+}
+
+GTEST_TEST(Blackboard, AccessByNameAndIndex)
+{
+  Blackboard blackboard;
+  const std::size_t c = Blackboard::getIndex<C>("C");
+
+  EXPECT_FALSE(blackboard.exists("C"));
+  EXPECT_FALSE(blackboard.exists(c));
+
+  C& first = blackboard.alloc<C>("C");
+  first.a = 42;
+  C& second = blackboard.alloc<C>(c);
+  EXPECT_EQ(&first, &second);
+  EXPECT_TRUE(blackboard.exists("C"));
+  EXPECT_EQ(&first, &blackboard[c]);
+  EXPECT_EQ(&first, &blackboard["C"]);
+
+  blackboard.free(c);
+  EXPECT_TRUE(blackboard.exists(c));
+  blackboard.free("C");
+  EXPECT_FALSE(blackboard.exists(c));
+}
+
+GTEST_TEST(Blackboard, NamesUnknownAtStaticInitialization)
+{
+  Blackboard blackboard;
+  EXPECT_EQ(Blackboard::npos, Blackboard::findIndex("NotARepresentation"));
+  EXPECT_FALSE(blackboard.exists("NotARepresentation"));
+
+  // Indices assigned later extend blackboards that already exist.
+  const std::size_t index = Blackboard::getIndex("LateRepresentation");
+  EXPECT_EQ(index, Blackboard::findIndex("LateRepresentation"));
+  D& d = blackboard.alloc<D>(index);
+  EXPECT_EQ(&d, &blackboard["LateRepresentation"]);
+  blackboard.free(index);
+}
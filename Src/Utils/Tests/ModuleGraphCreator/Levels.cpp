@@ -0,0 +1,77 @@
+/**
+ * @file Tools/ModuleGraphCreator/Levels.cpp
+ *
+ * This file implements tests for the dependency levels of providers.
+ */
+
+#include "Utils/Tests/ModuleGraphCreator/ModuleGraphCreatorTest.h"
+
+#include <gtest/gtest.h>
+#include <unordered_map>
+
+/*
+ * Require:
+ * Ac: -> A
+ * Bc: -> B
+ * Cc: A -> B
+ * Dc: -> C
+ * Ec: A,B -> C
+ * Fc: (C) -> D
+ * Cm: A,C -> A,B
+ */
+
+/**
+ * The function determines the dependency levels of all providers of a single thread.
+ * @param providers The providers of the thread.
+ * @return The level of each representation provided.
+ */
+static std::unordered_map<std::string, unsigned> calcLevels(const std::vector<Configuration::RepresentationProvider>& providers)
+{
+  FunctionList::execute();
+  const Configuration config = createConfig({providers});
+  ModuleGraphCreator moduleGraphCreator(config);
+  Blackboard blackboard;
+  OutBinaryMemory out(100);
+  out << config;
+  InBinaryMemory in(out.data());
+  EXPECT_TRUE(moduleGraphCreator.update(in));
+
+  const ModuleGraphCreator::ExecutionValues values = moduleGraphCreator.getExecutionValues(0);
+  EXPECT_EQ(values.providers.size(), values.levels.size());
+  std::unordered_map<std::string, unsigned> levels;
+  for(std::size_t i = 0; i < values.providers.size(); ++i)
+    levels[values.providers[i].representation] = values.levels[i];
+  return levels;
+}
+
+GTEST_TEST(ModuleGraphCreatorLevels, independentProviders)
+{
+  auto levels = calcLevels({{"A", "Ac"}, {"B", "Bc"}, {"C", "Ec"}});
+  EXPECT_EQ(0u, levels["A"]);
+  EXPECT_EQ(0u, levels["B"]);
+  EXPECT_EQ(1u, levels["C"]);
+}
+
+GTEST_TEST(ModuleGraphCreatorLevels, chain)
+{
+  auto levels = calcLevels({{"A", "Ac"}, {"B", "Cc"}, {"C", "Ec"}});
+  EXPECT_EQ(0u, levels["A"]);
+  EXPECT_EQ(1u, levels["B"]);
+  EXPECT_EQ(2u, levels["C"]);
+}
+
+GTEST_TEST(ModuleGraphCreatorLevels, sameModule)
+{
+  // Cm requires the representation it provides itself, which is allowed.
+  auto levels = calcLevels({{"A", "Cm"}, {"B", "Cm"}, {"C", "Dc"}});
+  EXPECT_EQ(0u, levels["C"]);
+  EXPECT_EQ(1u, levels["A"]);
+  EXPECT_EQ(2u, levels["B"]);
+}
+
+GTEST_TEST(ModuleGraphCreatorLevels, uses)
+{
+  // No execution order is required, but the two providers must not run concurrently.
+  auto levels = calcLevels({{"C", "Dc"}, {"D", "Fc"}});
+  EXPECT_NE(levels["C"], levels["D"]);
+}
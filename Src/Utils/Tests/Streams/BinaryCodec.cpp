@@ -0,0 +1,157 @@
+#include "Tools/Math/Angle.h"
+#include "Tools/Math/Eigen.h"
+#include "Tools/Math/Random.h"
+#include "Tools/Streams/AutoStreamable.h"
+#include "Tools/Streams/Enum.h"
+#include "Tools/Streams/InStreams.h"
+#include "Tools/Streams/OutStreams.h"
+
+#include "gtest/gtest.h"
+#include <cstring>
+
+namespace BinaryCodecTest
+{
+  ENUM(Color,
+  {,
+    red,
+    green,
+    blue,
+  });
+
+  STREAMABLE(Inner,
+  {,
+    (short) s,
+    (Vector2f) v,
+  });
+
+  STREAMABLE(Fixed,
+  {
+    int reads = 0; /**< Counts the calls of onRead. */
+    void onRead() {++reads;},
+
+    (bool) flag,
+    (Color) color,
+    (Angle) angle,
+    (Vector2f) position,
+    (Matrix3f) covariance,
+    (int[3]) counts,
+    (std::array<unsigned char, 2>) bytes,
+    (Inner) inner,
+  });
+
+  STREAMABLE_WITH_BASE(Derived, Fixed,
+  {,
+    (double) weight,
+  });
+
+  STREAMABLE(Variable,
+  {,
+    (float) value,
+    (std::vector<Vector2f>) points,
+  });
+
+  static_assert(Streaming::BinaryCodec<Inner>::fixed && Streaming::BinaryCodec<Inner>::size == 10);
+  static_assert(Streaming::BinaryCodec<Fixed>::fixed && Streaming::BinaryCodec<Fixed>::size == 1 + 1 + 4 + 8 + 36 + 12 + 2 + 10);
+  static_assert(Streaming::BinaryCodec<Derived>::fixed && Streaming::BinaryCodec<Derived>::size == Streaming::BinaryCodec<Fixed>::size + 8);
+  static_assert(!Streaming::BinaryCodec<Variable>::fixed);
+
+  static void randomize(Fixed& f)
+  {
+    f.flag = Random::bernoulli();
+    f.color = static_cast<Color>(Random::uniformInt(0, numOfColors - 1));
+    f.angle = Random::uniform(-pi, pi);
+    f.position = Vector2f::Random();
+    f.covariance = Matrix3f::Random();
+    for(int& count : f.counts)
+      count = Random::uniformInt(-1000, 1000);
+    f.bytes = {{static_cast<unsigned char>(Random::uniformInt(0, 255)), static_cast<unsigned char>(Random::uniformInt(0, 255))}};
+    f.inner.s = static_cast<short>(Random::uniformInt(-1000, 1000));
+    f.inner.v = Vector2f::Random();
+  }
+
+  /** Writes all attributes individually, i.e. the way the streams did without the codecs. */
+  static void writeFields(Out& stream, const Fixed& f)
+  {
+    stream << f.flag << f.color << static_cast<float>(f.angle) << f.position.x() << f.position.y();
+    for(int i = 0; i < 9; ++i)
+      stream << f.covariance.data()[i];
+    stream << f.counts[0] << f.counts[1] << f.counts[2] << f.bytes[0] << f.bytes[1]
+           << f.inner.s << f.inner.v.x() << f.inner.v.y();
+  }
+
+  static void expectEqual(const Fixed& a, const Fixed& b)
+  {
+    EXPECT_EQ(a.flag, b.flag);
+    EXPECT_EQ(a.color, b.color);
+    EXPECT_EQ(static_cast<float>(a.angle), static_cast<float>(b.angle));
+    EXPECT_TRUE(a.position == b.position);
+    EXPECT_TRUE(a.covariance == b.covariance);
+    EXPECT_TRUE(std::equal(a.counts, a.counts + 3, b.counts));
+    EXPECT_EQ(a.bytes, b.bytes);
+    EXPECT_EQ(a.inner.s, b.inner.s);
+    EXPECT_TRUE(a.inner.v == b.inner.v);
+  }
+
+  GTEST_TEST(BinaryCodec, SameBytesAsFieldByField)
+  {
+    Derived d;
+    randomize(d);
+    d.weight = Random::uniform(0.0, 1.0);
+
+    OutBinaryMemory encoded;
+    encoded << d;
+    OutBinaryMemory expected;
+    writeFields(expected, d);
+    expected << d.weight;
+
+    ASSERT_EQ(expected.size(), Streaming::BinaryCodec<Derived>::size);
+    ASSERT_EQ(expected.size(), encoded.size());
+    EXPECT_EQ(0, std::memcmp(expected.data(), encoded.data(), encoded.size()));
+  }
+
+  GTEST_TEST(BinaryCodec, RoundTrip)
+  {
+    Derived d;
+    randomize(d);
+    d.weight = Random::uniform(0.0, 1.0);
+    OutBinaryMemory out;
+    out << d;
+
+    Derived read;
+    InBinaryMemory in(out.data(), out.size());
+    in >> read;
+    expectEqual(d, read);
+    EXPECT_EQ(d.weight, read.weight);
+
+    // Text streams still stream each attribute.
+    OutMapMemory map;
+    map << d;
+    Derived fromMap;
+    InMapMemory inMap(map.data(), map.size());
+    inMap >> fromMap;
+    EXPECT_EQ(d.color, fromMap.color);
+    EXPECT_EQ(d.counts[2], fromMap.counts[2]);
+    EXPECT_NEAR(d.inner.v.x(), fromMap.inner.v.x(), 1e-5f);
+
+    // onRead is called as often as when streaming each attribute.
+    EXPECT_GE(read.reads, 1);
+    EXPECT_EQ(fromMap.reads, read.reads);
+  }
+
+  GTEST_TEST(BinaryCodec, VariableSize)
+  {
+    Variable v;
+    v.value = 1.5f;
+    for(int i = 0; i < 100; ++i)
+      v.points.emplace_back(Vector2f::Random());
+    OutBinaryMemory out;
+    out << v;
+    EXPECT_EQ(sizeof(float) + sizeof(unsigned) + 100 * 2 * sizeof(float), out.size());
+
+    Variable read;
+    InBinaryMemory in(out.data(), out.size());
+    in >> read;
+    EXPECT_EQ(v.value, read.value);
+    EXPECT_TRUE(v.points == read.points);
+  }
+}
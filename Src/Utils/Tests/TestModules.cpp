@@ -13,6 +13,7 @@ MAKE_MODULE(Bc, infrastructure);
 MAKE_MODULE(Cc, infrastructure);
 MAKE_MODULE(Dc, infrastructure);
 MAKE_MODULE(Ec, infrastructure);
+MAKE_MODULE(Fc, infrastructure);
 
 MAKE_MODULE(Am, infrastructure);
 MAKE_MODULE(Bm, infrastructure);
@@ -3,12 +3,13 @@
  *
  * This file declares a series of test modules and representations.
  *
- * Module: REQUIRES -> PROVIDES
+ * Module: REQUIRES (USES) -> PROVIDES
  * Ac: -> A
  * Bc: -> B
  * Cc: A -> B
  * Dc: -> C
  * Ec: A,B -> C
+ * Fc: (C) -> D
  *
  * Am: C -> D
  * Bm: B -> A
@@ -98,6 +99,18 @@ protected:
   void update(C&) override {}
 };
 
+MODULE(Fc,
+{,
+  USES(C),
+  PROVIDES(D),
+});
+
+class Fc : public FcBase
+{
+protected:
+  void update(D&) override {}
+};
+
 // Motion
 MODULE(Am,
 {,
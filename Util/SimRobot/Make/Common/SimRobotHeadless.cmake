@@ -0,0 +1,17 @@
+set(SIMROBOTHEADLESS_ROOT_DIR "${SIMROBOT_PREFIX}/Src/SimRobotHeadless")
+
+file(GLOB SIMROBOTHEADLESS_SOURCES "${SIMROBOTHEADLESS_ROOT_DIR}/*.cpp" "${SIMROBOTHEADLESS_ROOT_DIR}/*.h")
+
+add_executable(SimRobotHeadless "${SIMROBOTHEADLESS_SOURCES}")
+
+# The modules are searched relative to the executable, i.e. next to the one of SimRobot.
+set_property(TARGET SimRobotHeadless PROPERTY RUNTIME_OUTPUT_DIRECTORY "${SIMROBOT_OUTPUT_DIR}")
+set_property(TARGET SimRobotHeadless PROPERTY XCODE_GENERATE_SCHEME ON)
+
+target_include_directories(SimRobotHeadless PRIVATE "${SIMROBOTHEADLESS_ROOT_DIR}" "${SIMROBOT_ROOT_DIR}")
+target_link_libraries(SimRobotHeadless PRIVATE Qt5::Core Qt5::Gui Qt5::Widgets)
+add_dependencies(SimRobotHeadless SimRobot SimRobotCore2 SimRobotCore2D ${SIMROBOT_CONTROLLERS})
+
+target_link_libraries(SimRobotHeadless PRIVATE Flags::Default)
+
+source_group(TREE "${SIMROBOTHEADLESS_ROOT_DIR}" FILES ${SIMROBOTHEADLESS_SOURCES})
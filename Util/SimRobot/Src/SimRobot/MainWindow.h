@@ -88,6 +88,7 @@ private:
   int guiUpdateRate = 100;
   unsigned int lastGuiUpdate = 0;
   QString filePath; /**< the path to the currently opened file */
+  QStringList arguments; /**< the arguments for the modules (always empty) */
 
   class RegisteredModule
   {
@@ -132,6 +133,7 @@ private:
   const QString& getAppPath() const override {return appPath;}
   QSettings& getSettings() override {return settings;}
   QSettings& getLayoutSettings() override {return layoutSettings;}
+  const QStringList& getArguments() const override {return arguments;}
 
   void closeEvent(QCloseEvent* event) override;
   void timerEvent(QTimerEvent* event) override;
@@ -7,6 +7,7 @@
 #pragma once
 
 class QString;
+class QStringList;
 template<typename T> class QVector;
 class QIcon;
 class QMenu;
@@ -156,6 +157,7 @@ namespace SimRobot
     virtual const QString& getAppPath() const = 0;
     virtual QSettings& getSettings() = 0;
     virtual QSettings& getLayoutSettings() = 0;
+    virtual const QStringList& getArguments() const = 0; /**< Arguments for the modules from the command line (only passed by the headless runner) */
     virtual bool isSimRunning() = 0;
     virtual void simReset() = 0;
     virtual void simStart() = 0;
@@ -0,0 +1,245 @@
+/**
+ * @file SimRobotHeadless/HeadlessApplication.cpp
+ * Implementation of an implementation of the SimRobot interface that runs a scene without a GUI
+ */
+
+#include "HeadlessApplication.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QVector>
+#include <iostream>
+
+HeadlessApplication::HeadlessApplication(const QString& appPath, const QStringList& arguments) :
+  appPath(appPath),
+  arguments(arguments),
+  settings("B-Human", "SimRobotHeadless"),
+  layoutSettings("B-Human", "SimRobotHeadless/Layouts")
+{}
+
+HeadlessApplication::~HeadlessApplication()
+{
+  // the scene graph is gone before the modules are deleted (as in the GUI)
+  for(RegisteredObject* registeredObject : registeredObjectsByObject)
+    delete registeredObject;
+  registeredObjectsByObject.clear();
+  registeredObjectsByKindAndName.clear();
+
+  qDeleteAll(statusLabels);
+  statusLabels.clear();
+
+  // unload all modules in reverse order
+  for(auto loadedModule = loadedModules.rbegin(); loadedModule != loadedModules.rend(); ++loadedModule)
+  {
+    delete (*loadedModule)->module;
+    (*loadedModule)->unload();
+    delete *loadedModule;
+  }
+  loadedModules.clear();
+  loadedModulesByName.clear();
+}
+
+bool HeadlessApplication::openFile(const QString& fileName)
+{
+  QFileInfo fileInfo(fileName);
+  if(!fileInfo.exists())
+  {
+    showWarning("SimRobotHeadless", QString("Cannot open file %1.").arg(fileName));
+    return false;
+  }
+  filePath = fileInfo.absoluteDir().canonicalPath() + '/' + fileInfo.fileName();
+  layoutSettings.beginGroup(fileInfo.baseName());
+
+  if(!loadModule(fileInfo.suffix() == "ros2d" ? "SimRobotCore2D" : "SimRobotCore2") || !compileModules())
+    return false;
+
+  running = true;
+  return true;
+}
+
+unsigned HeadlessApplication::run(unsigned maxSteps)
+{
+  unsigned steps = 0;
+  while(running && (!maxSteps || steps < maxSteps))
+  {
+    for(LoadedModule* loadedModule : loadedModules)
+      loadedModule->module->update();
+    ++steps;
+
+    // there is no event loop, but modules may still post events
+    QCoreApplication::processEvents();
+  }
+  return steps;
+}
+
+bool HeadlessApplication::compileModules()
+{
+  if(compiled)
+    return true;
+
+  bool success = true;
+  for(int i = 0; i < loadedModules.count(); ++i) // note: list of modules may grow while compiling modules
+  {
+    LoadedModule* loadedModule = loadedModules[i];
+    if(!loadedModule->compiled)
+    {
+      loadedModule->compiled = loadedModule->module->compile();
+      if(!loadedModule->compiled)
+        success = false;
+    }
+  }
+  if(!success)
+    return false;
+
+  compiled = true;
+
+  // link modules
+  for(LoadedModule* loadedModule : loadedModules)
+    loadedModule->module->link();
+  return true;
+}
+
+bool HeadlessApplication::loadModule(const QString& name)
+{
+  if(loadedModulesByName.contains(name))
+    return true; // already loaded
+
+#ifdef WINDOWS
+  const QString& moduleName = name;
+#elif defined MACOS
+  QString moduleName = QFileInfo(appPath).path() + "/SimRobot.app/Contents/lib/" + name;
+#else
+  QString moduleName = QFileInfo(appPath).path() + "/lib" + name + ".so";
+#endif
+  LoadedModule* loadedModule = new LoadedModule(moduleName);
+  loadedModule->createModule = reinterpret_cast<LoadedModule::CreateModuleProc>(loadedModule->resolve("createModule"));
+  if(!loadedModule->createModule)
+  {
+    showWarning("SimRobotHeadless", loadedModule->errorString());
+    loadedModule->unload();
+    delete loadedModule;
+    return false;
+  }
+  loadedModule->module = loadedModule->createModule(*this);
+  Q_ASSERT(loadedModule->module);
+  loadedModulesByName.insert(name, loadedModule);
+  loadedModules.append(loadedModule);
+  return true;
+}
+
+bool HeadlessApplication::registerObject(const SimRobot::Module&, SimRobot::Object& object, const SimRobot::Object* parent, int)
+{
+  RegisteredObject* parentObject = parent ? registeredObjectsByObject.value(parent) : nullptr;
+  RegisteredObject* newObject = new RegisteredObject(&object, parentObject);
+  if(parentObject)
+    parentObject->children.append(newObject);
+
+  registeredObjectsByObject.insert(&object, newObject);
+  registeredObjectsByKindAndName[object.getKind()].insert(newObject->fullName, newObject);
+  return true;
+}
+
+bool HeadlessApplication::unregisterObject(const SimRobot::Object& object)
+{
+  RegisteredObject* registeredObject = registeredObjectsByObject.value(&object);
+  if(!registeredObject)
+    return false;
+  if(registeredObject->parent)
+    registeredObject->parent->children.removeOne(registeredObject);
+  deleteRegisteredObject(registeredObject);
+  return true;
+}
+
+void HeadlessApplication::deleteRegisteredObject(RegisteredObject* registeredObject)
+{
+  for(RegisteredObject* child : registeredObject->children)
+    deleteRegisteredObject(child);
+  registeredObjectsByObject.remove(registeredObject->object);
+  const int kind = registeredObject->object->getKind();
+  auto registeredObjectsByName = registeredObjectsByKindAndName.find(kind);
+  if(registeredObjectsByName != registeredObjectsByKindAndName.end())
+  {
+    registeredObjectsByName->remove(registeredObject->fullName);
+    if(registeredObjectsByName->isEmpty())
+      registeredObjectsByKindAndName.erase(registeredObjectsByName);
+  }
+  delete registeredObject;
+}
+
+SimRobot::Object* HeadlessApplication::resolveObject(const QString& fullName, int kind)
+{
+  for(auto i = kind ? registeredObjectsByKindAndName.find(kind) : registeredObjectsByKindAndName.begin(); i != registeredObjectsByKindAndName.end(); ++i)
+  {
+    const RegisteredObject* object = i->value(fullName);
+    if(object)
+      return object->object;
+
+    if(kind)
+      break;
+  }
+  return nullptr;
+}
+
+SimRobot::Object* HeadlessApplication::resolveObject(const QVector<QString>& parts, const SimRobot::Object* parent, int kind)
+{
+  const int partsCount = parts.count();
+  if(partsCount <= 0)
+    return nullptr;
+  const QString& lastPart = parts.at(partsCount - 1);
+  for(auto i = kind ? registeredObjectsByKindAndName.find(kind) : registeredObjectsByKindAndName.begin(); i != registeredObjectsByKindAndName.end(); ++i)
+  {
+    for(const RegisteredObject* object : *i)
+    {
+      if(!object->fullName.endsWith(lastPart))
+        continue;
+
+      // all other parts must be found in this order among the ancestors
+      const RegisteredObject* currentObject = object;
+      for(int j = partsCount - 2; j >= 0 && currentObject; --j)
+        for(currentObject = currentObject->parent; currentObject && !currentObject->fullName.endsWith(parts.at(j));)
+          currentObject = currentObject->parent;
+      if(currentObject && parent)
+        for(currentObject = currentObject->parent; currentObject && currentObject->object != parent;)
+          currentObject = currentObject->parent;
+      if(currentObject)
+        return object->object;
+    }
+
+    if(kind)
+      break;
+  }
+  return nullptr;
+}
+
+int HeadlessApplication::getObjectChildCount(const SimRobot::Object& object)
+{
+  const RegisteredObject* registeredObject = registeredObjectsByObject.value(&object);
+  return registeredObject ? registeredObject->children.count() : 0;
+}
+
+SimRobot::Object* HeadlessApplication::getObjectChild(const SimRobot::Object& object, int index)
+{
+  const RegisteredObject* registeredObject = registeredObjectsByObject.value(&object);
+  return registeredObject && index >= 0 && index < registeredObject->children.count() ? registeredObject->children[index]->object : nullptr;
+}
+
+bool HeadlessApplication::addStatusLabel(const SimRobot::Module&, SimRobot::StatusLabel* statusLabel)
+{
+  if(!statusLabel)
+    return false;
+  statusLabels.append(statusLabel);
+  return true;
+}
+
+bool HeadlessApplication::selectObject(const SimRobot::Object& object)
+{
+  for(LoadedModule* loadedModule : loadedModules)
+    loadedModule->module->selectedObject(object);
+  return true;
+}
+
+void HeadlessApplication::showWarning(const QString& title, const QString& message)
+{
+  std::cerr << title.toUtf8().constData() << ": " << message.toUtf8().constData() << std::endl;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file SimRobotHeadless/HeadlessApplication.h
+ * Declaration of an implementation of the SimRobot interface that runs a scene without a GUI
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QLibrary>
+#include <QList>
+#include <QSettings>
+#include <QStringList>
+
+#include "SimRobot.h"
+
+/**
+ * An implementation of the SimRobot application interface that does not create any
+ * widgets. It loads the modules for a scene and updates them as fast as possible
+ * until a module stops the simulation.
+ */
+class HeadlessApplication : public SimRobot::Application
+{
+public:
+  /**
+   * Constructor
+   * @param appPath The path to the executable of the application
+   * @param arguments The arguments for the modules (see SimRobot::Application::getArguments)
+   */
+  HeadlessApplication(const QString& appPath, const QStringList& arguments);
+
+  /** Destructor. Unloads all modules. */
+  ~HeadlessApplication();
+
+  /**
+   * Loads and compiles the modules for a scene
+   * @param fileName The name of the scene file (.ros2 or .ros2d)
+   * @return Whether the scene was loaded successfully
+   */
+  bool openFile(const QString& fileName);
+
+  /**
+   * Updates all modules until the simulation is stopped
+   * @param maxSteps The maximum number of simulation steps (0: unlimited)
+   * @return The number of simulation steps performed
+   */
+  unsigned run(unsigned maxSteps = 0);
+
+private:
+  class LoadedModule : public QLibrary
+  {
+  public:
+    SimRobot::Module* module = nullptr;
+    bool compiled = false;
+    using CreateModuleProc = SimRobot::Module* (*)(SimRobot::Application&);
+    CreateModuleProc createModule = nullptr;
+
+    LoadedModule(const QString& name) : QLibrary(name) {}
+  };
+
+  /** An entry of the scene graph. Children are listed in the order they were registered. */
+  class RegisteredObject
+  {
+  public:
+    SimRobot::Object* object;
+    RegisteredObject* parent;
+    const QString fullName;
+    QList<RegisteredObject*> children;
+
+    RegisteredObject(SimRobot::Object* object, RegisteredObject* parent) :
+      object(object), parent(parent), fullName(object->getFullName()) {}
+  };
+
+  QString appPath;
+  QStringList arguments;
+  QString filePath; /**< the path to the currently opened file */
+  QSettings settings;
+  QSettings layoutSettings;
+  bool compiled = false;
+  bool running = false;
+
+  QList<LoadedModule*> loadedModules;
+  QHash<QString, LoadedModule*> loadedModulesByName;
+  QList<SimRobot::StatusLabel*> statusLabels; /**< the status labels are never shown, but owned by the application */
+
+  QHash<const SimRobot::Object*, RegisteredObject*> registeredObjectsByObject;
+  QHash<int, QHash<QString, RegisteredObject*>> registeredObjectsByKindAndName;
+
+  bool compileModules();
+  void deleteRegisteredObject(RegisteredObject* registeredObject);
+
+  bool registerObject(const SimRobot::Module& module, SimRobot::Object& object, const SimRobot::Object* parent, int flags) override;
+  bool unregisterObject(const SimRobot::Object& object) override;
+  SimRobot::Object* resolveObject(const QString& fullName, int kind) override;
+  SimRobot::Object* resolveObject(const QVector<QString>& parts, const SimRobot::Object* parent, int kind) override;
+  int getObjectChildCount(const SimRobot::Object& object) override;
+  SimRobot::Object* getObjectChild(const SimRobot::Object& object, int index) override;
+  bool addStatusLabel(const SimRobot::Module& module, SimRobot::StatusLabel* statusLabel) override;
+  bool registerModule(const SimRobot::Module&, const QString&, const QString&, int) override {return true;}
+  bool loadModule(const QString& name) override;
+  bool openObject(const SimRobot::Object&) override {return false;}
+  bool closeObject(const SimRobot::Object&) override {return false;}
+  bool selectObject(const SimRobot::Object& object) override;
+  void showWarning(const QString& title, const QString& message) override;
+  void setStatusMessage(const QString&) override {}
+  const QString& getFilePath() const override {return filePath;}
+  const QString& getAppPath() const override {return appPath;}
+  QSettings& getSettings() override {return settings;}
+  QSettings& getLayoutSettings() override {return layoutSettings;}
+  const QStringList& getArguments() const override {return arguments;}
+  bool isSimRunning() override {return running;}
+  void simReset() override {}
+  void simStart() override {running = true;}
+  void simStep() override {}
+  void simStop() override {running = false;}
+};
@@ -0,0 +1,167 @@
+/**
+ * @file SimRobotHeadless/Main.cpp
+ * Implementation of the main function of SimRobotHeadless. It simulates a scene
+ * without a GUI as fast as possible. Several runs ("matches") of the same scene
+ * are simulated in parallel by child processes of this application, because
+ * the controllers keep their state in global variables.
+ */
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QThread>
+
+#ifndef WINDOWS
+#include <clocale>
+#endif
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+#include "HeadlessApplication.h"
+
+/** Prints how to use this application. */
+static void printUsage()
+{
+  std::cerr << "usage: SimRobotHeadless [-matches <n>] [-jobs <n>] [-steps <n>] <scene> {<argument>}\n"
+            << "  -matches <n>  Simulate the scene n times (default: 1).\n"
+            << "  -jobs <n>     Simulate up to n matches at the same time (default: number of cores).\n"
+            << "  -steps <n>    Stop each match after n simulation steps (default: when a module stops it).\n"
+            << "  <scene>       The scene file (.ros2 or .ros2d).\n"
+            << "  <argument>    Passed to the modules, where %1 is replaced by the index of the match.\n"
+            << "                The RoboCup controller executes them as console commands, e.g.\n"
+            << "  SimRobotHeadless -matches 100 Config/Scenes/DescriptionFiles/2D/[2D]7vs7.ros2d \"dt off\" \"gc ready\" \"ms /tmp/match%1.cfg\"" << std::endl;
+}
+
+/**
+ * Simulates a single match in this process.
+ * @param scene The scene file.
+ * @param arguments The arguments for the modules.
+ * @param match The index of the match.
+ * @param steps The maximum number of simulation steps (0: unlimited).
+ * @return The exit code of the application.
+ */
+static int runMatch(const QString& scene, QStringList arguments, int match, unsigned steps)
+{
+  for(QString& argument : arguments)
+    argument.replace("%1", QString::number(match));
+
+  HeadlessApplication application(QCoreApplication::applicationFilePath(), arguments);
+  if(!application.openFile(scene))
+    return EXIT_FAILURE;
+  application.run(steps);
+  return EXIT_SUCCESS;
+}
+
+/**
+ * Simulates several matches in child processes.
+ * @param scene The scene file.
+ * @param arguments The arguments for the modules.
+ * @param matches The number of matches.
+ * @param jobs The maximum number of child processes running at the same time.
+ * @param steps The maximum number of simulation steps per match (0: unlimited).
+ * @return The exit code of the application.
+ */
+static int runMatches(const QString& scene, const QStringList& arguments, int matches, int jobs, unsigned steps)
+{
+  QElapsedTimer timer;
+  timer.start();
+  int started = 0;
+  int running = 0;
+  int failed = 0;
+
+  std::function<void()> startNext = [&]
+  {
+    const int match = started++;
+    ++running;
+    QProcess* process = new QProcess;
+    process->setStandardOutputFile(QProcess::nullDevice());
+    process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+
+    auto finish = [&, process, match](bool success)
+    {
+      std::cout << "Match " << match << (success ? " finished" : " failed") << " after " << timer.elapsed() / 1000.0 << " s" << std::endl;
+      if(!success)
+        ++failed;
+      --running;
+      process->deleteLater();
+      if(started < matches)
+        startNext();
+      else if(!running)
+        QCoreApplication::quit();
+    };
+    QObject::connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), [finish](int exitCode, QProcess::ExitStatus exitStatus)
+    {
+      finish(exitStatus == QProcess::NormalExit && exitCode == EXIT_SUCCESS);
+    });
+    QObject::connect(process, &QProcess::errorOccurred, [finish](QProcess::ProcessError error)
+    {
+      if(error == QProcess::FailedToStart) // otherwise, finished is signaled as well
+        finish(false);
+    });
+
+    process->start(QCoreApplication::applicationFilePath(),
+                   QStringList() << "-match" << QString::number(match) << "-steps" << QString::number(steps) << scene << arguments);
+  };
+
+  while(started < std::min(matches, jobs))
+    startNext();
+  if(running) // processes that failed to start might already have finished everything
+    QCoreApplication::exec();
+
+  std::cout << matches << " matches (" << failed << " failed) simulated in " << timer.elapsed() / 1000.0 << " s" << std::endl;
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  // no windows are ever shown, but the controllers still need a QApplication
+#if !defined WINDOWS && !defined MACOS
+  if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen"); // works without a display
+#endif
+  QApplication app(argc, argv);
+#ifndef WINDOWS
+  setlocale(LC_NUMERIC, "C");
+#endif
+  app.setApplicationName("SimRobotHeadless");
+
+  int matches = 1;
+  int jobs = QThread::idealThreadCount();
+  int match = -1;
+  unsigned steps = 0;
+  QString scene;
+  QStringList arguments;
+  const QStringList commandLine = app.arguments();
+  for(int i = 1; i < commandLine.size(); ++i)
+  {
+    const QString& argument = commandLine[i];
+    if(!scene.isEmpty())
+      arguments.append(argument);
+    else if(argument == "-matches" && i + 1 < commandLine.size())
+      matches = commandLine[++i].toInt();
+    else if(argument == "-jobs" && i + 1 < commandLine.size())
+      jobs = commandLine[++i].toInt();
+    else if(argument == "-match" && i + 1 < commandLine.size())
+      match = commandLine[++i].toInt();
+    else if(argument == "-steps" && i + 1 < commandLine.size())
+      steps = commandLine[++i].toUInt();
+    else if(argument.startsWith('-'))
+    {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+    else
+      scene = argument;
+  }
+  if(scene.isEmpty() || matches < 1 || jobs < 1)
+  {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  if(match >= 0 || matches == 1)
+    return runMatch(scene, arguments, std::max(match, 0), steps);
+  else
+    return runMatches(scene, arguments, matches, jobs, steps);
+}